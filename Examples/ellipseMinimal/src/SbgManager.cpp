@@ -5,12 +5,19 @@
 
 SbgManager::SbgManager()
 {
+	//
+	// The sbgECom handle is too large to be a member of an object that can live on the stack
+	//
+	pComHandle = new SbgEComHandle;
+
 	initialize();
 }
 
 SbgManager::~SbgManager()
 {
 	release();
+
+	delete pComHandle;
 }
 
 bool SbgManager::initialize()
@@ -49,7 +56,7 @@ bool SbgManager::initialize()
 		return false;
 	}
 
-	errorCode = sbgEComInit(&comHandle, &sbgInterface);
+	errorCode = sbgEComInit(pComHandle, &sbgInterface);
 
 	if (errorCode != SBG_NO_ERROR)
 	{
@@ -63,7 +70,7 @@ bool SbgManager::initialize()
 	//
 	// Get device inforamtions
 	//
-	errorCode = sbgEComCmdGetInfo(&comHandle, &deviceInfo);
+	errorCode = sbgEComCmdGetInfo(pComHandle, &deviceInfo);
 
 	//
 	// Display device information if no error
@@ -87,7 +94,7 @@ bool SbgManager::initialize()
 	//
 	// Define callbacks for received data
 	//
-	sbgEComSetReceiveCallback(&comHandle, recFunc, this);
+	sbgEComSetReceiveCallback(pComHandle, recFunc, this);
 
 	m_bInitialized = true;
 
@@ -103,7 +110,7 @@ bool SbgManager::release()
 	//
 	// Close the sbgEcom library
 	//
-	sbgEComClose(&comHandle);
+	sbgEComClose(pComHandle);
 
 	return true;
 }
@@ -250,7 +257,7 @@ DWORD SbgManager::ThreadProc(void)
 				//
 		// Try to read a frame
 		//
-		errorCode = sbgEComHandle(&comHandle);
+		errorCode = sbgEComHandle(pComHandle);
 
 		//
 		// Test if we have to release some CPU (no frame received)
@@ -258,9 +265,9 @@ DWORD SbgManager::ThreadProc(void)
 		if (errorCode == SBG_NOT_READY)
 		{
 			//
-			// Release CPU
+			// Release CPU until new data are received
 			//
-			sbgSleep(1);
+			sbgInterfaceWaitReadable(&sbgInterface, 100);
 		}
 		else
 		{
@@ -385,7 +392,7 @@ bool SbgManager::SetParameter(int fps)
 	//
 	// Configure some output logs to 25 Hz
 	//
-	if (sbgEComCmdOutputSetConf(&comHandle, SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER, mode) != SBG_NO_ERROR)
+	if (sbgEComCmdOutputSetConf(pComHandle, SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER, mode) != SBG_NO_ERROR)
 	{
 		fprintf(stderr, "ellipseMinimal: Unable to configure output log SBG_ECOM_LOG_EKF_EULER.\n");
 		return false;
@@ -56,7 +56,7 @@ protected:
 
 private:
 	// sbg
-	SbgEComHandle			comHandle;
+	SbgEComHandle			*pComHandle;		// allocated on the heap as the handle is quite large
 	SbgErrorCode			errorCode;
 	SbgInterface			sbgInterface;
 	int32					retValue = 0;
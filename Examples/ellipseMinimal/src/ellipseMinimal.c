@@ -79,7 +79,7 @@ SbgErrorCode onLogReceived(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const Sb
  */
 int main(int argc, char** argv)
 {
-	SbgEComHandle			comHandle;
+	static SbgEComHandle	comHandle;
 	SbgErrorCode			errorCode;
 	SbgInterface			sbgInterface;
 	int32					retValue = 0;
@@ -163,9 +163,9 @@ int main(int argc, char** argv)
 				if (errorCode == SBG_NOT_READY)
 				{
 					//
-					// Release CPU
+					// Release CPU until new data are received
 					//
-					sbgSleep(1);
+					sbgInterfaceWaitReadable(&sbgInterface, 100);
 				}
 				else
 				{
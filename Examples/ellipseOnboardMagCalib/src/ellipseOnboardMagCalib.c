@@ -170,7 +170,7 @@ void displayMagCalibResults(SbgEComMagCalibMode mode, const SbgEComMagCalibResul
  */
 int main(int argc, char** argv)
 {
-	SbgEComHandle			comHandle;
+	static SbgEComHandle	comHandle;
 	SbgErrorCode			errorCode;
 	SbgInterface			sbgInterface;
 	int32					retValue = 0;
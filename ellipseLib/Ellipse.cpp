@@ -1,8 +1,1091 @@
 #include "Ellipse.h"
-#include <time.h>
+#include <commands/transfer/sbgEComTransfer.h>
 
-Ellipse Ellipse::Connect(const char* deviceName)
+//----------------------------------------------------------------------//
+//- Private methods declarations                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse an EllipseLeverArm answer.
+ *	\param[in]	pInputStream							Stream buffer initialized on the answer payload.
+ *	\param[out]	pValue									Value to fill.
+ *	\return												SBG_NO_ERROR if the payload has been parsed.
+ */
+static SbgErrorCode decodeLeverArm(SbgStreamBuffer *pInputStream, EllipseLeverArm *pValue)
+{
+	return sbgEComCmdOdoParseLeverArm(pInputStream, pValue->leverArm);
+}
+
+/*!
+ *	Parse an EllipseCanOutputConf answer.
+ *	\param[in]	pInputStream							Stream buffer initialized on the answer payload.
+ *	\param[out]	pValue									Value to fill.
+ *	\return												SBG_NO_ERROR if the payload has been parsed.
+ */
+static SbgErrorCode decodeCanOutputConf(SbgStreamBuffer *pInputStream, EllipseCanOutputConf *pValue)
+{
+	return sbgEComCmdCanOutputParseConf(pInputStream, &pValue->mode, &pValue->userId, &pValue->extended);
+}
+
+/*!
+ *	Parse an EllipseNmeaTalkerId answer.
+ *	\param[in]	pInputStream							Stream buffer initialized on the answer payload.
+ *	\param[out]	pValue									Value to fill.
+ *	\return												SBG_NO_ERROR if the payload has been parsed.
+ */
+static SbgErrorCode decodeNmeaTalkerId(SbgStreamBuffer *pInputStream, EllipseNmeaTalkerId *pValue)
+{
+	return sbgEComCmdOutputParseNmeaTalkerId(pInputStream, pValue->talkerId);
+}
+
+/*!
+ *	Parse an EllipseSensorAlignment answer.
+ *	\param[in]	pInputStream							Stream buffer initialized on the answer payload.
+ *	\param[out]	pValue									Value to fill.
+ *	\return												SBG_NO_ERROR if the payload has been parsed.
+ */
+static SbgErrorCode decodeSensorAlignment(SbgStreamBuffer *pInputStream, EllipseSensorAlignment *pValue)
+{
+	return sbgEComCmdSensorParseAlignmentAndLeverArm(pInputStream, &pValue->alignment, pValue->leverArm);
+}
+
+//----------------------------------------------------------------------//
+//- EllipseTask methods                                                -//
+//----------------------------------------------------------------------//
+
+std::coroutine_handle<> EllipseTask::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+{
+	//
+	// Resume the awaiting task if any, otherwise return to the event loop
+	//
+	if (handle.promise().m_continuation)
+	{
+		return handle.promise().m_continuation;
+	}
+	else
+	{
+		return std::noop_coroutine();
+	}
+}
+
+EllipseTask::EllipseTask(EllipseTask &&other) noexcept : m_handle(other.m_handle)
+{
+	other.m_handle = nullptr;
+}
+
+EllipseTask &EllipseTask::operator=(EllipseTask &&other) noexcept
+{
+	if (this != &other)
+	{
+		if (m_handle)
+		{
+			m_handle.destroy();
+		}
+
+		m_handle = other.m_handle;
+		other.m_handle = nullptr;
+	}
+
+	return *this;
+}
+
+EllipseTask::~EllipseTask()
+{
+	//
+	// Destroying a suspended coroutine also cancels the command it is waiting for
+	//
+	if (m_handle)
+	{
+		m_handle.destroy();
+	}
+}
+
+void EllipseTask::start()
+{
+	//
+	// A coroutine that has been started is suspended on a command or finished
+	//
+	if ( (m_handle) && (!m_handle.done()) && (!m_handle.promise().m_continuation) && (m_handle.promise().m_errorCode == SBG_NOT_READY) )
+	{
+		m_handle.promise().m_errorCode = SBG_NO_ERROR;
+		m_handle.resume();
+	}
+}
+
+bool EllipseTask::isDone() const
+{
+	return ( (!m_handle) || (m_handle.done()) );
+}
+
+SbgErrorCode EllipseTask::getResult() const
+{
+	if (isDone())
+	{
+		return m_handle ? m_handle.promise().m_errorCode : SBG_INVALID_PARAMETER;
+	}
+	else
+	{
+		return SBG_NOT_READY;
+	}
+}
+
+std::coroutine_handle<> EllipseTask::await_suspend(std::coroutine_handle<> caller) noexcept
+{
+	//
+	// Run this task right now, the caller is resumed once it is finished
+	//
+	m_handle.promise().m_continuation = caller;
+	m_handle.promise().m_errorCode = SBG_NO_ERROR;
+
+	return m_handle;
+}
+
+//----------------------------------------------------------------------//
+//- EllipseCommand methods                                             -//
+//----------------------------------------------------------------------//
+
+EllipseCommand::EllipseCommand(Ellipse *pDevice, uint16 cmd, SbgEComAsyncCmdType type, const void *pPayload, uint32 payloadSize, uint32 timeOut) :
+	m_pDevice(pDevice), m_cmd(cmd), m_type(type), m_timeOut(timeOut), m_payloadSize(0), m_answerSize(0), m_ticket(0), m_errorCode(SBG_NOT_READY), m_pNextReady(nullptr), m_bReady(false)
+{
+	//
+	// An invalid command is directly completed so it doesn't suspend the coroutine
+	//
+	if ( (payloadSize > sizeof(m_payload)) || ( (payloadSize > 0) && (pPayload == NULL) ) )
+	{
+		m_errorCode = SBG_INVALID_PARAMETER;
+	}
+	else if (payloadSize > 0)
+	{
+		memcpy(m_payload, pPayload, payloadSize);
+		m_payloadSize = payloadSize;
+	}
+}
+
+EllipseCommand::~EllipseCommand()
+{
+	//
+	// The awaiting coroutine has been destroyed before the answer has been received
+	//
+	if (m_ticket != 0)
+	{
+		sbgEComCmdCancel(m_pDevice->getHandle(), m_ticket);
+	}
+
+	//
+	// The awaiting coroutine has been destroyed before the event loop has resumed it
+	//
+	if (m_bReady)
+	{
+		m_pDevice->removeReadyCommand(this);
+	}
+}
+
+bool EllipseCommand::await_suspend(std::coroutine_handle<> caller) noexcept
+{
+	SbgErrorCode	errorCode;
+	void			*pAnswer;
+	uint32			maxAnswerSize;
+
+	//
+	// Only get commands need to store their answer
+	//
+	if (m_type == SBG_ECOM_ASYNC_CMD_WAIT_ANSWER)
+	{
+		pAnswer = m_answer;
+		maxAnswerSize = sizeof(m_answer);
+	}
+	else
+	{
+		pAnswer = NULL;
+		maxAnswerSize = 0;
+	}
+
+	errorCode = sbgEComCmdSubmitEx(m_pDevice->getHandle(), m_cmd, m_type, m_payload, m_payloadSize, pAnswer, maxAnswerSize, m_timeOut, onCompleted, this, &m_ticket);
+
+	if (errorCode != SBG_NO_ERROR)
+	{
+		//
+		// The command couldn't be queued so resume the coroutine right now
+		//
+		m_ticket = 0;
+		m_errorCode = errorCode;
+
+		return false;
+	}
+	else if (m_errorCode != SBG_NOT_READY)
+	{
+		//
+		// The command has already failed because it couldn't be sent
+		//
+		return false;
+	}
+
+	m_caller = caller;
+
+	return true;
+}
+
+void EllipseCommand::onCompleted(SbgEComHandle *pHandle, uint32 ticket, SbgErrorCode result, const void *pAnswer, uint32 answerSize, void *pUserArg)
+{
+	EllipseCommand	*pCommand = (EllipseCommand*)pUserArg;
+
+	SBG_UNUSED_PARAMETER(pHandle);
+	SBG_UNUSED_PARAMETER(ticket);
+	SBG_UNUSED_PARAMETER(pAnswer);
+
+	pCommand->m_errorCode = result;
+	pCommand->m_answerSize = (result == SBG_NO_ERROR) ? answerSize : 0;
+
+	pCommand->m_ticket = 0;
+
+	//
+	// The coroutine isn't suspended yet if the command is completed during sbgEComCmdSubmitEx
+	// Otherwise, it is resumed by the event loop once sbgEComHandle has returned and not from the frames dispatch
+	//
+	if (pCommand->m_caller)
+	{
+		pCommand->m_pDevice->addReadyCommand(pCommand);
+	}
+}
+
+//----------------------------------------------------------------------//
+//- Ellipse methods                                                    -//
+//----------------------------------------------------------------------//
+
+Ellipse::Ellipse() : m_bOwnInterface(false), m_bConnected(false), m_pFirstReady(nullptr), m_pLastReady(nullptr)
+{
+	sbgInterfaceZeroInit(&m_interface);
+}
+
+Ellipse::~Ellipse()
+{
+	close();
+}
+
+SbgErrorCode Ellipse::connect(const char *deviceName, uint32 baudRate)
+{
+	SbgErrorCode	errorCode;
+
+	close();
+
+	errorCode = sbgInterfaceSerialCreate(&m_interface, deviceName, baudRate);
+
+	if (errorCode == SBG_NO_ERROR)
+	{
+		m_bOwnInterface = true;
+		errorCode = connect(&m_interface);
+	}
+
+	return errorCode;
+}
+
+SbgErrorCode Ellipse::connect(SbgInterface *pInterface)
+{
+	SbgErrorCode	errorCode;
+
+	errorCode = sbgEComInit(&m_comHandle, pInterface);
+
+	if (errorCode == SBG_NO_ERROR)
+	{
+		m_bConnected = true;
+	}
+	else
+	{
+		close();
+	}
+
+	return errorCode;
+}
+
+void Ellipse::close()
+{
+	if (m_bConnected)
+	{
+		sbgEComClose(&m_comHandle);
+		m_bConnected = false;
+	}
+
+	if (m_bOwnInterface)
+	{
+		sbgInterfaceSerialDestroy(&m_interface);
+		m_bOwnInterface = false;
+	}
+}
+
+void Ellipse::setReceiveCallback(SbgEComReceiveFunc pReceiveCallback, void *pUserArg)
+{
+	sbgEComSetReceiveCallback(&m_comHandle, pReceiveCallback, pUserArg);
+}
+
+SbgErrorCode Ellipse::poll(uint32 timeOut)
+{
+	SbgErrorCode	errorCode;
+
+	//
+	// Dispatch the binary logs, commands completed by the received frames are only resumed once the dispatch is over
+	//
+	errorCode = sbgEComHandle(&m_comHandle);
+
+	resumeReadyCommands();
+
+	if ( (errorCode == SBG_NOT_READY) && (timeOut > 0) )
+	{
+		sbgInterfaceWaitReadable(m_comHandle.protocolHandle.pLinkedInterface, timeOut);
+	}
+
+	return errorCode;
+}
+
+SbgErrorCode Ellipse::run(EllipseTask &task)
 {
+	task.start();
 
-	return Ellipse();
+	while (!task.isDone())
+	{
+		poll();
+	}
+
+	return task.getResult();
+}
+
+void Ellipse::addReadyCommand(EllipseCommand *pCommand)
+{
+	pCommand->m_pNextReady = nullptr;
+	pCommand->m_bReady = true;
+
+	if (m_pLastReady)
+	{
+		m_pLastReady->m_pNextReady = pCommand;
+	}
+	else
+	{
+		m_pFirstReady = pCommand;
+	}
+
+	m_pLastReady = pCommand;
+}
+
+void Ellipse::removeReadyCommand(EllipseCommand *pCommand)
+{
+	EllipseCommand	*pPrevious = nullptr;
+	EllipseCommand	*pCurrent;
+
+	for (pCurrent = m_pFirstReady; pCurrent; pCurrent = pCurrent->m_pNextReady)
+	{
+		if (pCurrent == pCommand)
+		{
+			if (pPrevious)
+			{
+				pPrevious->m_pNextReady = pCurrent->m_pNextReady;
+			}
+			else
+			{
+				m_pFirstReady = pCurrent->m_pNextReady;
+			}
+
+			if (m_pLastReady == pCurrent)
+			{
+				m_pLastReady = pPrevious;
+			}
+
+			pCommand->m_pNextReady = nullptr;
+			pCommand->m_bReady = false;
+			break;
+		}
+
+		pPrevious = pCurrent;
+	}
+}
+
+void Ellipse::resumeReadyCommands()
+{
+	EllipseCommand	*pCommand;
+
+	//
+	// A resumed coroutine can destroy other tasks, so each command is removed from the list before being resumed
+	//
+	while (m_pFirstReady)
+	{
+		pCommand = m_pFirstReady;
+
+		m_pFirstReady = pCommand->m_pNextReady;
+
+		if (!m_pFirstReady)
+		{
+			m_pLastReady = nullptr;
+		}
+
+		pCommand->m_pNextReady = nullptr;
+		pCommand->m_bReady = false;
+
+		pCommand->m_caller.resume();
+	}
+}
+
+EllipseCommand Ellipse::setCommand(SbgEComCmd cmdId, SbgStreamBuffer *pOutputStream)
+{
+	return EllipseCommand(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, cmdId), SBG_ECOM_ASYNC_CMD_WAIT_ACK, sbgStreamBufferGetLinkedBuffer(pOutputStream), (uint32)sbgStreamBufferGetLength(pOutputStream));
+}
+
+EllipseTask Ellipse::transferSend(SbgEComCmd cmdId, const void *pBuffer, uint32 size)
+{
+	SbgErrorCode	errorCode;
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE];
+	uint32			offset;
+	uint32			packetSize;
+
+	if ( (pBuffer == NULL) || (size == 0) )
+	{
+		co_return SBG_INVALID_PARAMETER;
+	}
+
+	//
+	// Initiate the upload with the total size
+	//
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgStreamBufferWriteUint16LE(&outputStream, ECOM_TRANSFER_START);
+	sbgStreamBufferWriteUint32LE(&outputStream, size);
+
+	errorCode = co_await setCommand(cmdId, &outputStream);
+
+	//
+	// Send the data packet by packet, packets are smaller than SBG_ECOM_PACKET_SIZE to fit in an asynchronous command
+	//
+	for (offset = 0; (errorCode == SBG_NO_ERROR) && (offset < size); offset += packetSize)
+	{
+		packetSize = size - offset;
+
+		if (packetSize > ELLIPSE_TRANSFER_PACKET_SIZE)
+		{
+			packetSize = ELLIPSE_TRANSFER_PACKET_SIZE;
+		}
+
+		sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+		sbgStreamBufferWriteUint16LE(&outputStream, ECOM_TRANSFER_DATA);
+		sbgStreamBufferWriteUint32LE(&outputStream, offset);
+		sbgStreamBufferWriteBuffer(&outputStream, (const uint8*)pBuffer + offset, packetSize);
+
+		errorCode = co_await setCommand(cmdId, &outputStream);
+	}
+
+	//
+	// End the upload
+	//
+	if (errorCode == SBG_NO_ERROR)
+	{
+		sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+		sbgStreamBufferWriteUint16LE(&outputStream, ECOM_TRANSFER_END);
+
+		errorCode = co_await setCommand(cmdId, &outputStream);
+	}
+
+	co_return errorCode;
+}
+
+EllipseTask Ellipse::transferReceive(SbgEComCmd cmdId, void *pBuffer, uint32 *pSize, uint32 maxSize)
+{
+	SbgErrorCode	errorCode;
+	SbgStreamBuffer	outputStream;
+	SbgStreamBuffer	inputStream;
+	uint8			outputBuffer[3*sizeof(uint32)];
+	uint16			cmd;
+	uint32			transferSize = 0;
+	uint32			offset;
+	uint32			packetSize;
+
+	if ( (pBuffer == NULL) || (pSize == NULL) || (maxSize == 0) )
+	{
+		co_return SBG_INVALID_PARAMETER;
+	}
+
+	cmd = SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, cmdId);
+
+	//
+	// Initiate the download, the device answers with the total size
+	//
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgStreamBufferWriteUint16LE(&outputStream, ECOM_TRANSFER_START);
+
+	{
+		EllipseCommand startCommand(this, cmd, SBG_ECOM_ASYNC_CMD_WAIT_ANSWER, outputBuffer, (uint32)sbgStreamBufferGetLength(&outputStream));
+
+		errorCode = co_await startCommand;
+
+		if (errorCode == SBG_NO_ERROR)
+		{
+			sbgStreamBufferInitForRead(&inputStream, startCommand.getAnswer(), startCommand.getAnswerSize());
+
+			if (sbgStreamBufferReadUint16LE(&inputStream) == ECOM_TRANSFER_START)
+			{
+				transferSize = sbgStreamBufferReadUint32LE(&inputStream);
+				errorCode = sbgStreamBufferGetLastError(&inputStream);
+			}
+			else
+			{
+				errorCode = SBG_ERROR;
+			}
+		}
+	}
+
+	if ( (errorCode == SBG_NO_ERROR) && (transferSize > maxSize) )
+	{
+		co_return SBG_INVALID_PARAMETER;
+	}
+
+	//
+	// Receive the data packet by packet
+	//
+	for (offset = 0; (errorCode == SBG_NO_ERROR) && (offset < transferSize); offset += packetSize)
+	{
+		packetSize = transferSize - offset;
+
+		if (packetSize > ELLIPSE_TRANSFER_PACKET_SIZE)
+		{
+			packetSize = ELLIPSE_TRANSFER_PACKET_SIZE;
+		}
+
+		sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+		sbgStreamBufferWriteUint16LE(&outputStream, ECOM_TRANSFER_DATA);
+		sbgStreamBufferWriteUint32LE(&outputStream, offset);
+		sbgStreamBufferWriteUint32LE(&outputStream, packetSize);
+
+		EllipseCommand dataCommand(this, cmd, SBG_ECOM_ASYNC_CMD_WAIT_ANSWER, outputBuffer, (uint32)sbgStreamBufferGetLength(&outputStream));
+
+		errorCode = co_await dataCommand;
+
+		if (errorCode == SBG_NO_ERROR)
+		{
+			//
+			// The answer contains the transfer command, the offset and then the data
+			//
+			sbgStreamBufferInitForRead(&inputStream, dataCommand.getAnswer(), dataCommand.getAnswerSize());
+
+			if ( (sbgStreamBufferReadUint16LE(&inputStream) == ECOM_TRANSFER_DATA) && (sbgStreamBufferReadUint32LE(&inputStream) == offset) &&
+				 (dataCommand.getAnswerSize() == packetSize + sizeof(uint16) + sizeof(uint32)) )
+			{
+				sbgStreamBufferReadBuffer(&inputStream, (uint8*)pBuffer + offset, packetSize);
+			}
+			else
+			{
+				errorCode = SBG_ERROR;
+			}
+		}
+	}
+
+	//
+	// End the download
+	//
+	if (errorCode == SBG_NO_ERROR)
+	{
+		sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+		sbgStreamBufferWriteUint16LE(&outputStream, ECOM_TRANSFER_END);
+
+		errorCode = co_await setCommand(cmdId, &outputStream);
+	}
+
+	if (errorCode == SBG_NO_ERROR)
+	{
+		*pSize = transferSize;
+	}
+
+	co_return errorCode;
+}
+
+//----------------------------------------------------------------------//
+//- Advanced commands                                                  -//
+//----------------------------------------------------------------------//
+
+EllipseGetCommand<SbgEComAdvancedConf> Ellipse::advancedGetConf()
+{
+	return EllipseGetCommand<SbgEComAdvancedConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ADVANCED_CONF), NULL, 0, sbgEComCmdAdvancedParseConf);
+}
+
+EllipseCommand Ellipse::advancedSetConf(const SbgEComAdvancedConf &conf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[1];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdAdvancedWriteConf(&outputStream, &conf);
+
+	return setCommand(SBG_ECOM_CMD_ADVANCED_CONF, &outputStream);
+}
+
+//----------------------------------------------------------------------//
+//- Event commands                                                     -//
+//----------------------------------------------------------------------//
+
+EllipseGetCommand<SbgEComSyncInConf> Ellipse::syncInGetConf(SbgEComSyncInId syncInId)
+{
+	uint8			outputBuffer[1] = { (uint8)syncInId };
+
+	return EllipseGetCommand<SbgEComSyncInConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_SYNC_IN_CONF), outputBuffer, sizeof(outputBuffer), sbgEComCmdSyncInParseConf);
+}
+
+EllipseCommand Ellipse::syncInSetConf(SbgEComSyncInId syncInId, const SbgEComSyncInConf &conf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[2*sizeof(uint8) + sizeof(int32)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdSyncInWriteConf(&outputStream, syncInId, &conf);
+
+	return setCommand(SBG_ECOM_CMD_SYNC_IN_CONF, &outputStream);
+}
+
+EllipseGetCommand<SbgEComSyncOutConf> Ellipse::syncOutGetConf(SbgEComSyncOutId syncOutId)
+{
+	uint8			outputBuffer[1] = { (uint8)syncOutId };
+
+	return EllipseGetCommand<SbgEComSyncOutConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_SYNC_OUT_CONF), outputBuffer, sizeof(outputBuffer), sbgEComCmdSyncOutParseConf);
+}
+
+EllipseCommand Ellipse::syncOutSetConf(SbgEComSyncOutId syncOutId, const SbgEComSyncOutConf &conf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[3*sizeof(uint8) + sizeof(uint16) + sizeof(uint32)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdSyncOutWriteConf(&outputStream, syncOutId, &conf);
+
+	return setCommand(SBG_ECOM_CMD_SYNC_OUT_CONF, &outputStream);
+}
+
+EllipseGetCommand<float> Ellipse::virtualOdometerGetConf()
+{
+	return EllipseGetCommand<float>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_VIRTUAL_ODOMETER_CONF), NULL, 0, sbgEComCmdVirtualOdometerParseConf);
+}
+
+EllipseCommand Ellipse::virtualOdometerSetConf(float distance)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[sizeof(float)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdVirtualOdometerWriteConf(&outputStream, distance);
+
+	return setCommand(SBG_ECOM_CMD_VIRTUAL_ODOMETER_CONF, &outputStream);
+}
+
+//----------------------------------------------------------------------//
+//- Features and information commands                                  -//
+//----------------------------------------------------------------------//
+
+EllipseGetCommand<SbgEComFeatures> Ellipse::getFeatures()
+{
+	return EllipseGetCommand<SbgEComFeatures>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_FEATURES), NULL, 0, sbgEComCmdParseFeatures);
+}
+
+EllipseGetCommand<SbgEComDeviceInfo> Ellipse::getInfo()
+{
+	return EllipseGetCommand<SbgEComDeviceInfo>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO), NULL, 0, sbgEComCmdParseInfo);
+}
+
+//----------------------------------------------------------------------//
+//- GNSS commands                                                      -//
+//----------------------------------------------------------------------//
+
+EllipseCommand Ellipse::gnss1SetModelId(uint32 id)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[sizeof(uint32)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdGenericWriteModelId(&outputStream, id);
+
+	return setCommand(SBG_ECOM_CMD_GNSS_1_MODEL_ID, &outputStream);
+}
+
+EllipseGetCommand<SbgEComModelInfo> Ellipse::gnss1GetModelInfo()
+{
+	return EllipseGetCommand<SbgEComModelInfo>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_GNSS_1_MODEL_ID), NULL, 0, sbgEComCmdGenericParseModelInfo);
+}
+
+EllipseGetCommand<SbgEComGnssAlignmentInfo> Ellipse::gnss1GetLeverArmAlignment()
+{
+	return EllipseGetCommand<SbgEComGnssAlignmentInfo>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_GNSS_1_LEVER_ARM_ALIGNMENT), NULL, 0, sbgEComCmdGnssParseLeverArmAlignment);
+}
+
+EllipseCommand Ellipse::gnss1SetLeverArmAlignment(const SbgEComGnssAlignmentInfo &alignConf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[6*sizeof(float)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdGnssWriteLeverArmAlignment(&outputStream, &alignConf);
+
+	return setCommand(SBG_ECOM_CMD_GNSS_1_LEVER_ARM_ALIGNMENT, &outputStream);
+}
+
+EllipseGetCommand<SbgEComGnssRejectionConf> Ellipse::gnss1GetRejection()
+{
+	return EllipseGetCommand<SbgEComGnssRejectionConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_GNSS_1_REJECT_MODES), NULL, 0, sbgEComCmdGnssParseRejection);
+}
+
+EllipseCommand Ellipse::gnss1SetRejection(const SbgEComGnssRejectionConf &rejectConf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[4*sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdGnssWriteRejection(&outputStream, &rejectConf);
+
+	return setCommand(SBG_ECOM_CMD_GNSS_1_REJECT_MODES, &outputStream);
+}
+
+//----------------------------------------------------------------------//
+//- Interface commands                                                 -//
+//----------------------------------------------------------------------//
+
+EllipseGetCommand<SbgEComInterfaceConf> Ellipse::interfaceGetUartConf(SbgEComPortId interfaceId)
+{
+	uint8			outputBuffer[1] = { (uint8)interfaceId };
+
+	return EllipseGetCommand<SbgEComInterfaceConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_UART_CONF), outputBuffer, sizeof(outputBuffer), sbgEComCmdInterfaceParseUartConf);
+}
+
+EllipseCommand Ellipse::interfaceSetUartConf(SbgEComPortId interfaceId, const SbgEComInterfaceConf &conf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[2*sizeof(uint8) + sizeof(uint32)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdInterfaceWriteUartConf(&outputStream, interfaceId, &conf);
+
+	return setCommand(SBG_ECOM_CMD_UART_CONF, &outputStream);
+}
+
+EllipseGetCommand<SbgEComCanBitRate> Ellipse::interfaceGetCanConf()
+{
+	return EllipseGetCommand<SbgEComCanBitRate>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_CAN_BUS_CONF), NULL, 0, sbgEComCmdInterfaceParseCanConf);
+}
+
+EllipseCommand Ellipse::interfaceSetCanConf(SbgEComCanBitRate bitrate)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[sizeof(uint16)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdInterfaceWriteCanConf(&outputStream, bitrate);
+
+	return setCommand(SBG_ECOM_CMD_CAN_BUS_CONF, &outputStream);
+}
+
+//----------------------------------------------------------------------//
+//- License commands                                                   -//
+//----------------------------------------------------------------------//
+
+EllipseTask Ellipse::licenseApply(const void *pBuffer, uint32 size)
+{
+	return transferSend(SBG_ECOM_CMD_LICENSE_APPLY, pBuffer, size);
+}
+
+//----------------------------------------------------------------------//
+//- Magnetometer commands                                              -//
+//----------------------------------------------------------------------//
+
+EllipseCommand Ellipse::magSetModelId(uint32 id)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[sizeof(uint32)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdGenericWriteModelId(&outputStream, id);
+
+	return setCommand(SBG_ECOM_CMD_MAGNETOMETER_MODEL_ID, &outputStream);
+}
+
+EllipseGetCommand<SbgEComModelInfo> Ellipse::magGetModelInfo()
+{
+	return EllipseGetCommand<SbgEComModelInfo>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_MAGNETOMETER_MODEL_ID), NULL, 0, sbgEComCmdGenericParseModelInfo);
+}
+
+EllipseGetCommand<SbgEComMagRejectionConf> Ellipse::magGetRejection()
+{
+	return EllipseGetCommand<SbgEComMagRejectionConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_MAGNETOMETER_REJECT_MODE), NULL, 0, sbgEComCmdMagParseRejection);
+}
+
+EllipseCommand Ellipse::magSetRejection(const SbgEComMagRejectionConf &rejectConf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[1];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdMagWriteRejection(&outputStream, &rejectConf);
+
+	return setCommand(SBG_ECOM_CMD_MAGNETOMETER_REJECT_MODE, &outputStream);
+}
+
+EllipseCommand Ellipse::magSetCalibData(const float offset[3], const float matrix[9])
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[12*sizeof(float)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdMagWriteCalibData(&outputStream, offset, matrix);
+
+	return setCommand(SBG_ECOM_CMD_SET_MAG_CALIB, &outputStream);
+}
+
+EllipseCommand Ellipse::magStartCalib(SbgEComMagCalibMode mode, SbgEComMagCalibBandwidth bandwidth)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[2*sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdMagWriteStartCalib(&outputStream, mode, bandwidth);
+
+	return setCommand(SBG_ECOM_CMD_START_MAG_CALIB, &outputStream);
+}
+
+EllipseGetCommand<SbgEComMagCalibResults> Ellipse::magComputeCalib()
+{
+	//
+	// The device needs more time to compute the calibration
+	//
+	return EllipseGetCommand<SbgEComMagCalibResults>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_COMPUTE_MAG_CALIB), NULL, 0, sbgEComCmdMagParseCalibResults, ELLIPSE_MAG_COMPUTE_CALIB_TIME_OUT);
+}
+
+//----------------------------------------------------------------------//
+//- Odometer commands                                                  -//
+//----------------------------------------------------------------------//
+
+EllipseGetCommand<SbgEComOdoConf> Ellipse::odoGetConf()
+{
+	return EllipseGetCommand<SbgEComOdoConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ODO_CONF), NULL, 0, sbgEComCmdOdoParseConf);
+}
+
+EllipseCommand Ellipse::odoSetConf(const SbgEComOdoConf &odometerConf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[sizeof(float) + 2*sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdOdoWriteConf(&outputStream, &odometerConf);
+
+	return setCommand(SBG_ECOM_CMD_ODO_CONF, &outputStream);
+}
+
+EllipseGetCommand<EllipseLeverArm> Ellipse::odoGetLeverArm()
+{
+	return EllipseGetCommand<EllipseLeverArm>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ODO_LEVER_ARM), NULL, 0, decodeLeverArm);
+}
+
+EllipseCommand Ellipse::odoSetLeverArm(const float leverArm[3])
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[3*sizeof(float)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdOdoWriteLeverArm(&outputStream, leverArm);
+
+	return setCommand(SBG_ECOM_CMD_ODO_LEVER_ARM, &outputStream);
+}
+
+EllipseGetCommand<SbgEComOdoRejectionConf> Ellipse::odoGetRejection()
+{
+	return EllipseGetCommand<SbgEComOdoRejectionConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ODO_REJECT_MODE), NULL, 0, sbgEComCmdOdoParseRejection);
+}
+
+EllipseCommand Ellipse::odoSetRejection(const SbgEComOdoRejectionConf &rejectConf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[1];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdOdoWriteRejection(&outputStream, &rejectConf);
+
+	return setCommand(SBG_ECOM_CMD_ODO_REJECT_MODE, &outputStream);
+}
+
+//----------------------------------------------------------------------//
+//- Output commands                                                    -//
+//----------------------------------------------------------------------//
+
+EllipseGetCommand<SbgEComOutputMode> Ellipse::outputGetConf(SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId)
+{
+	uint8			outputBuffer[3] = { (uint8)outputPort, (uint8)msgId, (uint8)classId };
+
+	return EllipseGetCommand<SbgEComOutputMode>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_OUTPUT_CONF), outputBuffer, sizeof(outputBuffer), sbgEComCmdOutputParseConf);
+}
+
+EllipseCommand Ellipse::outputSetConf(SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId, SbgEComOutputMode mode)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[3*sizeof(uint8) + sizeof(uint16)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdOutputWriteConf(&outputStream, outputPort, classId, msgId, mode);
+
+	return setCommand(SBG_ECOM_CMD_OUTPUT_CONF, &outputStream);
+}
+
+EllipseGetCommand<bool> Ellipse::outputClassGetEnable(SbgEComOutputPort outputPort, SbgEComClass classId)
+{
+	uint8			outputBuffer[2] = { (uint8)outputPort, (uint8)classId };
+
+	return EllipseGetCommand<bool>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_OUTPUT_CLASS_ENABLE), outputBuffer, sizeof(outputBuffer), sbgEComCmdOutputClassParseEnable);
+}
+
+EllipseCommand Ellipse::outputClassSetEnable(SbgEComOutputPort outputPort, SbgEComClass classId, bool enable)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[3*sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdOutputClassWriteEnable(&outputStream, outputPort, classId, enable);
+
+	return setCommand(SBG_ECOM_CMD_OUTPUT_CLASS_ENABLE, &outputStream);
+}
+
+EllipseGetCommand<EllipseCanOutputConf> Ellipse::canOutputGetConf(SbgECanMessageId internalId)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[sizeof(uint16)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgStreamBufferWriteUint16LE(&outputStream, (uint16)internalId);
+
+	return EllipseGetCommand<EllipseCanOutputConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_CAN_OUTPUT_CONF), outputBuffer, sizeof(outputBuffer), decodeCanOutputConf);
+}
+
+EllipseCommand Ellipse::canOutputSetConf(SbgECanMessageId internalId, SbgEComOutputMode mode, uint32 userId, bool extended)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[2*sizeof(uint16) + sizeof(uint32) + sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdCanOutputWriteConf(&outputStream, internalId, mode, userId, extended);
+
+	return setCommand(SBG_ECOM_CMD_CAN_OUTPUT_CONF, &outputStream);
+}
+
+EllipseGetCommand<SbgEComLegacyConf> Ellipse::outputGetLegacyConf(SbgEComOutputPort outputPort)
+{
+	uint8			outputBuffer[1] = { (uint8)outputPort };
+
+	return EllipseGetCommand<SbgEComLegacyConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_LEGACY_CONT_OUTPUT_CONF), outputBuffer, sizeof(outputBuffer), sbgEComCmdOutputParseLegacyConf);
+}
+
+EllipseCommand Ellipse::outputSetLegacyConf(SbgEComOutputPort outputPort, const SbgEComLegacyConf &conf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[3*sizeof(uint8) + sizeof(uint32) + sizeof(uint16)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdOutputWriteLegacyConf(&outputStream, outputPort, &conf);
+
+	return setCommand(SBG_ECOM_CMD_LEGACY_CONT_OUTPUT_CONF, &outputStream);
+}
+
+EllipseGetCommand<EllipseNmeaTalkerId> Ellipse::outputGetNmeaTalkerId(SbgEComOutputPort outputPort)
+{
+	uint8			outputBuffer[1] = { (uint8)outputPort };
+
+	return EllipseGetCommand<EllipseNmeaTalkerId>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_NMEA_TALKER_ID), outputBuffer, sizeof(outputBuffer), decodeNmeaTalkerId);
+}
+
+EllipseCommand Ellipse::outputSetNmeaTalkerId(SbgEComOutputPort outputPort, const char nmeaTalkerId[2])
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[3*sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdOutputWriteNmeaTalkerId(&outputStream, outputPort, nmeaTalkerId);
+
+	return setCommand(SBG_ECOM_CMD_NMEA_TALKER_ID, &outputStream);
+}
+
+//----------------------------------------------------------------------//
+//- Sensor commands                                                    -//
+//----------------------------------------------------------------------//
+
+EllipseCommand Ellipse::sensorSetMotionProfileId(uint32 id)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[sizeof(uint32)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdGenericWriteModelId(&outputStream, id);
+
+	return setCommand(SBG_ECOM_CMD_MOTION_PROFILE_ID, &outputStream);
+}
+
+EllipseGetCommand<SbgEComModelInfo> Ellipse::sensorGetMotionProfileInfo()
+{
+	return EllipseGetCommand<SbgEComModelInfo>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_MOTION_PROFILE_ID), NULL, 0, sbgEComCmdGenericParseModelInfo);
+}
+
+EllipseGetCommand<SbgEComInitConditionConf> Ellipse::sensorGetInitCondition()
+{
+	return EllipseGetCommand<SbgEComInitConditionConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INIT_PARAMETERS), NULL, 0, sbgEComCmdSensorParseInitCondition);
+}
+
+EllipseCommand Ellipse::sensorSetInitCondition(const SbgEComInitConditionConf &conf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[3*sizeof(double) + sizeof(uint16) + 2*sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdSensorWriteInitCondition(&outputStream, &conf);
+
+	return setCommand(SBG_ECOM_CMD_INIT_PARAMETERS, &outputStream);
+}
+
+EllipseGetCommand<SbgEComAidingAssignConf> Ellipse::sensorGetAidingAssignment()
+{
+	return EllipseGetCommand<SbgEComAidingAssignConf>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_AIDING_ASSIGNMENT), NULL, 0, sbgEComCmdSensorParseAidingAssignment);
+}
+
+EllipseCommand Ellipse::sensorSetAidingAssignment(const SbgEComAidingAssignConf &conf)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[11*sizeof(uint8)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdSensorWriteAidingAssignment(&outputStream, &conf);
+
+	return setCommand(SBG_ECOM_CMD_AIDING_ASSIGNMENT, &outputStream);
+}
+
+EllipseGetCommand<EllipseSensorAlignment> Ellipse::sensorGetAlignmentAndLeverArm()
+{
+	return EllipseGetCommand<EllipseSensorAlignment>(this, SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_IMU_ALIGNMENT_LEVER_ARM), NULL, 0, decodeSensorAlignment);
+}
+
+EllipseCommand Ellipse::sensorSetAlignmentAndLeverArm(const SbgEComSensorAlignmentInfo &alignConf, const float leverArm[3])
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[2*sizeof(uint8) + 6*sizeof(float)];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdSensorWriteAlignmentAndLeverArm(&outputStream, &alignConf, leverArm);
+
+	return setCommand(SBG_ECOM_CMD_IMU_ALIGNMENT_LEVER_ARM, &outputStream);
+}
+
+//----------------------------------------------------------------------//
+//- Settings commands                                                  -//
+//----------------------------------------------------------------------//
+
+EllipseCommand Ellipse::settingsAction(SbgEComSettingsAction action)
+{
+	SbgStreamBuffer	outputStream;
+	uint8			outputBuffer[1];
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+	sbgEComCmdSettingsWriteAction(&outputStream, action);
+
+	return setCommand(SBG_ECOM_CMD_SETTINGS_ACTION, &outputStream);
+}
+
+EllipseTask Ellipse::importSettings(const void *pBuffer, uint32 size)
+{
+	return transferSend(SBG_ECOM_CMD_IMPORT_SETTINGS, pBuffer, size);
+}
+
+EllipseTask Ellipse::exportSettings(void *pBuffer, uint32 *pSize, uint32 maxSize)
+{
+	return transferReceive(SBG_ECOM_CMD_EXPORT_SETTINGS, pBuffer, pSize, maxSize);
 }
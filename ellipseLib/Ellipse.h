@@ -1,11 +1,484 @@
-
+/*!
+ *	\file		Ellipse.h
+ *	\author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		C++20 front end of the sbgECom library based on coroutines.
+ *
+ *	Each device command returns an awaitable object so a whole configuration sequence
+ *	can be written sequentially in a coroutine:
+ *
+ *		EllipseTask configure(Ellipse &device)
+ *		{
+ *			SbgErrorCode errorCode;
+ *
+ *			errorCode = co_await device.outputSetConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER, SBG_ECOM_OUTPUT_MODE_DIV_8);
+ *			...
+ *			co_return errorCode;
+ *		}
+ *
+ *	Commands are sent using the sbgECom asynchronous command engine. Once the answer has been received,
+ *	the coroutine is resumed by the Ellipse event loop after sbgEComHandle has returned, so a coroutine never
+ *	runs from within the frames dispatch. The event loop keeps handling incoming frames while commands are
+ *	in progress so the binary logs are still dispatched and no thread is needed.
+ *
+ *	All coroutines have to be run from the thread that runs the event loop.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
 
 #pragma once
-class Ellipse
+
+#include <coroutine>
+#include <exception>
+#include <sbgEComLib.h>
+
+//----------------------------------------------------------------------//
+//- Global definitions                                                 -//
+//----------------------------------------------------------------------//
+#define ELLIPSE_WAIT_TIME_OUT					(10)						/*!< Time out in ms used by the event loop to wait for incoming data. */
+#define ELLIPSE_MAG_COMPUTE_CALIB_TIME_OUT		(5000)						/*!< Time out in ms to compute a magnetometers calibration. */
+#define ELLIPSE_TRANSFER_PACKET_SIZE			(SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE - sizeof(uint16) - sizeof(uint32))	/*!< Max data size sent or received in a single transfer frame. */
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Result of a get command: the command error code and the returned value if no error occurred.
+ */
+template <typename T>
+struct EllipseResult
 {
+	SbgErrorCode				 errorCode;					/*!< SBG_NO_ERROR if the value is valid. */
+	T							 value;						/*!< Value returned by the device. */
+};
+
+/*!
+ * Odometer lever arm returned by Ellipse::odoGetLeverArm.
+ */
+struct EllipseLeverArm
+{
+	float						 leverArm[3];				/*!< X, Y, Z lever arm in meters. */
+};
+
+/*!
+ * Sensor alignment and lever arm returned by Ellipse::sensorGetAlignmentAndLeverArm.
+ */
+struct EllipseSensorAlignment
+{
+	SbgEComSensorAlignmentInfo	 alignment;					/*!< Sensor alignment. */
+	float						 leverArm[3];				/*!< X, Y, Z primary lever arm in meters. */
+};
+
+/*!
+ * CAN output configuration returned by Ellipse::canOutputGetConf.
+ */
+struct EllipseCanOutputConf
+{
+	SbgEComOutputMode			 mode;						/*!< Output mode of the CAN message. */
+	uint32						 userId;					/*!< CAN identifier used for this message. */
+	bool						 extended;					/*!< TRUE if the identifier is an extended one. */
+};
+
+/*!
+ * NMEA talker id returned by Ellipse::outputGetNmeaTalkerId.
+ */
+struct EllipseNmeaTalkerId
+{
+	char						 talkerId[2];				/*!< The two NMEA talker id characters. */
+};
+
+//----------------------------------------------------------------------//
+//- Coroutines definitions                                             -//
+//----------------------------------------------------------------------//
+
+class Ellipse;
 
+/*!
+ * Coroutine returning a SbgErrorCode, used to write a sequence of commands.
+ * The coroutine only starts when it is awaited by another task or run by the Ellipse event loop.
+ */
+class EllipseTask
+{
+public:
+	class promise_type;
+
+	/*!
+	 * Resume the awaiting coroutine once this task is finished.
+	 */
+	struct FinalAwaiter
+	{
+		bool await_ready() const noexcept { return false; }
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+		void await_resume() const noexcept {}
+	};
+
+	class promise_type
+	{
+	public:
+		EllipseTask get_return_object() { return EllipseTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() const noexcept { return {}; }
+		FinalAwaiter final_suspend() const noexcept { return {}; }
+		void return_value(SbgErrorCode errorCode) noexcept { m_errorCode = errorCode; }
+		void unhandled_exception() const noexcept { std::terminate(); }
+
+		SbgErrorCode				 m_errorCode = SBG_NOT_READY;	/*!< Value returned by the coroutine. */
+		std::coroutine_handle<>		 m_continuation;				/*!< Coroutine awaiting this task, if any. */
+	};
+
+	EllipseTask(EllipseTask &&other) noexcept;
+	EllipseTask &operator=(EllipseTask &&other) noexcept;
+	EllipseTask(const EllipseTask &) = delete;
+	EllipseTask &operator=(const EllipseTask &) = delete;
+	~EllipseTask();
+
+	/*!
+	 *	Start the coroutine if it hasn't been started yet.
+	 *	It runs until its first command is sent and then it is resumed by the event loop.
+	 */
+	void start();
+
+	/*!
+	 *	Returns TRUE once the coroutine has returned.
+	 *	\return												TRUE if the task is finished.
+	 */
+	bool isDone() const;
+
+	/*!
+	 *	Returns the value returned by the coroutine.
+	 *	\return												The coroutine result or SBG_NOT_READY if it isn't finished.
+	 */
+	SbgErrorCode getResult() const;
+
+	bool await_ready() const noexcept { return isDone(); }
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept;
+	SbgErrorCode await_resume() const noexcept { return getResult(); }
+
+private:
+	explicit EllipseTask(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+	std::coroutine_handle<promise_type>	 m_handle;			/*!< The coroutine owned by this task. */
+};
+
+/*!
+ * Awaitable command sent using the sbgECom asynchronous command engine.
+ * Awaiting a set command returns the SbgErrorCode of the ACK.
+ * The command is sent when it is awaited and cancelled if the awaiting coroutine is destroyed before it completes.
+ */
+class EllipseCommand
+{
 public:
-	Ellipse Connect(const char* deviceName);
+	/*!
+	 *	Prepare a command, the payload is copied.
+	 *	\param[in]	pDevice									Connected device the command is sent to.
+	 *	\param[in]	cmd										Command id to send, built using SBG_ECOM_BUILD_ID.
+	 *	\param[in]	type									Define if the command is completed by an ACK or by an answer frame.
+	 *	\param[in]	pPayload								Command payload (can be NULL if payloadSize is 0).
+	 *	\param[in]	payloadSize								Payload size in bytes (up to SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE).
+	 *	\param[in]	timeOut									Time out in ms to receive the answer of each trial.
+	 */
+	EllipseCommand(Ellipse *pDevice, uint16 cmd, SbgEComAsyncCmdType type, const void *pPayload, uint32 payloadSize, uint32 timeOut = SBG_ECOM_ASYNC_CMD_TIME_OUT);
+	EllipseCommand(const EllipseCommand &) = delete;
+	EllipseCommand &operator=(const EllipseCommand &) = delete;
+	~EllipseCommand();
+
+	bool await_ready() const noexcept { return m_errorCode != SBG_NOT_READY; }
+	bool await_suspend(std::coroutine_handle<> caller) noexcept;
+	SbgErrorCode await_resume() const noexcept { return m_errorCode; }
+
+	/*!
+	 *	Returns the answer payload of a completed get command.
+	 *	\return												Pointer on the answer payload.
+	 */
+	const uint8 *getAnswer() const { return m_answer; }
+
+	/*!
+	 *	Returns the answer payload size of a completed get command.
+	 *	\return												Answer payload size in bytes.
+	 */
+	uint32 getAnswerSize() const { return m_answerSize; }
+
+private:
+	friend class Ellipse;
+
+	static void onCompleted(SbgEComHandle *pHandle, uint32 ticket, SbgErrorCode result, const void *pAnswer, uint32 answerSize, void *pUserArg);
 
+	Ellipse						*m_pDevice;					/*!< Device the command is sent to. */
+	uint16						 m_cmd;						/*!< Command id to send. */
+	SbgEComAsyncCmdType			 m_type;					/*!< Define how the command is completed. */
+	uint32						 m_timeOut;					/*!< Time out in ms of each trial. */
+	uint8						 m_payload[SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE];	/*!< Copy of the command payload. */
+	uint32						 m_payloadSize;				/*!< Command payload size in bytes. */
+	uint8						 m_answer[SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE];	/*!< Answer payload of a get command. */
+	uint32						 m_answerSize;				/*!< Answer payload size in bytes. */
+	uint32						 m_ticket;					/*!< Ticket of the command while it is in progress, 0 otherwise. */
+	SbgErrorCode				 m_errorCode;				/*!< Command result or SBG_NOT_READY while it is in progress. */
+	std::coroutine_handle<>		 m_caller;					/*!< Coroutine resumed once the command is completed. */
+	EllipseCommand				*m_pNextReady;				/*!< Next completed command waiting to resume its coroutine. */
+	bool						 m_bReady;					/*!< TRUE while the command is in the device list of completed commands. */
 };
 
+/*!
+ * Awaitable get command, awaiting it returns an EllipseResult with the parsed answer.
+ */
+template <typename T>
+class EllipseGetCommand : public EllipseCommand
+{
+public:
+	/*!
+	 *	Method used to parse the answer payload, the sbgECom command modules provide one for each command.
+	 *	\param[in]	pInputStream							Stream buffer initialized on the answer payload.
+	 *	\param[out]	pValue									Value to fill.
+	 *	\return												SBG_NO_ERROR if the payload has been parsed.
+	 */
+	typedef SbgErrorCode (*DecodeFunc)(SbgStreamBuffer *pInputStream, T *pValue);
+
+	/*!
+	 *	Prepare a get command, the payload is copied.
+	 *	\param[in]	pDevice									Connected device the command is sent to.
+	 *	\param[in]	cmd										Command id to send, built using SBG_ECOM_BUILD_ID.
+	 *	\param[in]	pPayload								Command payload (can be NULL if payloadSize is 0).
+	 *	\param[in]	payloadSize								Payload size in bytes.
+	 *	\param[in]	pDecodeFunc								Method used to parse the answer payload into a T.
+	 *	\param[in]	timeOut									Time out in ms to receive the answer of each trial.
+	 */
+	EllipseGetCommand(Ellipse *pDevice, uint16 cmd, const void *pPayload, uint32 payloadSize, DecodeFunc pDecodeFunc, uint32 timeOut = SBG_ECOM_ASYNC_CMD_TIME_OUT) :
+		EllipseCommand(pDevice, cmd, SBG_ECOM_ASYNC_CMD_WAIT_ANSWER, pPayload, payloadSize, timeOut), m_pDecodeFunc(pDecodeFunc)
+	{
+	}
+
+	EllipseResult<T> await_resume() noexcept
+	{
+		EllipseResult<T>	result = {};
+		SbgStreamBuffer		inputStream;
+
+		result.errorCode = EllipseCommand::await_resume();
+
+		if (result.errorCode == SBG_NO_ERROR)
+		{
+			//
+			// Parse the answer, a too short answer is reported by the stream buffer
+			//
+			sbgStreamBufferInitForRead(&inputStream, getAnswer(), getAnswerSize());
+			result.errorCode = m_pDecodeFunc(&inputStream, &result.value);
+		}
+
+		return result;
+	}
+
+private:
+	DecodeFunc					 m_pDecodeFunc;				/*!< Method used to parse the answer payload. */
+};
+
+//----------------------------------------------------------------------//
+//- Ellipse device                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Ellipse device with its event loop.
+ * This class embeds the sbgECom handle and is quite large so it should not be allocated on the stack.
+ * All tasks using the device should be finished or destroyed before the device is closed.
+ */
+class Ellipse
+{
+public:
+	Ellipse();
+	~Ellipse();
+
+	/*!
+	 *	Open a serial port and initialize the sbgECom library on it.
+	 *	\param[in]	deviceName								Serial port name such as "COM8" or "/dev/ttyUSB0".
+	 *	\param[in]	baudRate								Serial port baud rate.
+	 *	\return												SBG_NO_ERROR if the device is connected.
+	 */
+	SbgErrorCode connect(const char *deviceName, uint32 baudRate);
+
+	/*!
+	 *	Initialize the sbgECom library on an interface already opened by the user (UDP, file...).
+	 *	The interface stays owned by the user and isn't closed by close().
+	 *	\param[in]	pInterface								A valid opened interface.
+	 *	\return												SBG_NO_ERROR if the device is connected.
+	 */
+	SbgErrorCode connect(SbgInterface *pInterface);
+
+	/*!
+	 *	Close the sbgECom library and the serial port opened by connect.
+	 */
+	void close();
+
+	/*!
+	 *	Define the callback called for each received binary log.
+	 *	\param[in]	pReceiveCallback						Method called for each received binary log.
+	 *	\param[in]	pUserArg								User argument passed to the callback.
+	 */
+	void setReceiveCallback(SbgEComReceiveFunc pReceiveCallback, void *pUserArg);
+
+	/*!
+	 *	Returns the underlying sbgECom handle.
+	 *	\return												The sbgECom handle.
+	 */
+	SbgEComHandle *getHandle() { return &m_comHandle; }
+
+	/*!
+	 *	Run one event loop iteration: handle all received frames, which dispatches the binary logs, then resume the
+	 *	coroutines whose command has been completed and wait for new data if nothing has been received.
+	 *	\param[in]	timeOut									Time in ms to wait for new data if nothing has been received.
+	 *	\return												SBG_NO_ERROR if frames may still have to be handled or SBG_NOT_READY if all frames have been handled.
+	 */
+	SbgErrorCode poll(uint32 timeOut = ELLIPSE_WAIT_TIME_OUT);
+
+	/*!
+	 *	Start a task and run the event loop until it is finished.
+	 *	\param[in]	task									Task to run.
+	 *	\return												The value returned by the task.
+	 */
+	SbgErrorCode run(EllipseTask &task);
+
+	/*!
+	 *	Start a task and run the event loop until it is finished.
+	 *	\param[in]	task									Task to run.
+	 *	\return												The value returned by the task.
+	 */
+	SbgErrorCode run(EllipseTask &&task) { return run(task); }
+
+	//
+	// Advanced commands
+	//
+	EllipseGetCommand<SbgEComAdvancedConf> advancedGetConf();
+	EllipseCommand advancedSetConf(const SbgEComAdvancedConf &conf);
+
+	//
+	// Event commands
+	//
+	EllipseGetCommand<SbgEComSyncInConf> syncInGetConf(SbgEComSyncInId syncInId);
+	EllipseCommand syncInSetConf(SbgEComSyncInId syncInId, const SbgEComSyncInConf &conf);
+	EllipseGetCommand<SbgEComSyncOutConf> syncOutGetConf(SbgEComSyncOutId syncOutId);
+	EllipseCommand syncOutSetConf(SbgEComSyncOutId syncOutId, const SbgEComSyncOutConf &conf);
+	EllipseGetCommand<float> virtualOdometerGetConf();
+	EllipseCommand virtualOdometerSetConf(float distance);
+
+	//
+	// Features and information commands
+	//
+	EllipseGetCommand<SbgEComFeatures> getFeatures();
+	EllipseGetCommand<SbgEComDeviceInfo> getInfo();
+
+	//
+	// GNSS commands
+	//
+	EllipseCommand gnss1SetModelId(uint32 id);
+	EllipseGetCommand<SbgEComModelInfo> gnss1GetModelInfo();
+	EllipseGetCommand<SbgEComGnssAlignmentInfo> gnss1GetLeverArmAlignment();
+	EllipseCommand gnss1SetLeverArmAlignment(const SbgEComGnssAlignmentInfo &alignConf);
+	EllipseGetCommand<SbgEComGnssRejectionConf> gnss1GetRejection();
+	EllipseCommand gnss1SetRejection(const SbgEComGnssRejectionConf &rejectConf);
+
+	//
+	// Interface commands
+	//
+	EllipseGetCommand<SbgEComInterfaceConf> interfaceGetUartConf(SbgEComPortId interfaceId);
+	EllipseCommand interfaceSetUartConf(SbgEComPortId interfaceId, const SbgEComInterfaceConf &conf);
+	EllipseGetCommand<SbgEComCanBitRate> interfaceGetCanConf();
+	EllipseCommand interfaceSetCanConf(SbgEComCanBitRate bitrate);
+
+	//
+	// License commands, the buffer has to stay valid until the task is finished
+	//
+	EllipseTask licenseApply(const void *pBuffer, uint32 size);
+
+	//
+	// Magnetometer commands
+	//
+	EllipseCommand magSetModelId(uint32 id);
+	EllipseGetCommand<SbgEComModelInfo> magGetModelInfo();
+	EllipseGetCommand<SbgEComMagRejectionConf> magGetRejection();
+	EllipseCommand magSetRejection(const SbgEComMagRejectionConf &rejectConf);
+	EllipseCommand magSetCalibData(const float offset[3], const float matrix[9]);
+	EllipseCommand magStartCalib(SbgEComMagCalibMode mode, SbgEComMagCalibBandwidth bandwidth);
+	EllipseGetCommand<SbgEComMagCalibResults> magComputeCalib();
+
+	//
+	// Odometer commands
+	//
+	EllipseGetCommand<SbgEComOdoConf> odoGetConf();
+	EllipseCommand odoSetConf(const SbgEComOdoConf &odometerConf);
+	EllipseGetCommand<EllipseLeverArm> odoGetLeverArm();
+	EllipseCommand odoSetLeverArm(const float leverArm[3]);
+	EllipseGetCommand<SbgEComOdoRejectionConf> odoGetRejection();
+	EllipseCommand odoSetRejection(const SbgEComOdoRejectionConf &rejectConf);
+
+	//
+	// Output commands
+	//
+	EllipseGetCommand<SbgEComOutputMode> outputGetConf(SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId);
+	EllipseCommand outputSetConf(SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId, SbgEComOutputMode mode);
+	EllipseGetCommand<bool> outputClassGetEnable(SbgEComOutputPort outputPort, SbgEComClass classId);
+	EllipseCommand outputClassSetEnable(SbgEComOutputPort outputPort, SbgEComClass classId, bool enable);
+	EllipseGetCommand<EllipseCanOutputConf> canOutputGetConf(SbgECanMessageId internalId);
+	EllipseCommand canOutputSetConf(SbgECanMessageId internalId, SbgEComOutputMode mode, uint32 userId, bool extended);
+	EllipseGetCommand<SbgEComLegacyConf> outputGetLegacyConf(SbgEComOutputPort outputPort);
+	EllipseCommand outputSetLegacyConf(SbgEComOutputPort outputPort, const SbgEComLegacyConf &conf);
+	EllipseGetCommand<EllipseNmeaTalkerId> outputGetNmeaTalkerId(SbgEComOutputPort outputPort);
+	EllipseCommand outputSetNmeaTalkerId(SbgEComOutputPort outputPort, const char nmeaTalkerId[2]);
+
+	//
+	// Sensor commands
+	//
+	EllipseCommand sensorSetMotionProfileId(uint32 id);
+	EllipseGetCommand<SbgEComModelInfo> sensorGetMotionProfileInfo();
+	EllipseGetCommand<SbgEComInitConditionConf> sensorGetInitCondition();
+	EllipseCommand sensorSetInitCondition(const SbgEComInitConditionConf &conf);
+	EllipseGetCommand<SbgEComAidingAssignConf> sensorGetAidingAssignment();
+	EllipseCommand sensorSetAidingAssignment(const SbgEComAidingAssignConf &conf);
+	EllipseGetCommand<EllipseSensorAlignment> sensorGetAlignmentAndLeverArm();
+	EllipseCommand sensorSetAlignmentAndLeverArm(const SbgEComSensorAlignmentInfo &alignConf, const float leverArm[3]);
+
+	//
+	// Settings commands, the buffers have to stay valid until the tasks are finished
+	//
+	EllipseCommand settingsAction(SbgEComSettingsAction action);
+	EllipseTask importSettings(const void *pBuffer, uint32 size);
+	EllipseTask exportSettings(void *pBuffer, uint32 *pSize, uint32 maxSize);
+
+private:
+	friend class EllipseCommand;
+
+	/*!
+	 *	Append a completed command to the list of coroutines resumed by the event loop.
+	 *	\param[in]	pCommand								Completed command whose coroutine is suspended.
+	 */
+	void addReadyCommand(EllipseCommand *pCommand);
+
+	/*!
+	 *	Remove a command from the list of completed commands if it is still in it.
+	 *	\param[in]	pCommand								Command being destroyed.
+	 */
+	void removeReadyCommand(EllipseCommand *pCommand);
+
+	/*!
+	 *	Resume the coroutines of all completed commands, including the ones completed while resuming them.
+	 */
+	void resumeReadyCommands();
+
+	EllipseCommand setCommand(SbgEComCmd cmdId, SbgStreamBuffer *pOutputStream);
+	EllipseTask transferSend(SbgEComCmd cmdId, const void *pBuffer, uint32 size);
+	EllipseTask transferReceive(SbgEComCmd cmdId, void *pBuffer, uint32 *pSize, uint32 maxSize);
+
+	SbgInterface				 m_interface;				/*!< Serial interface opened by connect. */
+	SbgEComHandle				 m_comHandle;				/*!< sbgECom library handle. */
+	bool						 m_bOwnInterface;			/*!< TRUE if the interface has been opened by connect. */
+	bool						 m_bConnected;				/*!< TRUE if the sbgECom library is initialized. */
+	EllipseCommand				*m_pFirstReady;				/*!< First completed command waiting to resume its coroutine. */
+	EllipseCommand				*m_pLastReady;				/*!< Last completed command waiting to resume its coroutine. */
+};
@@ -0,0 +1,15 @@
+#!/bin/sh
+# This script is used to build the Ellipse C++20 library on unix systems.
+# The sbgECom library should have been built first using sbgECom/projects/unix/build.sh.
+
+# Define the G++ options, coroutines require C++20
+gppOptions="-std=c++20 -I ../sbgECom/common/ -I ../sbgECom/src/ -c -Wall "
+
+# Create the intermediate directory
+mkdir -p obj
+
+# Create all objects for the Ellipse library
+g++ $gppOptions Ellipse.cpp -o obj/Ellipse.o || exit 1
+
+# Create the library
+ar cr libEllipse.a obj/Ellipse.o
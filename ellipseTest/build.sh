@@ -0,0 +1,20 @@
+#!/bin/sh
+# This script is used to build and run the Ellipse tests on unix systems.
+# The sbgECom library and then the Ellipse library should have been built first using
+# sbgECom/projects/unix/build.sh and ellipseLib/build.sh.
+# Example: ./build.sh
+
+# Define the compiler options, the tests use the sbgECom simulated device
+gccOptions="-I ../sbgECom/common/ -I ../sbgECom/src/ -I ../sbgECom/tests/ -Wall"
+gppOptions="-std=c++20 -I ../ellipseLib/ $gccOptions"
+libs="-L../ellipseLib/ -lEllipse -L../sbgECom/ -lSbgECom -lpthread -lm"
+
+# Create the intermediate directory
+mkdir -p obj
+
+# Build the tests
+gcc $gccOptions -c ../sbgECom/tests/sbgEComTestDevice.c -o obj/sbgEComTestDevice.o || exit 1
+g++ $gppOptions ellipseTest.cpp Main.cpp obj/sbgEComTestDevice.o $libs -o ellipseTest || exit 1
+
+# Run the tests, the script fails if one test fails
+./ellipseTest || exit 1
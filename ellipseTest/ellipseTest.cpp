@@ -1,27 +1,349 @@
-// ellipseTest.cpp : This file contains the 'main' function. Program execution begins and ends there.
-//
+/*!
+ *	\file		ellipseTest.cpp
+ *	\author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Tests of the Ellipse coroutines front end against a simulated device.
+ *
+ *	Each test runs a coroutine on the Ellipse event loop while the simulated device
+ *	answers, or ignores, the commands written by the host.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
 
-#include <iostream>
+#include "Main.h"
+#include <Ellipse.h>
+#include <sbgEComTestDevice.h>
+#include <stdio.h>
+#include <stdlib.h>
 
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_SERIAL_NUMBER			(45000123)							/*!< Serial number returned by the simulated device. */
+#define TEST_NUM_IMU_LOGS			(4)									/*!< Number of IMU logs sent along with each answer. */
 
+/*!
+ * Behavior of the simulated device and what it has received.
+ */
+struct TestDeviceState
+{
+	bool			answer;												/*!< FALSE if the device never answers. */
+	uint16			lastCmd;											/*!< Last received command id. */
+	uint8			lastPayload[16];									/*!< Last received payload. */
+	uint32			lastPayloadSize;									/*!< Last received payload size. */
+	uint32			numImuLogs;											/*!< Number of IMU logs dispatched to the host. */
+};
 
-int main()
+/*!
+ * Values checked by a test coroutine once it has been resumed.
+ */
+struct TestResult
+{
+	SbgErrorCode	errorCode;											/*!< Result of the awaited command. */
+	uint32			serialNumber;										/*!< Serial number returned by a get command. */
+	bool			outsideDispatch;									/*!< TRUE if the coroutine has been resumed after the frames dispatch. */
+};
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static SbgEComTestDevice	gDevice;
+static TestDeviceState		gDeviceState;
+static Ellipse				gEllipse;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Simulated device command callback, it answers get and set commands followed by a few IMU logs.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	cmd										Received command id.
+ *	\param[in]	pPayload								Received payload.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\param[in]	pUserArg								Unused.
+ */
+static void testOnDeviceCmd(SbgEComTestDevice *pDevice, uint16 cmd, const uint8 *pPayload, uint32 payloadSize, void *pUserArg)
+{
+	SbgStreamBuffer		outputStream;
+	uint8				outputBuffer[64];
+	uint32				i;
+
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	gDeviceState.lastCmd = cmd;
+	gDeviceState.lastPayloadSize = payloadSize;
+
+	if (payloadSize <= sizeof(gDeviceState.lastPayload))
+	{
+		memcpy(gDeviceState.lastPayload, pPayload, payloadSize);
+	}
+
+	if (!gDeviceState.answer)
+	{
+		return;
+	}
+
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+
+	if (cmd == SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO))
+	{
+		//
+		// Answer the device information
+		//
+		sbgStreamBufferWriteBuffer(&outputStream, "ELLIPSE2-N-G4A2-B1", 18);
+
+		for (i = 18; i < SBG_ECOM_INFO_PRODUCT_CODE_LENGTH; i++)
+		{
+			sbgStreamBufferWriteUint8LE(&outputStream, 0);
+		}
+
+		sbgStreamBufferWriteUint32LE(&outputStream, TEST_SERIAL_NUMBER);
+		sbgStreamBufferWriteUint32LE(&outputStream, 1);
+		sbgStreamBufferWriteUint16LE(&outputStream, 2026);
+		sbgStreamBufferWriteUint8LE(&outputStream, 10);
+		sbgStreamBufferWriteUint8LE(&outputStream, 18);
+		sbgStreamBufferWriteUint32LE(&outputStream, 0x01000000);
+		sbgStreamBufferWriteUint32LE(&outputStream, 0x02000000);
+	}
+	else
+	{
+		//
+		// Acknowledge any other command
+		//
+		sbgStreamBufferWriteUint16LE(&outputStream, cmd);
+		sbgStreamBufferWriteUint16LE(&outputStream, SBG_NO_ERROR);
+
+		cmd = SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK);
+	}
+
+	sbgEComTestDeviceSendFrame(pDevice, cmd, outputBuffer, (uint32)sbgStreamBufferGetLength(&outputStream));
+
+	//
+	// The binary logs sent after the answer are dispatched in the same sbgEComHandle call
+	//
+	for (i = 0; i < TEST_NUM_IMU_LOGS; i++)
+	{
+		sbgEComTestDeviceSendImu(pDevice, i);
+	}
+}
+
+/*!
+ *	Binary logs callback that counts the received IMU logs.
+ *	\param[in]	pHandle									The sbgECom handle.
+ *	\param[in]	logCmd									Received log id.
+ *	\param[in]	pLogData								Parsed log.
+ *	\param[in]	pUserArg								Unused.
+ *	\return												SBG_NO_ERROR.
+ */
+static SbgErrorCode testOnLogReceived(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg)
+{
+	SBG_UNUSED_PARAMETER(pHandle);
+	SBG_UNUSED_PARAMETER(pLogData);
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	if (logCmd == SBG_ECOM_LOG_IMU_DATA)
+	{
+		gDeviceState.numImuLogs++;
+	}
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Connect the Ellipse to a new simulated device.
+ *	\param[in]	answer									FALSE if the device never answers.
+ *	\return												TRUE if the Ellipse is connected.
+ */
+static bool testSetUp(bool answer)
+{
+	memset(&gDeviceState, 0x00, sizeof(gDeviceState));
+	gDeviceState.answer = answer;
+
+	sbgEComTestDeviceInit(&gDevice, SBG_ECOM_MAX_BUFFER_SIZE);
+	sbgEComTestDeviceSetCmdCallback(&gDevice, testOnDeviceCmd, NULL);
+
+	if (gEllipse.connect(&gDevice.interface) == SBG_NO_ERROR)
+	{
+		gEllipse.setReceiveCallback(testOnLogReceived, NULL);
+
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/*!
+ *	Check that a coroutine doesn't run from within the frames dispatch: the interface can only be read outside of it.
+ *	\return												TRUE if sbgEComHandle has read the interface.
+ */
+static bool testIsOutsideDispatch()
+{
+	uint32	numReads;
+
+	numReads = gDevice.numReads;
+	sbgEComHandle(gEllipse.getHandle());
+
+	return (gDevice.numReads > numReads);
+}
+
+/*!
+ *	Print a test result.
+ *	\param[in]	pName									Test name.
+ *	\param[in]	passed									TRUE if the test has passed.
+ *	\return												passed.
+ */
+static bool testReport(const char *pName, bool passed)
 {
-    
+	printf("%-40s %s\n", pName, passed ? "passed" : "FAILED");
 
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Coroutines                                                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Await a get command.
+ *	\param[in]	device									Connected device.
+ *	\param[out]	pResult									Values checked by the test.
+ *	\return												The command result.
+ */
+static EllipseTask testGetTask(Ellipse &device, TestResult *pResult)
+{
+	EllipseResult<SbgEComDeviceInfo>	info;
+
+	info = co_await device.getInfo();
+
+	pResult->outsideDispatch = testIsOutsideDispatch();
+	pResult->errorCode = info.errorCode;
+	pResult->serialNumber = info.value.serialNumber;
+
+	co_return info.errorCode;
+}
+
+/*!
+ *	Await a set command.
+ *	\param[in]	device									Connected device.
+ *	\param[out]	pResult									Values checked by the test.
+ *	\return												The command result.
+ */
+static EllipseTask testSetTask(Ellipse &device, TestResult *pResult)
+{
+	SbgErrorCode	errorCode;
+
+	errorCode = co_await device.outputSetConf(SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_LOG_EKF_EULER, SBG_ECOM_OUTPUT_MODE_DIV_8);
+
+	pResult->outsideDispatch = testIsOutsideDispatch();
+	pResult->errorCode = errorCode;
+
+	co_return errorCode;
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	A get command returns the parsed answer and the logs received with it are still dispatched.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testGetCommand()
+{
+	TestResult	result = {};
+	bool		passed;
+
+	passed = testSetUp(TRUE);
+
+	if (passed)
+	{
+		passed &= (gEllipse.run(testGetTask(gEllipse, &result)) == SBG_NO_ERROR);
+		passed &= (result.errorCode == SBG_NO_ERROR) && (result.serialNumber == TEST_SERIAL_NUMBER);
+		passed &= (gDeviceState.lastCmd == SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO)) && (gDeviceState.lastPayloadSize == 0);
+		passed &= result.outsideDispatch;
+		passed &= (gDeviceState.numImuLogs == TEST_NUM_IMU_LOGS);
 
-    std::cout << "Hello World!\n";
-    
+		gEllipse.close();
+	}
 
+	return testReport("get command", passed);
 }
 
-// Run program: Ctrl + F5 or Debug > Start Without Debugging menu
-// Debug program: F5 or Debug > Start Debugging menu
+/*!
+ *	A set command sends its payload and returns the ACK error code.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testSetCommand()
+{
+	static const uint8	expectedPayload[] = { SBG_ECOM_OUTPUT_PORT_A, SBG_ECOM_LOG_EKF_EULER, SBG_ECOM_CLASS_LOG_ECOM_0, SBG_ECOM_OUTPUT_MODE_DIV_8, 0x00 };
+	TestResult			result = {};
+	bool				passed;
+
+	passed = testSetUp(TRUE);
+
+	if (passed)
+	{
+		passed &= (gEllipse.run(testSetTask(gEllipse, &result)) == SBG_NO_ERROR);
+		passed &= (result.errorCode == SBG_NO_ERROR);
+		passed &= (gDeviceState.lastCmd == SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_OUTPUT_CONF));
+		passed &= (gDeviceState.lastPayloadSize == sizeof(expectedPayload)) && (memcmp(gDeviceState.lastPayload, expectedPayload, sizeof(expectedPayload)) == 0);
+		passed &= result.outsideDispatch;
+		passed &= (gDeviceState.numImuLogs == TEST_NUM_IMU_LOGS);
+
+		gEllipse.close();
+	}
+
+	return testReport("set command", passed);
+}
+
+/*!
+ *	A command that is never answered is sent SBG_ECOM_ASYNC_CMD_NUM_TRIALS times and then resumes its coroutine with SBG_TIME_OUT.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCommandTimeOut()
+{
+	TestResult	result = {};
+	bool		passed;
+
+	passed = testSetUp(FALSE);
+
+	if (passed)
+	{
+		passed &= (gEllipse.run(testSetTask(gEllipse, &result)) == SBG_TIME_OUT);
+		passed &= (result.errorCode == SBG_TIME_OUT);
+		passed &= (gDevice.numFramesWritten == SBG_ECOM_ASYNC_CMD_NUM_TRIALS);
+		passed &= result.outsideDispatch;
 
-// Tips for Getting Started: 
-//   1. Use the Solution Explorer window to add/manage files
-//   2. Use the Team Explorer window to connect to source control
-//   3. Use the Output window to see build output and other messages
-//   4. Use the Error List window to view errors
-//   5. Go to Project > Add New Item to create new code files, or Project > Add Existing Item to add existing code files to the project
-//   6. In the future, to open this project again, go to File > Open > Project and select the .sln file
+		gEllipse.close();
+	}
+
+	return testReport("command time out", passed);
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main()
+{
+	bool	passed = TRUE;
+
+	passed &= testGetCommand();
+	passed &= testSetCommand();
+	passed &= testCommandTimeOut();
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,23 @@
+#!/bin/sh
+# This script is used to build and run the sbgECom benchmarks on unix systems.
+# The sbgECom library should have been built first using projects/unix/build.sh.
+# Results are only representative if the library has been built with optimizations (-O2).
+# Example: ./build.sh
+
+# Define the GCC options
+gccOptions="-O2 -I ../common/ -I ../src/ -Wall"
+gccLibs="-L../ -lSbgECom -lpthread -lm"
+
+# Build all the benchmarks
+gcc $gccOptions sbgEComBenchRxCopies.c sbgEComBenchStream.c $gccLibs -o sbgEComBenchRxCopies || exit 1
+gcc $gccOptions sbgEComBenchSync.c sbgEComBenchStream.c $gccLibs -o sbgEComBenchSync || exit 1
+gcc $gccOptions sbgEComBenchCrc.c sbgEComBenchStream.c $gccLibs -o sbgEComBenchCrc || exit 1
+gcc $gccOptions sbgEComBenchResync.c sbgEComBenchStream.c $gccLibs -o sbgEComBenchResync || exit 1
+gcc $gccOptions sbgEComBenchLogs.c sbgEComBenchStream.c $gccLibs -o sbgEComBenchLogs || exit 1
+
+# Run all the benchmarks
+./sbgEComBenchRxCopies || exit 1
+./sbgEComBenchSync || exit 1
+./sbgEComBenchCrc || exit 1
+./sbgEComBenchResync || exit 1
+./sbgEComBenchLogs || exit 1
\ No newline at end of file
@@ -0,0 +1,139 @@
+/*!
+ *	\file		sbgEComBenchCrc.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Throughput of each CRC-16 and CRC-32 kernel.
+ *
+ *	Sizes are picked around the sbgECom frames: small logs, medium logs and a full
+ *	reception buffer. Kernels that the processor doesn't support are skipped.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <crc/sbgCrc.h>
+#include "sbgEComBenchStream.h"
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define BENCH_NUM_BYTES				(128*1024*1024)							/*!< Number of bytes processed for each kernel and size. */
+
+static const char	*gKernelNames[] = { "auto", "byte", "slicing4", "slicing8", "pclmul" };
+static const uint32	 gCrc16Sizes[] = { 66, 130, 512, 4090 };
+static const uint32	 gCrc32Sizes[] = { 64, 512, 4088 };
+
+//----------------------------------------------------------------------//
+//- Benchmark                                                          -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Measure a kernel on buffers of a given size.
+ *	\param[in]	pBuffer									Data buffer.
+ *	\param[in]	size									Size in bytes of each CRC computation.
+ *	\param[in]	crc32									TRUE to measure the CRC-32 or FALSE for the CRC-16.
+ *	\return												Throughput in GB/s.
+ */
+static double benchCrc(const uint8 *pBuffer, uint32 size, bool crc32)
+{
+	volatile uint32	result = 0;
+	uint64			startTime;
+	uint32			i;
+
+	startTime = sbgGetMonotonicNs();
+
+	for (i = 0; i < BENCH_NUM_BYTES / size; i++)
+	{
+		if (crc32)
+		{
+			result += sbgCrc32Compute(pBuffer, size);
+		}
+		else
+		{
+			result += sbgCrc16Compute(pBuffer, size);
+		}
+	}
+
+	return (double)(BENCH_NUM_BYTES / size * size) / (sbgGetMonotonicNs() - startTime);
+}
+
+/*!
+ *	Print the throughput table of one CRC.
+ *	\param[in]	pBuffer									Data buffer.
+ *	\param[in]	pSizes									Measured sizes.
+ *	\param[in]	numSizes								Number of measured sizes.
+ *	\param[in]	crc32									TRUE to measure the CRC-32 or FALSE for the CRC-16.
+ */
+static void benchCrcTable(const uint8 *pBuffer, const uint32 *pSizes, uint32 numSizes, bool crc32)
+{
+	SbgCrcKernel	kernel;
+	uint32			i;
+
+	printf("%-10s", crc32 ? "CRC-32" : "CRC-16");
+
+	for (kernel = SBG_CRC_KERNEL_BYTE; kernel <= SBG_CRC_KERNEL_PCLMUL; kernel++)
+	{
+		printf("%10s", gKernelNames[kernel]);
+	}
+
+	printf("\n");
+
+	for (i = 0; i < numSizes; i++)
+	{
+		printf("%6u B   ", pSizes[i]);
+
+		for (kernel = SBG_CRC_KERNEL_BYTE; kernel <= SBG_CRC_KERNEL_PCLMUL; kernel++)
+		{
+			if (sbgCrcSetKernel(kernel) == SBG_NO_ERROR)
+			{
+				printf("%10.2f", benchCrc(pBuffer, pSizes[i], crc32));
+			}
+			else
+			{
+				printf("%10s", "-");
+			}
+		}
+
+		printf("\n");
+	}
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	static uint8	buffer[SBG_ECOM_MAX_BUFFER_SIZE];
+	uint32			state = 1;
+	uint32			i;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	for (i = 0; i < sizeof(buffer); i++)
+	{
+		buffer[i] = (uint8)sbgEComBenchRandom(&state);
+	}
+
+	printf("Throughput in GB/s:\n");
+
+	benchCrcTable(buffer, gCrc16Sizes, sizeof(gCrc16Sizes)/sizeof(gCrc16Sizes[0]), FALSE);
+	printf("\n");
+	benchCrcTable(buffer, gCrc32Sizes, sizeof(gCrc32Sizes)/sizeof(gCrc32Sizes[0]), TRUE);
+
+	sbgCrcSetKernel(SBG_CRC_KERNEL_AUTO);
+
+	return EXIT_SUCCESS;
+}
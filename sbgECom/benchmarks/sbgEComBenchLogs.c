@@ -0,0 +1,112 @@
+/*!
+ *	\file		sbgEComBenchLogs.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Time spent by sbgEComBinaryLogParse to decode each log type.
+ *
+ *	Each log is parsed from a set of random payloads of its complete size, so
+ *	optional fields are read as well.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include "sbgEComBenchStream.h"
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define BENCH_NUM_PARSES			(10000000)								/*!< Number of parsed frames for each log type. */
+#define BENCH_NUM_PAYLOADS			(64)									/*!< Number of different random payloads of each log type. */
+#define BENCH_MAX_PAYLOAD_SIZE		(260)									/*!< Largest payload size of the measured logs. */
+
+/*!
+ * Log type measured by the benchmark.
+ */
+typedef struct _BenchLog
+{
+	const char					*pName;										/*!< Log name. */
+	uint16						 command;									/*!< Log id. */
+	uint32						 payloadSize;								/*!< Complete payload size in bytes. */
+} BenchLog;
+
+static const BenchLog gLogs[] =
+{
+	{ "IMU_DATA",		SBG_ECOM_LOG_IMU_DATA,			58	},
+	{ "EKF_EULER",		SBG_ECOM_LOG_EKF_EULER,			32	},
+	{ "EKF_QUAT",		SBG_ECOM_LOG_EKF_QUAT,			36	},
+	{ "EKF_NAV",		SBG_ECOM_LOG_EKF_NAV,			72	},
+	{ "GPS_VEL",		SBG_ECOM_LOG_GPS1_VEL,			44	},
+	{ "GPS_POS",		SBG_ECOM_LOG_GPS1_POS,			57	},
+	{ "GPS_HDT",		SBG_ECOM_LOG_GPS1_HDT,			26	},
+	{ "MAG",			SBG_ECOM_LOG_MAG,				30	},
+	{ "DVL",			SBG_ECOM_LOG_DVL_BOTTOM_TRACK,	30	},
+	{ "SHIP_MOTION",	SBG_ECOM_LOG_SHIP_MOTION_0,		46	},
+	{ "STATUS",			SBG_ECOM_LOG_STATUS,			22	},
+	{ "UTC_TIME",		SBG_ECOM_LOG_UTC_TIME,			21	},
+	{ "USBL",			SBG_ECOM_LOG_USBL,				38	},
+	{ "DEBUG_0",		SBG_ECOM_LOG_DEBUG_0,			260	}
+};
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	static uint8		payloads[BENCH_NUM_PAYLOADS][BENCH_MAX_PAYLOAD_SIZE];
+	SbgBinaryLogData	logData;
+	volatile uint32		numErrors = 0;
+	uint32				state = 1;
+	uint64				startTime;
+	uint32				log;
+	uint32				i;
+	uint32				j;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	for (i = 0; i < BENCH_NUM_PAYLOADS; i++)
+	{
+		for (j = 0; j < BENCH_MAX_PAYLOAD_SIZE; j++)
+		{
+			payloads[i][j] = (uint8)sbgEComBenchRandom(&state);
+		}
+	}
+
+	printf("Parse time in ns per frame:\n");
+
+	for (log = 0; log < sizeof(gLogs)/sizeof(gLogs[0]); log++)
+	{
+		startTime = sbgGetMonotonicNs();
+
+		for (i = 0; i < BENCH_NUM_PARSES; i++)
+		{
+			if (sbgEComBinaryLogParse(gLogs[log].command, payloads[i % BENCH_NUM_PAYLOADS], gLogs[log].payloadSize, &logData) != SBG_NO_ERROR)
+			{
+				numErrors++;
+			}
+		}
+
+		printf("%-16s %6.1f\n", gLogs[log].pName, (double)(sbgGetMonotonicNs() - startTime) / BENCH_NUM_PARSES);
+	}
+
+	if (numErrors > 0)
+	{
+		printf("%u frames couldn't be parsed\n", numErrors);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,244 @@
+/*!
+ *	\file		sbgEComBenchResync.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Worst case resynchronization cost on fuzzed input.
+ *
+ *	Each stream is made of adversarial noise with a valid frame every few KB. The noise
+ *	is built to produce as many false starts of frame as possible: SYNC_1 / SYNC_2
+ *	pairs followed by plausible lengths but no ETX char. Every stream is received for
+ *	several seeds and the worst time and CRC work per received byte are reported,
+ *	along with the number of valid frames lost.
+ *
+ *	A false start of frame whose ETX char matches by chance is dropped as a whole with
+ *	a CRC error, so valid frames it overlaps are lost as well.
+ *
+ *	The protocol source is built into this benchmark with a counting sbgCrc16Update.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include <crc/sbgCrc.h>
+#include "sbgEComBenchStream.h"
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define BENCH_STREAM_SIZE			(16*1024*1024)							/*!< Size in bytes of each received stream. */
+#define BENCH_MAX_READ_SIZE			(512)									/*!< Maximum number of bytes returned by each read. */
+#define BENCH_FRAME_PERIOD			(8*1024)								/*!< Number of noise bytes between two valid frames. */
+#define BENCH_NUM_SEEDS				(4)										/*!< Number of seeds each kind of noise is received with. */
+
+/*!
+ * Kinds of fuzzed noise.
+ */
+typedef enum _BenchNoise
+{
+	BENCH_NOISE_DENSE_MAX_LENGTH,											/*!< Dense SYNC_1 / SYNC_2 pairs with a 4080 bytes length and no ETX. */
+	BENCH_NOISE_RANDOM_LENGTH,												/*!< SYNC_1 / SYNC_2 pairs with random lengths separated by random junk. */
+	BENCH_NOISE_SYNC_BYTES,													/*!< Random mix of SYNC_1, SYNC_2 and other bytes. */
+	BENCH_NOISE_NUM															/*!< Number of noise kinds. */
+} BenchNoise;
+
+static const char *gNoiseNames[BENCH_NOISE_NUM] = { "dense FF 5A with 4080 len, no ETX", "FF 5A with random len + junk", "random 0xFF/0x5A noise" };
+
+//----------------------------------------------------------------------//
+//- Counted CRC                                                        -//
+//----------------------------------------------------------------------//
+
+static uint64	gNumCrcBytes;
+
+/*!
+ *	sbgCrc16Update used by the protocol source, counts the processed bytes.
+ *	\param[in]	pInstance								CRC instance.
+ *	\param[in]	pData									Data buffer.
+ *	\param[in]	dataSize								Data size in bytes.
+ */
+static void benchCountedCrc16Update(SbgCrc16 *pInstance, const void *pData, uint32 dataSize)
+{
+	gNumCrcBytes += dataSize;
+
+	sbgCrc16Update(pInstance, pData, dataSize);
+}
+
+//
+// The protocol source is built into this benchmark, sbgCrc.h has already been included so only its calls are redirected
+//
+#define sbgCrc16Update		benchCountedCrc16Update
+#include "../src/protocol/sbgEComProtocol.c"
+#undef sbgCrc16Update
+
+//----------------------------------------------------------------------//
+//- Benchmark                                                          -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Append a block of noise to the stream.
+ *	\param[in]	pStream									The stream.
+ *	\param[in]	noise									Kind of noise.
+ *	\param[in]	size									Approximate number of noise bytes.
+ *	\param[in]	pState									Random state, updated by the call.
+ */
+static void benchAddNoise(SbgEComBenchStream *pStream, BenchNoise noise, uint32 size, uint32 *pState)
+{
+	uint8		*pBuffer = pStream->pBuffer + pStream->writeIndex;
+	uint32		 length;
+	uint32		 i = 0;
+
+	while (i < size)
+	{
+		switch (noise)
+		{
+		case BENCH_NOISE_DENSE_MAX_LENGTH:
+		case BENCH_NOISE_RANDOM_LENGTH:
+			length = (noise == BENCH_NOISE_DENSE_MAX_LENGTH) ? 4080 : (sbgEComBenchRandom(pState) % (SBG_ECOM_MAX_PAYLOAD_SIZE + 1));
+
+			pBuffer[i++] = SBG_ECOM_SYNC_1;
+			pBuffer[i++] = SBG_ECOM_SYNC_2;
+			pBuffer[i++] = (uint8)sbgEComBenchRandom(pState);
+			pBuffer[i++] = (uint8)sbgEComBenchRandom(pState);
+			pBuffer[i++] = (uint8)length;
+			pBuffer[i++] = (uint8)(length >> 8);
+
+			//
+			// The dense noise starts a new false frame every few bytes, the other one adds junk of any size
+			//
+			length = (noise == BENCH_NOISE_DENSE_MAX_LENGTH) ? (sbgEComBenchRandom(pState) % 8) : (sbgEComBenchRandom(pState) % 256);
+
+			for (; (length > 0) && (i < size); length--)
+			{
+				pBuffer[i++] = (uint8)sbgEComBenchRandom(pState);
+			}
+			break;
+		default:
+			switch (sbgEComBenchRandom(pState) % 3)
+			{
+			case 0:
+				pBuffer[i++] = SBG_ECOM_SYNC_1;
+				break;
+			case 1:
+				pBuffer[i++] = SBG_ECOM_SYNC_2;
+				break;
+			default:
+				pBuffer[i++] = (uint8)sbgEComBenchRandom(pState);
+				break;
+			}
+			break;
+		}
+	}
+
+	//
+	// No false start of frame of the dense noise can be ended by an ETX char
+	//
+	if (noise == BENCH_NOISE_DENSE_MAX_LENGTH)
+	{
+		for (length = 0; length < i; length++)
+		{
+			if (pBuffer[length] == SBG_ECOM_ETX)
+			{
+				pBuffer[length] = 0x00;
+			}
+		}
+	}
+
+	pStream->writeIndex += i;
+}
+
+/*!
+ *	Fill the stream with noise and a valid frame every BENCH_FRAME_PERIOD bytes.
+ *	\param[in]	pStream									The stream to fill.
+ *	\param[in]	noise									Kind of noise.
+ *	\param[in]	seed									Seed of the noise.
+ */
+static void benchFillStream(SbgEComBenchStream *pStream, BenchNoise noise, uint32 seed)
+{
+	uint8			payload[72];
+	uint32			state = seed;
+	uint32			i;
+
+	sbgEComBenchStreamClear(pStream);
+
+	while (pStream->writeIndex + 2 * BENCH_FRAME_PERIOD < pStream->bufferSize)
+	{
+		benchAddNoise(pStream, noise, BENCH_FRAME_PERIOD, &state);
+
+		for (i = 0; i < sizeof(payload); i++)
+		{
+			payload[i] = (uint8)sbgEComBenchRandom(&state);
+		}
+
+		sbgEComBenchStreamAddFrame(pStream, SBG_ECOM_LOG_EKF_NAV, payload, sizeof(payload));
+	}
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	static SbgEComBenchStream	stream;
+	static SbgEComProtocol		protocol;
+	SbgEComBenchRxResult		result;
+	uint32						noise;
+	uint32						seed;
+	uint32						maxLostFrames;
+	double						nsPerByte;
+	double						crcPerByte;
+	double						maxNsPerByte;
+	double						maxCrcPerByte;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	if (sbgEComBenchStreamInit(&stream, BENCH_STREAM_SIZE, BENCH_MAX_READ_SIZE, 1) != SBG_NO_ERROR)
+	{
+		return EXIT_FAILURE;
+	}
+
+	printf("Worst case over %u seeds (CRC bytes per received byte / ns per byte):\n", BENCH_NUM_SEEDS);
+
+	for (noise = 0; noise < BENCH_NOISE_NUM; noise++)
+	{
+		maxNsPerByte = 0.0;
+		maxCrcPerByte = 0.0;
+		maxLostFrames = 0;
+
+		for (seed = 1; seed <= BENCH_NUM_SEEDS; seed++)
+		{
+			benchFillStream(&stream, (BenchNoise)noise, seed);
+			stream.readSeed = seed;
+
+			gNumCrcBytes = 0;
+
+			sbgEComProtocolInit(&protocol, &stream.interface);
+			sbgEComBenchStreamReceiveAll(&stream, &protocol, &result);
+			sbgEComProtocolClose(&protocol);
+
+			nsPerByte = (double)result.elapsedNs / stream.writeIndex;
+			crcPerByte = (double)gNumCrcBytes / stream.writeIndex;
+
+			maxNsPerByte = (nsPerByte > maxNsPerByte) ? nsPerByte : maxNsPerByte;
+			maxCrcPerByte = (crcPerByte > maxCrcPerByte) ? crcPerByte : maxCrcPerByte;
+			maxLostFrames = (stream.numFrames - result.numFrames > maxLostFrames) ? (stream.numFrames - result.numFrames) : maxLostFrames;
+		}
+
+		printf("%-36s %6.2f / %5.2f  lost frames=%u/%u\n", gNoiseNames[noise], maxCrcPerByte, maxNsPerByte, maxLostFrames, stream.numFrames);
+	}
+
+	sbgEComBenchStreamClose(&stream);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,469 @@
+/*!
+ *	\file		sbgEComBenchRxCopies.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Number of bytes copied by the protocol reception path for each received frame.
+ *
+ *	A large stream of IMU and EKF sized frames is received in random read sizes, first
+ *	clean and then with junk bytes and corrupted CRCs. The protocol source is built into
+ *	this benchmark with counting memcpy and memmove so every byte moved inside the
+ *	reception buffer is accounted for. The payload copy to the caller buffer, that
+ *	sbgEComProtocolReceive always does, is reported apart.
+ *
+ *	Each stream is also received by a reference copy of the former reception loop, that
+ *	compacts a linear buffer with memmove after each frame, so both paths are compared
+ *	on the same input and checked to return the same frames.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include "sbgEComBenchStream.h"
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define BENCH_STREAM_SIZE			(64*1024*1024)							/*!< Size in bytes of the received stream. */
+#define BENCH_MAX_READ_SIZE			(512)									/*!< Maximum number of bytes returned by each read. */
+
+//----------------------------------------------------------------------//
+//- Counted copies                                                     -//
+//----------------------------------------------------------------------//
+
+static uint64	gNumBytesCopied;
+static uint64	gNumBytesMoved;
+
+/*!
+ *	memcpy used by the protocol source, counts the copied bytes.
+ *	\param[out]	pDst									Destination buffer.
+ *	\param[in]	pSrc									Source buffer.
+ *	\param[in]	size									Number of bytes to copy.
+ *	\return												pDst.
+ */
+static void *benchCountedMemcpy(void *pDst, const void *pSrc, size_t size)
+{
+	gNumBytesCopied += size;
+
+	return memcpy(pDst, pSrc, size);
+}
+
+/*!
+ *	memmove used by the protocol source, counts the moved bytes.
+ *	\param[out]	pDst									Destination buffer.
+ *	\param[in]	pSrc									Source buffer.
+ *	\param[in]	size									Number of bytes to move.
+ *	\return												pDst.
+ */
+static void *benchCountedMemmove(void *pDst, const void *pSrc, size_t size)
+{
+	gNumBytesMoved += size;
+
+	return memmove(pDst, pSrc, size);
+}
+
+//
+// The protocol source is built into this benchmark, string.h has already been included so only its calls are redirected
+//
+#define memcpy		benchCountedMemcpy
+#define memmove		benchCountedMemmove
+#include "../src/protocol/sbgEComProtocol.c"
+#undef memcpy
+#undef memmove
+
+//----------------------------------------------------------------------//
+//- Reference reception loop                                           -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Reception state of the former protocol implementation, frames are always stored at the beginning of a linear buffer.
+ */
+typedef struct _BenchRefProtocol
+{
+	SbgInterface		*pLinkedInterface;							/*!< Interface used to read bytes. */
+	uint8				 rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE];		/*!< The reception buffer. */
+	uint32				 rxBufferSize;								/*!< The current reception buffer size in bytes. */
+} BenchRefProtocol;
+
+/*!
+ *	Method used to receive a frame and copy its payload, such as sbgEComProtocolReceive.
+ */
+typedef SbgErrorCode (*BenchReceiveFunc)(void *pContext, uint16 *pCmd, void *pData, uint32 *pSize, uint32 maxSize);
+
+/*!
+ *	Former sbgEComProtocolReceive implementation, kept as a reference.
+ *	Junk bytes and received frames are removed by moving the remaining bytes to the beginning of the buffer.
+ *	\param[in]	pContext								Reference protocol state.
+ *	\param[out]	pCmd									Pointer to hold the returned command.
+ *	\param[out]	pData									Allocated buffer used to hold received data field.
+ *	\param[out]	pSize									Pointer used to hold the received data field size.
+ *	\param[in]	maxSize									Max number of bytes that can be stored in the pData buffer.
+ *	\return												SBG_NO_ERROR if we have received a valid frame.
+ */
+static SbgErrorCode benchRefReceive(void *pContext, uint16 *pCmd, void *pData, uint32 *pSize, uint32 maxSize)
+{
+	BenchRefProtocol	*pHandle = (BenchRefProtocol*)pContext;
+	SbgErrorCode		 errorCode = SBG_NOT_READY;
+	SbgStreamBuffer		 inputStream;
+	bool				 syncFound;
+	uint32				 payloadSize;
+	uint16				 frameCrc;
+	uint16				 computedCrc;
+	uint32				 i;
+	uint32				 numBytesRead;
+	uint16				 receivedCmd;
+	uint32				 payloadOffset;
+
+	*pSize = 0;
+
+	//
+	// Read as much data as we can if the receive buffer isn't full
+	//
+	if (pHandle->rxBufferSize < SBG_ECOM_MAX_BUFFER_SIZE)
+	{
+		if (sbgInterfaceRead(pHandle->pLinkedInterface, pHandle->rxBuffer + pHandle->rxBufferSize, &numBytesRead, SBG_ECOM_MAX_BUFFER_SIZE - pHandle->rxBufferSize) == SBG_NO_ERROR)
+		{
+			pHandle->rxBufferSize += numBytesRead;
+		}
+	}
+
+	while (pHandle->rxBufferSize > 0)
+	{
+		syncFound = FALSE;
+
+		//
+		// Look for SYNC_1 and SYNC_2 chars byte per byte and remove the junk bytes before them
+		//
+		if (pHandle->rxBufferSize >= 2)
+		{
+			for (i = 0; i < pHandle->rxBufferSize-1; i++)
+			{
+				if ( (pHandle->rxBuffer[i] == SBG_ECOM_SYNC_1) && (pHandle->rxBuffer[i+1] == SBG_ECOM_SYNC_2) )
+				{
+					if (i > 0)
+					{
+						benchCountedMemmove(pHandle->rxBuffer, pHandle->rxBuffer+i, pHandle->rxBufferSize-i);
+						pHandle->rxBufferSize = pHandle->rxBufferSize-i;
+					}
+
+					syncFound = TRUE;
+					break;
+				}
+			}
+		}
+
+		if (syncFound)
+		{
+			if (pHandle->rxBufferSize < 8)
+			{
+				return SBG_NOT_READY;
+			}
+
+			sbgStreamBufferInitForRead(&inputStream, pHandle->rxBuffer, pHandle->rxBufferSize);
+			sbgStreamBufferSeek(&inputStream, sizeof(uint8)*2, SB_SEEK_CUR_INC);
+			receivedCmd = sbgStreamBufferReadUint16LE(&inputStream);
+			payloadSize = (uint16)sbgStreamBufferReadUint16LE(&inputStream);
+
+			if (payloadSize <= SBG_ECOM_MAX_PAYLOAD_SIZE)
+			{
+				if (pHandle->rxBufferSize < payloadSize+9)
+				{
+					return SBG_NOT_READY;
+				}
+
+				payloadOffset = sbgStreamBufferTell(&inputStream);
+				sbgStreamBufferSeek(&inputStream, payloadSize, SB_SEEK_CUR_INC);
+				frameCrc = sbgStreamBufferReadUint16LE(&inputStream);
+
+				if (sbgStreamBufferReadUint8(&inputStream) == SBG_ECOM_ETX)
+				{
+					sbgStreamBufferSeek(&inputStream, payloadOffset, SB_SEEK_SET);
+					*pCmd = receivedCmd;
+
+					//
+					// The CRC is computed once the whole frame has been received
+					//
+					computedCrc = sbgCrc16Compute(pHandle->rxBuffer + 2, payloadSize + 4);
+
+					if (frameCrc == computedCrc)
+					{
+						if (payloadSize <= maxSize)
+						{
+							*pSize = payloadSize;
+							benchCountedMemcpy(pData, sbgStreamBufferGetCursor(&inputStream), payloadSize);
+							errorCode = SBG_NO_ERROR;
+						}
+						else
+						{
+							errorCode = SBG_BUFFER_OVERFLOW;
+						}
+					}
+					else
+					{
+						errorCode = SBG_INVALID_CRC;
+					}
+
+					//
+					// Remove the frame by moving the remaining bytes to the beginning of the buffer
+					//
+					if (pHandle->rxBufferSize > payloadSize+9)
+					{
+						pHandle->rxBufferSize = pHandle->rxBufferSize-(payloadSize+9);
+						benchCountedMemmove(pHandle->rxBuffer, pHandle->rxBuffer+payloadSize+9, pHandle->rxBufferSize);
+					}
+					else
+					{
+						pHandle->rxBufferSize = 0;
+					}
+
+					return errorCode;
+				}
+			}
+
+			//
+			// Invalid start of frame, remove the SYNC 1 and SYNC 2 chars to retry to find a new frame
+			//
+			pHandle->rxBufferSize -= 2;
+			benchCountedMemmove(pHandle->rxBuffer, pHandle->rxBuffer+2, pHandle->rxBufferSize);
+		}
+		else
+		{
+			//
+			// Only keep a trailing SYNC char for next time
+			//
+			if (pHandle->rxBuffer[pHandle->rxBufferSize-1] == SBG_ECOM_SYNC_1)
+			{
+				pHandle->rxBuffer[0] = SBG_ECOM_SYNC_1;
+				pHandle->rxBufferSize = 1;
+			}
+			else
+			{
+				pHandle->rxBufferSize = 0;
+			}
+
+			return SBG_NOT_READY;
+		}
+	}
+
+	return SBG_NOT_READY;
+}
+
+/*!
+ *	Receive a frame with the current ring buffer implementation.
+ *	\param[in]	pContext								Protocol handle.
+ *	\param[out]	pCmd									Pointer to hold the returned command.
+ *	\param[out]	pData									Allocated buffer used to hold received data field.
+ *	\param[out]	pSize									Pointer used to hold the received data field size.
+ *	\param[in]	maxSize									Max number of bytes that can be stored in the pData buffer.
+ *	\return												SBG_NO_ERROR if we have received a valid frame.
+ */
+static SbgErrorCode benchRingReceive(void *pContext, uint16 *pCmd, void *pData, uint32 *pSize, uint32 maxSize)
+{
+	return sbgEComProtocolReceive((SbgEComProtocol*)pContext, pCmd, pData, pSize, maxSize);
+}
+
+//----------------------------------------------------------------------//
+//- Benchmark                                                          -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Fill the stream with IMU, EKF and status sized frames, optionally with junk bytes and corrupted CRCs.
+ *	\param[in]	pStream									The stream to fill.
+ *	\param[in]	withNoise								TRUE to add junk before 10% of the frames and corrupt 2% of the CRCs.
+ */
+static void benchFillStream(SbgEComBenchStream *pStream, bool withNoise)
+{
+	static const uint16	cmds[]	= { SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LOG_EKF_NAV, SBG_ECOM_LOG_EKF_EULER, SBG_ECOM_LOG_EKF_QUAT, SBG_ECOM_LOG_GPS1_POS, SBG_ECOM_LOG_STATUS };
+	static const uint32	sizes[]	= { 58, 72, 32, 36, 57, 22 };
+	uint8				payload[128];
+	uint8				junk[32];
+	uint32				state = 1;
+	uint32				index;
+	uint32				junkSize;
+	uint32				i;
+
+	sbgEComBenchStreamClear(pStream);
+
+	while (pStream->writeIndex + sizeof(payload) + sizeof(junk) + SBG_ECOM_FRAME_OVERHEAD < pStream->bufferSize)
+	{
+		index = sbgEComBenchRandom(&state) % 6;
+
+		for (i = 0; i < sizes[index]; i++)
+		{
+			payload[i] = (uint8)sbgEComBenchRandom(&state);
+		}
+
+		if ( (withNoise) && (sbgEComBenchRandom(&state) % 10 == 0) )
+		{
+			junkSize = sbgEComBenchRandom(&state) % sizeof(junk);
+
+			for (i = 0; i < junkSize; i++)
+			{
+				junk[i] = (sbgEComBenchRandom(&state) % 2) ? SBG_ECOM_SYNC_1 : (uint8)sbgEComBenchRandom(&state);
+			}
+
+			sbgEComBenchStreamAddBytes(pStream, junk, junkSize);
+		}
+
+		sbgEComBenchStreamAddFrame(pStream, cmds[index], payload, sizes[index]);
+
+		if ( (withNoise) && (sbgEComBenchRandom(&state) % 50 == 0) )
+		{
+			pStream->pBuffer[pStream->writeIndex - 3] ^= 0x01;
+		}
+	}
+}
+
+/*!
+ *	Receive the whole stream, from its beginning, with the given reception method.
+ *	Both reception paths are called through the same function pointer so their timings can be compared.
+ *	\param[in]	pStream									The stream, rewound before being received.
+ *	\param[in]	pReceiveFunc							Reception method.
+ *	\param[in]	pContext								Protocol state given to pReceiveFunc.
+ *	\param[out]	pResult									Received frames and elapsed time.
+ */
+static void benchReceiveAll(SbgEComBenchStream *pStream, BenchReceiveFunc pReceiveFunc, void *pContext, SbgEComBenchRxResult *pResult)
+{
+	static uint8	payload[SBG_ECOM_MAX_PAYLOAD_SIZE];
+	SbgErrorCode	errorCode;
+	uint16			cmd;
+	uint32			payloadSize;
+	uint32			i;
+	uint64			startTime;
+
+	memset(pResult, 0x00, sizeof(SbgEComBenchRxResult));
+
+	sbgEComBenchStreamRewind(pStream);
+	startTime = sbgGetMonotonicNs();
+
+	for (;;)
+	{
+		errorCode = pReceiveFunc(pContext, &cmd, payload, &payloadSize, sizeof(payload));
+
+		if (errorCode == SBG_NO_ERROR)
+		{
+			pResult->numFrames++;
+			pResult->numPayloadBytes += payloadSize;
+			pResult->checksum = pResult->checksum * 31 + cmd;
+
+			for (i = 0; i < payloadSize; i++)
+			{
+				pResult->checksum = pResult->checksum * 131 + payload[i];
+			}
+		}
+		else if (errorCode == SBG_INVALID_CRC)
+		{
+			pResult->numCrcErrors++;
+			pResult->checksum = pResult->checksum * 7 + cmd;
+		}
+		else if (pStream->readIndex == pStream->writeIndex)
+		{
+			break;
+		}
+	}
+
+	pResult->elapsedNs = sbgGetMonotonicNs() - startTime;
+}
+
+/*!
+ *	Print the number of bytes copied per frame by a reception path.
+ *	The payload copy to the caller buffer is counted by the memcpy hook as well, only the rest is done inside the reception buffer.
+ *	\param[in]	pName									Reception path and stream description.
+ *	\param[in]	pStream									The received stream.
+ *	\param[in]	pResult									Received frames and elapsed time.
+ */
+static void benchPrint(const char *pName, const SbgEComBenchStream *pStream, const SbgEComBenchRxResult *pResult)
+{
+	printf("%-40s sent=%u frames=%u crcErrors=%u moved=%.1f B/frame linearized=%.2f B/frame copied=%.1f B/frame payload=%.1f B/frame %.1f ns/frame\n",
+		pName, pStream->numFrames, pResult->numFrames, pResult->numCrcErrors,
+		(double)gNumBytesMoved / pResult->numFrames,
+		(double)(gNumBytesCopied - pResult->numPayloadBytes) / pResult->numFrames,
+		(double)(gNumBytesMoved + gNumBytesCopied - pResult->numPayloadBytes) / pResult->numFrames,
+		(double)pResult->numPayloadBytes / pResult->numFrames,
+		(double)pResult->elapsedNs / pResult->numFrames);
+}
+
+/*!
+ *	Receive the stream with the reference loop and with the ring buffer, and print the number of bytes copied per frame.
+ *	\param[in]	pStream									The filled stream.
+ *	\param[in]	pName									Stream description.
+ *	\return												TRUE if both paths have returned the same frames.
+ */
+static bool benchRun(SbgEComBenchStream *pStream, const char *pName)
+{
+	static SbgEComProtocol	protocol;
+	static BenchRefProtocol	refProtocol;
+	SbgEComBenchRxResult	refResult;
+	SbgEComBenchRxResult	result;
+	char					name[64];
+
+	refProtocol.pLinkedInterface = &pStream->interface;
+	refProtocol.rxBufferSize = 0;
+
+	gNumBytesCopied = 0;
+	gNumBytesMoved = 0;
+
+	benchReceiveAll(pStream, benchRefReceive, &refProtocol, &refResult);
+
+	sprintf(name, "%s (memmove)", pName);
+	benchPrint(name, pStream, &refResult);
+
+	sbgEComProtocolInit(&protocol, &pStream->interface);
+
+	gNumBytesCopied = 0;
+	gNumBytesMoved = 0;
+
+	benchReceiveAll(pStream, benchRingReceive, &protocol, &result);
+
+	sprintf(name, "%s (ring buffer)", pName);
+	benchPrint(name, pStream, &result);
+
+	sbgEComProtocolClose(&protocol);
+
+	if ( (result.numFrames != refResult.numFrames) || (result.numCrcErrors != refResult.numCrcErrors) || (result.checksum != refResult.checksum) )
+	{
+		printf("%s: the ring buffer doesn't return the same frames as the reference loop\n", pName);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	static SbgEComBenchStream	stream;
+	bool						passed = TRUE;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	if (sbgEComBenchStreamInit(&stream, BENCH_STREAM_SIZE, BENCH_MAX_READ_SIZE, 1) != SBG_NO_ERROR)
+	{
+		return EXIT_FAILURE;
+	}
+
+	benchFillStream(&stream, FALSE);
+	passed &= benchRun(&stream, "clean stream");
+
+	benchFillStream(&stream, TRUE);
+	passed &= benchRun(&stream, "junk and corrupted CRCs");
+
+	sbgEComBenchStreamClose(&stream);
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
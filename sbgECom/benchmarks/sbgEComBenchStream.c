@@ -0,0 +1,248 @@
+#include "sbgEComBenchStream.h"
+#include <crc/sbgCrc.h>
+
+//----------------------------------------------------------------------//
+//- Private methods declarations                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Read function of the simulated stream, each read returns a random number of bytes.
+ *	\param[in]	pHandle									The stream interface.
+ *	\param[out]	pBuffer									Buffer used to return the read bytes.
+ *	\param[out]	pReadBytes								Number of bytes read.
+ *	\param[in]	bytesToRead								Maximum number of bytes to read.
+ *	\return												Always SBG_NO_ERROR.
+ */
+static SbgErrorCode sbgEComBenchStreamRead(SbgInterface *pHandle, void *pBuffer, uint32 *pReadBytes, uint32 bytesToRead)
+{
+	SbgEComBenchStream	*pStream = (SbgEComBenchStream*)pHandle->handle;
+	uint32				 numBytes;
+
+	numBytes = sbgEComBenchRandom(&pStream->readState) % pStream->maxReadSize + 1;
+
+	if (numBytes > bytesToRead)
+	{
+		numBytes = bytesToRead;
+	}
+
+	if (numBytes > pStream->writeIndex - pStream->readIndex)
+	{
+		numBytes = pStream->writeIndex - pStream->readIndex;
+	}
+
+	memcpy(pBuffer, pStream->pBuffer + pStream->readIndex, numBytes);
+	pStream->readIndex += numBytes;
+
+	*pReadBytes = numBytes;
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Write function of the simulated stream, written frames are ignored.
+ *	\param[in]	pHandle									The stream interface.
+ *	\param[in]	pBuffer									Written bytes.
+ *	\param[in]	bytesToWrite							Number of written bytes.
+ *	\return												Always SBG_NO_ERROR.
+ */
+static SbgErrorCode sbgEComBenchStreamWrite(SbgInterface *pHandle, const void *pBuffer, uint32 bytesToWrite)
+{
+	SBG_UNUSED_PARAMETER(pHandle);
+	SBG_UNUSED_PARAMETER(pBuffer);
+	SBG_UNUSED_PARAMETER(bytesToWrite);
+
+	return SBG_NO_ERROR;
+}
+
+//----------------------------------------------------------------------//
+//- Public methods definitions                                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Returns the next value of a simple linear congruential generator.
+ *	\param[in]	pState									Generator state, updated by the call.
+ *	\return												A 24 bits random value.
+ */
+uint32 sbgEComBenchRandom(uint32 *pState)
+{
+	*pState = *pState * 1103515245u + 12345u;
+
+	return *pState >> 8;
+}
+
+/*!
+ *	Allocate an empty stream.
+ *	\param[in]	pStream									Stream to initialize.
+ *	\param[in]	bufferSize								Maximum number of bytes the stream can hold.
+ *	\param[in]	maxReadSize								Maximum number of bytes returned by each read.
+ *	\param[in]	seed									Seed of the read sizes.
+ *	\return												SBG_NO_ERROR if the stream has been allocated.
+ */
+SbgErrorCode sbgEComBenchStreamInit(SbgEComBenchStream *pStream, uint32 bufferSize, uint32 maxReadSize, uint32 seed)
+{
+	sbgInterfaceZeroInit(&pStream->interface);
+
+	pStream->interface.handle = pStream;
+	pStream->interface.pReadFunc = sbgEComBenchStreamRead;
+	pStream->interface.pWriteFunc = sbgEComBenchStreamWrite;
+
+	pStream->pBuffer = (uint8*)malloc(bufferSize);
+	pStream->bufferSize = bufferSize;
+	pStream->maxReadSize = maxReadSize;
+	pStream->readSeed = seed;
+
+	sbgEComBenchStreamClear(pStream);
+
+	return (pStream->pBuffer != NULL) ? SBG_NO_ERROR : SBG_MALLOC_FAILED;
+}
+
+/*!
+ *	Release a stream.
+ *	\param[in]	pStream									Stream to release.
+ */
+void sbgEComBenchStreamClose(SbgEComBenchStream *pStream)
+{
+	free(pStream->pBuffer);
+	pStream->pBuffer = NULL;
+}
+
+/*!
+ *	Empty a stream so it can be filled again.
+ *	\param[in]	pStream									The stream.
+ */
+void sbgEComBenchStreamClear(SbgEComBenchStream *pStream)
+{
+	pStream->writeIndex = 0;
+	pStream->numFrames = 0;
+
+	sbgEComBenchStreamRewind(pStream);
+}
+
+/*!
+ *	Read the stream again from its beginning with the same read sizes.
+ *	\param[in]	pStream									The stream.
+ */
+void sbgEComBenchStreamRewind(SbgEComBenchStream *pStream)
+{
+	pStream->readIndex = 0;
+	pStream->readState = pStream->readSeed;
+}
+
+/*!
+ *	Append a complete frame to the stream.
+ *	\param[in]	pStream									The stream.
+ *	\param[in]	cmd										Command id, built with SBG_ECOM_BUILD_ID for extended classes.
+ *	\param[in]	pPayload								Payload or NULL if payloadSize is 0.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\return												SBG_NO_ERROR if the frame has been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComBenchStreamAddFrame(SbgEComBenchStream *pStream, uint16 cmd, const void *pPayload, uint32 payloadSize)
+{
+	uint8	*pFrame;
+	uint16	 crc;
+
+	if ( (payloadSize > SBG_ECOM_MAX_PAYLOAD_SIZE) || (pStream->writeIndex + payloadSize + SBG_ECOM_FRAME_OVERHEAD > pStream->bufferSize) )
+	{
+		return SBG_BUFFER_OVERFLOW;
+	}
+
+	pFrame = pStream->pBuffer + pStream->writeIndex;
+
+	pFrame[0] = SBG_ECOM_SYNC_1;
+	pFrame[1] = SBG_ECOM_SYNC_2;
+	pFrame[2] = (uint8)cmd;
+	pFrame[3] = (uint8)(cmd >> 8);
+	pFrame[4] = (uint8)payloadSize;
+	pFrame[5] = (uint8)(payloadSize >> 8);
+
+	if (payloadSize > 0)
+	{
+		memcpy(pFrame + 6, pPayload, payloadSize);
+	}
+
+	//
+	// The CRC covers the command, the length and the payload
+	//
+	crc = sbgCrc16Compute(pFrame + 2, payloadSize + 4);
+
+	pFrame[payloadSize + 6] = (uint8)crc;
+	pFrame[payloadSize + 7] = (uint8)(crc >> 8);
+	pFrame[payloadSize + 8] = SBG_ECOM_ETX;
+
+	pStream->writeIndex += payloadSize + SBG_ECOM_FRAME_OVERHEAD;
+	pStream->numFrames++;
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Append raw bytes, such as line noise, to the stream.
+ *	\param[in]	pStream									The stream.
+ *	\param[in]	pBuffer									Bytes to append.
+ *	\param[in]	size									Number of bytes to append.
+ *	\return												SBG_NO_ERROR if the bytes have been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComBenchStreamAddBytes(SbgEComBenchStream *pStream, const void *pBuffer, uint32 size)
+{
+	if (pStream->writeIndex + size > pStream->bufferSize)
+	{
+		return SBG_BUFFER_OVERFLOW;
+	}
+
+	memcpy(pStream->pBuffer + pStream->writeIndex, pBuffer, size);
+	pStream->writeIndex += size;
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Receive the whole stream with sbgEComProtocolReceive, from its beginning.
+ *	\param[in]	pStream									The stream, rewound before being received.
+ *	\param[in]	pProtocol								Protocol handle to use, initialized on the stream interface.
+ *	\param[out]	pResult									Received frames and elapsed time.
+ */
+void sbgEComBenchStreamReceiveAll(SbgEComBenchStream *pStream, SbgEComProtocol *pProtocol, SbgEComBenchRxResult *pResult)
+{
+	static uint8	payload[SBG_ECOM_MAX_PAYLOAD_SIZE];
+	SbgErrorCode	errorCode;
+	uint16			cmd;
+	uint32			payloadSize;
+	uint32			i;
+	uint64			startTime;
+
+	memset(pResult, 0x00, sizeof(SbgEComBenchRxResult));
+
+	sbgEComBenchStreamRewind(pStream);
+	startTime = sbgGetMonotonicNs();
+
+	for (;;)
+	{
+		errorCode = sbgEComProtocolReceive(pProtocol, &cmd, payload, &payloadSize, sizeof(payload));
+
+		if (errorCode == SBG_NO_ERROR)
+		{
+			pResult->numFrames++;
+			pResult->numPayloadBytes += payloadSize;
+			pResult->checksum = pResult->checksum * 31 + cmd;
+
+			for (i = 0; i < payloadSize; i++)
+			{
+				pResult->checksum = pResult->checksum * 131 + payload[i];
+			}
+		}
+		else if (errorCode == SBG_INVALID_CRC)
+		{
+			pResult->numCrcErrors++;
+			pResult->checksum = pResult->checksum * 7 + cmd;
+		}
+		else if (pStream->readIndex == pStream->writeIndex)
+		{
+			//
+			// Nothing more can be received once the stream has been fully read and the reception buffer is drained
+			//
+			break;
+		}
+	}
+
+	pResult->elapsedNs = sbgGetMonotonicNs() - startTime;
+}
@@ -0,0 +1,143 @@
+/*!
+ *	\file		sbgEComBenchStream.h
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Simulated byte stream used by the sbgECom benchmarks.
+ *
+ *	The stream is an SbgInterface that reads from a large heap buffer filled
+ *	beforehand with frames and junk bytes. Each read returns a random number of
+ *	bytes, from 1 up to maxReadSize, so frames are split across reads and wrap
+ *	around the protocol reception buffer like on a real serial port.
+ *
+ *	All random values come from a seeded generator so every run of a benchmark
+ *	processes exactly the same bytes.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#ifndef __SBG_ECOM_BENCH_STREAM_H__
+#define __SBG_ECOM_BENCH_STREAM_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sbgECom.h>
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Simulated byte stream read through an SbgInterface.
+ */
+typedef struct _SbgEComBenchStream
+{
+	SbgInterface				 interface;					/*!< Interface given to sbgEComProtocolInit or sbgEComInit. */
+	uint8						*pBuffer;					/*!< Bytes of the stream. */
+	uint32						 bufferSize;				/*!< Number of bytes that can be stored in pBuffer. */
+	uint32						 readIndex;					/*!< Position of the next byte to read. */
+	uint32						 writeIndex;				/*!< Number of bytes stored in the stream. */
+	uint32						 maxReadSize;				/*!< Maximum number of bytes returned by each read. */
+	uint32						 readSeed;					/*!< Seed of the read sizes, restored by sbgEComBenchStreamRewind. */
+	uint32						 readState;					/*!< Random state used to pick the read sizes. */
+	uint32						 numFrames;					/*!< Number of frames added to the stream. */
+} SbgEComBenchStream;
+
+/*!
+ * Result of the reception of a whole stream with sbgEComProtocolReceive.
+ */
+typedef struct _SbgEComBenchRxResult
+{
+	uint32						 numFrames;					/*!< Number of valid frames received. */
+	uint32						 numCrcErrors;				/*!< Number of frames received with an invalid CRC. */
+	uint64						 numPayloadBytes;			/*!< Number of payload bytes of the valid frames. */
+	uint32						 checksum;					/*!< Checksum of the received commands and payloads, used to compare runs. */
+	uint64						 elapsedNs;					/*!< Time in ns spent to receive the whole stream. */
+} SbgEComBenchRxResult;
+
+//----------------------------------------------------------------------//
+//- Public methods declarations                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Returns the next value of a simple linear congruential generator.
+ *	\param[in]	pState									Generator state, updated by the call.
+ *	\return												A 24 bits random value.
+ */
+uint32 sbgEComBenchRandom(uint32 *pState);
+
+/*!
+ *	Allocate an empty stream.
+ *	\param[in]	pStream									Stream to initialize.
+ *	\param[in]	bufferSize								Maximum number of bytes the stream can hold.
+ *	\param[in]	maxReadSize								Maximum number of bytes returned by each read.
+ *	\param[in]	seed									Seed of the read sizes.
+ *	\return												SBG_NO_ERROR if the stream has been allocated.
+ */
+SbgErrorCode sbgEComBenchStreamInit(SbgEComBenchStream *pStream, uint32 bufferSize, uint32 maxReadSize, uint32 seed);
+
+/*!
+ *	Release a stream.
+ *	\param[in]	pStream									Stream to release.
+ */
+void sbgEComBenchStreamClose(SbgEComBenchStream *pStream);
+
+/*!
+ *	Empty a stream so it can be filled again.
+ *	\param[in]	pStream									The stream.
+ */
+void sbgEComBenchStreamClear(SbgEComBenchStream *pStream);
+
+/*!
+ *	Read the stream again from its beginning with the same read sizes.
+ *	\param[in]	pStream									The stream.
+ */
+void sbgEComBenchStreamRewind(SbgEComBenchStream *pStream);
+
+/*!
+ *	Append a complete frame to the stream.
+ *	\param[in]	pStream									The stream.
+ *	\param[in]	cmd										Command id, built with SBG_ECOM_BUILD_ID for extended classes.
+ *	\param[in]	pPayload								Payload or NULL if payloadSize is 0.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\return												SBG_NO_ERROR if the frame has been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComBenchStreamAddFrame(SbgEComBenchStream *pStream, uint16 cmd, const void *pPayload, uint32 payloadSize);
+
+/*!
+ *	Append raw bytes, such as line noise, to the stream.
+ *	\param[in]	pStream									The stream.
+ *	\param[in]	pBuffer									Bytes to append.
+ *	\param[in]	size									Number of bytes to append.
+ *	\return												SBG_NO_ERROR if the bytes have been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComBenchStreamAddBytes(SbgEComBenchStream *pStream, const void *pBuffer, uint32 size);
+
+/*!
+ *	Receive the whole stream with sbgEComProtocolReceive, from its beginning.
+ *	\param[in]	pStream									The stream, rewound before being received.
+ *	\param[in]	pProtocol								Protocol handle to use, initialized on the stream interface.
+ *	\param[out]	pResult									Received frames and elapsed time.
+ */
+void sbgEComBenchStreamReceiveAll(SbgEComBenchStream *pStream, SbgEComProtocol *pProtocol, SbgEComBenchRxResult *pResult);
+
+//----------------------------------------------------------------------//
+//- Footer (close extern C block)                                      -//
+//----------------------------------------------------------------------//
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SBG_ECOM_BENCH_STREAM_H__ */
@@ -0,0 +1,226 @@
+/*!
+ *	\file		sbgEComBenchSync.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Throughput of the start of frame scanner on garbage-heavy input.
+ *
+ *	The scanner is first measured alone on a 4 KB buffer without any SYNC_1 / SYNC_2
+ *	pair, against a plain byte loop. The whole reception path is then measured on
+ *	streams where about 2000 junk bytes precede each frame and the port returns up
+ *	to 4 KB per read.
+ *
+ *	The protocol source is built into this benchmark so its static scanner can be
+ *	called directly. The scanner variant depends on the compiler target, build with
+ *	-mavx2 to measure the AVX2 one.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <stdio.h>
+#include "sbgEComBenchStream.h"
+#include "../src/protocol/sbgEComProtocol.c"
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define BENCH_SCAN_SIZE				(4096)									/*!< Size in bytes of the buffer searched by the scanner alone. */
+#define BENCH_SCAN_BYTES			(1024ull*1024*1024)						/*!< Number of bytes searched for each kind of junk. */
+#define BENCH_STREAM_SIZE			(64*1024*1024)							/*!< Size in bytes of the received stream. */
+#define BENCH_MAX_READ_SIZE			(4096)									/*!< Maximum number of bytes returned by each read. */
+#define BENCH_JUNK_SIZE				(2000)									/*!< Average number of junk bytes before each frame. */
+
+#if defined(SBG_ECOM_SYNC_SCAN_AVX2)
+	#define BENCH_SCANNER_NAME		"AVX2"
+#elif defined(SBG_ECOM_SYNC_SCAN_SSE2)
+	#define BENCH_SCANNER_NAME		"SSE2"
+#else
+	#define BENCH_SCANNER_NAME		"memchr"
+#endif
+
+/*!
+ * Kinds of junk bytes found on a serial port.
+ */
+typedef enum _BenchJunk
+{
+	BENCH_JUNK_RANDOM,														/*!< Uniformly random bytes. */
+	BENCH_JUNK_ASCII,														/*!< Printable chars, like NMEA sentences on a shared port. */
+	BENCH_JUNK_SYNC_1,														/*!< One byte out of three is SYNC_1, like an idle or noisy line. */
+	BENCH_JUNK_NUM															/*!< Number of junk kinds. */
+} BenchJunk;
+
+static const char *gJunkNames[BENCH_JUNK_NUM] = { "random bytes", "ASCII (NMEA-like)", "1/3 bytes 0xFF" };
+
+//----------------------------------------------------------------------//
+//- Benchmark                                                          -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Fill a buffer with junk bytes that never contain a SYNC_1 / SYNC_2 pair.
+ *	\param[out]	pBuffer									Buffer to fill.
+ *	\param[in]	size									Number of bytes to fill.
+ *	\param[in]	junk									Kind of junk bytes.
+ *	\param[in]	pState									Random state, updated by the call.
+ */
+static void benchFillJunk(uint8 *pBuffer, uint32 size, BenchJunk junk, uint32 *pState)
+{
+	uint32		i;
+
+	for (i = 0; i < size; i++)
+	{
+		switch (junk)
+		{
+		case BENCH_JUNK_ASCII:
+			pBuffer[i] = (uint8)(' ' + sbgEComBenchRandom(pState) % 95);
+			break;
+		case BENCH_JUNK_SYNC_1:
+			pBuffer[i] = (sbgEComBenchRandom(pState) % 3 == 0) ? SBG_ECOM_SYNC_1 : (uint8)sbgEComBenchRandom(pState);
+			break;
+		default:
+			pBuffer[i] = (uint8)sbgEComBenchRandom(pState);
+			break;
+		}
+
+		if ( (i > 0) && (pBuffer[i - 1] == SBG_ECOM_SYNC_1) && (pBuffer[i] == SBG_ECOM_SYNC_2) )
+		{
+			pBuffer[i] = 0x00;
+		}
+	}
+}
+
+/*!
+ *	Reference scanner that compares every byte pair.
+ *	\param[in]	pBuffer									Buffer to search.
+ *	\param[in]	size									Buffer size in bytes.
+ *	\return												Offset of the first pair or size if there is none.
+ */
+static uint32 benchFindSyncByteLoop(const uint8 *pBuffer, uint32 size)
+{
+	uint32		i;
+
+	for (i = 0; i + 1 < size; i++)
+	{
+		if ( (pBuffer[i] == SBG_ECOM_SYNC_1) && (pBuffer[i + 1] == SBG_ECOM_SYNC_2) )
+		{
+			return i;
+		}
+	}
+
+	return size;
+}
+
+/*!
+ *	Measure a scanner on a buffer without any sync pair.
+ *	\param[in]	pFindSync								Scanner to measure.
+ *	\param[in]	pBuffer									Buffer to search.
+ *	\return												Throughput in GB/s.
+ */
+static double benchScan(uint32 (*pFindSync)(const uint8 *, uint32), const uint8 *pBuffer)
+{
+	volatile uint32	result = 0;
+	uint64			startTime;
+	uint64			i;
+
+	startTime = sbgGetMonotonicNs();
+
+	for (i = 0; i < BENCH_SCAN_BYTES; i += BENCH_SCAN_SIZE)
+	{
+		result += pFindSync(pBuffer, BENCH_SCAN_SIZE);
+	}
+
+	if (result != (uint32)(BENCH_SCAN_BYTES / BENCH_SCAN_SIZE * BENCH_SCAN_SIZE))
+	{
+		printf("a sync pair has been found in the junk bytes\n");
+	}
+
+	return (double)BENCH_SCAN_BYTES / (sbgGetMonotonicNs() - startTime);
+}
+
+/*!
+ *	Receive a stream made of frames preceded by junk bytes and print the throughput.
+ *	\param[in]	pStream									Stream used to store the bytes.
+ *	\param[in]	junk									Kind of junk bytes.
+ */
+static void benchReceive(SbgEComBenchStream *pStream, BenchJunk junk)
+{
+	static SbgEComProtocol	protocol;
+	static uint8			junkBytes[2*BENCH_JUNK_SIZE];
+	SbgEComBenchRxResult	result;
+	SbgEComProtocolStats	stats;
+	uint8					payload[64];
+	uint32					state = 1;
+	uint32					junkSize;
+
+	sbgEComBenchStreamClear(pStream);
+	memset(payload, 0x00, sizeof(payload));
+
+	while (pStream->writeIndex + sizeof(junkBytes) + sizeof(payload) + SBG_ECOM_FRAME_OVERHEAD < pStream->bufferSize)
+	{
+		junkSize = sbgEComBenchRandom(&state) % sizeof(junkBytes);
+
+		benchFillJunk(junkBytes, junkSize, junk, &state);
+		sbgEComBenchStreamAddBytes(pStream, junkBytes, junkSize);
+		sbgEComBenchStreamAddFrame(pStream, SBG_ECOM_LOG_IMU_DATA, payload, 58);
+	}
+
+	sbgEComProtocolInit(&protocol, &pStream->interface);
+	sbgEComBenchStreamReceiveAll(pStream, &protocol, &result);
+	sbgEComProtocolGetStats(&protocol, &stats);
+
+	printf("%-20s frames=%u/%u discarded=%.1f%% %.2f GB/s\n",
+		gJunkNames[junk], result.numFrames, pStream->numFrames,
+		100.0 * stats.bytesDiscarded / pStream->writeIndex,
+		(double)pStream->writeIndex / result.elapsedNs);
+
+	sbgEComProtocolClose(&protocol);
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	static SbgEComBenchStream	stream;
+	static uint8				buffer[BENCH_SCAN_SIZE];
+	uint32						state = 1;
+	uint32						junk;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	printf("Scanner alone on %u bytes without sync pair (byte loop / %s):\n", BENCH_SCAN_SIZE, BENCH_SCANNER_NAME);
+
+	for (junk = 0; junk < BENCH_JUNK_NUM; junk++)
+	{
+		benchFillJunk(buffer, sizeof(buffer), (BenchJunk)junk, &state);
+
+		printf("%-20s %.2f GB/s / %.2f GB/s\n", gJunkNames[junk], benchScan(benchFindSyncByteLoop, buffer), benchScan(sbgEComProtocolFindSync, buffer));
+	}
+
+	if (sbgEComBenchStreamInit(&stream, BENCH_STREAM_SIZE, BENCH_MAX_READ_SIZE, 1) != SBG_NO_ERROR)
+	{
+		return EXIT_FAILURE;
+	}
+
+	printf("\nReception of frames preceded by about %u junk bytes:\n", BENCH_JUNK_SIZE);
+
+	for (junk = 0; junk < BENCH_JUNK_NUM; junk++)
+	{
+		benchReceive(&stream, (BenchJunk)junk);
+	}
+
+	sbgEComBenchStreamClose(&stream);
+
+	return EXIT_SUCCESS;
+}
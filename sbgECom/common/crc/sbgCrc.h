@@ -33,6 +33,46 @@ typedef uint32 SbgCrc32;
 /*!< Type used to compute a 16 bit CRC. */
 typedef uint16 SbgCrc16;
 
+/*!
+ *	Kernels that can be used to compute the CRCs.
+ *	All kernels return exactly the same values, only the throughput differs.
+ */
+typedef enum _SbgCrcKernel
+{
+	SBG_CRC_KERNEL_AUTO,							/*!< Use the fastest kernel supported by the processor. */
+	SBG_CRC_KERNEL_BYTE,							/*!< Reference kernel using one table lookup per byte. */
+	SBG_CRC_KERNEL_SLICING_4,						/*!< Slicing-by-4 kernel processing 4 bytes per step. */
+	SBG_CRC_KERNEL_SLICING_8,						/*!< Slicing-by-8 kernel processing 8 bytes per step. */
+	SBG_CRC_KERNEL_PCLMUL							/*!< x86 kernel folding 64 bytes per step using the PCLMULQDQ instruction. */
+} SbgCrcKernel;
+
+//----------------------------------------------------------------------//
+//- Kernel selection                                                   -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Test if a CRC kernel can be used on this platform.
+ *	\param[in]	kernel					The kernel to test.
+ *	\return								TRUE if the kernel is supported by both the build and the processor.
+ */
+bool sbgCrcIsKernelSupported(SbgCrcKernel kernel);
+
+/*!
+ *	Define the kernel used to compute both 16 and 32 bit CRCs.
+ *	All kernels return exactly the same CRC values, only the throughput differs.
+ *	\param[in]	kernel					The kernel to use or SBG_CRC_KERNEL_AUTO to select the fastest supported one.
+ *	\return								SBG_NO_ERROR if the kernel has been selected.<br>
+ *										SBG_INVALID_PARAMETER if the kernel isn't supported on this platform.
+ */
+SbgErrorCode sbgCrcSetKernel(SbgCrcKernel kernel);
+
+/*!
+ *	Returns the kernel used to compute CRCs.
+ *	When the automatic selection is active, the fastest supported kernel is resolved and returned.
+ *	\return								The kernel currently in use (never SBG_CRC_KERNEL_AUTO).
+ */
+SbgCrcKernel sbgCrcGetKernel(void);
+
 //----------------------------------------------------------------------//
 //- 32 bits Ethernet CRC                                               -//
 //----------------------------------------------------------------------//
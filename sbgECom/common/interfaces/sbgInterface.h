@@ -56,6 +56,20 @@ typedef struct _SbgInterface SbgInterface;
  */
 typedef void* SbgInterfaceHandle;
 
+/*!
+ * Maximum number of buffers that can be written in a single vectored write operation.
+ */
+#define SBG_INTERFACE_WRITEV_MAX_BUFFERS		(16)
+
+/*!
+ * Describes one of the buffers written by a vectored write operation.
+ */
+typedef struct _SbgInterfaceBuffer
+{
+	const void		*pBuffer;								/*!< Pointer on the data to write. */
+	uint32			 size;									/*!< Number of bytes to write. */
+} SbgInterfaceBuffer;
+
 //----------------------------------------------------------------------//
 //- Callbacks definitions                                              -//
 //----------------------------------------------------------------------//
@@ -69,6 +83,15 @@ typedef void* SbgInterfaceHandle;
  */
 typedef SbgErrorCode (*SbgInterfaceWriteFunc)(SbgInterface *pHandle, const void *pBuffer, uint32 bytesToWrite);
 
+/*!
+ * Try to write several buffers, one after the other, to an interface without having to concatenate them first.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+typedef SbgErrorCode (*SbgInterfaceWriteVFunc)(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers);
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -86,6 +109,15 @@ typedef SbgErrorCode (*SbgInterfaceReadFunc)(SbgInterface *pHandle, void *pBuffe
  */
 typedef bool (*SbgInterfaceIsValidFunc)(SbgInterface *pHandle);
 
+/*!
+ * Block until some data can be read from an interface or the time out expires.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read.<br>
+ *														SBG_TIME_OUT if no data has been received within the time out.
+ */
+typedef SbgErrorCode (*SbgInterfaceWaitReadableFunc)(SbgInterface *pHandle, uint32 timeOut);
+
 //----------------------------------------------------------------------//
 //- Structures definitions                                             -//
 //----------------------------------------------------------------------//
@@ -99,8 +131,10 @@ struct _SbgInterface
 	SbgInterfaceType			 type;								/*!< The interface type. */
 
 	SbgInterfaceWriteFunc		pWriteFunc;							/*!< Pointer on the method used to write some data to this interface. */
+	SbgInterfaceWriteVFunc		pWriteVFunc;						/*!< Optional pointer on the method used to write several buffers at once (NULL if not supported). */
 	SbgInterfaceReadFunc		pReadFunc;							/*!< Pointer on the method used to read some data to this interface. */
 	SbgInterfaceIsValidFunc		pIsValidFunc;						/*!< Pointer on the method used to test if the interface is working correctly.*/
+	SbgInterfaceWaitReadableFunc	pWaitReadableFunc;				/*!< Optional pointer on the method used to wait for incoming data (NULL if not supported). */
 };
 
 //----------------------------------------------------------------------//
@@ -119,8 +153,10 @@ SBG_INLINE void sbgInterfaceZeroInit(SbgInterface *pHandle)
 	pHandle->handle			= NULL;
 	pHandle->type			= SBG_IF_TYPE_UNKNOW;
 	pHandle->pWriteFunc		= NULL;
+	pHandle->pWriteVFunc	= NULL;
 	pHandle->pReadFunc		= NULL;
 	pHandle->pIsValidFunc	= NULL;
+	pHandle->pWaitReadableFunc	= NULL;
 }
 
 /*!
@@ -151,6 +187,41 @@ SBG_INLINE SbgErrorCode sbgInterfaceWrite(SbgInterface *pHandle, const void *pBu
 	return pHandle->pWriteFunc(pHandle, pBuffer, bytesToWrite);
 }
 
+/*!
+ * Try to write several buffers, one after the other, to an interface.
+ * If the interface doesn't support vectored writes, each buffer is written using a separate write operation.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+SBG_INLINE SbgErrorCode sbgInterfaceWriteV(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers)
+{
+	SbgErrorCode	errorCode = SBG_NO_ERROR;
+	uint32			i;
+
+	//
+	// Call the vectored write method if the interface has one
+	//
+	if (pHandle->pWriteVFunc)
+	{
+		return pHandle->pWriteVFunc(pHandle, pBuffers, numBuffers);
+	}
+
+	//
+	// Otherwise, write each buffer one after the other
+	//
+	for (i = 0; (i < numBuffers) && (errorCode == SBG_NO_ERROR); i++)
+	{
+		if (pBuffers[i].size > 0)
+		{
+			errorCode = pHandle->pWriteFunc(pHandle, pBuffers[i].pBuffer, pBuffers[i].size);
+		}
+	}
+
+	return errorCode;
+}
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -167,4 +238,33 @@ SBG_INLINE SbgErrorCode sbgInterfaceRead(SbgInterface *pHandle, void *pBuffer, u
 	return pHandle->pReadFunc(pHandle, pBuffer, pReadBytes, bytesToRead);
 }
 
+/*!
+ * Block until some data can be read from an interface or the time out expires.
+ * If the interface can't wait for incoming data, the CPU is just released for 1 ms so the caller can try to read again.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read or may be read.<br>
+ *														SBG_TIME_OUT if no data has been received within the time out.
+ */
+SBG_INLINE SbgErrorCode sbgInterfaceWaitReadable(SbgInterface *pHandle, uint32 timeOut)
+{
+	//
+	// Call the wait method if the interface has one
+	//
+	if (pHandle->pWaitReadableFunc)
+	{
+		return pHandle->pWaitReadableFunc(pHandle, timeOut);
+	}
+
+	//
+	// Fall back to the polling behavior
+	//
+	if (timeOut > 0)
+	{
+		sbgSleep(1);
+	}
+
+	return SBG_NO_ERROR;
+}
+
 #endif /* __INTERFACE_H__ */
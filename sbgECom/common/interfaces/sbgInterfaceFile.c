@@ -46,6 +46,7 @@ SbgErrorCode sbgInterfaceFileOpen(SbgInterface *pHandle, const char *filePath)
 			pHandle->type = SBG_IF_TYPE_FILE;
 			pHandle->pReadFunc = sbgInterfaceFileRead;
 			pHandle->pWriteFunc = sbgInterfaceFileWriteFake;
+			pHandle->pWaitReadableFunc = sbgInterfaceFileWaitReadable;
 		}
 		else
 		{
@@ -99,6 +100,7 @@ SbgErrorCode sbgInterfaceFileWriteOpen(SbgInterface *pHandle, const char *filePa
 			pHandle->type = SBG_IF_TYPE_FILE;
 			pHandle->pReadFunc = sbgInterfaceFileReadFake;
 			pHandle->pWriteFunc = sbgInterfaceFileWrite;
+			pHandle->pWriteVFunc = sbgInterfaceFileWriteV;
 		}
 		else
 		{
@@ -284,6 +286,48 @@ SbgErrorCode sbgInterfaceFileWrite(SbgInterface *pHandle, const void *pBuffer, u
 	}
 }
 
+/*!
+ * Try to write several buffers to an interface.
+ * Buffers are directly appended to the FILE stream buffer so they don't have to be concatenated first.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+SbgErrorCode sbgInterfaceFileWriteV(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers)
+{
+	FILE *pOutputFile;
+	uint32 i;
+
+	//
+	// Test input parameters
+	//
+	if ( (pHandle) && (pBuffers) )
+	{
+		//
+		// Get the internal FILE handle
+		//
+		pOutputFile = (FILE*)(pHandle->handle);
+
+		//
+		// Write each buffer one after the other
+		//
+		for (i = 0; i < numBuffers; i++)
+		{
+			if ( (pBuffers[i].size > 0) && (fwrite(pBuffers[i].pBuffer, sizeof(uint8), pBuffers[i].size, pOutputFile) != pBuffers[i].size) )
+			{
+				return SBG_WRITE_ERROR;
+			}
+		}
+
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -320,6 +364,38 @@ SbgErrorCode sbgInterfaceFileRead(SbgInterface *pHandle, void *pBuffer, uint32 *
 }
 
 
+/*!
+ * Wait until some data can be read from a file.
+ * A file can always be read until its end, once the end has been reached we just wait for the whole time out.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read.<br>
+ *														SBG_TIME_OUT if the end of the file has been reached.
+ */
+SbgErrorCode sbgInterfaceFileWaitReadable(SbgInterface *pHandle, uint32 timeOut)
+{
+	//
+	// Test input parameters
+	//
+	if (pHandle)
+	{
+		//
+		// No data will ever be appended to the file
+		//
+		if (feof((FILE*)(pHandle->handle)))
+		{
+			sbgSleep(timeOut);
+			return SBG_TIME_OUT;
+		}
+
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
 /*!
  * Fake write function for read only interfaces
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -85,6 +85,15 @@ uint32 sbgInterfaceFileGetCursor(const SbgInterface *pHandle);
  */
 SbgErrorCode sbgInterfaceFileWrite(SbgInterface *pHandle, const void *pBuffer, uint32 bytesToWrite);
 
+/*!
+ * Try to write several buffers to an interface.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+SbgErrorCode sbgInterfaceFileWriteV(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers);
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -95,6 +104,16 @@ SbgErrorCode sbgInterfaceFileWrite(SbgInterface *pHandle, const void *pBuffer, u
  */
 SbgErrorCode sbgInterfaceFileRead(SbgInterface *pHandle, void *pBuffer, uint32 *pReadBytes, uint32 bytesToRead);
 
+/*!
+ * Wait until some data can be read from a file.
+ * A file can always be read until its end, once the end has been reached we just wait for the whole time out.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read.<br>
+ *														SBG_TIME_OUT if the end of the file has been reached.
+ */
+SbgErrorCode sbgInterfaceFileWaitReadable(SbgInterface *pHandle, uint32 timeOut);
+
 /*!
  * Fake write function for read only interfaces
  * \param[in]	pHandle									Valid handle on an initialized interface.
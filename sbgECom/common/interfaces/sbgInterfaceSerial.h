@@ -81,6 +81,26 @@ SbgErrorCode sbgInterfaceSerialChangeBaudrate(SbgInterface *pHandle, uint32 baud
  */
 SbgErrorCode sbgInterfaceSerialWrite(SbgInterface *pHandle, const void *pBuffer, uint32 bytesToWrite);
 
+#if !defined(WIN32) && !defined(WIN64)
+/*!
+ * Try to write several buffers to an interface using a single system call when possible (not available on Windows).
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+SbgErrorCode sbgInterfaceSerialWriteV(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers);
+
+/*!
+ * Block until some data can be read from the serial port or the time out expires (not available on Windows).
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read.<br>
+ *														SBG_TIME_OUT if no data has been received within the time out.
+ */
+SbgErrorCode sbgInterfaceSerialWaitReadable(SbgInterface *pHandle, uint32 timeOut);
+#endif
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -6,6 +6,8 @@
 #include <errno.h>
 #include <termios.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <poll.h>
 
 //----------------------------------------------------------------------//
 //- Private methods declarations                                       -//
@@ -163,6 +165,8 @@ SbgErrorCode sbgInterfaceSerialCreate(SbgInterface *pHandle, const char *deviceN
                                 pHandle->type = SBG_IF_TYPE_SERIAL;
                                 pHandle->pReadFunc = sbgInterfaceSerialRead;
                                 pHandle->pWriteFunc = sbgInterfaceSerialWrite;
+                                pHandle->pWriteVFunc = sbgInterfaceSerialWriteV;
+                                pHandle->pWaitReadableFunc = sbgInterfaceSerialWaitReadable;
                                 
                                 //
                                 // Purge the communication
@@ -411,6 +415,89 @@ SbgErrorCode sbgInterfaceSerialWrite(SbgInterface *pHandle, const void *pBuffer,
 	}
 }
 
+/*!
+ * Try to write several buffers to an interface using a single system call when possible.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+SbgErrorCode sbgInterfaceSerialWriteV(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers)
+{
+	struct iovec	ioVectors[SBG_INTERFACE_WRITEV_MAX_BUFFERS];
+	struct iovec	*pCurrentVector = ioVectors;
+	uint32			numVectorsLeft = 0;
+	ssize_t			numBytesWritten;
+	int32			hSerialHandle;
+	uint32			i;
+
+	//
+	// Test input parameters
+	//
+	if ( (pHandle) && (pBuffers) && (numBuffers <= SBG_INTERFACE_WRITEV_MAX_BUFFERS) )
+	{
+		//
+		// Get the internal serial handle
+		//
+		hSerialHandle = (int32)(intptr_t)pHandle->handle;
+
+		//
+		// Build the IO vectors and skip empty buffers
+		//
+		for (i = 0; i < numBuffers; i++)
+		{
+			if (pBuffers[i].size > 0)
+			{
+				ioVectors[numVectorsLeft].iov_base = (void*)pBuffers[i].pBuffer;
+				ioVectors[numVectorsLeft].iov_len = pBuffers[i].size;
+				numVectorsLeft++;
+			}
+		}
+
+		//
+		// Write all the buffers
+		//
+		while (numVectorsLeft > 0)
+		{
+			numBytesWritten = writev(hSerialHandle, pCurrentVector, numVectorsLeft);
+
+			//
+			// Test the there is no error
+			//
+			if (numBytesWritten == -1)
+			{
+				//
+				// An error has occured during the write
+				//
+				fprintf(stderr, "sbgInterfaceSerialWriteV: Unable to write to our device: %s\n", strerror(errno));
+				return SBG_WRITE_ERROR;
+			}
+
+			//
+			// Skip the buffers that have been fully written and update the partially written one
+			//
+			while ( (numVectorsLeft > 0) && ((size_t)numBytesWritten >= pCurrentVector->iov_len) )
+			{
+				numBytesWritten -= pCurrentVector->iov_len;
+				pCurrentVector++;
+				numVectorsLeft--;
+			}
+
+			if (numVectorsLeft > 0)
+			{
+				pCurrentVector->iov_base = (uint8*)pCurrentVector->iov_base + numBytesWritten;
+				pCurrentVector->iov_len -= numBytesWritten;
+			}
+		}
+
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -468,3 +555,64 @@ SbgErrorCode sbgInterfaceSerialRead(SbgInterface *pHandle, void *pBuffer, uint32
 	
 	return errorCode;
 }
+
+/*!
+ * Block until some data can be read from the serial port or the time out expires.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read.<br>
+ *														SBG_TIME_OUT if no data has been received within the time out.
+ */
+SbgErrorCode sbgInterfaceSerialWaitReadable(SbgInterface *pHandle, uint32 timeOut)
+{
+	struct pollfd	pollDescriptor;
+	int				retValue;
+	uint64			lastValidTime;
+	uint64			currentTime;
+
+	//
+	// Test input parameters
+	//
+	if (pHandle)
+	{
+		//
+		// Wait for the serial port to become readable
+		//
+		pollDescriptor.fd = (int32)(intptr_t)pHandle->handle;
+		pollDescriptor.events = POLLIN;
+		pollDescriptor.revents = 0;
+
+		lastValidTime = sbgGetTimeUs() + (uint64)timeOut * 1000;
+
+		retValue = poll(&pollDescriptor, 1, (int)timeOut);
+
+		//
+		// Wait again for the remaining time if a signal has interrupted the wait
+		//
+		while ( (retValue < 0) && (errno == EINTR) )
+		{
+			currentTime = sbgGetTimeUs();
+			timeOut = (lastValidTime > currentTime) ? (uint32)((lastValidTime - currentTime + 999) / 1000) : 0;
+
+			retValue = poll(&pollDescriptor, 1, (int)timeOut);
+		}
+
+		if (retValue > 0)
+		{
+			return SBG_NO_ERROR;
+		}
+		else if (retValue == 0)
+		{
+			return SBG_TIME_OUT;
+		}
+		else
+		{
+			fprintf(stderr, "sbgInterfaceSerialWaitReadable: Unable to wait for incoming data: %s\n", strerror(errno));
+			return SBG_READ_ERROR;
+		}
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
@@ -138,6 +138,8 @@ SbgErrorCode sbgInterfaceSerialCreate(SbgInterface *pHandle, const char *deviceN
 								pHandle->type = SBG_IF_TYPE_SERIAL;
 								pHandle->pReadFunc = sbgInterfaceSerialRead;
 								pHandle->pWriteFunc = sbgInterfaceSerialWrite;
+								pHandle->pWriteVFunc = NULL;
+								pHandle->pWaitReadableFunc = NULL;
 								
 								//
 								// Purge the communication
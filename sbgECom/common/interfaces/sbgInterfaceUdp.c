@@ -8,8 +8,11 @@
     #include <netinet/in.h>
     #include <sys/types.h>
     #include <sys/socket.h>
+    #include <sys/uio.h>
     #include <unistd.h>
     #include <fcntl.h>
+    #include <poll.h>
+    #include <errno.h>
 	
 	
 	#define SOCKADDR_IN    struct sockaddr_in
@@ -256,6 +259,12 @@ SbgErrorCode sbgInterfaceUdpCreate(SbgInterface *pHandle, sbgIpAddress outAddres
 										pHandle->type = SBG_IF_TYPE_ETH_UDP;
 										pHandle->pReadFunc = sbgInterfaceUdpRead;
 										pHandle->pWriteFunc = sbgInterfaceUdpWrite;
+#if defined (WIN32) || defined (WIN64)
+										pHandle->pWriteVFunc = NULL;
+#else
+										pHandle->pWriteVFunc = sbgInterfaceUdpWriteV;
+#endif
+										pHandle->pWaitReadableFunc = sbgInterfaceUdpWaitReadable;
 
 										//
 										// Return without any error
@@ -549,6 +558,134 @@ SbgErrorCode sbgInterfaceUdpWrite(SbgInterface *pHandle, const void *pBuffer, ui
 	return errorCode;
 }
 
+#if !defined(WIN32) && !defined(WIN64)
+/*!
+ * Try to write several buffers to an interface without concatenating them first.
+ * Datagrams are split exactly as sbgInterfaceUdpWrite would split the concatenated buffers.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+SbgErrorCode sbgInterfaceUdpWriteV(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+	SbgInterfaceUdp *pUdpHandle;
+	SOCKADDR_IN outAddr;
+	struct iovec ioVectors[SBG_INTERFACE_WRITEV_MAX_BUFFERS];
+	struct msghdr message;
+	ssize_t numBytesSent;
+	uint32 partialWriteSize;
+	uint32 bufferIndex = 0;
+	uint32 bufferOffset = 0;
+	uint32 chunkSize;
+	SOCKET udpSocket;
+
+	//
+	// First, test that we have a valid UDP interface
+	//
+	if ( (pHandle) && (pHandle->type == SBG_IF_TYPE_ETH_UDP) && (pBuffers) && (numBuffers <= SBG_INTERFACE_WRITEV_MAX_BUFFERS) )
+	{
+		//
+		// Get the UDP handle
+		//
+		pUdpHandle = (SbgInterfaceUdp*)pHandle->handle;
+
+		//
+		// Get the UDP socket
+		//
+		udpSocket = *((SOCKET*)pUdpHandle->pUdpSendSocket);
+
+		//
+		// Define the receiver address and port
+		//
+		memset(&outAddr, 0x00, sizeof(outAddr));
+		outAddr.sin_family = AF_INET;
+		outAddr.sin_addr.s_addr = htonl(pUdpHandle->outAddress);
+		outAddr.sin_port = htons((u_short)pUdpHandle->outPort);
+
+		memset(&message, 0x00, sizeof(message));
+		message.msg_name = &outAddr;
+		message.msg_namelen = sizeof(outAddr);
+		message.msg_iov = ioVectors;
+
+		//
+		// Send packets until all buffers have been sent
+		//
+		while (bufferIndex < numBuffers)
+		{
+			//
+			// Gather at most SBG_INTERFACE_UDP_PACKET_MAX_SIZE bytes in the next datagram
+			//
+			partialWriteSize = 0;
+			message.msg_iovlen = 0;
+
+			while ( (bufferIndex < numBuffers) && (partialWriteSize < SBG_INTERFACE_UDP_PACKET_MAX_SIZE) )
+			{
+				chunkSize = pBuffers[bufferIndex].size - bufferOffset;
+
+				if (chunkSize > SBG_INTERFACE_UDP_PACKET_MAX_SIZE - partialWriteSize)
+				{
+					chunkSize = SBG_INTERFACE_UDP_PACKET_MAX_SIZE - partialWriteSize;
+				}
+
+				if (chunkSize > 0)
+				{
+					ioVectors[message.msg_iovlen].iov_base = (uint8*)pBuffers[bufferIndex].pBuffer + bufferOffset;
+					ioVectors[message.msg_iovlen].iov_len = chunkSize;
+					message.msg_iovlen++;
+					partialWriteSize += chunkSize;
+					bufferOffset += chunkSize;
+				}
+
+				//
+				// Move to the next buffer once the current one has been fully gathered
+				//
+				if (bufferOffset == pBuffers[bufferIndex].size)
+				{
+					bufferIndex++;
+					bufferOffset = 0;
+				}
+			}
+
+			//
+			// Only empty buffers are left
+			//
+			if (partialWriteSize == 0)
+			{
+				break;
+			}
+
+			//
+			// Send the datagram to the receiver
+			//
+			numBytesSent = sendmsg(udpSocket, &message, 0);
+
+			//
+			// Test that all the bytes have been written
+			//
+			if ((uint32)numBytesSent != partialWriteSize)
+			{
+				//
+				// Unable to write some bytes
+				//
+				errorCode = SBG_WRITE_ERROR;
+				break;
+			}
+		}
+	}
+	else
+	{
+		//
+		// Interface not initialized
+		//
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+#endif
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -625,3 +762,87 @@ SbgErrorCode sbgInterfaceUdpRead(SbgInterface *pHandle, void *pBuffer, uint32 *p
 
 	return errorCode;
 }
+
+/*!
+ * Block until some data can be read from the UDP interface or the time out expires.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read.<br>
+ *														SBG_TIME_OUT if no data has been received within the time out.
+ */
+SbgErrorCode sbgInterfaceUdpWaitReadable(SbgInterface *pHandle, uint32 timeOut)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+	SbgInterfaceUdp *pUdpHandle;
+	int32 retValue;
+	SOCKET udpSocket;
+	 #if defined (WIN32) || defined (WIN64)
+	fd_set readSockets;
+	struct timeval selectTimeOut;
+	#else
+	struct pollfd pollDescriptor;
+	uint64 lastValidTime;
+	uint64 currentTime;
+	#endif
+
+	//
+	// First, test that we have a valid UDP interface
+	//
+	if ( (pHandle) && (pHandle->type == SBG_IF_TYPE_ETH_UDP) )
+	{
+		//
+		// Get the UDP handle and socket
+		//
+		pUdpHandle = (SbgInterfaceUdp*)pHandle->handle;
+		udpSocket = *((SOCKET*)pUdpHandle->pUdpRecvSocket);
+
+		 #if defined (WIN32) || defined (WIN64)
+		//
+		// Winsock only provides select on all supported Windows versions
+		//
+		FD_ZERO(&readSockets);
+		FD_SET(udpSocket, &readSockets);
+		selectTimeOut.tv_sec = timeOut / 1000;
+		selectTimeOut.tv_usec = (timeOut % 1000) * 1000;
+
+		retValue = select(0, &readSockets, NULL, NULL, &selectTimeOut);
+		#else
+		pollDescriptor.fd = udpSocket;
+		pollDescriptor.events = POLLIN;
+		pollDescriptor.revents = 0;
+
+		lastValidTime = sbgGetTimeUs() + (uint64)timeOut * 1000;
+
+		retValue = poll(&pollDescriptor, 1, (int)timeOut);
+
+		//
+		// Wait again for the remaining time if a signal has interrupted the wait
+		//
+		while ( (retValue == SOCKET_ERROR) && (errno == EINTR) )
+		{
+			currentTime = sbgGetTimeUs();
+			timeOut = (lastValidTime > currentTime) ? (uint32)((lastValidTime - currentTime + 999) / 1000) : 0;
+
+			retValue = poll(&pollDescriptor, 1, (int)timeOut);
+		}
+		#endif
+
+		if (retValue == 0)
+		{
+			errorCode = SBG_TIME_OUT;
+		}
+		else if (retValue == SOCKET_ERROR)
+		{
+			errorCode = SBG_ERROR;
+		}
+	}
+	else
+	{
+		//
+		// Interface not initialized
+		//
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
@@ -89,6 +89,17 @@ SbgErrorCode sbgInterfaceUdpDestroy(SbgInterface *pHandle);
  */
 SbgErrorCode sbgInterfaceUdpWrite(SbgInterface *pHandle, const void *pBuffer, uint32 bytesToWrite);
 
+#if !defined(WIN32) && !defined(WIN64)
+/*!
+ * Try to write several buffers to an interface without concatenating them first (not available on Windows).
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	pBuffers								Array of buffers to write.
+ * \param[in]	numBuffers								Number of buffers in the array (up to SBG_INTERFACE_WRITEV_MAX_BUFFERS).
+ * \return												SBG_NO_ERROR if all bytes have been written successfully.
+ */
+SbgErrorCode sbgInterfaceUdpWriteV(SbgInterface *pHandle, const SbgInterfaceBuffer *pBuffers, uint32 numBuffers);
+#endif
+
 /*!
  * Try to read some data from an interface.
  * \param[in]	pHandle									Valid handle on an initialized interface.
@@ -99,4 +110,13 @@ SbgErrorCode sbgInterfaceUdpWrite(SbgInterface *pHandle, const void *pBuffer, ui
  */
 SbgErrorCode sbgInterfaceUdpRead(SbgInterface *pHandle, void *pBuffer, uint32 *pReadBytes, uint32 bytesToRead);
 
+/*!
+ * Block until some data can be read from the UDP interface or the time out expires.
+ * \param[in]	pHandle									Valid handle on an initialized interface.
+ * \param[in]	timeOut									Maximum time to wait in ms.
+ * \return												SBG_NO_ERROR if some data can be read.<br>
+ *														SBG_TIME_OUT if no data has been received within the time out.
+ */
+SbgErrorCode sbgInterfaceUdpWaitReadable(SbgInterface *pHandle, uint32 timeOut);
+
 #endif /* __INTERFACE_UDP_H__ */
@@ -27,6 +27,16 @@
 //----------------------------------------------------------------------//
 #define SBG_CONFIG_UNALIGNED_ACCESS_AUTH			DISABLE					/*!< Set to ENABLE if the platform supports unaligned access */
 #define SBG_CONFIG_BIG_ENDIAN						DISABLE					/*!< Set to ENABLE if the platform byte order is big-endian */
+#define SBG_CONFIG_USE_SIMD							ENABLE					/*!< Set to ENABLE to use SSE2/AVX2 code paths when the compiler targets these instruction sets */
+
+/*!
+ *	Set to ENABLE to share an sbgECom handle between threads, for example to send commands while another thread handles
+ *	received logs, and to use the sbgEComReader thread. Locks and threads are then created using the sbgPlatform methods.
+ *	It can also be defined by the build system (-DSBG_CONFIG_MULTI_THREAD=ENABLE) but must be the same for the library and the application.
+ */
+#ifndef SBG_CONFIG_MULTI_THREAD
+	#define SBG_CONFIG_MULTI_THREAD					DISABLE
+#endif
 
 //----------------------------------------------------------------------//
 //- Debug / logging Configurations                                     -//
@@ -9,6 +9,10 @@
 	#include <windows.h>
 #else
 	#include <unistd.h>
+
+	#if SBG_CONFIG_MULTI_THREAD == ENABLE
+		#include <pthread.h>
+	#endif
 #endif
 
 //----------------------------------------------------------------------//
@@ -17,6 +21,7 @@
 
 /*!
  *	Returns the current time in ms.
+ *	This time is based on a monotonic clock and wraps around every 49 days, use sbgGetTimeUs to measure durations.
  *	\return				The current time in ms.
  */
 uint32 sbgGetTime(void)
@@ -24,7 +29,53 @@ uint32 sbgGetTime(void)
 	//
 	// Return the current time in ms
 	//
-	return clock() / (CLOCKS_PER_SEC / 1000);
+	return (uint32)(sbgGetMonotonicNs() / 1000000);
+}
+
+/*!
+ *	Returns the current time in us using a monotonic clock that isn't affected by system time changes.
+ *	\return				The current time in us.
+ */
+uint64 sbgGetTimeUs(void)
+{
+	//
+	// Return the current time in us
+	//
+	return sbgGetMonotonicNs() / 1000;
+}
+
+/*!
+ *	Returns the current time in ns using a monotonic clock that isn't affected by system time changes.
+ *	The origin is unspecified so only differences between two values should be used.
+ *	\return				The current time in ns.
+ */
+uint64 sbgGetMonotonicNs(void)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	static LARGE_INTEGER	frequency = { 0 };
+	LARGE_INTEGER			counter;
+
+	//
+	// The performance counter frequency is fixed at system boot so only query it once
+	//
+	if (frequency.QuadPart == 0)
+	{
+		QueryPerformanceFrequency(&frequency);
+	}
+
+	QueryPerformanceCounter(&counter);
+
+	//
+	// Split the conversion to avoid overflowing 64 bits
+	//
+	return (uint64)(counter.QuadPart / frequency.QuadPart) * 1000000000ull + (uint64)(counter.QuadPart % frequency.QuadPart) * 1000000000ull / (uint64)frequency.QuadPart;
+	#else
+	struct timespec			currentTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+	return (uint64)currentTime.tv_sec * 1000000000ull + (uint64)currentTime.tv_nsec;
+	#endif
 }
 
 /*!
@@ -43,6 +94,317 @@ void sbgSleep(uint32 ms)
 	#endif
 }
 
+//----------------------------------------------------------------------//
+//- Threads and locks methods to reimplement for your platform         -//
+//----------------------------------------------------------------------//
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+
+#if defined (WIN32) || defined (WIN64)
+struct _SbgPlatformMutex
+{
+	SRWLOCK					 lock;
+};
+
+struct _SbgPlatformCond
+{
+	CONDITION_VARIABLE		 cond;
+};
+
+struct _SbgPlatformThread
+{
+	HANDLE					 thread;
+	SbgPlatformThreadFunc	 pFunc;
+	void					*pArg;
+};
+#else
+struct _SbgPlatformMutex
+{
+	pthread_mutex_t			 mutex;
+};
+
+struct _SbgPlatformCond
+{
+	pthread_cond_t			 cond;
+};
+
+struct _SbgPlatformThread
+{
+	pthread_t				 thread;
+	SbgPlatformThreadFunc	 pFunc;
+	void					*pArg;
+};
+
+//
+// Identifiers are given to the threads the first time they ask for it, 0 means no identifier yet
+//
+static SBG_THREAD_LOCAL uint32	gThreadId = 0;
+static uint32					gLastThreadId = 0;
+#endif
+
+/*!
+ *	Create a mutex.
+ *	\return				The created mutex or NULL if it couldn't be created.
+ */
+SbgPlatformMutex *sbgPlatformMutexCreate(void)
+{
+	SbgPlatformMutex	*pMutex;
+
+	pMutex = (SbgPlatformMutex*)malloc(sizeof(SbgPlatformMutex));
+
+	if (pMutex)
+	{
+	 #if defined (WIN32) || defined (WIN64)
+		InitializeSRWLock(&pMutex->lock);
+	#else
+		pthread_mutex_init(&pMutex->mutex, NULL);
+	#endif
+	}
+
+	return pMutex;
+}
+
+/*!
+ *	Destroy a mutex that isn't locked anymore.
+ *	\param[in]	pMutex	Mutex to destroy, can be NULL.
+ */
+void sbgPlatformMutexDestroy(SbgPlatformMutex *pMutex)
+{
+	if (pMutex)
+	{
+	 #if !defined (WIN32) && !defined (WIN64)
+		pthread_mutex_destroy(&pMutex->mutex);
+	#endif
+		free(pMutex);
+	}
+}
+
+/*!
+ *	Lock a mutex, waiting as long as needed.
+ *	\param[in]	pMutex	Mutex to lock.
+ */
+void sbgPlatformMutexLock(SbgPlatformMutex *pMutex)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	AcquireSRWLockExclusive(&pMutex->lock);
+	#else
+	pthread_mutex_lock(&pMutex->mutex);
+	#endif
+}
+
+/*!
+ *	Try to lock a mutex without waiting.
+ *	\param[in]	pMutex	Mutex to lock.
+ *	\return				TRUE if the mutex has been locked.
+ */
+bool sbgPlatformMutexTryLock(SbgPlatformMutex *pMutex)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	return TryAcquireSRWLockExclusive(&pMutex->lock) ? TRUE : FALSE;
+	#else
+	return (pthread_mutex_trylock(&pMutex->mutex) == 0) ? TRUE : FALSE;
+	#endif
+}
+
+/*!
+ *	Unlock a mutex locked by the calling thread.
+ *	\param[in]	pMutex	Mutex to unlock.
+ */
+void sbgPlatformMutexUnlock(SbgPlatformMutex *pMutex)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	ReleaseSRWLockExclusive(&pMutex->lock);
+	#else
+	pthread_mutex_unlock(&pMutex->mutex);
+	#endif
+}
+
+/*!
+ *	Create a condition variable.
+ *	\return				The created condition variable or NULL if it couldn't be created.
+ */
+SbgPlatformCond *sbgPlatformCondCreate(void)
+{
+	SbgPlatformCond		*pCond;
+	 #if !defined (WIN32) && !defined (WIN64)
+	pthread_condattr_t	 condAttr;
+	#endif
+
+	pCond = (SbgPlatformCond*)malloc(sizeof(SbgPlatformCond));
+
+	if (pCond)
+	{
+	 #if defined (WIN32) || defined (WIN64)
+		InitializeConditionVariable(&pCond->cond);
+	#else
+		//
+		// The condition uses the monotonic clock so the wait isn't affected by system time changes
+		//
+		pthread_condattr_init(&condAttr);
+		pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+		pthread_cond_init(&pCond->cond, &condAttr);
+		pthread_condattr_destroy(&condAttr);
+	#endif
+	}
+
+	return pCond;
+}
+
+/*!
+ *	Destroy a condition variable nobody waits for anymore.
+ *	\param[in]	pCond	Condition variable to destroy, can be NULL.
+ */
+void sbgPlatformCondDestroy(SbgPlatformCond *pCond)
+{
+	if (pCond)
+	{
+	 #if !defined (WIN32) && !defined (WIN64)
+		pthread_cond_destroy(&pCond->cond);
+	#endif
+		free(pCond);
+	}
+}
+
+/*!
+ *	Atomically unlock a mutex and wait until the condition is signaled or the time out expires, the mutex is locked again on return.
+ *	Spurious wake ups are allowed so the caller should check its condition again.
+ *	\param[in]	pCond	Condition variable to wait for.
+ *	\param[in]	pMutex	Mutex locked by the calling thread.
+ *	\param[in]	timeOut	Maximum time to wait in ms, measured with a monotonic clock.
+ */
+void sbgPlatformCondWait(SbgPlatformCond *pCond, SbgPlatformMutex *pMutex, uint32 timeOut)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	SleepConditionVariableSRW(&pCond->cond, &pMutex->lock, timeOut, 0);
+	#else
+	struct timespec		deadline;
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += timeOut / 1000;
+	deadline.tv_nsec += (long)(timeOut % 1000) * 1000000;
+
+	if (deadline.tv_nsec >= 1000000000)
+	{
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000;
+	}
+
+	pthread_cond_timedwait(&pCond->cond, &pMutex->mutex, &deadline);
+	#endif
+}
+
+/*!
+ *	Wake up all the threads waiting for a condition variable.
+ *	\param[in]	pCond	Condition variable to signal.
+ */
+void sbgPlatformCondBroadcast(SbgPlatformCond *pCond)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	WakeAllConditionVariable(&pCond->cond);
+	#else
+	pthread_cond_broadcast(&pCond->cond);
+	#endif
+}
+
+#if defined (WIN32) || defined (WIN64)
+/*!
+ *	Native thread entry point that calls the user one.
+ *	\param[in]	pArg	The thread object.
+ *	\return				Always 0.
+ */
+static DWORD WINAPI sbgPlatformThreadEntry(LPVOID pArg)
+{
+	SbgPlatformThread	*pThread = (SbgPlatformThread*)pArg;
+
+	pThread->pFunc(pThread->pArg);
+
+	return 0;
+}
+#else
+/*!
+ *	Native thread entry point that calls the user one.
+ *	\param[in]	pArg	The thread object.
+ *	\return				Always NULL.
+ */
+static void *sbgPlatformThreadEntry(void *pArg)
+{
+	SbgPlatformThread	*pThread = (SbgPlatformThread*)pArg;
+
+	pThread->pFunc(pThread->pArg);
+
+	return NULL;
+}
+#endif
+
+/*!
+ *	Create and start a thread.
+ *	\param[in]	pFunc	Thread entry point.
+ *	\param[in]	pArg	User argument given to the entry point.
+ *	\return				The created thread or NULL if it couldn't be created.
+ */
+SbgPlatformThread *sbgPlatformThreadCreate(SbgPlatformThreadFunc pFunc, void *pArg)
+{
+	SbgPlatformThread	*pThread;
+
+	pThread = (SbgPlatformThread*)malloc(sizeof(SbgPlatformThread));
+
+	if (pThread)
+	{
+		pThread->pFunc = pFunc;
+		pThread->pArg = pArg;
+
+	 #if defined (WIN32) || defined (WIN64)
+		pThread->thread = CreateThread(NULL, 0, sbgPlatformThreadEntry, pThread, 0, NULL);
+
+		if (pThread->thread == NULL)
+	#else
+		if (pthread_create(&pThread->thread, NULL, sbgPlatformThreadEntry, pThread) != 0)
+	#endif
+		{
+			free(pThread);
+			pThread = NULL;
+		}
+	}
+
+	return pThread;
+}
+
+/*!
+ *	Wait until a thread has exited and release it.
+ *	\param[in]	pThread	Thread to join.
+ */
+void sbgPlatformThreadJoin(SbgPlatformThread *pThread)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	WaitForSingleObject(pThread->thread, INFINITE);
+	CloseHandle(pThread->thread);
+	#else
+	pthread_join(pThread->thread, NULL);
+	#endif
+
+	free(pThread);
+}
+
+/*!
+ *	Returns an identifier of the calling thread, unique among the running threads.
+ *	\return				Non zero identifier of the calling thread.
+ */
+uint32 sbgPlatformGetThreadId(void)
+{
+	 #if defined (WIN32) || defined (WIN64)
+	return (uint32)GetCurrentThreadId();
+	#else
+	if (gThreadId == 0)
+	{
+		gThreadId = __atomic_add_fetch(&gLastThreadId, 1, __ATOMIC_RELAXED);
+	}
+
+	return gThreadId;
+	#endif
+}
+
+#endif
+
 //----------------------------------------------------------------------//
 //- Specific logging methods to reimplement for your platform          -//
 //----------------------------------------------------------------------//
@@ -28,6 +28,8 @@
 #include "../sbgTypes.h"
 #include "../sbgErrorCodes.h"
 #include "../sbgDebug.h"
+#include "../sbgDefines.h"
+#include "sbgConfig.h"
 
 //----------------------------------------------------------------------//
 //- Add here any additional includes you want to share                 -//
@@ -47,16 +49,191 @@
 
 /*!
  *	Returns the current time in ms.
+ *	This time is based on a monotonic clock and wraps around every 49 days, use sbgGetTimeUs to measure durations.
  *	\return				The current time in ms.
  */
 uint32 sbgGetTime(void);
 
+/*!
+ *	Returns the current time in us using a monotonic clock that isn't affected by system time changes.
+ *	\return				The current time in us.
+ */
+uint64 sbgGetTimeUs(void);
+
+/*!
+ *	Returns the current time in ns using a monotonic clock that isn't affected by system time changes.
+ *	The origin is unspecified so only differences between two values should be used.
+ *	\return				The current time in ns.
+ */
+uint64 sbgGetMonotonicNs(void);
+
 /*!
  *	Sleep for the specified number of ms.
  *	\param[in]	ms		Number of millisecondes to wait.
  */
 void sbgSleep(uint32 ms);
 
+//----------------------------------------------------------------------//
+//- Threads and locks methods to reimplement for your platform         -//
+//----------------------------------------------------------------------//
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+
+//
+// Opaque objects allocated by the platform, they are only used through the methods below.
+//
+typedef struct _SbgPlatformMutex	SbgPlatformMutex;			/*!< Non recursive mutex. */
+typedef struct _SbgPlatformCond		SbgPlatformCond;			/*!< Condition variable used with a SbgPlatformMutex. */
+typedef struct _SbgPlatformThread	SbgPlatformThread;			/*!< Joinable thread. */
+
+/*!
+ *	Thread entry point.
+ *	\param[in]	pArg			User argument given to sbgPlatformThreadCreate.
+ */
+typedef void (*SbgPlatformThreadFunc)(void *pArg);
+
+/*!
+ *	Create a mutex.
+ *	\return				The created mutex or NULL if it couldn't be created.
+ */
+SbgPlatformMutex *sbgPlatformMutexCreate(void);
+
+/*!
+ *	Destroy a mutex that isn't locked anymore.
+ *	\param[in]	pMutex	Mutex to destroy, can be NULL.
+ */
+void sbgPlatformMutexDestroy(SbgPlatformMutex *pMutex);
+
+/*!
+ *	Lock a mutex, waiting as long as needed.
+ *	\param[in]	pMutex	Mutex to lock.
+ */
+void sbgPlatformMutexLock(SbgPlatformMutex *pMutex);
+
+/*!
+ *	Try to lock a mutex without waiting.
+ *	\param[in]	pMutex	Mutex to lock.
+ *	\return				TRUE if the mutex has been locked.
+ */
+bool sbgPlatformMutexTryLock(SbgPlatformMutex *pMutex);
+
+/*!
+ *	Unlock a mutex locked by the calling thread.
+ *	\param[in]	pMutex	Mutex to unlock.
+ */
+void sbgPlatformMutexUnlock(SbgPlatformMutex *pMutex);
+
+/*!
+ *	Create a condition variable.
+ *	\return				The created condition variable or NULL if it couldn't be created.
+ */
+SbgPlatformCond *sbgPlatformCondCreate(void);
+
+/*!
+ *	Destroy a condition variable nobody waits for anymore.
+ *	\param[in]	pCond	Condition variable to destroy, can be NULL.
+ */
+void sbgPlatformCondDestroy(SbgPlatformCond *pCond);
+
+/*!
+ *	Atomically unlock a mutex and wait until the condition is signaled or the time out expires, the mutex is locked again on return.
+ *	Spurious wake ups are allowed so the caller should check its condition again.
+ *	\param[in]	pCond	Condition variable to wait for.
+ *	\param[in]	pMutex	Mutex locked by the calling thread.
+ *	\param[in]	timeOut	Maximum time to wait in ms, measured with a monotonic clock.
+ */
+void sbgPlatformCondWait(SbgPlatformCond *pCond, SbgPlatformMutex *pMutex, uint32 timeOut);
+
+/*!
+ *	Wake up all the threads waiting for a condition variable.
+ *	\param[in]	pCond	Condition variable to signal.
+ */
+void sbgPlatformCondBroadcast(SbgPlatformCond *pCond);
+
+/*!
+ *	Create and start a thread.
+ *	\param[in]	pFunc	Thread entry point.
+ *	\param[in]	pArg	User argument given to the entry point.
+ *	\return				The created thread or NULL if it couldn't be created.
+ */
+SbgPlatformThread *sbgPlatformThreadCreate(SbgPlatformThreadFunc pFunc, void *pArg);
+
+/*!
+ *	Wait until a thread has exited and release it.
+ *	\param[in]	pThread	Thread to join.
+ */
+void sbgPlatformThreadJoin(SbgPlatformThread *pThread);
+
+/*!
+ *	Returns an identifier of the calling thread, unique among the running threads.
+ *	\return				Non zero identifier of the calling thread.
+ */
+uint32 sbgPlatformGetThreadId(void);
+
+#endif
+
+//----------------------------------------------------------------------//
+//- Atomic operations to reimplement for your platform                 -//
+//----------------------------------------------------------------------//
+
+//
+// Used to share indexes between threads without locks, variables should be declared as volatile uint32.
+// With MSVC, the accesses use __iso_volatile_load32 / __iso_volatile_store32 so they don't depend on /volatile:ms.
+// x86 / x64 are strongly ordered and only need a compiler barrier, ARM needs a dmb instruction.
+//
+#if defined (_MSC_VER)
+	#include <intrin.h>
+
+	#if defined (_M_ARM64)
+		#define SBG_ATOMIC_FENCE_ACQUIRE()				__dmb(_ARM64_BARRIER_ISH)		/*!< Following memory accesses can't be moved before previous loads. */
+		#define SBG_ATOMIC_FENCE_RELEASE()				__dmb(_ARM64_BARRIER_ISH)		/*!< Previous memory accesses can't be moved after following stores. */
+	#elif defined (_M_ARM)
+		#define SBG_ATOMIC_FENCE_ACQUIRE()				__dmb(_ARM_BARRIER_ISH)			/*!< Following memory accesses can't be moved before previous loads. */
+		#define SBG_ATOMIC_FENCE_RELEASE()				__dmb(_ARM_BARRIER_ISH)			/*!< Previous memory accesses can't be moved after following stores. */
+	#else
+		#define SBG_ATOMIC_FENCE_ACQUIRE()				_ReadWriteBarrier()				/*!< Following memory accesses can't be moved before previous loads. */
+		#define SBG_ATOMIC_FENCE_RELEASE()				_ReadWriteBarrier()				/*!< Previous memory accesses can't be moved after following stores. */
+	#endif
+
+	/*!
+	 *	Read a shared 32 bits variable with acquire semantics.
+	 *	\param[in]	pVar							Variable to read.
+	 *	\return										The variable value.
+	 */
+	static __forceinline uint32 sbgAtomicLoadAcquire32(const volatile uint32 *pVar)
+	{
+		uint32	value;
+
+		value = (uint32)__iso_volatile_load32((const volatile __int32*)pVar);
+		SBG_ATOMIC_FENCE_ACQUIRE();
+
+		return value;
+	}
+
+	/*!
+	 *	Write a shared 32 bits variable with release semantics.
+	 *	\param[in]	pVar							Variable to write.
+	 *	\param[in]	value							Value to write.
+	 */
+	static __forceinline void sbgAtomicStoreRelease32(volatile uint32 *pVar, uint32 value)
+	{
+		SBG_ATOMIC_FENCE_RELEASE();
+		__iso_volatile_store32((volatile __int32*)pVar, (__int32)value);
+	}
+
+	#define SBG_ATOMIC_LOAD_ACQUIRE(var)				sbgAtomicLoadAcquire32(&(var))					/*!< Read a shared variable, following memory accesses can't be moved before it. */
+	#define SBG_ATOMIC_STORE_RELEASE(var, value)		sbgAtomicStoreRelease32(&(var), (value))		/*!< Write a shared variable, previous memory accesses can't be moved after it. */
+	#define SBG_ATOMIC_LOAD_RELAXED(var)				((uint32)__iso_volatile_load32((const volatile __int32*)&(var)))	/*!< Read a shared variable without any ordering constraint. */
+	#define SBG_ATOMIC_STORE_RELAXED(var, value)		__iso_volatile_store32((volatile __int32*)&(var), (__int32)(value))	/*!< Write a shared variable without any ordering constraint. */
+#else
+	#define SBG_ATOMIC_LOAD_ACQUIRE(var)				__atomic_load_n(&(var), __ATOMIC_ACQUIRE)		/*!< Read a shared variable, following memory accesses can't be moved before it. */
+	#define SBG_ATOMIC_STORE_RELEASE(var, value)		__atomic_store_n(&(var), (value), __ATOMIC_RELEASE)	/*!< Write a shared variable, previous memory accesses can't be moved after it. */
+	#define SBG_ATOMIC_FENCE_ACQUIRE()					__atomic_thread_fence(__ATOMIC_ACQUIRE)			/*!< Following memory accesses can't be moved before previous loads. */
+	#define SBG_ATOMIC_FENCE_RELEASE()					__atomic_thread_fence(__ATOMIC_RELEASE)			/*!< Previous memory accesses can't be moved after following stores. */
+	#define SBG_ATOMIC_LOAD_RELAXED(var)				__atomic_load_n(&(var), __ATOMIC_RELAXED)		/*!< Read a shared variable without any ordering constraint. */
+	#define SBG_ATOMIC_STORE_RELAXED(var, value)		__atomic_store_n(&(var), (value), __ATOMIC_RELAXED)	/*!< Write a shared variable without any ordering constraint. */
+#endif
+
 //----------------------------------------------------------------------//
 //- Specific logging methods to reimplement for your platform          -//
 //----------------------------------------------------------------------//
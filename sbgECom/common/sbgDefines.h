@@ -82,6 +82,17 @@
 	#endif
 #endif
 
+/*!
+ *	Macro used to abstract the compiler specific thread local storage keyword.
+ */
+#ifndef SBG_THREAD_LOCAL
+	#if defined (_MSC_VER)
+		#define SBG_THREAD_LOCAL	__declspec(thread)
+	#else
+		#define SBG_THREAD_LOCAL	__thread
+	#endif
+#endif
+
 /*!
  *	Macro used to avoid compiler warning when a variable is not used.
  */
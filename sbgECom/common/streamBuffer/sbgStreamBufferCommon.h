@@ -282,7 +282,7 @@ SBG_INLINE uint32 sbgStreamBufferGetLength(SbgStreamBuffer *pHandle)
 	//
 	// Return the number of bytes between the begin of the stream and the current pointer
 	//
-	return ((uint32)pHandle->pCurrentPtr - (uint32)pHandle->pBufferPtr);
+	return (uint32)(pHandle->pCurrentPtr - pHandle->pBufferPtr);
 }
 
 /*!
@@ -398,7 +398,7 @@ SBG_INLINE uint32 sbgStreamBufferTell(SbgStreamBuffer *pHandle)
 	//
 	SBG_ASSERT(pHandle, "Invalid input parameters");
 
-	return (uint32)pHandle->pCurrentPtr - (uint32)pHandle->pBufferPtr;
+	return (uint32)(pHandle->pCurrentPtr - pHandle->pBufferPtr);
 }
 
 /*!
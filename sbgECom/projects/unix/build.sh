@@ -1,8 +1,10 @@
 #!/bin/sh
 # This script is used to build the sbgCom library on unix systems.
+# Extra GCC options can be given, for example to build the multi-thread version:
+# ./build.sh -DSBG_CONFIG_MULTI_THREAD=ENABLE
 
 # Define the GCC options according to the selected endianness
-gccOptions="-I ../../common/ -c -Wall "
+gccOptions="-I ../../common/ -c -Wall $*"
 
 # Create the intermediate directory		
 mkdir obj
@@ -51,6 +53,10 @@ gcc $gccOptions ../../src/protocol/sbgEComProtocol.c -o obj/sbgEComProtocol.o
 
 # Create all objets for the root directory
 gcc $gccOptions ../../src/sbgECom.c -o obj/sbgECom.o
+gcc $gccOptions ../../src/sbgEComReader.c -o obj/sbgEComReader.o
+gcc $gccOptions ../../src/sbgEComBroadcast.c -o obj/sbgEComBroadcast.o
+gcc $gccOptions ../../src/sbgEComLatency.c -o obj/sbgEComLatency.o
+gcc $gccOptions ../../src/sbgEComLogBatch.c -o obj/sbgEComLogBatch.o
 
 # Create the library
-ar cr ../../libSbgECom.a obj/sbgCrc.o obj/sbgInterfaceFile.o obj/sbgInterfaceSerialUnix.o obj/sbgInterfaceUdp.o obj/sbgPlatform.o obj/sbgEComBinaryLogDebug.o obj/sbgEComBinaryLogDvl.o obj/sbgEComBinaryLogEkf.o obj/sbgEComBinaryLogEvent.o obj/sbgEComBinaryLogGps.o obj/sbgEComBinaryLogImu.o obj/sbgEComBinaryLogMag.o obj/sbgEComBinaryLogOdometer.o obj/sbgEComBinaryLogPressure.o obj/sbgEComBinaryLogs.o obj/sbgEComBinaryLogShipMotion.o obj/sbgEComBinaryLogStatus.o obj/sbgEComBinaryLogUsbl.o obj/sbgEComBinaryLogUtc.o obj/sbgEComCmdAdvanced.o obj/sbgEComCmdCommon.o obj/sbgEComCmdEvent.o obj/sbgEComCmdFeatures.o obj/sbgEComCmdGnss.o obj/sbgEComCmdInfo.o obj/sbgEComCmdInterface.o obj/sbgEComCmdLicense.o obj/sbgEComCmdMag.o obj/sbgEComCmdOdo.o obj/sbgEComCmdOutput.o obj/sbgEComCmdSensor.o obj/sbgEComCmdSettings.o obj/sbgEComTransfer.o obj/sbgEComProtocol.o obj/sbgECom.o
\ No newline at end of file
+ar cr ../../libSbgECom.a obj/sbgCrc.o obj/sbgInterfaceFile.o obj/sbgInterfaceSerialUnix.o obj/sbgInterfaceUdp.o obj/sbgPlatform.o obj/sbgEComBinaryLogDebug.o obj/sbgEComBinaryLogDvl.o obj/sbgEComBinaryLogEkf.o obj/sbgEComBinaryLogEvent.o obj/sbgEComBinaryLogGps.o obj/sbgEComBinaryLogImu.o obj/sbgEComBinaryLogMag.o obj/sbgEComBinaryLogOdometer.o obj/sbgEComBinaryLogPressure.o obj/sbgEComBinaryLogs.o obj/sbgEComBinaryLogShipMotion.o obj/sbgEComBinaryLogStatus.o obj/sbgEComBinaryLogUsbl.o obj/sbgEComBinaryLogUtc.o obj/sbgEComCmdAdvanced.o obj/sbgEComCmdCommon.o obj/sbgEComCmdEvent.o obj/sbgEComCmdFeatures.o obj/sbgEComCmdGnss.o obj/sbgEComCmdInfo.o obj/sbgEComCmdInterface.o obj/sbgEComCmdLicense.o obj/sbgEComCmdMag.o obj/sbgEComCmdOdo.o obj/sbgEComCmdOutput.o obj/sbgEComCmdSensor.o obj/sbgEComCmdSettings.o obj/sbgEComTransfer.o obj/sbgEComProtocol.o obj/sbgECom.o obj/sbgEComReader.o obj/sbgEComBroadcast.o obj/sbgEComLatency.o obj/sbgEComLogBatch.o
\ No newline at end of file
@@ -1,5 +1,22 @@
 #include "sbgEComBinaryLogDebug.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_DEBUG_0 message.
+ */
+#define SBG_ECOM_LOG_DEBUG_0_FIELDS(FIELD, OPTIONAL_FIELD)		\
+	FIELD(SbgLogDebug0Data,	timeStamp,	0,	Uint32,	1)			\
+	FIELD(SbgLogDebug0Data,	data[0],	4,	Float,	64)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_DEBUG_0 message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_DEBUG_0_FIELDS, SbgLogDebug0Data)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_DEBUG_0_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,30 +27,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseDebug0Data(const void *pPayload, uint32 payloadSize, SbgLogDebug0Data *pOutputData)
 {
-	SbgStreamBuffer	inputStream;
-	uint32			i;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-	//
-	// Read the frame payload and return
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-
-	//
-	// Read each value in the array
-	//
-	for (i = 0; i < 64; i++)
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_DEBUG_0_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_DEBUG_0_FIELDS)
+	}
+	else
 	{
-		pOutputData->data[i] = sbgStreamBufferReadFloatLE(&inputStream);
+		errorCode = SBG_INVALID_FRAME;
 	}
 
-	return SBG_NO_ERROR;
+	return errorCode;
 }
@@ -45,7 +45,8 @@ typedef struct _SbgLogDebug0
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseDebug0Data(const void *pPayload, uint32 payloadSize, SbgLogDebug0Data *pOutputData);
 
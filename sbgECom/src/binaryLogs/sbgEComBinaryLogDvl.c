@@ -1,5 +1,24 @@
 #include "sbgEComBinaryLogDvl.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_DVL_# message.
+ */
+#define SBG_ECOM_LOG_DVL_FIELDS(FIELD, OPTIONAL_FIELD)				\
+	FIELD(SbgLogDvlData,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogDvlData,	status,				4,	Uint16,	1)		\
+	FIELD(SbgLogDvlData,	velocity[0],		6,	Float,	3)		\
+	FIELD(SbgLogDvlData,	velocityStdDev[0],	18,	Float,	3)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_DVL_# message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_DVL_FIELDS, SbgLogDvlData)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_DVL_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,33 +29,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseDvlData(const void *pPayload, uint32 payloadSize, SbgLogDvlData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
-
-	//
-	// Create an input stream to read the payload
-	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Read the frame payload
+	// Check once that the payload contains all the required fields
 	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status = sbgStreamBufferReadUint16LE(&inputStream);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_DVL_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_DVL_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	pOutputData->velocity[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocity[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocity[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->velocityStdDev[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocityStdDev[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocityStdDev[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
@@ -56,7 +56,8 @@ typedef struct _SbgLogDvlData
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseDvlData(const void *pPayload, uint32 payloadSize, SbgLogDvlData *pOutputData);
 
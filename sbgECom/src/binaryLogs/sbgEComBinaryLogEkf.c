@@ -1,5 +1,24 @@
 #include "sbgEComBinaryLogEkf.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas checks                                                 -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check the offset of each field of the SBG_ECOM_LOG_EKF_EULER message.
+ */
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_EKF_EULER_FIELDS)
+
+/*!
+ * Check the offset of each field of the SBG_ECOM_LOG_EKF_QUAT message.
+ */
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_EKF_QUAT_FIELDS)
+
+/*!
+ * Check the offset of each field of the SBG_ECOM_LOG_EKF_NAV message.
+ */
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_EKF_NAV_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,36 +29,27 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseEkfEulerData(const void *pPayload, uint32 payloadSize, SbgLogEkfEulerData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
-
-	//
-	// Create an input stream to read the payload
-	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Read the frame payload
+	// Check once that the payload contains all the required fields
 	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_EKF_EULER_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_EKF_EULER_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	pOutputData->euler[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->euler[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->euler[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->eulerStdDev[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->eulerStdDev[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->eulerStdDev[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->status			= sbgStreamBufferReadUint32LE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
 
 /*!
@@ -47,37 +57,27 @@ SbgErrorCode sbgEComBinaryLogParseEkfEulerData(const void *pPayload, uint32 payl
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseEkfQuatData(const void *pPayload, uint32 payloadSize, SbgLogEkfQuatData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_EKF_QUAT_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_EKF_QUAT_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-
-	pOutputData->quaternion[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->quaternion[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->quaternion[2] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->quaternion[3] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->eulerStdDev[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->eulerStdDev[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->eulerStdDev[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->status			= sbgStreamBufferReadUint32LE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
 
 /*!
@@ -85,44 +85,25 @@ SbgErrorCode sbgEComBinaryLogParseEkfQuatData(const void *pPayload, uint32 paylo
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseEkfNavData(const void *pPayload, uint32 payloadSize, SbgLogEkfNavData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_EKF_NAV_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_EKF_NAV_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-
-	pOutputData->velocity[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocity[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocity[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->velocityStdDev[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocityStdDev[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocityStdDev[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->position[0] = sbgStreamBufferReadDoubleLE(&inputStream);
-	pOutputData->position[1] = sbgStreamBufferReadDoubleLE(&inputStream);
-	pOutputData->position[2] = sbgStreamBufferReadDoubleLE(&inputStream);
-
-	pOutputData->undulation = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->positionStdDev[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->positionStdDev[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->positionStdDev[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->status			= sbgStreamBufferReadUint32LE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
@@ -21,6 +21,7 @@
 #define __SBG_ECOM_BINARY_LOG_EKF_H__
 
 #include <sbgCommon.h>
+#include "sbgEComBinaryLogSchema.h"
 
 //----------------------------------------------------------------------//
 //- Solution status definitions                                        -//
@@ -141,6 +142,55 @@ typedef struct _SbgLogEkfNavData
 	uint32	status;					/*!< EKF solution status bitmask and enum. */
 } SbgLogEkfNavData;
 
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_EKF_EULER message.
+ */
+#define SBG_ECOM_LOG_EKF_EULER_FIELDS(FIELD, OPTIONAL_FIELD)			\
+	FIELD(SbgLogEkfEulerData,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogEkfEulerData,	euler[0],			4,	Float,	3)		\
+	FIELD(SbgLogEkfEulerData,	eulerStdDev[0],		16,	Float,	3)		\
+	FIELD(SbgLogEkfEulerData,	status,				28,	Uint32,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_EKF_EULER message.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_EKF_EULER_FIELDS, SbgLogEkfEulerData)
+
+/*!
+ * Fields of the SBG_ECOM_LOG_EKF_QUAT message.
+ */
+#define SBG_ECOM_LOG_EKF_QUAT_FIELDS(FIELD, OPTIONAL_FIELD)				\
+	FIELD(SbgLogEkfQuatData,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogEkfQuatData,	quaternion[0],		4,	Float,	4)		\
+	FIELD(SbgLogEkfQuatData,	eulerStdDev[0],		20,	Float,	3)		\
+	FIELD(SbgLogEkfQuatData,	status,				32,	Uint32,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_EKF_QUAT message.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_EKF_QUAT_FIELDS, SbgLogEkfQuatData)
+
+/*!
+ * Fields of the SBG_ECOM_LOG_EKF_NAV message.
+ */
+#define SBG_ECOM_LOG_EKF_NAV_FIELDS(FIELD, OPTIONAL_FIELD)			\
+	FIELD(SbgLogEkfNavData,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogEkfNavData,	velocity[0],		4,	Float,	3)		\
+	FIELD(SbgLogEkfNavData,	velocityStdDev[0],	16,	Float,	3)		\
+	FIELD(SbgLogEkfNavData,	position[0],		28,	Double,	3)		\
+	FIELD(SbgLogEkfNavData,	undulation,			52,	Float,	1)		\
+	FIELD(SbgLogEkfNavData,	positionStdDev[0],	56,	Float,	3)		\
+	FIELD(SbgLogEkfNavData,	status,				68,	Uint32,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_EKF_NAV message.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_EKF_NAV_FIELDS, SbgLogEkfNavData)
+
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
 //----------------------------------------------------------------------//
@@ -150,7 +200,8 @@ typedef struct _SbgLogEkfNavData
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseEkfEulerData(const void *pPayload, uint32 payloadSize, SbgLogEkfEulerData *pOutputData);
 
@@ -159,7 +210,8 @@ SbgErrorCode sbgEComBinaryLogParseEkfEulerData(const void *pPayload, uint32 payl
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseEkfQuatData(const void *pPayload, uint32 payloadSize, SbgLogEkfQuatData *pOutputData);
 
@@ -168,8 +220,169 @@ SbgErrorCode sbgEComBinaryLogParseEkfQuatData(const void *pPayload, uint32 paylo
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseEkfNavData(const void *pPayload, uint32 payloadSize, SbgLogEkfNavData *pOutputData);
 
+//----------------------------------------------------------------------//
+//- Lazy accessors                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Read the time stamp in us of a SBG_ECOM_LOG_EKF_EULER message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The time stamp in us or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogEkfEulerGetTimestamp(const void *pPayload, uint32 payloadSize)
+{
+	uint32	timestamp;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfEulerData, 0, Uint32, &timestamp, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		timestamp = 0;
+	}
+
+	return timestamp;
+}
+
+/*!
+ *	Read the euler angles of a SBG_ECOM_LOG_EKF_EULER message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\param[out]	euler						Roll, Pitch and Yaw angles in rad.
+ *	\return									SBG_NO_ERROR if the values have been read or SBG_BUFFER_OVERFLOW if the payload is too small.
+ */
+SBG_INLINE SbgErrorCode sbgEComLogEkfEulerGetEuler(const void *pPayload, uint32 payloadSize, float euler[3])
+{
+	return SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfEulerData, 4, Float, euler, pPayload, payloadSize);
+}
+
+/*!
+ *	Read the EKF solution status bitmask of a SBG_ECOM_LOG_EKF_EULER message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The EKF solution status bitmask or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogEkfEulerGetStatus(const void *pPayload, uint32 payloadSize)
+{
+	uint32	status;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfEulerData, 28, Uint32, &status, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		status = 0;
+	}
+
+	return status;
+}
+
+/*!
+ *	Read the time stamp in us of a SBG_ECOM_LOG_EKF_QUAT message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The time stamp in us or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogEkfQuatGetTimestamp(const void *pPayload, uint32 payloadSize)
+{
+	uint32	timestamp;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfQuatData, 0, Uint32, &timestamp, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		timestamp = 0;
+	}
+
+	return timestamp;
+}
+
+/*!
+ *	Read the quaternion of a SBG_ECOM_LOG_EKF_QUAT message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\param[out]	quaternion					Orientation quaternion stored in W, X, Y, Z form.
+ *	\return									SBG_NO_ERROR if the values have been read or SBG_BUFFER_OVERFLOW if the payload is too small.
+ */
+SBG_INLINE SbgErrorCode sbgEComLogEkfQuatGetQuaternion(const void *pPayload, uint32 payloadSize, float quaternion[4])
+{
+	return SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfQuatData, 4, Float, quaternion, pPayload, payloadSize);
+}
+
+/*!
+ *	Read the EKF solution status bitmask of a SBG_ECOM_LOG_EKF_QUAT message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The EKF solution status bitmask or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogEkfQuatGetStatus(const void *pPayload, uint32 payloadSize)
+{
+	uint32	status;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfQuatData, 32, Uint32, &status, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		status = 0;
+	}
+
+	return status;
+}
+
+/*!
+ *	Read the time stamp in us of a SBG_ECOM_LOG_EKF_NAV message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The time stamp in us or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogEkfNavGetTimestamp(const void *pPayload, uint32 payloadSize)
+{
+	uint32	timestamp;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfNavData, 0, Uint32, &timestamp, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		timestamp = 0;
+	}
+
+	return timestamp;
+}
+
+/*!
+ *	Read the velocity of a SBG_ECOM_LOG_EKF_NAV message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\param[out]	velocity					North, East, Down velocity in m.s^-1.
+ *	\return									SBG_NO_ERROR if the values have been read or SBG_BUFFER_OVERFLOW if the payload is too small.
+ */
+SBG_INLINE SbgErrorCode sbgEComLogEkfNavGetVelocity(const void *pPayload, uint32 payloadSize, float velocity[3])
+{
+	return SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfNavData, 4, Float, velocity, pPayload, payloadSize);
+}
+
+/*!
+ *	Read the position of a SBG_ECOM_LOG_EKF_NAV message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\param[out]	position					Latitude, Longitude in degrees positive North and East and Altitude above Mean Sea Level in meters.
+ *	\return									SBG_NO_ERROR if the values have been read or SBG_BUFFER_OVERFLOW if the payload is too small.
+ */
+SBG_INLINE SbgErrorCode sbgEComLogEkfNavGetPosition(const void *pPayload, uint32 payloadSize, double position[3])
+{
+	return SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfNavData, 28, Double, position, pPayload, payloadSize);
+}
+
+/*!
+ *	Read the EKF solution status bitmask of a SBG_ECOM_LOG_EKF_NAV message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The EKF solution status bitmask or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogEkfNavGetStatus(const void *pPayload, uint32 payloadSize)
+{
+	uint32	status;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogEkfNavData, 68, Uint32, &status, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		status = 0;
+	}
+
+	return status;
+}
+
 #endif
@@ -1,5 +1,26 @@
 #include "sbgEComBinaryLogEvent.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_EVENT_# message.
+ */
+#define SBG_ECOM_LOG_EVENT_FIELDS(FIELD, OPTIONAL_FIELD)		\
+	FIELD(SbgLogEvent,	timeStamp,		0,	Uint32,	1)			\
+	FIELD(SbgLogEvent,	status,			4,	Uint16,	1)			\
+	FIELD(SbgLogEvent,	timeOffset0,	6,	Uint16,	1)			\
+	FIELD(SbgLogEvent,	timeOffset1,	8,	Uint16,	1)			\
+	FIELD(SbgLogEvent,	timeOffset2,	10,	Uint16,	1)			\
+	FIELD(SbgLogEvent,	timeOffset3,	12,	Uint16,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_EVENT_# message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_EVENT_FIELDS, SbgLogEvent)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_EVENT_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,29 +31,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseEvent(const void *pPayload, uint32 payloadSize, SbgLogEvent *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_EVENT_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_EVENT_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp		= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status			= sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->timeOffset0	= sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->timeOffset1	= sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->timeOffset2	= sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->timeOffset3	= sbgStreamBufferReadUint16LE(&inputStream);
-	
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
@@ -1,5 +1,69 @@
 #include "sbgEComBinaryLogGps.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_GPS#_VEL message.
+ */
+#define SBG_ECOM_LOG_GPS_VEL_FIELDS(FIELD, OPTIONAL_FIELD)		\
+	FIELD(SbgLogGpsVel,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogGpsVel,	status,				4,	Uint32,	1)		\
+	FIELD(SbgLogGpsVel,	timeOfWeek,			8,	Uint32,	1)		\
+	FIELD(SbgLogGpsVel,	velocity[0],		12,	Float,	3)		\
+	FIELD(SbgLogGpsVel,	velocityAcc[0],		24,	Float,	3)		\
+	FIELD(SbgLogGpsVel,	course,				36,	Float,	1)		\
+	FIELD(SbgLogGpsVel,	courseAcc,			40,	Float,	1)
+
+/*!
+ * Fields of the SBG_ECOM_LOG_GPS#_POS message.
+ */
+#define SBG_ECOM_LOG_GPS_POS_FIELDS(FIELD, OPTIONAL_FIELD)							\
+	FIELD(SbgLogGpsPos,	timeStamp,			0,	Uint32,	1)							\
+	FIELD(SbgLogGpsPos,	status,				4,	Uint32,	1)							\
+	FIELD(SbgLogGpsPos,	timeOfWeek,			8,	Uint32,	1)							\
+	FIELD(SbgLogGpsPos,	latitude,			12,	Double,	1)							\
+	FIELD(SbgLogGpsPos,	longitude,			20,	Double,	1)							\
+	FIELD(SbgLogGpsPos,	altitude,			28,	Double,	1)							\
+	FIELD(SbgLogGpsPos,	undulation,			36,	Float,	1)							\
+	FIELD(SbgLogGpsPos,	latitudeAccuracy,	40,	Float,	1)							\
+	FIELD(SbgLogGpsPos,	longitudeAccuracy,	44,	Float,	1)							\
+	FIELD(SbgLogGpsPos,	altitudeAccuracy,	48,	Float,	1)							\
+	OPTIONAL_FIELD(SbgLogGpsPos,	numSvUsed,			52,	Uint8,	1,	0)			\
+	OPTIONAL_FIELD(SbgLogGpsPos,	baseStationId,		53,	Uint16,	1,	0xFFFF)		\
+	OPTIONAL_FIELD(SbgLogGpsPos,	differentialAge,	55,	Uint16,	1,	0xFFFF)
+
+/*!
+ * Fields of the SBG_ECOM_LOG_GPS#_HDT message.
+ */
+#define SBG_ECOM_LOG_GPS_HDT_FIELDS(FIELD, OPTIONAL_FIELD)		\
+	FIELD(SbgLogGpsHdt,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogGpsHdt,	status,				4,	Uint16,	1)		\
+	FIELD(SbgLogGpsHdt,	timeOfWeek,			6,	Uint32,	1)		\
+	FIELD(SbgLogGpsHdt,	heading,			10,	Float,	1)		\
+	FIELD(SbgLogGpsHdt,	headingAccuracy,	14,	Float,	1)		\
+	FIELD(SbgLogGpsHdt,	pitch,				18,	Float,	1)		\
+	FIELD(SbgLogGpsHdt,	pitchAccuracy,		22,	Float,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_GPS#_VEL message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_GPS_VEL_FIELDS, SbgLogGpsVel)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_GPS_VEL_FIELDS)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_GPS#_POS message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_GPS_POS_FIELDS, SbgLogGpsPos)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_GPS_POS_FIELDS)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_GPS#_HDT message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_GPS_HDT_FIELDS, SbgLogGpsHdt)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_GPS_HDT_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,36 +74,27 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseGpsVelData(const void *pPayload, uint32 payloadSize, SbgLogGpsVel *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp		= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status			= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->timeOfWeek		= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->velocity[0]	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocity[1]	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocity[2]	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocityAcc[0]	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocityAcc[1]	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->velocityAcc[2]	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->course			= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->courseAcc		= sbgStreamBufferReadFloatLE(&inputStream);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_GPS_VEL_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_GPS_VEL_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
 
 /*!
@@ -47,57 +102,27 @@ SbgErrorCode sbgEComBinaryLogParseGpsVelData(const void *pPayload, uint32 payloa
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseGpsPosData(const void *pPayload, uint32 payloadSize, SbgLogGpsPos *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp			= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status				= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->timeOfWeek			= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->latitude			= sbgStreamBufferReadDoubleLE(&inputStream);
-	pOutputData->longitude			= sbgStreamBufferReadDoubleLE(&inputStream);
-	pOutputData->altitude			= sbgStreamBufferReadDoubleLE(&inputStream);
-	pOutputData->undulation			= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->latitudeAccuracy	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->longitudeAccuracy	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->altitudeAccuracy	= sbgStreamBufferReadFloatLE(&inputStream);
-
-	//
-	// Test if we have a additional information such as base station id (since version 1.4)
-	//
-	if (payloadSize >= 57)
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_GPS_POS_FIELDS))
 	{
-		//
-		// Read the additional information
-		//
-		pOutputData->numSvUsed			= sbgStreamBufferReadUint8LE(&inputStream);
-		pOutputData->baseStationId		= sbgStreamBufferReadUint16LE(&inputStream);
-		pOutputData->differentialAge	= sbgStreamBufferReadUint16LE(&inputStream);
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_GPS_POS_FIELDS)
 	}
 	else
 	{
-		//
-		// Default the additional information
-		//
-		pOutputData->numSvUsed = 0;
-		pOutputData->baseStationId = 0xFFFF;
-		pOutputData->differentialAge = 0xFFFF;
+		errorCode = SBG_INVALID_FRAME;
 	}
 
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
 
 /*!
@@ -105,32 +130,27 @@ SbgErrorCode sbgEComBinaryLogParseGpsPosData(const void *pPayload, uint32 payloa
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseGpsHdtData(const void *pPayload, uint32 payloadSize, SbgLogGpsHdt *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp			= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status				= sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->timeOfWeek			= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->heading			= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->headingAccuracy	= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->pitch				= sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->pitchAccuracy		= sbgStreamBufferReadFloatLE(&inputStream);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_GPS_HDT_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_GPS_HDT_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
 
 /*!
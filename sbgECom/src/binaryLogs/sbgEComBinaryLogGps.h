@@ -321,7 +321,8 @@ typedef struct _SbgLogGpsRaw
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseGpsVelData(const void *pPayload, uint32 payloadSize, SbgLogGpsVel *pOutputData);
 
@@ -330,7 +331,8 @@ SbgErrorCode sbgEComBinaryLogParseGpsVelData(const void *pPayload, uint32 payloa
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseGpsPosData(const void *pPayload, uint32 payloadSize, SbgLogGpsPos *pOutputData);
 
@@ -339,7 +341,8 @@ SbgErrorCode sbgEComBinaryLogParseGpsPosData(const void *pPayload, uint32 payloa
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseGpsHdtData(const void *pPayload, uint32 payloadSize, SbgLogGpsHdt *pOutputData);
 
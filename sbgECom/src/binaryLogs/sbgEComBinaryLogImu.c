@@ -1,5 +1,14 @@
 #include "sbgEComBinaryLogImu.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas checks                                                 -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check the offset of each field of the SBG_ECOM_LOG_IMU_DATA message.
+ */
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_IMU_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,43 +19,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseImuData(const void *pPayload, uint32 payloadSize, SbgLogImuData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
-
-	//
-	// Create an input stream to read the payload
-	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status = sbgStreamBufferReadUint16LE(&inputStream);
-				
-	pOutputData->accelerometers[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->accelerometers[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->accelerometers[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->gyroscopes[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->gyroscopes[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->gyroscopes[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->temperature = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->deltaVelocity[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->deltaVelocity[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->deltaVelocity[2] = sbgStreamBufferReadFloatLE(&inputStream);
-				
-	pOutputData->deltaAngle[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->deltaAngle[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->deltaAngle[2] = sbgStreamBufferReadFloatLE(&inputStream);
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// TODO: check for an error on the input stream such as buffer overflow
+	// Check once that the payload contains all the required fields
 	//
-	return SBG_NO_ERROR;
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_IMU_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_IMU_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
+
+	return errorCode;
 }
@@ -21,6 +21,7 @@
 #define __SBG_ECOM_BINARY_LOG_IMU_H__
 
 #include <sbgCommon.h>
+#include "sbgEComBinaryLogSchema.h"
 
 //----------------------------------------------------------------------//
 //- Log Inertial Data definitions                                      -//
@@ -61,6 +62,27 @@ typedef struct _SbgLogImuData
 	float	deltaAngle[3];				/*!< X, Y, Z delta angle in rad.s^-1. */
 } SbgLogImuData;
 
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_IMU_DATA message.
+ */
+#define SBG_ECOM_LOG_IMU_FIELDS(FIELD, OPTIONAL_FIELD)				\
+	FIELD(SbgLogImuData,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogImuData,	status,				4,	Uint16,	1)		\
+	FIELD(SbgLogImuData,	accelerometers[0],	6,	Float,	3)		\
+	FIELD(SbgLogImuData,	gyroscopes[0],		18,	Float,	3)		\
+	FIELD(SbgLogImuData,	temperature,		30,	Float,	1)		\
+	FIELD(SbgLogImuData,	deltaVelocity[0],	34,	Float,	3)		\
+	FIELD(SbgLogImuData,	deltaAngle[0],		46,	Float,	3)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_IMU_DATA message.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_IMU_FIELDS, SbgLogImuData)
+
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
 //----------------------------------------------------------------------//
@@ -70,8 +92,91 @@ typedef struct _SbgLogImuData
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseImuData(const void *pPayload, uint32 payloadSize, SbgLogImuData *pOutputData);
 
+//----------------------------------------------------------------------//
+//- Lazy accessors                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Read the time stamp in us of a SBG_ECOM_LOG_IMU_DATA message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The time stamp in us or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogImuGetTimestamp(const void *pPayload, uint32 payloadSize)
+{
+	uint32	timestamp;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogImuData, 0, Uint32, &timestamp, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		timestamp = 0;
+	}
+
+	return timestamp;
+}
+
+/*!
+ *	Read the IMU status bitmask of a SBG_ECOM_LOG_IMU_DATA message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The IMU status bitmask or 0 if the payload is too small.
+ */
+SBG_INLINE uint16 sbgEComLogImuGetStatus(const void *pPayload, uint32 payloadSize)
+{
+	uint16	status;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogImuData, 4, Uint16, &status, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		status = 0;
+	}
+
+	return status;
+}
+
+/*!
+ *	Read the accelerometers of a SBG_ECOM_LOG_IMU_DATA message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\param[out]	accelerometers				X, Y, Z accelerometers in m.s^-2.
+ *	\return									SBG_NO_ERROR if the values have been read or SBG_BUFFER_OVERFLOW if the payload is too small.
+ */
+SBG_INLINE SbgErrorCode sbgEComLogImuGetAccelerometers(const void *pPayload, uint32 payloadSize, float accelerometers[3])
+{
+	return SBG_ECOM_LOG_READ_FIELD_AT(SbgLogImuData, 6, Float, accelerometers, pPayload, payloadSize);
+}
+
+/*!
+ *	Read the gyroscopes of a SBG_ECOM_LOG_IMU_DATA message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\param[out]	gyroscopes					X, Y, Z gyroscopes in rad.s^-1.
+ *	\return									SBG_NO_ERROR if the values have been read or SBG_BUFFER_OVERFLOW if the payload is too small.
+ */
+SBG_INLINE SbgErrorCode sbgEComLogImuGetGyroscopes(const void *pPayload, uint32 payloadSize, float gyroscopes[3])
+{
+	return SBG_ECOM_LOG_READ_FIELD_AT(SbgLogImuData, 18, Float, gyroscopes, pPayload, payloadSize);
+}
+
+/*!
+ *	Read the internal temperature of a SBG_ECOM_LOG_IMU_DATA message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The internal temperature or 0 if the payload is too small.
+ */
+SBG_INLINE float sbgEComLogImuGetTemperature(const void *pPayload, uint32 payloadSize)
+{
+	float	temperature;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogImuData, 30, Float, &temperature, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		temperature = 0;
+	}
+
+	return temperature;
+}
+
 #endif
@@ -1,5 +1,38 @@
 #include "sbgEComBinaryLogMag.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_MAG message.
+ */
+#define SBG_ECOM_LOG_MAG_FIELDS(FIELD, OPTIONAL_FIELD)			\
+	FIELD(SbgLogMag,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogMag,	status,				4,	Uint16,	1)		\
+	FIELD(SbgLogMag,	magnetometers[0],	6,	Float,	3)		\
+	FIELD(SbgLogMag,	accelerometers[0],	18,	Float,	3)
+
+/*!
+ * Fields of the SBG_ECOM_LOG_MAG_CALIB message.
+ */
+#define SBG_ECOM_LOG_MAG_CALIB_FIELDS(FIELD, OPTIONAL_FIELD)		\
+	FIELD(SbgLogMagCalib,	timeStamp,		0,	Uint32,	1)			\
+	FIELD(SbgLogMagCalib,	reserved,		4,	Uint16,	1)			\
+	FIELD(SbgLogMagCalib,	magData[0],		6,	Uint8,	16)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_MAG message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_MAG_FIELDS, SbgLogMag)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_MAG_FIELDS)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_MAG_CALIB message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_MAG_CALIB_FIELDS, SbgLogMagCalib)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_MAG_CALIB_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,35 +43,27 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseMagData(const void *pPayload, uint32 payloadSize, SbgLogMag *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_MAG_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_MAG_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status = sbgStreamBufferReadUint16LE(&inputStream);
-
-	pOutputData->magnetometers[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->magnetometers[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->magnetometers[2] = sbgStreamBufferReadFloatLE(&inputStream);
-				
-	pOutputData->accelerometers[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->accelerometers[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->accelerometers[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
 
 /*!
@@ -46,25 +71,25 @@ SbgErrorCode sbgEComBinaryLogParseMagData(const void *pPayload, uint32 payloadSi
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseMagCalibData(const void *pPayload, uint32 payloadSize, SbgLogMagCalib *pOutputData)
 {
-	SbgStreamBuffer inputStream;
-
-	//
-	// Create an input stream to read the payload
-	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Read the frame payload
+	// Check once that the payload contains all the required fields
 	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->reserved = sbgStreamBufferReadUint16LE(&inputStream);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_MAG_CALIB_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_MAG_CALIB_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// Read the raw magnetic calibration data buffer
-	//
-	return sbgStreamBufferReadBuffer(&inputStream, pOutputData->magData, sizeof(pOutputData->magData));
+	return errorCode;
 }
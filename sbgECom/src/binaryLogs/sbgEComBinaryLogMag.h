@@ -76,7 +76,8 @@ typedef struct _SbgLogMagCalib
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseMagData(const void *pPayload, uint32 payloadSize, SbgLogMag *pOutputData);
 
@@ -85,7 +86,8 @@ SbgErrorCode sbgEComBinaryLogParseMagData(const void *pPayload, uint32 payloadSi
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseMagCalibData(const void *pPayload, uint32 payloadSize, SbgLogMagCalib *pOutputData);
 
@@ -1,5 +1,23 @@
 #include "sbgEComBinaryLogOdometer.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_ODO_VEL message.
+ */
+#define SBG_ECOM_LOG_ODOMETER_FIELDS(FIELD, OPTIONAL_FIELD)		\
+	FIELD(SbgLogOdometerData,	timeStamp,	0,	Uint32,	1)		\
+	FIELD(SbgLogOdometerData,	status,		4,	Uint16,	1)		\
+	FIELD(SbgLogOdometerData,	velocity,	6,	Float,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_ODO_VEL message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_ODOMETER_FIELDS, SbgLogOdometerData)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_ODOMETER_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,27 +28,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseOdometerData(const void *pPayload, uint32 payloadSize, SbgLogOdometerData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
-
-	//
-	// Create an input stream to read the payload
-	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Read the frame payload
+	// Check once that the payload contains all the required fields
 	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status = sbgStreamBufferReadUint16LE(&inputStream);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_ODOMETER_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_ODOMETER_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	pOutputData->velocity = sbgStreamBufferReadFloatLE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
@@ -0,0 +1,420 @@
+/*!
+ *	\file		sbgEComBinaryLogSchema.h
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Table driven decoding of received binary logs.
+ *
+ *	Each binary log is described by a table of fields that gives for each field the output structure,
+ *	the member, the offset in the payload, the type and the number of elements.
+ *	The table is written as a macro taking two macros as arguments, one called for each required field
+ *	and one called for each optional field:
+ *
+ *		#define SBG_ECOM_LOG_MAG_FIELDS(FIELD, OPTIONAL_FIELD)							\
+ *			FIELD(SbgLogMag,	timeStamp,				0,	Uint32,	1)					\
+ *			FIELD(SbgLogMag,	status,					4,	Uint16,	1)					\
+ *			FIELD(SbgLogMag,	magnetometers[0],		6,	Float,	3)					\
+ *			...
+ *
+ *	The table is expanded at compile time into straight line code so decoding a log costs the same as
+ *	hand written reads, and into the size of the required fields so the payload size is checked only once per frame.
+ *
+ *	Fields that have been appended in later firmware versions, such as numSvUsed in SbgLogGpsPos,
+ *	are declared as optional with a default value. The optional fields of a log have been added together
+ *	so they are all read if the payload contains all of them, otherwise they are all set to their default value.
+ *
+ *	Fields should be declared in payload order, each one starting right after the previous one and the
+ *	optional fields last. SBG_ECOM_LOG_CHECK_LAYOUT checks at compile time that each field offset matches.
+ *
+ *	On little endian hosts the payload layout of each field already matches the output structure,
+ *	so arrays such as accelerometers[3] are copied with a single memcpy whatever SBG_CONFIG_UNALIGNED_ACCESS_AUTH is.
+ *	Other hosts, and builds that define SBG_ECOM_LOG_PORTABLE_READS, assemble each element byte per byte.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+#ifndef __SBG_ECOM_BINARY_LOG_SCHEMA_H__
+#define __SBG_ECOM_BINARY_LOG_SCHEMA_H__
+
+#include <sbgCommon.h>
+#include <stddef.h>
+
+//----------------------------------------------------------------------//
+//- Select the fields read according to the target                     -//
+//----------------------------------------------------------------------//
+#if (SBG_CONFIG_BIG_ENDIAN == DISABLE) && !defined(SBG_ECOM_LOG_PORTABLE_READS) && (	(defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)) ||	\
+																						defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM) || defined(_M_ARM64) )
+	#define SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+#endif
+
+//----------------------------------------------------------------------//
+//- Fields read operations                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Read an array of unsigned 8 bits integers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadUint8(const uint8 *pSrc, uint8 *pDst, uint32 count)
+{
+	memcpy(pDst, pSrc, count);
+}
+
+/*!
+ *	Read an array of signed 8 bits integers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadInt8(const uint8 *pSrc, int8 *pDst, uint32 count)
+{
+	memcpy(pDst, pSrc, count);
+}
+
+/*!
+ *	Returns a little endian 16 bits value.
+ *	\param[in]	pSrc						Payload position of the value.
+ *	\return									Value in the platform endianness.
+ */
+SBG_INLINE uint16 sbgEComLogGetUint16(const uint8 *pSrc)
+{
+	return (uint16)(pSrc[0] | (pSrc[1] << 8));
+}
+
+/*!
+ *	Returns a little endian 32 bits value.
+ *	\param[in]	pSrc						Payload position of the value.
+ *	\return									Value in the platform endianness.
+ */
+SBG_INLINE uint32 sbgEComLogGetUint32(const uint8 *pSrc)
+{
+	return (uint32)pSrc[0] | ((uint32)pSrc[1] << 8) | ((uint32)pSrc[2] << 16) | ((uint32)pSrc[3] << 24);
+}
+
+/*!
+ *	Returns a little endian 64 bits value.
+ *	\param[in]	pSrc						Payload position of the value.
+ *	\return									Value in the platform endianness.
+ */
+SBG_INLINE uint64 sbgEComLogGetUint64(const uint8 *pSrc)
+{
+	return	(uint64)pSrc[0]			| ((uint64)pSrc[1] << 8)	| ((uint64)pSrc[2] << 16)	| ((uint64)pSrc[3] << 24) |
+			((uint64)pSrc[4] << 32)	| ((uint64)pSrc[5] << 40)	| ((uint64)pSrc[6] << 48)	| ((uint64)pSrc[7] << 56);
+}
+
+/*!
+ *	Read an array of little endian unsigned 16 bits integers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadUint16(const uint8 *pSrc, uint16 *pDst, uint32 count)
+{
+#ifdef SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+	//
+	// The payload layout is the host one, copy all elements at once
+	//
+	memcpy(pDst, pSrc, count * sizeof(uint16));
+#else
+	uint32		i;
+
+	for (i = 0; i < count; i++)
+	{
+		pDst[i] = sbgEComLogGetUint16(pSrc);
+		pSrc += sizeof(uint16);
+	}
+#endif
+}
+
+/*!
+ *	Read an array of little endian signed 16 bits integers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadInt16(const uint8 *pSrc, int16 *pDst, uint32 count)
+{
+#ifdef SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+	//
+	// The payload layout is the host one, copy all elements at once
+	//
+	memcpy(pDst, pSrc, count * sizeof(int16));
+#else
+	uint32		i;
+
+	for (i = 0; i < count; i++)
+	{
+		pDst[i] = (int16)sbgEComLogGetUint16(pSrc);
+		pSrc += sizeof(int16);
+	}
+#endif
+}
+
+/*!
+ *	Read an array of little endian unsigned 32 bits integers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadUint32(const uint8 *pSrc, uint32 *pDst, uint32 count)
+{
+#ifdef SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+	//
+	// The payload layout is the host one, copy all elements at once
+	//
+	memcpy(pDst, pSrc, count * sizeof(uint32));
+#else
+	uint32		i;
+
+	for (i = 0; i < count; i++)
+	{
+		pDst[i] = sbgEComLogGetUint32(pSrc);
+		pSrc += sizeof(uint32);
+	}
+#endif
+}
+
+/*!
+ *	Read an array of little endian signed 32 bits integers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadInt32(const uint8 *pSrc, int32 *pDst, uint32 count)
+{
+#ifdef SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+	//
+	// The payload layout is the host one, copy all elements at once
+	//
+	memcpy(pDst, pSrc, count * sizeof(int32));
+#else
+	uint32		i;
+
+	for (i = 0; i < count; i++)
+	{
+		pDst[i] = (int32)sbgEComLogGetUint32(pSrc);
+		pSrc += sizeof(int32);
+	}
+#endif
+}
+
+/*!
+ *	Read an array of little endian 32 bits floating point numbers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadFloat(const uint8 *pSrc, float *pDst, uint32 count)
+{
+#ifdef SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+	//
+	// The payload layout is the host one, copy all elements at once
+	//
+	memcpy(pDst, pSrc, count * sizeof(float));
+#else
+	FloatNint	value;
+	uint32		i;
+
+	for (i = 0; i < count; i++)
+	{
+		value.valU = sbgEComLogGetUint32(pSrc);
+		pDst[i] = value.valF;
+		pSrc += sizeof(float);
+	}
+#endif
+}
+
+/*!
+ *	Read an array of little endian 64 bits floating point numbers.
+ *	\param[in]	pSrc						Payload position of the first element.
+ *	\param[out]	pDst						Output array.
+ *	\param[in]	count						Number of elements.
+ */
+SBG_INLINE void sbgEComLogReadDouble(const uint8 *pSrc, double *pDst, uint32 count)
+{
+#ifdef SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+	//
+	// The payload layout is the host one, copy all elements at once
+	//
+	memcpy(pDst, pSrc, count * sizeof(double));
+#else
+	DoubleNint	value;
+	uint32		i;
+
+	for (i = 0; i < count; i++)
+	{
+		value.valU = sbgEComLogGetUint64(pSrc);
+		pDst[i] = value.valF;
+		pSrc += sizeof(double);
+	}
+#endif
+}
+
+//----------------------------------------------------------------------//
+//- Fields table expansion macros                                      -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Payload size in bytes of a field, arrays are declared using their first element such as accelerometers[0].
+ */
+#define SBG_ECOM_LOG_FIELD_SIZE(structType, member, payloadOffset, type, count)	\
+	(sizeof(((structType*)0)->member) * (count))
+
+/*!
+ * Expand a required field into the payload size of the required fields, used as FIELD argument of a fields table.
+ */
+#define SBG_ECOM_LOG_REQUIRED_SIZE(structType, member, payloadOffset, type, count)	\
+	+ SBG_ECOM_LOG_FIELD_SIZE(structType, member, payloadOffset, type, count)
+
+/*!
+ * Ignore an optional field when computing the payload size of the required fields, used as OPTIONAL_FIELD argument of a fields table.
+ */
+#define SBG_ECOM_LOG_OPTIONAL_SIZE(structType, member, payloadOffset, type, count, defaultValue)
+
+/*!
+ * Expand an optional field into its payload size, used as OPTIONAL_FIELD argument of a fields table.
+ */
+#define SBG_ECOM_LOG_ALL_OPTIONAL_SIZE(structType, member, payloadOffset, type, count, defaultValue)	\
+	+ SBG_ECOM_LOG_FIELD_SIZE(structType, member, payloadOffset, type, count)
+
+/*!
+ * Returns the payload size in bytes of the required fields of a fields table, required fields should be contiguous from the payload start.
+ */
+#define SBG_ECOM_LOG_PAYLOAD_SIZE(fieldsTable)	\
+	(0 fieldsTable(SBG_ECOM_LOG_REQUIRED_SIZE, SBG_ECOM_LOG_OPTIONAL_SIZE))
+
+/*!
+ * Returns the payload size in bytes of all the fields of a fields table, optional ones included.
+ */
+#define SBG_ECOM_LOG_FULL_PAYLOAD_SIZE(fieldsTable)	\
+	(0 fieldsTable(SBG_ECOM_LOG_REQUIRED_SIZE, SBG_ECOM_LOG_ALL_OPTIONAL_SIZE))
+
+/*!
+ * Ignore a required field, used as FIELD argument of a fields table.
+ */
+#define SBG_ECOM_LOG_SKIP_FIELD(structType, member, payloadOffset, type, count)
+
+/*!
+ * Expand a required field into its read, used as FIELD argument of a fields table.
+ * The pBuffer (const uint8 pointer on the payload) and pOutputData variables should be defined by the calling code.
+ */
+#define SBG_ECOM_LOG_READ_FIELD(structType, member, payloadOffset, type, count)	\
+	sbgEComLogRead##type(pBuffer + (payloadOffset), &pOutputData->member, (count));
+
+/*!
+ * Expand an optional field into its read, used as OPTIONAL_FIELD argument of a fields table.
+ * The pBuffer (const uint8 pointer on the payload) and pOutputData variables should be defined by the calling code.
+ */
+#define SBG_ECOM_LOG_READ_OPTIONAL_FIELD(structType, member, payloadOffset, type, count, defaultValue)	\
+	SBG_ECOM_LOG_READ_FIELD(structType, member, payloadOffset, type, count)
+
+/*!
+ * Expand an optional field into the assignment of its default value, used as OPTIONAL_FIELD argument of a fields table.
+ * The pOutputData variable should be defined by the calling code.
+ */
+#define SBG_ECOM_LOG_DEFAULT_OPTIONAL_FIELD(structType, member, payloadOffset, type, count, defaultValue)	\
+	{																										\
+		uint32 fieldIndex;																					\
+																											\
+		for (fieldIndex = 0; fieldIndex < (count); fieldIndex++)											\
+		{																									\
+			(&pOutputData->member)[fieldIndex] = (defaultValue);											\
+		}																									\
+	}
+
+/*!
+ * Expand a fields table into the reads of all its fields, the optional fields are read only if the payload contains all of them.
+ * The pBuffer, payloadSize and pOutputData variables should be defined by the calling code.
+ */
+#define SBG_ECOM_LOG_READ_FIELDS(fieldsTable)												\
+	fieldsTable(SBG_ECOM_LOG_READ_FIELD, SBG_ECOM_LOG_OPTIONAL_SIZE)						\
+																							\
+	if (payloadSize >= SBG_ECOM_LOG_FULL_PAYLOAD_SIZE(fieldsTable))							\
+	{																						\
+		fieldsTable(SBG_ECOM_LOG_SKIP_FIELD, SBG_ECOM_LOG_READ_OPTIONAL_FIELD)				\
+	}																						\
+	else																					\
+	{																						\
+		fieldsTable(SBG_ECOM_LOG_SKIP_FIELD, SBG_ECOM_LOG_DEFAULT_OPTIONAL_FIELD)			\
+	}
+
+//----------------------------------------------------------------------//
+//- Fields layout                                                      -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Expand a field into a byte array named after its payload offset, used as FIELD argument of a fields table.
+ */
+#define SBG_ECOM_LOG_LAYOUT_FIELD(structType, member, payloadOffset, type, count)	\
+	uint8 field##payloadOffset[SBG_ECOM_LOG_FIELD_SIZE(structType, member, payloadOffset, type, count)];
+
+/*!
+ * Expand an optional field into a byte array named after its payload offset, used as OPTIONAL_FIELD argument of a fields table.
+ */
+#define SBG_ECOM_LOG_LAYOUT_OPTIONAL_FIELD(structType, member, payloadOffset, type, count, defaultValue)	\
+	SBG_ECOM_LOG_LAYOUT_FIELD(structType, member, payloadOffset, type, count)
+
+/*!
+ * Define the payload layout of a fields table: a structure of byte arrays, without any padding, where each field follows the previous one.
+ */
+#define SBG_ECOM_LOG_DEFINE_LAYOUT(fieldsTable, structType)											\
+	struct _SbgEComLogLayout##structType															\
+	{																								\
+		fieldsTable(SBG_ECOM_LOG_LAYOUT_FIELD, SBG_ECOM_LOG_LAYOUT_OPTIONAL_FIELD)					\
+	};
+
+/*!
+ * Returns the payload offset of the field starting at payloadOffset, fails to compile if no field of the layout starts at this offset.
+ */
+#define SBG_ECOM_LOG_FIELD_OFFSET(structType, payloadOffset)	\
+	offsetof(struct _SbgEComLogLayout##structType, field##payloadOffset)
+
+/*!
+ * Returns the payload size in bytes of the field starting at payloadOffset.
+ */
+#define SBG_ECOM_LOG_FIELD_SIZE_AT(structType, payloadOffset)	\
+	sizeof(((struct _SbgEComLogLayout##structType*)0)->field##payloadOffset)
+
+/*!
+ * Expand a field into a compile time check of its payload offset, used as FIELD argument of a fields table.
+ * The build fails on an array with a negative size if the field doesn't start right after the previous one.
+ */
+#define SBG_ECOM_LOG_CHECK_FIELD(structType, member, payloadOffset, type, count)	\
+	typedef char sbgEComLogCheck##structType##_##payloadOffset[(SBG_ECOM_LOG_FIELD_OFFSET(structType, payloadOffset) == (payloadOffset)) ? 1 : -1];
+
+/*!
+ * Expand an optional field into a compile time check of its payload offset, used as OPTIONAL_FIELD argument of a fields table.
+ */
+#define SBG_ECOM_LOG_CHECK_OPTIONAL_FIELD(structType, member, payloadOffset, type, count, defaultValue)	\
+	SBG_ECOM_LOG_CHECK_FIELD(structType, member, payloadOffset, type, count)
+
+/*!
+ * Check at compile time that the payload offset of each field equals the sum of the sizes of the previous fields.
+ * The layout of the fields table should have been defined with SBG_ECOM_LOG_DEFINE_LAYOUT.
+ */
+#define SBG_ECOM_LOG_CHECK_LAYOUT(fieldsTable)	\
+	fieldsTable(SBG_ECOM_LOG_CHECK_FIELD, SBG_ECOM_LOG_CHECK_OPTIONAL_FIELD)
+
+/*!
+ * Read the field starting at payloadOffset directly from a payload, without parsing the whole log.
+ * The number of read elements is given by the field size so it fails to compile if no field of the layout starts at payloadOffset.
+ * Returns SBG_NO_ERROR if the field has been read or SBG_BUFFER_OVERFLOW if the payload is too small.
+ */
+#define SBG_ECOM_LOG_READ_FIELD_AT(structType, payloadOffset, type, pDst, pPayload, payloadSize)										\
+	(((payloadSize) >= SBG_ECOM_LOG_FIELD_OFFSET(structType, payloadOffset) + SBG_ECOM_LOG_FIELD_SIZE_AT(structType, payloadOffset)) ?	\
+		(sbgEComLogRead##type((const uint8*)(pPayload) + SBG_ECOM_LOG_FIELD_OFFSET(structType, payloadOffset), (pDst),					\
+			(uint32)(SBG_ECOM_LOG_FIELD_SIZE_AT(structType, payloadOffset) / sizeof(*(pDst)))), SBG_NO_ERROR) :							\
+		SBG_BUFFER_OVERFLOW)
+
+#endif
@@ -1,5 +1,26 @@
 #include "sbgEComBinaryLogShipMotion.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_SHIP_MOTION_# message.
+ */
+#define SBG_ECOM_LOG_SHIP_MOTION_FIELDS(FIELD, OPTIONAL_FIELD)							\
+	FIELD(SbgLogShipMotionData,	timeStamp,			0,	Uint32,	1)						\
+	FIELD(SbgLogShipMotionData,	mainHeavePeriod,	4,	Float,	1)						\
+	FIELD(SbgLogShipMotionData,	shipMotion[0],		8,	Float,	3)						\
+	FIELD(SbgLogShipMotionData,	shipAccel[0],		20,	Float,	3)						\
+	OPTIONAL_FIELD(SbgLogShipMotionData,	shipVel[0],			32,	Float,	3,	0)		\
+	OPTIONAL_FIELD(SbgLogShipMotionData,	status,				44,	Uint16,	1,	0)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_SHIP_MOTION_# message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_SHIP_MOTION_FIELDS, SbgLogShipMotionData)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_SHIP_MOTION_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,69 +31,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseShipMotionData(const void *pPayload, uint32 payloadSize, SbgLogShipMotionData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
-	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-
+	// Check once that the payload contains all the required fields
 	//
-	// Read the main heave period in seconds
-	//
-	pOutputData->mainHeavePeriod = sbgStreamBufferReadFloatLE(&inputStream);
-
-	//
-	// Read the surge, sway and heave ship motion
-	//
-	pOutputData->shipMotion[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->shipMotion[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->shipMotion[2] = sbgStreamBufferReadFloatLE(&inputStream);
-	
-	//
-	// Read the ship accelerations
-	//
-	pOutputData->shipAccel[0] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->shipAccel[1] = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->shipAccel[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-	//
-	// Check if we have other outputs in this frame
-	//
-	if (payloadSize >= 46)
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_SHIP_MOTION_FIELDS))
 	{
-		//
-		// Read new outputs
-		//
-		pOutputData->shipVel[0] = sbgStreamBufferReadFloatLE(&inputStream);
-		pOutputData->shipVel[1] = sbgStreamBufferReadFloatLE(&inputStream);
-		pOutputData->shipVel[2] = sbgStreamBufferReadFloatLE(&inputStream);
-
-		pOutputData->status = sbgStreamBufferReadUint16LE(&inputStream);
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_SHIP_MOTION_FIELDS)
 	}
 	else
 	{
-		//
-		// Those outputs are not available in previous versions
-		//
-		pOutputData->shipVel[0] = 0.0f;
-		pOutputData->shipVel[1] = 0.0f;
-		pOutputData->shipVel[2] = 0.0f;
-
-		pOutputData->status = 0;
+		errorCode = SBG_INVALID_FRAME;
 	}
 
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
@@ -1,5 +1,14 @@
 #include "sbgEComBinaryLogStatus.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas checks                                                 -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Check the offset of each field of the SBG_ECOM_LOG_STATUS message.
+ */
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_STATUS_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,30 +19,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseStatusData(const void *pPayload, uint32 payloadSize, SbgLogStatusData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_STATUS_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_STATUS_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp		= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->generalStatus	= sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->reserved1		= sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->comStatus		= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->aidingStatus	= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->reserved2		= sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->reserved3		= sbgStreamBufferReadUint16LE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
@@ -21,6 +21,7 @@
 #define __SBG_ECOM_BINARY_LOG_STATUS_H__
 
 #include <sbgCommon.h>
+#include "sbgEComBinaryLogSchema.h"
 
 //----------------------------------------------------------------------//
 //- General status definitions                                         -//
@@ -150,6 +151,27 @@ SBG_INLINE uint32 sbgEComLogStatusBuildCommunicationStatus(SbgEComCanBusStatus c
 	return	((((uint32)canStatus)&SBG_ECOM_CAN_STATUS_MASK) << SBG_ECOM_CAN_STATUS_SHIFT) | masks;
 }
 
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_STATUS message.
+ */
+#define SBG_ECOM_LOG_STATUS_FIELDS(FIELD, OPTIONAL_FIELD)		\
+	FIELD(SbgLogStatusData,	timeStamp,		0,	Uint32,	1)		\
+	FIELD(SbgLogStatusData,	generalStatus,	4,	Uint16,	1)		\
+	FIELD(SbgLogStatusData,	reserved1,		6,	Uint16,	1)		\
+	FIELD(SbgLogStatusData,	comStatus,		8,	Uint32,	1)		\
+	FIELD(SbgLogStatusData,	aidingStatus,	12,	Uint32,	1)		\
+	FIELD(SbgLogStatusData,	reserved2,		16,	Uint32,	1)		\
+	FIELD(SbgLogStatusData,	reserved3,		20,	Uint16,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_STATUS message.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_STATUS_FIELDS, SbgLogStatusData)
+
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
 //----------------------------------------------------------------------//
@@ -159,8 +181,85 @@ SBG_INLINE uint32 sbgEComLogStatusBuildCommunicationStatus(SbgEComCanBusStatus c
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseStatusData(const void *pPayload, uint32 payloadSize, SbgLogStatusData *pOutputData);
 
+//----------------------------------------------------------------------//
+//- Lazy accessors                                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Read the time stamp in us of a SBG_ECOM_LOG_STATUS message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The time stamp in us or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogStatusGetTimestamp(const void *pPayload, uint32 payloadSize)
+{
+	uint32	timestamp;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogStatusData, 0, Uint32, &timestamp, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		timestamp = 0;
+	}
+
+	return timestamp;
+}
+
+/*!
+ *	Read the general status bitmask of a SBG_ECOM_LOG_STATUS message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The general status bitmask or 0 if the payload is too small.
+ */
+SBG_INLINE uint16 sbgEComLogStatusGetGeneralStatus(const void *pPayload, uint32 payloadSize)
+{
+	uint16	generalStatus;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogStatusData, 4, Uint16, &generalStatus, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		generalStatus = 0;
+	}
+
+	return generalStatus;
+}
+
+/*!
+ *	Read the communication status bitmask of a SBG_ECOM_LOG_STATUS message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The communication status bitmask or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogStatusGetComStatus(const void *pPayload, uint32 payloadSize)
+{
+	uint32	comStatus;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogStatusData, 8, Uint32, &comStatus, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		comStatus = 0;
+	}
+
+	return comStatus;
+}
+
+/*!
+ *	Read the aiding equipments status bitmask of a SBG_ECOM_LOG_STATUS message directly from its payload without parsing the whole message.
+ *	\param[in]	pPayload					Read only pointer on the payload buffer.
+ *	\param[in]	payloadSize					Payload size in bytes.
+ *	\return									The aiding equipments status bitmask or 0 if the payload is too small.
+ */
+SBG_INLINE uint32 sbgEComLogStatusGetAidingStatus(const void *pPayload, uint32 payloadSize)
+{
+	uint32	aidingStatus;
+
+	if (SBG_ECOM_LOG_READ_FIELD_AT(SbgLogStatusData, 12, Uint32, &aidingStatus, pPayload, payloadSize) != SBG_NO_ERROR)
+	{
+		aidingStatus = 0;
+	}
+
+	return aidingStatus;
+}
+
 #endif
@@ -1,5 +1,28 @@
 #include "sbgEComBinaryLogUsbl.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_USBL message.
+ */
+#define SBG_ECOM_LOG_USBL_FIELDS(FIELD, OPTIONAL_FIELD)				\
+	FIELD(SbgLogUsblData,	timeStamp,			0,	Uint32,	1)		\
+	FIELD(SbgLogUsblData,	status,				4,	Uint16,	1)		\
+	FIELD(SbgLogUsblData,	latitude,			6,	Double,	1)		\
+	FIELD(SbgLogUsblData,	longitude,			14,	Double,	1)		\
+	FIELD(SbgLogUsblData,	depth,				22,	Float,	1)		\
+	FIELD(SbgLogUsblData,	latitudeAccuracy,	26,	Float,	1)		\
+	FIELD(SbgLogUsblData,	longitudeAccuracy,	30,	Float,	1)		\
+	FIELD(SbgLogUsblData,	depthAccuracy,		34,	Float,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_USBL message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_USBL_FIELDS, SbgLogUsblData)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_USBL_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,34 +33,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseUsblData(const void *pPayload, uint32 payloadSize, SbgLogUsblData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
-
-	//
-	// Create an input stream to read the payload
-	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
-
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status = sbgStreamBufferReadUint16LE(&inputStream);
-
-	pOutputData->latitude = sbgStreamBufferReadDoubleLE(&inputStream);
-	pOutputData->longitude = sbgStreamBufferReadDoubleLE(&inputStream);
-
-	pOutputData->depth = sbgStreamBufferReadFloatLE(&inputStream);
-
-	pOutputData->latitudeAccuracy = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->longitudeAccuracy = sbgStreamBufferReadFloatLE(&inputStream);
-	pOutputData->depthAccuracy = sbgStreamBufferReadFloatLE(&inputStream);
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// TODO: check for an error on the input stream such as buffer overflow
+	// Check once that the payload contains all the required fields
 	//
-	return SBG_NO_ERROR;
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_USBL_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_USBL_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
+
+	return errorCode;
 }
@@ -1,5 +1,30 @@
 #include "sbgEComBinaryLogUtc.h"
-#include <streamBuffer/sbgStreamBuffer.h>
+#include "sbgEComBinaryLogSchema.h"
+
+//----------------------------------------------------------------------//
+//- Log schemas                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Fields of the SBG_ECOM_LOG_UTC_TIME message.
+ */
+#define SBG_ECOM_LOG_UTC_FIELDS(FIELD, OPTIONAL_FIELD)			\
+	FIELD(SbgLogUtcData,	timeStamp,		0,	Uint32,	1)		\
+	FIELD(SbgLogUtcData,	status,			4,	Uint16,	1)		\
+	FIELD(SbgLogUtcData,	year,			6,	Uint16,	1)		\
+	FIELD(SbgLogUtcData,	month,			8,	Int8,	1)		\
+	FIELD(SbgLogUtcData,	day,			9,	Int8,	1)		\
+	FIELD(SbgLogUtcData,	hour,			10,	Int8,	1)		\
+	FIELD(SbgLogUtcData,	minute,			11,	Int8,	1)		\
+	FIELD(SbgLogUtcData,	second,			12,	Int8,	1)		\
+	FIELD(SbgLogUtcData,	nanoSecond,		13,	Int32,	1)		\
+	FIELD(SbgLogUtcData,	gpsTimeOfWeek,	17,	Uint32,	1)
+
+/*!
+ * Payload layout of the SBG_ECOM_LOG_UTC_TIME message, the offset of each field is checked at compile time.
+ */
+SBG_ECOM_LOG_DEFINE_LAYOUT(SBG_ECOM_LOG_UTC_FIELDS, SbgLogUtcData)
+SBG_ECOM_LOG_CHECK_LAYOUT(SBG_ECOM_LOG_UTC_FIELDS)
 
 //----------------------------------------------------------------------//
 //- Operations                                                         -//
@@ -10,33 +35,25 @@
  *	\param[in]	pPayload					Read only pointer on the payload buffer.
  *	\param[in]	payloadSize					Payload size in bytes.
  *	\param[out]	pOutputData					Pointer on the output structure that stores parsed data.
- *	\return									SBG_NO_ERROR if the payload has been parsed.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.<br>
+ *											SBG_INVALID_FRAME if the payload is too small.
  */
 SbgErrorCode sbgEComBinaryLogParseUtcData(const void *pPayload, uint32 payloadSize, SbgLogUtcData *pOutputData)
 {
-	SbgStreamBuffer inputStream;
+	const uint8		*pBuffer = (const uint8*)pPayload;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
 
 	//
-	// Create an input stream to read the payload
+	// Check once that the payload contains all the required fields
 	//
-	sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+	if (payloadSize >= SBG_ECOM_LOG_PAYLOAD_SIZE(SBG_ECOM_LOG_UTC_FIELDS))
+	{
+		SBG_ECOM_LOG_READ_FIELDS(SBG_ECOM_LOG_UTC_FIELDS)
+	}
+	else
+	{
+		errorCode = SBG_INVALID_FRAME;
+	}
 
-	//
-	// Read the frame payload
-	//
-	pOutputData->timeStamp = sbgStreamBufferReadUint32LE(&inputStream);
-	pOutputData->status = sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->year = sbgStreamBufferReadUint16LE(&inputStream);
-	pOutputData->month = sbgStreamBufferReadInt8LE(&inputStream);
-	pOutputData->day = sbgStreamBufferReadInt8LE(&inputStream);
-	pOutputData->hour = sbgStreamBufferReadInt8LE(&inputStream);
-	pOutputData->minute = sbgStreamBufferReadInt8LE(&inputStream);
-	pOutputData->second = sbgStreamBufferReadInt8LE(&inputStream);
-	pOutputData->nanoSecond = sbgStreamBufferReadInt32LE(&inputStream);
-	pOutputData->gpsTimeOfWeek = sbgStreamBufferReadUint32LE(&inputStream);
-
-	//
-	// TODO: check for an error on the input stream such as buffer overflow
-	//
-	return SBG_NO_ERROR;
+	return errorCode;
 }
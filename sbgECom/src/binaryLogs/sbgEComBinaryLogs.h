@@ -31,6 +31,7 @@
 #include "sbgEComBinaryLogMag.h"
 #include "sbgEComBinaryLogOdometer.h"
 #include "sbgEComBinaryLogPressure.h"
+#include "sbgEComBinaryLogSchema.h"
 #include "sbgEComBinaryLogShipMotion.h"
 #include "sbgEComBinaryLogStatus.h"
 #include "sbgEComBinaryLogUsbl.h"
@@ -1,6 +1,36 @@
 #include "sbgEComCmdAdvanced.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ADVANCED_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComAdvancedConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdAdvancedParseConf(SbgStreamBuffer *pInputStream, SbgEComAdvancedConf *pConf)
+{
+	pConf->timeReference = (SbgEComTimeReferenceSrc)sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ADVANCED_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pConf						Pointer to the SbgEComAdvancedConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdAdvancedWriteConf(SbgStreamBuffer *pOutputStream, const SbgEComAdvancedConf *pConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->timeReference);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Event commands		                                               -//
 //----------------------------------------------------------------------//
@@ -64,7 +94,7 @@ SbgErrorCode sbgEComCmdAdvancedGetConf(SbgEComHandle *pHandle, SbgEComAdvancedCo
 					//
 					// Read parameters
 					//
-					pConf->timeReference = (SbgEComTimeReferenceSrc)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdAdvancedParseConf(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -129,7 +159,7 @@ SbgErrorCode sbgEComCmdAdvancedSetConf(SbgEComHandle *pHandle, const SbgEComAdva
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->timeReference);
+			sbgEComCmdAdvancedWriteConf(&outputStream, pConf);
 
 			//
 			// Send the payload over ECom
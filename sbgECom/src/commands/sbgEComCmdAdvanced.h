@@ -49,6 +49,26 @@ typedef struct _SbgEComAdvancedConf
 	SbgEComTimeReferenceSrc	timeReference;		/*!< Time reference source for clock alignment. */
 } SbgEComAdvancedConf;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ADVANCED_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComAdvancedConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdAdvancedParseConf(SbgStreamBuffer *pInputStream, SbgEComAdvancedConf *pConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ADVANCED_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pConf						Pointer to the SbgEComAdvancedConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdAdvancedWriteConf(SbgStreamBuffer *pOutputStream, const SbgEComAdvancedConf *pConf);
+
 //----------------------------------------------------------------------//
 //- Advanced commands			                                       -//
 //----------------------------------------------------------------------//
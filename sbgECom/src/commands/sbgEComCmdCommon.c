@@ -1,6 +1,37 @@
 #include "sbgEComCmdCommon.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a model info answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pModelInfo					Pointer to a SbgEComModelInfo struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdGenericParseModelInfo(SbgStreamBuffer *pInputStream, SbgEComModelInfo *pModelInfo)
+{
+	pModelInfo->id = sbgStreamBufferReadUint32LE(pInputStream);
+	pModelInfo->revision = sbgStreamBufferReadUint32LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a model id command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	modelId						Model id to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdGenericWriteModelId(SbgStreamBuffer *pOutputStream, uint32 modelId)
+{
+	sbgStreamBufferWriteUint32LE(pOutputStream, modelId);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Generic command definitions                                        -//
 //----------------------------------------------------------------------//
@@ -29,7 +60,7 @@ SbgErrorCode sbgEComCmdGenericSetModelId(SbgEComHandle *pHandle, uint16 command,
 		// Init stream buffer for output and Build payload
 		//
 		sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
-		sbgStreamBufferWriteUint32LE(&outputStream, modelId);
+		sbgEComCmdGenericWriteModelId(&outputStream, modelId);
 
 		//
 		// Send the command three times
@@ -136,8 +167,7 @@ SbgErrorCode sbgEComCmdGenericGetModelInfo(SbgEComHandle *pHandle, uint16 comman
 					//
 					// Read parameters
 					//
-					pModelInfo->id = sbgStreamBufferReadUint32LE(&inputStream);
-					pModelInfo->revision = sbgStreamBufferReadUint32LE(&inputStream);
+					errorCode = sbgEComCmdGenericParseModelInfo(&inputStream, pModelInfo);
 
 					//
 					// The command has been executed successfully so return
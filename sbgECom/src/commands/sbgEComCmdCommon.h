@@ -20,6 +20,7 @@
 #ifndef __SBG_ECOM_CMD_COMMON_H__
 #define __SBG_ECOM_CMD_COMMON_H__
 
+#include <streamBuffer/sbgStreamBuffer.h>
 #include "../sbgECom.h"
 
 //----------------------------------------------------------------------//
@@ -61,6 +62,26 @@ typedef struct _SbgEComModelInfo
 	uint32	revision;							/*!< Revision of the model */
 } SbgEComModelInfo;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a model info answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pModelInfo					Pointer to a SbgEComModelInfo struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdGenericParseModelInfo(SbgStreamBuffer *pInputStream, SbgEComModelInfo *pModelInfo);
+
+/*!
+ *	Write the payload of a model id command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	modelId						Model id to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdGenericWriteModelId(SbgStreamBuffer *pOutputStream, uint32 modelId);
+
 //----------------------------------------------------------------------//
 //- Generic command definitions                                        -//
 //----------------------------------------------------------------------//
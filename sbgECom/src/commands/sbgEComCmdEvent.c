@@ -1,6 +1,101 @@
 #include "sbgEComCmdEvent.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_SYNC_IN_CONF answer, the sync in id is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComSyncInConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSyncInParseConf(SbgStreamBuffer *pInputStream, SbgEComSyncInConf *pConf)
+{
+	sbgStreamBufferSeek(pInputStream, sizeof(uint8), SB_SEEK_CUR_INC);
+	pConf->sensitivity = (SbgEComSyncInSensitivity)sbgStreamBufferReadUint8LE(pInputStream);
+	pConf->delay = sbgStreamBufferReadInt32LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SYNC_IN_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	syncInId					The id of the sync in.
+ *	\param[in]	pConf						Pointer to the SbgEComSyncInConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSyncInWriteConf(SbgStreamBuffer *pOutputStream, SbgEComSyncInId syncInId, const SbgEComSyncInConf *pConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)syncInId);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->sensitivity);
+	sbgStreamBufferWriteInt32LE(pOutputStream, pConf->delay);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_SYNC_OUT_CONF answer, the sync out id and the reserved field are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComSyncOutConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSyncOutParseConf(SbgStreamBuffer *pInputStream, SbgEComSyncOutConf *pConf)
+{
+	sbgStreamBufferSeek(pInputStream, 2*sizeof(uint8), SB_SEEK_CUR_INC);
+	pConf->outputFunction = (SbgEComSyncOutFunction)sbgStreamBufferReadUint16LE(pInputStream);
+	pConf->polarity = (SbgEComSyncOutPolarity)sbgStreamBufferReadUint8LE(pInputStream);
+	pConf->duration = sbgStreamBufferReadUint32LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SYNC_OUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	syncOutId					The id of the sync out.
+ *	\param[in]	pConf						Pointer to the SbgEComSyncOutConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSyncOutWriteConf(SbgStreamBuffer *pOutputStream, SbgEComSyncOutId syncOutId, const SbgEComSyncOutConf *pConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)syncOutId);
+	sbgStreamBufferWriteUint8LE(pOutputStream, 0);
+	sbgStreamBufferWriteUint16LE(pOutputStream, (uint16)pConf->outputFunction);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->polarity);
+	sbgStreamBufferWriteUint32LE(pOutputStream, pConf->duration);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_VIRTUAL_ODOMETER_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pDistance					The distance of the virtual odometer pulse.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdVirtualOdometerParseConf(SbgStreamBuffer *pInputStream, float *pDistance)
+{
+	*pDistance = sbgStreamBufferReadFloatLE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_VIRTUAL_ODOMETER_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	distance					The distance of the virtual odometer pulse.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdVirtualOdometerWriteConf(SbgStreamBuffer *pOutputStream, float distance)
+{
+	sbgStreamBufferWriteFloatLE(pOutputStream, distance);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Event commands		                                               -//
 //----------------------------------------------------------------------//
@@ -66,9 +161,7 @@ SbgErrorCode sbgEComCmdSyncInGetConf(SbgEComHandle *pHandle, SbgEComSyncInId syn
 					// Read parameters
 					// First is returned the id of the sync, then the sensitivity and the delay at last.
 					//
-					syncInId = (SbgEComSyncInId)sbgStreamBufferReadUint8LE(&inputStream);					
-					pConf->sensitivity = (SbgEComSyncInSensitivity)sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->delay = sbgStreamBufferReadInt32LE(&inputStream);
+					errorCode = sbgEComCmdSyncInParseConf(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -129,9 +222,7 @@ SbgErrorCode sbgEComCmdSyncInSetConf(SbgEComHandle *pHandle, SbgEComSyncInId syn
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)syncInId);			
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->sensitivity);
-			sbgStreamBufferWriteInt32LE(&outputStream, pConf->delay);
+			sbgEComCmdSyncInWriteConf(&outputStream, syncInId, pConf);
 
 			//
 			// Build command
@@ -198,7 +289,6 @@ SbgErrorCode sbgEComCmdSyncOutGetConf(SbgEComHandle *pHandle, SbgEComSyncOutId s
 	uint16				receivedCmd;
 	uint32				receivedSize;
 	uint8				receivedBuffer[SBG_ECOM_MAX_BUFFER_SIZE];
-	uint8				reserved;
 	SbgStreamBuffer		inputStream;
 	SbgEComCmdId		cmd;
 
@@ -246,11 +336,7 @@ SbgErrorCode sbgEComCmdSyncOutGetConf(SbgEComHandle *pHandle, SbgEComSyncOutId s
 					// Read parameters
 					// First is returned the id of the sync, then a reserved field, the output function, polarity and the duration at last.
 					//
-					syncOutId = (SbgEComSyncOutId)sbgStreamBufferReadUint8LE(&inputStream);
-					reserved = sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->outputFunction = (SbgEComSyncOutFunction)sbgStreamBufferReadUint16LE(&inputStream);
-					pConf->polarity = (SbgEComSyncOutPolarity)sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->duration = sbgStreamBufferReadUint32LE(&inputStream);
+					errorCode = sbgEComCmdSyncOutParseConf(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -311,11 +397,7 @@ SbgErrorCode sbgEComCmdSyncOutSetConf(SbgEComHandle *pHandle, SbgEComSyncOutId s
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)syncOutId);
-			sbgStreamBufferWriteUint8LE(&outputStream, 0);
-			sbgStreamBufferWriteUint16LE(&outputStream, (uint16)pConf->outputFunction);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->polarity);
-			sbgStreamBufferWriteUint32LE(&outputStream, pConf->duration);
+			sbgEComCmdSyncOutWriteConf(&outputStream, syncOutId, pConf);
 
 			//
 			// Build command
@@ -428,7 +510,7 @@ SbgErrorCode sbgEComCmdVirtualOdometerGetConf(SbgEComHandle *pHandle, float *pDi
 					// Read parameters
 					// The only parameter returned is the distance between two pulses.
 					//
-					*pDistance = (SbgEComSyncOutId)sbgStreamBufferReadFloatLE(&inputStream);
+					errorCode = sbgEComCmdVirtualOdometerParseConf(&inputStream, pDistance);
 
 					//
 					// The command has been executed successfully so return
@@ -466,6 +548,8 @@ SbgErrorCode sbgEComCmdVirtualOdometerSetConf(SbgEComHandle *pHandle, float dist
 {
 	SbgErrorCode		errorCode = SBG_NO_ERROR;
 	uint32				trial;
+	uint8				outputBuffer[SBG_ECOM_MAX_BUFFER_SIZE];
+	SbgStreamBuffer		outputStream;
 	SbgEComCmdId		cmd;
 
 	//
@@ -478,15 +562,25 @@ SbgErrorCode sbgEComCmdVirtualOdometerSetConf(SbgEComHandle *pHandle, float dist
 		//
 		for (trial = 0; trial < 3; trial++)
 		{
+			//
+			// Init stream buffer for output
+			//
+			sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+
+			//
+			// Build payload
+			//
+			sbgEComCmdVirtualOdometerWriteConf(&outputStream, distance);
+
 			//
 			// Build command
 			//
 			cmd = SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_VIRTUAL_ODOMETER_CONF);
 
 			//
-			// Send the payload over ECom as a 4-byte payload
+			// Send the payload over ECom
 			//
-			errorCode = sbgEComProtocolSend(&pHandle->protocolHandle, cmd, &distance, sizeof(float));
+			errorCode = sbgEComProtocolSend(&pHandle->protocolHandle, cmd, sbgStreamBufferGetLinkedBuffer(&outputStream), sbgStreamBufferGetLength(&outputStream));
 
 			//
 			// Make sure that the command has been sent
@@ -112,6 +112,60 @@ typedef struct _SbgEComSyncOutConf
 	uint32						duration;		/*!< Pulse width for the sync out (in ns). */
 } SbgEComSyncOutConf;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_SYNC_IN_CONF answer, the sync in id is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComSyncInConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSyncInParseConf(SbgStreamBuffer *pInputStream, SbgEComSyncInConf *pConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SYNC_IN_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	syncInId					The id of the sync in.
+ *	\param[in]	pConf						Pointer to the SbgEComSyncInConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSyncInWriteConf(SbgStreamBuffer *pOutputStream, SbgEComSyncInId syncInId, const SbgEComSyncInConf *pConf);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_SYNC_OUT_CONF answer, the sync out id and the reserved field are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComSyncOutConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSyncOutParseConf(SbgStreamBuffer *pInputStream, SbgEComSyncOutConf *pConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SYNC_OUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	syncOutId					The id of the sync out.
+ *	\param[in]	pConf						Pointer to the SbgEComSyncOutConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSyncOutWriteConf(SbgStreamBuffer *pOutputStream, SbgEComSyncOutId syncOutId, const SbgEComSyncOutConf *pConf);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_VIRTUAL_ODOMETER_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pDistance					The distance of the virtual odometer pulse.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdVirtualOdometerParseConf(SbgStreamBuffer *pInputStream, float *pDistance);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_VIRTUAL_ODOMETER_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	distance					The distance of the virtual odometer pulse.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdVirtualOdometerWriteConf(SbgStreamBuffer *pOutputStream, float distance);
+
 //----------------------------------------------------------------------//
 //- Event commands				                                       -//
 //----------------------------------------------------------------------//
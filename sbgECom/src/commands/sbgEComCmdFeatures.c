@@ -1,6 +1,29 @@
 #include "sbgEComCmdFeatures.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_FEATURES answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pFeatures					Pointer to a SbgEComFeatures struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdParseFeatures(SbgStreamBuffer *pInputStream, SbgEComFeatures *pFeatures)
+{
+	pFeatures->sensorFeaturesMask = sbgStreamBufferReadUint32LE(pInputStream);
+	pFeatures->gnssType = (SbgEComGnssType)sbgStreamBufferReadUint8LE(pInputStream);
+	pFeatures->gnssUpdateRate = sbgStreamBufferReadUint8LE(pInputStream);
+	pFeatures->gnssSignalsMask = sbgStreamBufferReadUint32LE(pInputStream);
+	pFeatures->gnssFeaturesMask = sbgStreamBufferReadUint32LE(pInputStream);
+	sbgStreamBufferReadBuffer(pInputStream, pFeatures->gnssProductCode, 32*sizeof(char));
+	sbgStreamBufferReadBuffer(pInputStream, pFeatures->gnssSerialNumber, 32*sizeof(char));
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Features commands	                                               -//
 //----------------------------------------------------------------------//
@@ -64,13 +87,7 @@ SbgErrorCode sbgEComCmdGetFeatures(SbgEComHandle *pHandle, SbgEComFeatures *pFea
 					//
 					// Read parameters
 					//
-					pFeatures->sensorFeaturesMask	=  sbgStreamBufferReadUint32LE(&inputStream);
-					pFeatures->gnssType				= (SbgEComGnssType)sbgStreamBufferReadUint8LE(&inputStream);
-					pFeatures->gnssUpdateRate		= sbgStreamBufferReadUint8LE(&inputStream);
-					pFeatures->gnssSignalsMask		= sbgStreamBufferReadUint32LE(&inputStream);
-					pFeatures->gnssFeaturesMask		= sbgStreamBufferReadUint32LE(&inputStream);
-					sbgStreamBufferReadBuffer(&inputStream, pFeatures->gnssProductCode, 32*sizeof(char));
-					sbgStreamBufferReadBuffer(&inputStream, pFeatures->gnssSerialNumber, 32*sizeof(char));
+					errorCode = sbgEComCmdParseFeatures(&inputStream, pFeatures);
 
 					//
 					// The command has been executed successfully so return
@@ -95,6 +95,18 @@ typedef struct _SbgEComFeatures
 	char			gnssSerialNumber[32];		/*!< String containing the GNSS receiver serial number (\0 if unknown) */
 } SbgEComFeatures;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_FEATURES answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pFeatures					Pointer to a SbgEComFeatures struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdParseFeatures(SbgStreamBuffer *pInputStream, SbgEComFeatures *pFeatures);
+
 //----------------------------------------------------------------------//
 //- Info commands				                                       -//
 //----------------------------------------------------------------------//
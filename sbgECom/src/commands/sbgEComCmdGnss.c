@@ -2,6 +2,78 @@
 #include <streamBuffer/sbgStreamBuffer.h>
 #include "transfer/sbgEComTransfer.h"
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a GNSS lever arm and alignment answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pAlignConf					Pointer to a SbgEComGnssAlignmentInfo struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdGnssParseLeverArmAlignment(SbgStreamBuffer *pInputStream, SbgEComGnssAlignmentInfo *pAlignConf)
+{
+	pAlignConf->leverArmX = sbgStreamBufferReadFloatLE(pInputStream);
+	pAlignConf->leverArmY = sbgStreamBufferReadFloatLE(pInputStream);
+	pAlignConf->leverArmZ = sbgStreamBufferReadFloatLE(pInputStream);
+	pAlignConf->pitchOffset = sbgStreamBufferReadFloatLE(pInputStream);
+	pAlignConf->yawOffset = sbgStreamBufferReadFloatLE(pInputStream);
+	pAlignConf->antennaDistance = sbgStreamBufferReadFloatLE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a GNSS lever arm and alignment command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pAlignConf					Pointer to the SbgEComGnssAlignmentInfo struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdGnssWriteLeverArmAlignment(SbgStreamBuffer *pOutputStream, const SbgEComGnssAlignmentInfo *pAlignConf)
+{
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->leverArmX);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->leverArmY);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->leverArmZ);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->pitchOffset);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->yawOffset);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->antennaDistance);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a GNSS rejection answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pRejectConf					Pointer to a SbgEComGnssRejectionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdGnssParseRejection(SbgStreamBuffer *pInputStream, SbgEComGnssRejectionConf *pRejectConf)
+{
+	pRejectConf->position = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(pInputStream);
+	pRejectConf->velocity = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(pInputStream);
+	pRejectConf->course = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(pInputStream);
+	pRejectConf->hdt = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a GNSS rejection command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pRejectConf					Pointer to the SbgEComGnssRejectionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdGnssWriteRejection(SbgStreamBuffer *pOutputStream, const SbgEComGnssRejectionConf *pRejectConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pRejectConf->position);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pRejectConf->velocity);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pRejectConf->course);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pRejectConf->hdt);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- GNSS private commands                                              -//
 //----------------------------------------------------------------------//
@@ -150,12 +222,7 @@ SbgErrorCode sbgEComCmdGnssGetLeverArmAlignment(SbgEComHandle *pHandle, SbgEComG
 					//
 					// Read parameters
 					//
-					pAlignConf->leverArmX = sbgStreamBufferReadFloatLE(&inputStream);
-					pAlignConf->leverArmY = sbgStreamBufferReadFloatLE(&inputStream);
-					pAlignConf->leverArmZ = sbgStreamBufferReadFloatLE(&inputStream);
-					pAlignConf->pitchOffset = sbgStreamBufferReadFloatLE(&inputStream);
-					pAlignConf->yawOffset = sbgStreamBufferReadFloatLE(&inputStream);
-					pAlignConf->antennaDistance = sbgStreamBufferReadFloatLE(&inputStream);
+					errorCode = sbgEComCmdGnssParseLeverArmAlignment(&inputStream, pAlignConf);
 
 					//
 					// The command has been executed successfully so return
@@ -216,12 +283,7 @@ SbgErrorCode sbgEComCmdGnssSetLeverArmAlignment(SbgEComHandle *pHandle, const Sb
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->leverArmX);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->leverArmY);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->leverArmZ);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->pitchOffset);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->yawOffset);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->antennaDistance);
+			sbgEComCmdGnssWriteLeverArmAlignment(&outputStream, pAlignConf);
 
 			//
 			// Build command
@@ -334,10 +396,7 @@ SbgErrorCode sbgEComCmdGnssGetRejection(SbgEComHandle *pHandle, SbgEComGnssRejec
 					//
 					// Read parameters
 					//
-					pRejectConf->position = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(&inputStream);
-					pRejectConf->velocity = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(&inputStream);
-					pRejectConf->course = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(&inputStream);
-					pRejectConf->hdt = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdGnssParseRejection(&inputStream, pRejectConf);
 
 					//
 					// The command has been executed successfully so return
@@ -398,10 +457,7 @@ SbgErrorCode sbgEComCmdGnssSetRejection(SbgEComHandle *pHandle, const SbgEComGns
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pRejectConf->position);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pRejectConf->velocity);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pRejectConf->course);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pRejectConf->hdt);
+			sbgEComCmdGnssWriteRejection(&outputStream, pRejectConf);
 
 			//
 			// Build command
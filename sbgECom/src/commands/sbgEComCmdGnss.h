@@ -67,6 +67,42 @@ typedef struct _SbgEComGnssRejectionConf
 	SbgEComRejectionMode	hdt;			/*!< Rejection mode for true heading. */
 } SbgEComGnssRejectionConf;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a GNSS lever arm and alignment answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pAlignConf					Pointer to a SbgEComGnssAlignmentInfo struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdGnssParseLeverArmAlignment(SbgStreamBuffer *pInputStream, SbgEComGnssAlignmentInfo *pAlignConf);
+
+/*!
+ *	Write the payload of a GNSS lever arm and alignment command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pAlignConf					Pointer to the SbgEComGnssAlignmentInfo struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdGnssWriteLeverArmAlignment(SbgStreamBuffer *pOutputStream, const SbgEComGnssAlignmentInfo *pAlignConf);
+
+/*!
+ *	Parse the payload of a GNSS rejection answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pRejectConf					Pointer to a SbgEComGnssRejectionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdGnssParseRejection(SbgStreamBuffer *pInputStream, SbgEComGnssRejectionConf *pRejectConf);
+
+/*!
+ *	Write the payload of a GNSS rejection command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pRejectConf					Pointer to the SbgEComGnssRejectionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdGnssWriteRejection(SbgStreamBuffer *pOutputStream, const SbgEComGnssRejectionConf *pRejectConf);
+
 //----------------------------------------------------------------------//
 //- GNSS public commands		                                       -//
 //----------------------------------------------------------------------//
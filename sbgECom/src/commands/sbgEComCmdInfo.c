@@ -1,6 +1,30 @@
 #include "sbgEComCmdInfo.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_INFO answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pInfo						Pointer to a SbgEComDeviceInfo struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdParseInfo(SbgStreamBuffer *pInputStream, SbgEComDeviceInfo *pInfo)
+{
+	sbgStreamBufferReadBuffer(pInputStream, pInfo->productCode, SBG_ECOM_INFO_PRODUCT_CODE_LENGTH);
+	pInfo->serialNumber = sbgStreamBufferReadUint32LE(pInputStream);
+	pInfo->calibationRev = sbgStreamBufferReadUint32LE(pInputStream);
+	pInfo->calibrationYear = sbgStreamBufferReadUint16LE(pInputStream);
+	pInfo->calibrationMonth = sbgStreamBufferReadUint8LE(pInputStream);
+	pInfo->calibrationDay = sbgStreamBufferReadUint8LE(pInputStream);
+	pInfo->hardwareRev = sbgStreamBufferReadUint32LE(pInputStream);
+	pInfo->firmwareRev = sbgStreamBufferReadUint32LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Info commands		                                               -//
 //----------------------------------------------------------------------//
@@ -64,14 +88,7 @@ SbgErrorCode sbgEComCmdGetInfo(SbgEComHandle *pHandle, SbgEComDeviceInfo *pInfo)
 					//
 					// Read parameters
 					//
-					sbgStreamBufferReadBuffer(&inputStream, pInfo->productCode, SBG_ECOM_INFO_PRODUCT_CODE_LENGTH);
-					pInfo->serialNumber		= sbgStreamBufferReadUint32LE(&inputStream);
-					pInfo->calibationRev	= sbgStreamBufferReadUint32LE(&inputStream);
-					pInfo->calibrationYear	= sbgStreamBufferReadUint16LE(&inputStream);
-					pInfo->calibrationMonth = sbgStreamBufferReadUint8LE(&inputStream);
-					pInfo->calibrationDay	= sbgStreamBufferReadUint8LE(&inputStream);
-					pInfo->hardwareRev		= sbgStreamBufferReadUint32LE(&inputStream);
-					pInfo->firmwareRev		= sbgStreamBufferReadUint32LE(&inputStream);
+					errorCode = sbgEComCmdParseInfo(&inputStream, pInfo);
 
 					//
 					// The command has been executed successfully so return
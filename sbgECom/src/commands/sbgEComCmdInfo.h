@@ -48,6 +48,18 @@ typedef struct _SbgEComDeviceInfo
 	uint32	firmwareRev;									/*!< Firmware revision */
 } SbgEComDeviceInfo;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_INFO answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pInfo						Pointer to a SbgEComDeviceInfo struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdParseInfo(SbgStreamBuffer *pInputStream, SbgEComDeviceInfo *pInfo);
+
 //----------------------------------------------------------------------//
 //- Info commands				                                       -//
 //----------------------------------------------------------------------//
@@ -1,6 +1,67 @@
 #include "sbgEComCmdInterface.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_UART_CONF answer, the interface id is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComInterfaceConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdInterfaceParseUartConf(SbgStreamBuffer *pInputStream, SbgEComInterfaceConf *pConf)
+{
+	sbgStreamBufferSeek(pInputStream, sizeof(uint8), SB_SEEK_CUR_INC);
+	pConf->baudRate = sbgStreamBufferReadUint32LE(pInputStream);
+	pConf->mode = (SbgEComPortMode)sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_UART_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	interfaceId					The interface id.
+ *	\param[in]	pConf						Pointer to the SbgEComInterfaceConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdInterfaceWriteUartConf(SbgStreamBuffer *pOutputStream, SbgEComPortId interfaceId, const SbgEComInterfaceConf *pConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)interfaceId);
+	sbgStreamBufferWriteUint32LE(pOutputStream, pConf->baudRate);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->mode);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_CAN_BUS_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pBitrate					The CAN bitrate.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdInterfaceParseCanConf(SbgStreamBuffer *pInputStream, SbgEComCanBitRate *pBitrate)
+{
+	*pBitrate = (SbgEComCanBitRate)sbgStreamBufferReadUint16LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_CAN_BUS_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	bitrate						The CAN bitrate.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdInterfaceWriteCanConf(SbgStreamBuffer *pOutputStream, SbgEComCanBitRate bitrate)
+{
+	sbgStreamBufferWriteUint16LE(pOutputStream, (uint16)bitrate);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Interface commands                                                 -//
 //----------------------------------------------------------------------//
@@ -66,9 +127,7 @@ SbgErrorCode sbgEComCmdInterfaceGetUartConf(SbgEComHandle *pHandle, SbgEComPortI
 					// Read parameters
 					// First is returned interfaceId, then baud rate and the mode at last.
 					//
-					interfaceId = (SbgEComPortId)sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->baudRate = sbgStreamBufferReadUint32LE(&inputStream);
-					pConf->mode = (SbgEComPortMode)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdInterfaceParseUartConf(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -129,9 +188,7 @@ SbgErrorCode sbgEComCmdInterfaceSetUartConf(SbgEComHandle *pHandle, SbgEComPortI
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)interfaceId);
-			sbgStreamBufferWriteUint32LE(&outputStream, pConf->baudRate);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->mode);
+			sbgEComCmdInterfaceWriteUartConf(&outputStream, interfaceId, pConf);
 
 			//
 			// Build command
@@ -243,7 +300,7 @@ SbgErrorCode sbgEComCmdInterfaceGetCanConf(SbgEComHandle *pHandle, SbgEComCanBit
 					//
 					// Read bit rate returned by the device
 					//
-					*pBitrate = (SbgEComCanBitRate)sbgStreamBufferReadUint16LE(&inputStream);
+					errorCode = sbgEComCmdInterfaceParseCanConf(&inputStream, pBitrate);
 
 					//
 					// The command has been executed successfully so return
@@ -281,6 +338,8 @@ SbgErrorCode sbgEComCmdInterfaceSetCanConf(SbgEComHandle *pHandle, SbgEComCanBit
 {
 	SbgErrorCode		errorCode = SBG_NO_ERROR;
 	uint32				trial;
+	uint8				outputBuffer[SBG_ECOM_MAX_BUFFER_SIZE];
+	SbgStreamBuffer		outputStream;
 	SbgEComCmdId		cmd;
 
 	//
@@ -293,6 +352,16 @@ SbgErrorCode sbgEComCmdInterfaceSetCanConf(SbgEComHandle *pHandle, SbgEComCanBit
 		//
 		for (trial = 0; trial < 3; trial++)
 		{
+			//
+			// Init stream buffer for output
+			//
+			sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+
+			//
+			// Build payload
+			//
+			sbgEComCmdInterfaceWriteCanConf(&outputStream, bitrate);
+
 			//
 			// Build command
 			//
@@ -301,7 +370,7 @@ SbgErrorCode sbgEComCmdInterfaceSetCanConf(SbgEComHandle *pHandle, SbgEComCanBit
 			//
 			// Send the payload over ECom
 			//
-			errorCode = sbgEComProtocolSend(&pHandle->protocolHandle, cmd, &bitrate, sizeof(uint16));
+			errorCode = sbgEComProtocolSend(&pHandle->protocolHandle, cmd, sbgStreamBufferGetLinkedBuffer(&outputStream), sbgStreamBufferGetLength(&outputStream));
 
 			//
 			// Make sure that the command has been sent
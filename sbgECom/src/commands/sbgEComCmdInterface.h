@@ -83,6 +83,43 @@ typedef enum _SbgEComCanBitRate
 	SBG_ECOM_CAN_BITRATE_1000 		= 1000			/*!< 1Mb/s. */
 } SbgEComCanBitRate;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_UART_CONF answer, the interface id is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComInterfaceConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdInterfaceParseUartConf(SbgStreamBuffer *pInputStream, SbgEComInterfaceConf *pConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_UART_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	interfaceId					The interface id.
+ *	\param[in]	pConf						Pointer to the SbgEComInterfaceConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdInterfaceWriteUartConf(SbgStreamBuffer *pOutputStream, SbgEComPortId interfaceId, const SbgEComInterfaceConf *pConf);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_CAN_BUS_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pBitrate					The CAN bitrate.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdInterfaceParseCanConf(SbgStreamBuffer *pInputStream, SbgEComCanBitRate *pBitrate);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_CAN_BUS_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	bitrate						The CAN bitrate.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdInterfaceWriteCanConf(SbgStreamBuffer *pOutputStream, SbgEComCanBitRate bitrate);
+
 //----------------------------------------------------------------------//
 //- Interface commands                                                 -//
 //----------------------------------------------------------------------//
@@ -2,6 +2,120 @@
 #include <streamBuffer/sbgStreamBuffer.h>
 #include "transfer/sbgEComTransfer.h"
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SET_MAG_CALIB command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	offset						Magnetometers calibration offset vector.
+ *	\param[in]	matrix						Magnetometers calibration 3x3 matrix.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdMagWriteCalibData(SbgStreamBuffer *pOutputStream, const float offset[3], const float matrix[9])
+{
+	uint32		i;
+
+	for (i = 0; i < 3; i++)
+	{
+		sbgStreamBufferWriteFloatLE(pOutputStream, offset[i]);
+	}
+
+	for (i = 0; i < 9; i++)
+	{
+		sbgStreamBufferWriteFloatLE(pOutputStream, matrix[i]);
+	}
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_MAGNETOMETER_REJECT_MODE answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pRejectConf					Pointer to a SbgEComMagRejectionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdMagParseRejection(SbgStreamBuffer *pInputStream, SbgEComMagRejectionConf *pRejectConf)
+{
+	pRejectConf->magneticField = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_MAGNETOMETER_REJECT_MODE command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pRejectConf					Pointer to the SbgEComMagRejectionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdMagWriteRejection(SbgStreamBuffer *pOutputStream, const SbgEComMagRejectionConf *pRejectConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pRejectConf->magneticField);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_START_MAG_CALIB command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	mode						Define which magnetic calibration type to perform.
+ *	\param[in]	bandwidth					Define the magnetic calibration bandwidth.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdMagWriteStartCalib(SbgStreamBuffer *pOutputStream, SbgEComMagCalibMode mode, SbgEComMagCalibBandwidth bandwidth)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)mode);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)bandwidth);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_COMPUTE_MAG_CALIB answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pCalibResults				Pointer to a SbgEComMagCalibResults struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdMagParseCalibResults(SbgStreamBuffer *pInputStream, SbgEComMagCalibResults *pCalibResults)
+{
+	uint32		i;
+
+	pCalibResults->quality = (SbgEComMagCalibQuality)sbgStreamBufferReadUint8LE(pInputStream);
+	pCalibResults->confidence = (SbgEComMagCalibConfidence)sbgStreamBufferReadUint8LE(pInputStream);
+	pCalibResults->advancedStatus = sbgStreamBufferReadUint16LE(pInputStream);
+
+	pCalibResults->beforeMeanError = sbgStreamBufferReadFloatLE(pInputStream);
+	pCalibResults->beforeStdError = sbgStreamBufferReadFloatLE(pInputStream);
+	pCalibResults->beforeMaxError = sbgStreamBufferReadFloatLE(pInputStream);
+
+	pCalibResults->afterMeanError = sbgStreamBufferReadFloatLE(pInputStream);
+	pCalibResults->afterStdError = sbgStreamBufferReadFloatLE(pInputStream);
+	pCalibResults->afterMaxError = sbgStreamBufferReadFloatLE(pInputStream);
+
+	pCalibResults->meanAccuracy = sbgStreamBufferReadFloatLE(pInputStream);
+	pCalibResults->stdAccuracy = sbgStreamBufferReadFloatLE(pInputStream);
+	pCalibResults->maxAccuracy = sbgStreamBufferReadFloatLE(pInputStream);
+
+	pCalibResults->numPoints = sbgStreamBufferReadUint16LE(pInputStream);
+	pCalibResults->maxNumPoints = sbgStreamBufferReadUint16LE(pInputStream);
+
+	//
+	// Read the computed hard iron offset vector and soft iron matrix
+	//
+	for (i = 0; i < 3; i++)
+	{
+		pCalibResults->offset[i] = sbgStreamBufferReadFloatLE(pInputStream);
+	}
+
+	for (i = 0; i < 9; i++)
+	{
+		pCalibResults->matrix[i] = sbgStreamBufferReadFloatLE(pInputStream);
+	}
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Magnetometer commands                                              -//
 //----------------------------------------------------------------------//
@@ -101,7 +215,6 @@ SbgErrorCode sbgEComCmdMagSetCalibData(SbgEComHandle *pHandle, const float offse
 	SbgStreamBuffer		outputStream;
 	uint8				payload[12*sizeof(float)];
 	uint32				trial;
-	uint32				i;
 	SbgEComCmdId		cmd;
 
 	//
@@ -115,19 +228,9 @@ SbgErrorCode sbgEComCmdMagSetCalibData(SbgEComHandle *pHandle, const float offse
 		errorCode = sbgStreamBufferInitForWrite(&outputStream, payload, sizeof(payload));
 
 		//
-		// Write the offset vector
+		// Write the offset vector and the matrix
 		//
-		sbgStreamBufferWriteFloatLE(&outputStream, offset[0]);
-		sbgStreamBufferWriteFloatLE(&outputStream, offset[1]);
-		sbgStreamBufferWriteFloatLE(&outputStream, offset[2]);
-
-		//
-		// Write the matrix
-		//
-		for (i = 0; i < 9; i++)
-		{
-			sbgStreamBufferWriteFloatLE(&outputStream, matrix[i]);
-		}
+		sbgEComCmdMagWriteCalibData(&outputStream, offset, matrix);
 
 		//
 		// Build frame identifier based on message class and command id
@@ -250,7 +353,7 @@ SbgErrorCode sbgEComCmdMagGetRejection(SbgEComHandle *pHandle, SbgEComMagRejecti
 					//
 					// Read parameters
 					//
-					pRejectConf->magneticField = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdMagParseRejection(&inputStream, pRejectConf);
 
 					//
 					// The command has been executed successfully so return
@@ -315,7 +418,7 @@ SbgErrorCode sbgEComCmdMagSetRejection(SbgEComHandle *pHandle, const SbgEComMagR
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pRejectConf->magneticField);
+			sbgEComCmdMagWriteRejection(&outputStream, pRejectConf);
 
 			//
 			// Send the payload over ECom
@@ -397,8 +500,7 @@ SbgErrorCode sbgEComCmdMagStartCalib(SbgEComHandle *pHandle, SbgEComMagCalibMode
 		//
 		// Write the calibration mode and bandwith
 		//
-		sbgStreamBufferWriteUint8LE(&outputStream, (uint8)mode);
-		sbgStreamBufferWriteUint8LE(&outputStream, (uint8)bandwidth);
+		sbgEComCmdMagWriteStartCalib(&outputStream, mode, bandwidth);
 
 		//
 		// Build frame identifier based on message class and command id
@@ -478,7 +580,6 @@ SbgErrorCode sbgEComCmdMagComputeCalib(SbgEComHandle *pHandle, SbgEComMagCalibRe
 	uint8				receivedBuffer[SBG_ECOM_MAX_BUFFER_SIZE];
 	SbgStreamBuffer		inputStream;
 	SbgEComCmdId		cmd;
-	uint32				i;
 
 	//
 	// Test that the input pointer are valid
@@ -521,41 +622,9 @@ SbgErrorCode sbgEComCmdMagComputeCalib(SbgEComHandle *pHandle, SbgEComMagCalibRe
 					sbgStreamBufferInitForRead(&inputStream, receivedBuffer, receivedSize);
 
 					//
-					// Read quality and status parameters
-					//
-					pCalibResults->quality			= (SbgEComMagCalibQuality)sbgStreamBufferReadUint8LE(&inputStream);
-					pCalibResults->confidence		= (SbgEComMagCalibConfidence)sbgStreamBufferReadUint8LE(&inputStream);
-					pCalibResults->advancedStatus	= sbgStreamBufferReadUint16LE(&inputStream);
-
-					pCalibResults->beforeMeanError	= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->beforeStdError	= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->beforeMaxError	= sbgStreamBufferReadFloatLE(&inputStream);
-
-					pCalibResults->afterMeanError	= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->afterStdError	= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->afterMaxError	= sbgStreamBufferReadFloatLE(&inputStream);
-
-					pCalibResults->meanAccuracy		= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->stdAccuracy		= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->maxAccuracy		= sbgStreamBufferReadFloatLE(&inputStream);
-
-					pCalibResults->numPoints		= sbgStreamBufferReadUint16LE(&inputStream);
-					pCalibResults->maxNumPoints		= sbgStreamBufferReadUint16LE(&inputStream);
-
-					//
-					// Read the computed hard iron offset vector
-					//
-					pCalibResults->offset[0]		= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->offset[1]		= sbgStreamBufferReadFloatLE(&inputStream);
-					pCalibResults->offset[2]		= sbgStreamBufferReadFloatLE(&inputStream);
-
-					//
-					// Read the computed soft iron matrix
+					// Read parameters
 					//
-					for (i = 0; i < 9; i++)
-					{
-						pCalibResults->matrix[i]	= sbgStreamBufferReadFloatLE(&inputStream);
-					}
+					errorCode = sbgEComCmdMagParseCalibResults(&inputStream, pCalibResults);
 
 					//
 					// The command has been executed successfully so return
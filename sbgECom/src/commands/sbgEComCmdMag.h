@@ -131,6 +131,52 @@ typedef struct _SbgEComMagCalibResults
 	float						matrix[9];					/*!< Computed Hard & Soft Iron correction matrix. */
 } SbgEComMagCalibResults;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SET_MAG_CALIB command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	offset						Magnetometers calibration offset vector.
+ *	\param[in]	matrix						Magnetometers calibration 3x3 matrix.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdMagWriteCalibData(SbgStreamBuffer *pOutputStream, const float offset[3], const float matrix[9]);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_MAGNETOMETER_REJECT_MODE answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pRejectConf					Pointer to a SbgEComMagRejectionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdMagParseRejection(SbgStreamBuffer *pInputStream, SbgEComMagRejectionConf *pRejectConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_MAGNETOMETER_REJECT_MODE command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pRejectConf					Pointer to the SbgEComMagRejectionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdMagWriteRejection(SbgStreamBuffer *pOutputStream, const SbgEComMagRejectionConf *pRejectConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_START_MAG_CALIB command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	mode						Define which magnetic calibration type to perform.
+ *	\param[in]	bandwidth					Define the magnetic calibration bandwidth.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdMagWriteStartCalib(SbgStreamBuffer *pOutputStream, SbgEComMagCalibMode mode, SbgEComMagCalibBandwidth bandwidth);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_COMPUTE_MAG_CALIB answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pCalibResults				Pointer to a SbgEComMagCalibResults struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdMagParseCalibResults(SbgStreamBuffer *pInputStream, SbgEComMagCalibResults *pCalibResults);
+
 //----------------------------------------------------------------------//
 //- Magnetometer commands		                                       -//
 //----------------------------------------------------------------------//
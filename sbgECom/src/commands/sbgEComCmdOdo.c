@@ -1,6 +1,96 @@
 #include "sbgEComCmdOdo.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ODO_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pOdometerConf				Pointer to a SbgEComOdoConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOdoParseConf(SbgStreamBuffer *pInputStream, SbgEComOdoConf *pOdometerConf)
+{
+	pOdometerConf->gain = sbgStreamBufferReadFloatLE(pInputStream);
+	pOdometerConf->gainError = sbgStreamBufferReadUint8LE(pInputStream);
+	pOdometerConf->reverseMode = (sbgStreamBufferReadUint8LE(pInputStream) != 0);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ODO_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pOdometerConf				Pointer to the SbgEComOdoConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOdoWriteConf(SbgStreamBuffer *pOutputStream, const SbgEComOdoConf *pOdometerConf)
+{
+	sbgStreamBufferWriteFloatLE(pOutputStream, pOdometerConf->gain);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pOdometerConf->gainError);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pOdometerConf->reverseMode);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ODO_LEVER_ARM answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOdoParseLeverArm(SbgStreamBuffer *pInputStream, float leverArm[3])
+{
+	leverArm[0] = sbgStreamBufferReadFloatLE(pInputStream);
+	leverArm[1] = sbgStreamBufferReadFloatLE(pInputStream);
+	leverArm[2] = sbgStreamBufferReadFloatLE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ODO_LEVER_ARM command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOdoWriteLeverArm(SbgStreamBuffer *pOutputStream, const float leverArm[3])
+{
+	sbgStreamBufferWriteFloatLE(pOutputStream, leverArm[0]);
+	sbgStreamBufferWriteFloatLE(pOutputStream, leverArm[1]);
+	sbgStreamBufferWriteFloatLE(pOutputStream, leverArm[2]);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ODO_REJECT_MODE answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pRejectConf					Pointer to a SbgEComOdoRejectionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOdoParseRejection(SbgStreamBuffer *pInputStream, SbgEComOdoRejectionConf *pRejectConf)
+{
+	pRejectConf->velocity = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ODO_REJECT_MODE command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pRejectConf					Pointer to the SbgEComOdoRejectionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOdoWriteRejection(SbgStreamBuffer *pOutputStream, const SbgEComOdoRejectionConf *pRejectConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pRejectConf->velocity);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Odometer commands	                                               -//
 //----------------------------------------------------------------------//
@@ -64,9 +154,7 @@ SbgErrorCode sbgEComCmdOdoGetConf(SbgEComHandle *pHandle, SbgEComOdoConf *pOdome
 					//
 					// Read parameters
 					//
-					pOdometerConf->gain = sbgStreamBufferReadFloatLE(&inputStream);
-					pOdometerConf->gainError = sbgStreamBufferReadUint8LE(&inputStream);
-					pOdometerConf->reverseMode = sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdOdoParseConf(&inputStream, pOdometerConf);
 
 					//
 					// The command has been executed successfully so return
@@ -126,9 +214,7 @@ SbgErrorCode sbgEComCmdOdoSetConf(SbgEComHandle *pHandle, const SbgEComOdoConf *
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteFloatLE(&outputStream, pOdometerConf->gain);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pOdometerConf->gainError);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pOdometerConf->reverseMode);
+			sbgEComCmdOdoWriteConf(&outputStream, pOdometerConf);
 
 			//
 			// Build command
@@ -240,9 +326,7 @@ SbgErrorCode sbgEComCmdOdoGetLeverArm(SbgEComHandle *pHandle, float leverArm[3])
 					//
 					// Read parameters
 					//
-					leverArm[0] = sbgStreamBufferReadFloatLE(&inputStream);
-					leverArm[1] = sbgStreamBufferReadFloatLE(&inputStream);
-					leverArm[2] = sbgStreamBufferReadFloatLE(&inputStream);
+					errorCode = sbgEComCmdOdoParseLeverArm(&inputStream, leverArm);
 
 					//
 					// The command has been executed successfully so return
@@ -302,9 +386,7 @@ SbgErrorCode sbgEComCmdOdoSetLeverArm(SbgEComHandle *pHandle, const float leverA
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteFloatLE(&outputStream, leverArm[0]);
-			sbgStreamBufferWriteFloatLE(&outputStream, leverArm[1]);
-			sbgStreamBufferWriteFloatLE(&outputStream, leverArm[2]);
+			sbgEComCmdOdoWriteLeverArm(&outputStream, leverArm);
 
 			//
 			// Build command
@@ -416,7 +498,7 @@ SbgErrorCode sbgEComCmdOdoGetRejection(SbgEComHandle *pHandle, SbgEComOdoRejecti
 					//
 					// Read parameters
 					//
-					pRejectConf->velocity = (SbgEComRejectionMode)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdOdoParseRejection(&inputStream, pRejectConf);
 
 					//
 					// The command has been executed successfully so return
@@ -476,7 +558,7 @@ SbgErrorCode sbgEComCmdOdoSetRejection(SbgEComHandle *pHandle, const SbgEComOdoR
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pRejectConf->velocity);
+			sbgEComCmdOdoWriteRejection(&outputStream, pRejectConf);
 
 			//
 			// Build command
@@ -48,6 +48,58 @@ typedef struct _SbgEComOdoRejectionConf
 	SbgEComRejectionMode	velocity;		/*!< Rejection mode for velocity. */
 } SbgEComOdoRejectionConf;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ODO_CONF answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pOdometerConf				Pointer to a SbgEComOdoConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOdoParseConf(SbgStreamBuffer *pInputStream, SbgEComOdoConf *pOdometerConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ODO_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pOdometerConf				Pointer to the SbgEComOdoConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOdoWriteConf(SbgStreamBuffer *pOutputStream, const SbgEComOdoConf *pOdometerConf);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ODO_LEVER_ARM answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOdoParseLeverArm(SbgStreamBuffer *pInputStream, float leverArm[3]);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ODO_LEVER_ARM command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOdoWriteLeverArm(SbgStreamBuffer *pOutputStream, const float leverArm[3]);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_ODO_REJECT_MODE answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pRejectConf					Pointer to a SbgEComOdoRejectionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOdoParseRejection(SbgStreamBuffer *pInputStream, SbgEComOdoRejectionConf *pRejectConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_ODO_REJECT_MODE command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pRejectConf					Pointer to the SbgEComOdoRejectionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOdoWriteRejection(SbgStreamBuffer *pOutputStream, const SbgEComOdoRejectionConf *pRejectConf);
+
 //----------------------------------------------------------------------//
 //- Odometer commands												   -//
 //----------------------------------------------------------------------//
@@ -1,6 +1,177 @@
 #include "sbgEComCmdOutput.h"
 #include <streamBuffer/sbgStreamBuffer.h>
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_OUTPUT_CONF answer, the output port, message id and class are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pMode						The output mode of the message.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputParseConf(SbgStreamBuffer *pInputStream, SbgEComOutputMode *pMode)
+{
+	sbgStreamBufferSeek(pInputStream, 3*sizeof(uint8), SB_SEEK_CUR_INC);
+	*pMode = (SbgEComOutputMode)sbgStreamBufferReadUint16LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_OUTPUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port of the device for the log concerned.
+ *	\param[in]	classId						The class of the concerned log.
+ *	\param[in]	msgId						The id of the log.
+ *	\param[in]	mode						The output mode of the message.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputWriteConf(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId, SbgEComOutputMode mode)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)outputPort);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)msgId);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)classId);
+	sbgStreamBufferWriteUint16LE(pOutputStream, (uint16)mode);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_OUTPUT_CLASS_ENABLE answer, the output port and class are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pEnable						TRUE if the output class is enabled.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputClassParseEnable(SbgStreamBuffer *pInputStream, bool *pEnable)
+{
+	sbgStreamBufferSeek(pInputStream, 2*sizeof(uint8), SB_SEEK_CUR_INC);
+	*pEnable = (sbgStreamBufferReadUint8LE(pInputStream) != 0);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_OUTPUT_CLASS_ENABLE command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port.
+ *	\param[in]	classId						The output class id.
+ *	\param[in]	enable						TRUE to enable the output class.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputClassWriteEnable(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, SbgEComClass classId, bool enable)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)outputPort);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)classId);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)enable);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_CAN_OUTPUT_CONF answer, the internal message id is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pMode						The output mode of the message.
+ *	\param[out]	pUserId						The user defined id of the message.
+ *	\param[out]	pExtended					TRUE if the user id uses the extended format.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdCanOutputParseConf(SbgStreamBuffer *pInputStream, SbgEComOutputMode *pMode, uint32 *pUserId, bool *pExtended)
+{
+	sbgStreamBufferSeek(pInputStream, sizeof(uint16), SB_SEEK_CUR_INC);
+	*pMode = (SbgEComOutputMode)sbgStreamBufferReadUint16LE(pInputStream);
+	*pUserId = sbgStreamBufferReadUint32LE(pInputStream);
+	*pExtended = (sbgStreamBufferReadUint8LE(pInputStream) != 0);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_CAN_OUTPUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	internalId					The internal message id.
+ *	\param[in]	mode						The output mode of the message.
+ *	\param[in]	userId						The user defined id of the message.
+ *	\param[in]	extended					TRUE if the user id uses the extended format.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdCanOutputWriteConf(SbgStreamBuffer *pOutputStream, SbgECanMessageId internalId, SbgEComOutputMode mode, uint32 userId, bool extended)
+{
+	sbgStreamBufferWriteUint16LE(pOutputStream, (uint16)internalId);
+	sbgStreamBufferWriteUint16LE(pOutputStream, (uint16)mode);
+	sbgStreamBufferWriteUint32LE(pOutputStream, userId);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)extended);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_LEGACY_CONT_OUTPUT_CONF answer, the output port is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComLegacyConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputParseLegacyConf(SbgStreamBuffer *pInputStream, SbgEComLegacyConf *pConf)
+{
+	sbgStreamBufferSeek(pInputStream, sizeof(uint8), SB_SEEK_CUR_INC);
+	pConf->mask = sbgStreamBufferReadUint32LE(pInputStream);
+	pConf->format = (SbgEComLegacyFormat)sbgStreamBufferReadUint8LE(pInputStream);
+	pConf->endian = (SbgEComLegacyEndian)sbgStreamBufferReadUint8LE(pInputStream);
+	pConf->mode = (SbgEComOutputMode)sbgStreamBufferReadUint16LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_LEGACY_CONT_OUTPUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port.
+ *	\param[in]	pConf						Pointer to the SbgEComLegacyConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputWriteLegacyConf(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, const SbgEComLegacyConf *pConf)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)outputPort);
+	sbgStreamBufferWriteUint32LE(pOutputStream, pConf->mask);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->format);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->endian);
+	sbgStreamBufferWriteUint16LE(pOutputStream, (uint16)pConf->mode);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_NMEA_TALKER_ID answer, the output port is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	nmeaTalkerId				A 2-char array to hold the NMEA talker id.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputParseNmeaTalkerId(SbgStreamBuffer *pInputStream, char nmeaTalkerId[2])
+{
+	sbgStreamBufferSeek(pInputStream, sizeof(uint8), SB_SEEK_CUR_INC);
+	nmeaTalkerId[0] = (char)sbgStreamBufferReadUint8LE(pInputStream);
+	nmeaTalkerId[1] = (char)sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_NMEA_TALKER_ID command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port.
+ *	\param[in]	nmeaTalkerId				A 2-char array holding the NMEA talker id.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputWriteNmeaTalkerId(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, const char nmeaTalkerId[2])
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)outputPort);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)nmeaTalkerId[0]);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)nmeaTalkerId[1]);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Output commands		                                               -//
 //----------------------------------------------------------------------//
@@ -83,10 +254,7 @@ SbgErrorCode sbgEComCmdOutputGetConf(SbgEComHandle *pHandle, SbgEComOutputPort o
 					// Read parameters
 					// First is returned outputPort, then messageId, classId rate and the output configuration at last.
 					//
-					outputPort = (SbgEComOutputPort)sbgStreamBufferReadUint8LE(&inputStream);
-					msgId = sbgStreamBufferReadUint8LE(&inputStream);
-					classId = (SbgEComClass)sbgStreamBufferReadUint8LE(&inputStream);
-					*pConf = (SbgEComOutputMode)sbgStreamBufferReadUint16LE(&inputStream);
+					errorCode = sbgEComCmdOutputParseConf(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -149,10 +317,7 @@ SbgErrorCode sbgEComCmdOutputSetConf(SbgEComHandle *pHandle, SbgEComOutputPort o
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)outputPort);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)msgId);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)classId);
-			sbgStreamBufferWriteUint16LE(&outputStream, (uint16)conf);
+			sbgEComCmdOutputWriteConf(&outputStream, outputPort, classId, msgId, conf);
 
 			//
 			// Build command
@@ -281,9 +446,7 @@ SbgErrorCode sbgEComCmdOutputClassGetEnable(SbgEComHandle *pHandle, SbgEComOutpu
 					// Read parameters
 					// First is returned outputPort, then messageId, classId rate and the output configuration at last.
 					//
-					outputPort = (SbgEComOutputPort)sbgStreamBufferReadUint8LE(&inputStream);
-					classId = (SbgEComClass)sbgStreamBufferReadUint8LE(&inputStream);
-					*pEnable = (bool)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdOutputClassParseEnable(&inputStream, pEnable);
 
 					//
 					// The command has been executed successfully so return
@@ -345,9 +508,7 @@ SbgErrorCode sbgEComCmdOutputClassSetEnable(SbgEComHandle *pHandle, SbgEComOutpu
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)outputPort);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)classId);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)enable);
+			sbgEComCmdOutputClassWriteEnable(&outputStream, outputPort, classId, enable);
 
 			//
 			// Build command
@@ -463,10 +624,7 @@ SbgErrorCode sbgEComCmdCanOutputGetConf(SbgEComHandle *pHandle, SbgECanMessageId
 					// Read parameters
 					// First is returned outputPort, then messageId, classId rate and the output configuration at last.
 					//
-					internalId = (SbgECanMessageId)sbgStreamBufferReadUint16LE(&inputStream);
-					*pMode = (SbgEComOutputMode)sbgStreamBufferReadUint16LE(&inputStream);
-					*pUserId = sbgStreamBufferReadUint32LE(&inputStream);
-					*pExtended = (bool)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdCanOutputParseConf(&inputStream, pMode, pUserId, pExtended);
 					
 					//
 					// The command has been executed successfully so return
@@ -529,10 +687,7 @@ SbgErrorCode sbgEComCmdCanOutputSetConf(SbgEComHandle *pHandle, SbgECanMessageId
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint16LE(&outputStream, (uint16)internalId);
-			sbgStreamBufferWriteUint16LE(&outputStream, (uint16)mode);
-			sbgStreamBufferWriteUint32LE(&outputStream, userId);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)extended);
+			sbgEComCmdCanOutputWriteConf(&outputStream, internalId, mode, userId, extended);
 			
 			//
 			// Build command
@@ -658,11 +813,7 @@ SbgErrorCode sbgEComCmdOutputGetLegacyConf(SbgEComHandle *pHandle, SbgEComOutput
 					// Read parameters
 					// First is returned outputPort, then messageId, classId rate and the output configuration at last.
 					//
-					outputPort = (SbgEComOutputPort)sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->mask = sbgStreamBufferReadUint32LE(&inputStream);
-					pConf->format = (SbgEComLegacyFormat)sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->endian = (SbgEComLegacyEndian)sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->mode = (SbgEComOutputMode)sbgStreamBufferReadUint16LE(&inputStream);
+					errorCode = sbgEComCmdOutputParseLegacyConf(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -723,11 +874,7 @@ SbgErrorCode sbgEComCmdOutputSetLegacyConf(SbgEComHandle *pHandle, SbgEComOutput
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)outputPort);
-			sbgStreamBufferWriteUint32LE(&outputStream, pConf->mask);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->format);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->endian);
-			sbgStreamBufferWriteUint16LE(&outputStream, (uint16)pConf->mode);
+			sbgEComCmdOutputWriteLegacyConf(&outputStream, outputPort, pConf);
 
 			//
 			// Build command
@@ -840,9 +987,7 @@ SbgErrorCode sbgEComCmdOutputGetNmeaTalkerId(SbgEComHandle *pHandle, SbgEComOutp
 					//
 					// Read parameters
 					//
-					outputPort = (SbgEComOutputPort)sbgStreamBufferReadUint8LE(&inputStream);
-					nmeaTalkerId[0] = (char)sbgStreamBufferReadUint8LE(&inputStream);
-					nmeaTalkerId[1] = (char)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdOutputParseNmeaTalkerId(&inputStream, nmeaTalkerId);
 
 					//
 					// The command has been executed successfully so return
@@ -903,9 +1048,7 @@ SbgErrorCode sbgEComCmdOutputSetNmeaTalkerId(SbgEComHandle *pHandle, SbgEComOutp
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)outputPort);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)(nmeaTalkerId[0]));
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)(nmeaTalkerId[1]));
+			sbgEComCmdOutputWriteNmeaTalkerId(&outputStream, outputPort, nmeaTalkerId);
 
 			//
 			// Build command
@@ -93,6 +93,102 @@ typedef struct _SbgEComLegacyConf
 	SbgEComOutputMode		mode;		/*!< Mode of output. */
 } SbgEComLegacyConf;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_OUTPUT_CONF answer, the output port, message id and class are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pMode						The output mode of the message.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputParseConf(SbgStreamBuffer *pInputStream, SbgEComOutputMode *pMode);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_OUTPUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port of the device for the log concerned.
+ *	\param[in]	classId						The class of the concerned log.
+ *	\param[in]	msgId						The id of the log.
+ *	\param[in]	mode						The output mode of the message.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputWriteConf(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, SbgEComClass classId, SbgEComMsgId msgId, SbgEComOutputMode mode);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_OUTPUT_CLASS_ENABLE answer, the output port and class are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pEnable						TRUE if the output class is enabled.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputClassParseEnable(SbgStreamBuffer *pInputStream, bool *pEnable);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_OUTPUT_CLASS_ENABLE command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port.
+ *	\param[in]	classId						The output class id.
+ *	\param[in]	enable						TRUE to enable the output class.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputClassWriteEnable(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, SbgEComClass classId, bool enable);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_CAN_OUTPUT_CONF answer, the internal message id is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pMode						The output mode of the message.
+ *	\param[out]	pUserId						The user defined id of the message.
+ *	\param[out]	pExtended					TRUE if the user id uses the extended format.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdCanOutputParseConf(SbgStreamBuffer *pInputStream, SbgEComOutputMode *pMode, uint32 *pUserId, bool *pExtended);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_CAN_OUTPUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	internalId					The internal message id.
+ *	\param[in]	mode						The output mode of the message.
+ *	\param[in]	userId						The user defined id of the message.
+ *	\param[in]	extended					TRUE if the user id uses the extended format.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdCanOutputWriteConf(SbgStreamBuffer *pOutputStream, SbgECanMessageId internalId, SbgEComOutputMode mode, uint32 userId, bool extended);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_LEGACY_CONT_OUTPUT_CONF answer, the output port is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComLegacyConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputParseLegacyConf(SbgStreamBuffer *pInputStream, SbgEComLegacyConf *pConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_LEGACY_CONT_OUTPUT_CONF command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port.
+ *	\param[in]	pConf						Pointer to the SbgEComLegacyConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputWriteLegacyConf(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, const SbgEComLegacyConf *pConf);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_NMEA_TALKER_ID answer, the output port is skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	nmeaTalkerId				A 2-char array to hold the NMEA talker id.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdOutputParseNmeaTalkerId(SbgStreamBuffer *pInputStream, char nmeaTalkerId[2]);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_NMEA_TALKER_ID command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	outputPort					The output port.
+ *	\param[in]	nmeaTalkerId				A 2-char array holding the NMEA talker id.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdOutputWriteNmeaTalkerId(SbgStreamBuffer *pOutputStream, SbgEComOutputPort outputPort, const char nmeaTalkerId[2]);
+
 //----------------------------------------------------------------------//
 //- Output commands                                                    -//
 //----------------------------------------------------------------------//
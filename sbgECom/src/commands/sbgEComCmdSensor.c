@@ -2,6 +2,134 @@
 #include <streamBuffer/sbgStreamBuffer.h>
 #include "transfer/sbgEComTransfer.h"
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_INIT_PARAMETERS answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComInitConditionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSensorParseInitCondition(SbgStreamBuffer *pInputStream, SbgEComInitConditionConf *pConf)
+{
+	pConf->latitude = sbgStreamBufferReadDoubleLE(pInputStream);
+	pConf->longitude = sbgStreamBufferReadDoubleLE(pInputStream);
+	pConf->altitude = sbgStreamBufferReadDoubleLE(pInputStream);
+	pConf->year = sbgStreamBufferReadUint16LE(pInputStream);
+	pConf->month = sbgStreamBufferReadUint8LE(pInputStream);
+	pConf->day = sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_INIT_PARAMETERS command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pConf						Pointer to the SbgEComInitConditionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSensorWriteInitCondition(SbgStreamBuffer *pOutputStream, const SbgEComInitConditionConf *pConf)
+{
+	sbgStreamBufferWriteDoubleLE(pOutputStream, pConf->latitude);
+	sbgStreamBufferWriteDoubleLE(pOutputStream, pConf->longitude);
+	sbgStreamBufferWriteDoubleLE(pOutputStream, pConf->altitude);
+	sbgStreamBufferWriteUint16LE(pOutputStream, (uint16)pConf->year);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->month);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->day);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_AIDING_ASSIGNMENT answer, the reserved fields are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComAidingAssignConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSensorParseAidingAssignment(SbgStreamBuffer *pInputStream, SbgEComAidingAssignConf *pConf)
+{
+	pConf->gps1Port = (SbgEComModulePortAssignment)sbgStreamBufferReadUint8LE(pInputStream);
+	pConf->gps1Sync = (SbgEComModuleSyncAssignment)sbgStreamBufferReadUint8LE(pInputStream);
+	sbgStreamBufferSeek(pInputStream, 6*sizeof(uint8), SB_SEEK_CUR_INC);
+	pConf->rtcmPort = (SbgEComModulePortAssignment)sbgStreamBufferReadUint8LE(pInputStream);
+	sbgStreamBufferSeek(pInputStream, 1*sizeof(uint8), SB_SEEK_CUR_INC);
+	pConf->odometerPinsConf = (SbgEComOdometerPinAssignment)sbgStreamBufferReadUint8LE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_AIDING_ASSIGNMENT command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pConf						Pointer to the SbgEComAidingAssignConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSensorWriteAidingAssignment(SbgStreamBuffer *pOutputStream, const SbgEComAidingAssignConf *pConf)
+{
+	uint32		i;
+
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->gps1Port);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->gps1Sync);
+
+	//
+	// The reserved fields are written as zeros
+	//
+	for (i = 0; i < 6; i++)
+	{
+		sbgStreamBufferWriteUint8LE(pOutputStream, 0);
+	}
+
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->rtcmPort);
+	sbgStreamBufferWriteUint8LE(pOutputStream, 0);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pConf->odometerPinsConf);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_IMU_ALIGNMENT_LEVER_ARM answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pAlignConf					Pointer to a SbgEComSensorAlignmentInfo struct to fill.
+ *	\param[out]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSensorParseAlignmentAndLeverArm(SbgStreamBuffer *pInputStream, SbgEComSensorAlignmentInfo *pAlignConf, float leverArm[3])
+{
+	pAlignConf->axisDirectionX = (SbgEComAxisDirection)sbgStreamBufferReadUint8LE(pInputStream);
+	pAlignConf->axisDirectionY = (SbgEComAxisDirection)sbgStreamBufferReadUint8LE(pInputStream);
+	pAlignConf->misRoll = sbgStreamBufferReadFloatLE(pInputStream);
+	pAlignConf->misPitch = sbgStreamBufferReadFloatLE(pInputStream);
+	pAlignConf->misYaw = sbgStreamBufferReadFloatLE(pInputStream);
+	leverArm[0] = sbgStreamBufferReadFloatLE(pInputStream);
+	leverArm[1] = sbgStreamBufferReadFloatLE(pInputStream);
+	leverArm[2] = sbgStreamBufferReadFloatLE(pInputStream);
+
+	return sbgStreamBufferGetLastError(pInputStream);
+}
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_IMU_ALIGNMENT_LEVER_ARM command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pAlignConf					Pointer to the SbgEComSensorAlignmentInfo struct to write.
+ *	\param[in]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSensorWriteAlignmentAndLeverArm(SbgStreamBuffer *pOutputStream, const SbgEComSensorAlignmentInfo *pAlignConf, const float leverArm[3])
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pAlignConf->axisDirectionX);
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)pAlignConf->axisDirectionY);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->misRoll);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->misPitch);
+	sbgStreamBufferWriteFloatLE(pOutputStream, pAlignConf->misYaw);
+	sbgStreamBufferWriteFloatLE(pOutputStream, leverArm[0]);
+	sbgStreamBufferWriteFloatLE(pOutputStream, leverArm[1]);
+	sbgStreamBufferWriteFloatLE(pOutputStream, leverArm[2]);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Sensor commands		                                               -//
 //----------------------------------------------------------------------//
@@ -148,12 +276,7 @@ SbgErrorCode sbgEComCmdSensorGetInitCondition(SbgEComHandle *pHandle, SbgEComIni
 					//
 					// Read parameters
 					//
-					pConf->latitude = sbgStreamBufferReadDoubleLE(&inputStream);
-					pConf->longitude = sbgStreamBufferReadDoubleLE(&inputStream);
-					pConf->altitude = sbgStreamBufferReadDoubleLE(&inputStream);
-					pConf->year = sbgStreamBufferReadUint16LE(&inputStream);
-					pConf->month = sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->day = sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdSensorParseInitCondition(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -213,12 +336,7 @@ SbgErrorCode sbgEComCmdSensorSetInitCondition(SbgEComHandle *pHandle, const SbgE
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteDoubleLE(&outputStream, pConf->latitude);
-			sbgStreamBufferWriteDoubleLE(&outputStream, pConf->longitude);
-			sbgStreamBufferWriteDoubleLE(&outputStream, pConf->altitude);
-			sbgStreamBufferWriteUint16LE(&outputStream, (uint16)pConf->year);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->month);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->day);
+			sbgEComCmdSensorWriteInitCondition(&outputStream, pConf);
 
 			//
 			// Build command
@@ -330,12 +448,7 @@ SbgErrorCode sbgEComCmdSensorGetAidingAssignment(SbgEComHandle *pHandle, SbgECom
 					//
 					// Read parameters
 					//
-					pConf->gps1Port = (SbgEComModulePortAssignment)sbgStreamBufferReadUint8LE(&inputStream);
-					pConf->gps1Sync = (SbgEComModuleSyncAssignment)sbgStreamBufferReadUint8LE(&inputStream);
-					sbgStreamBufferSeek(&inputStream, 6*sizeof(uint8), SB_SEEK_CUR_INC);						/*!< Reserved fields to ignore */
-					pConf->rtcmPort = (SbgEComModulePortAssignment)sbgStreamBufferReadUint8LE(&inputStream);
-					sbgStreamBufferSeek(&inputStream, 1*sizeof(uint8), SB_SEEK_CUR_INC);						/*!< Reserved field to ignore */
-					pConf->odometerPinsConf = (SbgEComOdometerPinAssignment)sbgStreamBufferReadUint8LE(&inputStream);
+					errorCode = sbgEComCmdSensorParseAidingAssignment(&inputStream, pConf);
 
 					//
 					// The command has been executed successfully so return
@@ -395,12 +508,7 @@ SbgErrorCode sbgEComCmdSensorSetAidingAssignment(SbgEComHandle *pHandle, const S
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->gps1Port);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->gps1Sync);
-			sbgStreamBufferSeek(&outputStream, 6*sizeof(uint8), SB_SEEK_CUR_INC);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->rtcmPort);
-			sbgStreamBufferSeek(&outputStream, 1*sizeof(uint8), SB_SEEK_CUR_INC);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pConf->odometerPinsConf);
+			sbgEComCmdSensorWriteAidingAssignment(&outputStream, pConf);
 
 			//
 			// Build command
@@ -513,14 +621,7 @@ SbgErrorCode sbgEComCmdSensorGetAlignmentAndLeverArm(SbgEComHandle *pHandle, Sbg
 					//
 					// Read parameters
 					//
-					pAlignConf->axisDirectionX = (SbgEComAxisDirection)sbgStreamBufferReadUint8LE(&inputStream);
-					pAlignConf->axisDirectionY = (SbgEComAxisDirection)sbgStreamBufferReadUint8LE(&inputStream);
-					pAlignConf->misRoll = sbgStreamBufferReadFloatLE(&inputStream);
-					pAlignConf->misPitch = sbgStreamBufferReadFloatLE(&inputStream);
-					pAlignConf->misYaw = sbgStreamBufferReadFloatLE(&inputStream);
-					leverArm[0] = sbgStreamBufferReadFloatLE(&inputStream);
-					leverArm[1] = sbgStreamBufferReadFloatLE(&inputStream);
-					leverArm[2] = sbgStreamBufferReadFloatLE(&inputStream);
+					errorCode = sbgEComCmdSensorParseAlignmentAndLeverArm(&inputStream, pAlignConf, leverArm);
 
 					//
 					// The command has been executed successfully so return
@@ -581,14 +682,7 @@ SbgErrorCode sbgEComCmdSensorSetAlignmentAndLeverArm(SbgEComHandle *pHandle, con
 			//
 			// Build payload
 			//
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pAlignConf->axisDirectionX);
-			sbgStreamBufferWriteUint8LE(&outputStream, (uint8)pAlignConf->axisDirectionY);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->misRoll);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->misPitch);
-			sbgStreamBufferWriteFloatLE(&outputStream, pAlignConf->misYaw);
-			sbgStreamBufferWriteFloatLE(&outputStream, leverArm[0]);
-			sbgStreamBufferWriteFloatLE(&outputStream, leverArm[1]);
-			sbgStreamBufferWriteFloatLE(&outputStream, leverArm[2]);
+			sbgEComCmdSensorWriteAlignmentAndLeverArm(&outputStream, pAlignConf, leverArm);
 
 			//
 			// Build command
@@ -115,6 +115,60 @@ typedef struct _SbgEComInitConditionConf
 	uint8				day;						/*!< Initial day */
 } SbgEComInitConditionConf;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_INIT_PARAMETERS answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComInitConditionConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSensorParseInitCondition(SbgStreamBuffer *pInputStream, SbgEComInitConditionConf *pConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_INIT_PARAMETERS command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pConf						Pointer to the SbgEComInitConditionConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSensorWriteInitCondition(SbgStreamBuffer *pOutputStream, const SbgEComInitConditionConf *pConf);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_AIDING_ASSIGNMENT answer, the reserved fields are skipped.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pConf						Pointer to a SbgEComAidingAssignConf struct to fill.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSensorParseAidingAssignment(SbgStreamBuffer *pInputStream, SbgEComAidingAssignConf *pConf);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_AIDING_ASSIGNMENT command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pConf						Pointer to the SbgEComAidingAssignConf struct to write.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSensorWriteAidingAssignment(SbgStreamBuffer *pOutputStream, const SbgEComAidingAssignConf *pConf);
+
+/*!
+ *	Parse the payload of a SBG_ECOM_CMD_IMU_ALIGNMENT_LEVER_ARM answer.
+ *	\param[in]	pInputStream				Stream buffer initialized on the answer payload.
+ *	\param[out]	pAlignConf					Pointer to a SbgEComSensorAlignmentInfo struct to fill.
+ *	\param[out]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been parsed.
+ */
+SbgErrorCode sbgEComCmdSensorParseAlignmentAndLeverArm(SbgStreamBuffer *pInputStream, SbgEComSensorAlignmentInfo *pAlignConf, float leverArm[3]);
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_IMU_ALIGNMENT_LEVER_ARM command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	pAlignConf					Pointer to the SbgEComSensorAlignmentInfo struct to write.
+ *	\param[in]	leverArm					Array of three values, one for each axis.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSensorWriteAlignmentAndLeverArm(SbgStreamBuffer *pOutputStream, const SbgEComSensorAlignmentInfo *pAlignConf, const float leverArm[3]);
+
 //----------------------------------------------------------------------//
 //- Sensor commands				                                       -//
 //----------------------------------------------------------------------//
@@ -1,6 +1,23 @@
 #include "sbgEComCmdSettings.h"
 #include "transfer/sbgEComTransfer.h"
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SETTINGS_ACTION command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	action						One of the available SbgEComSettingsAction.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSettingsWriteAction(SbgStreamBuffer *pOutputStream, SbgEComSettingsAction action)
+{
+	sbgStreamBufferWriteUint8LE(pOutputStream, (uint8)action);
+
+	return sbgStreamBufferGetLastError(pOutputStream);
+}
+
 //----------------------------------------------------------------------//
 //- Settings commands                                                  -//
 //----------------------------------------------------------------------//
@@ -18,6 +35,8 @@ SbgErrorCode sbgEComCmdSettingsAction(SbgEComHandle *pHandle, SbgEComSettingsAct
 {
 	SbgErrorCode	errorCode = SBG_NO_ERROR;
 	uint32			trial;
+	uint8			outputBuffer[SBG_ECOM_MAX_BUFFER_SIZE];
+	SbgStreamBuffer	outputStream;
 	SbgEComCmdId	cmd;
 
 	//
@@ -30,15 +49,25 @@ SbgErrorCode sbgEComCmdSettingsAction(SbgEComHandle *pHandle, SbgEComSettingsAct
 		//
 		for (trial = 0; trial < 3; trial++)
 		{	
+			//
+			// Init stream buffer for output
+			//
+			sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+
+			//
+			// Build payload
+			//
+			sbgEComCmdSettingsWriteAction(&outputStream, action);
+
 			//
 			// Build command
 			//
 			cmd = SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_SETTINGS_ACTION);
 
 			//
-			// Send the command and the action as a 1-byte payload
+			// Send the payload over ECom
 			//
-			errorCode = sbgEComProtocolSend(&pHandle->protocolHandle, cmd, &action, 1);
+			errorCode = sbgEComProtocolSend(&pHandle->protocolHandle, cmd, sbgStreamBufferGetLinkedBuffer(&outputStream), sbgStreamBufferGetLength(&outputStream));
 
 			//
 			// Make sure that the command has been sent
@@ -36,6 +36,18 @@ typedef enum _SbgEComSettingsAction
 	SBG_ECOM_RESTORE_DEFAULT_SETTINGS	= 2			/*!< Restore default settings, save them to non-volatile memory and reboot the device. */
 } SbgEComSettingsAction;
 
+//----------------------------------------------------------------------//
+//- Payloads parsing and writing                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Write the payload of a SBG_ECOM_CMD_SETTINGS_ACTION command.
+ *	\param[in]	pOutputStream				Stream buffer to write the payload to.
+ *	\param[in]	action						One of the available SbgEComSettingsAction.
+ *	\return									SBG_NO_ERROR if the payload has been written.
+ */
+SbgErrorCode sbgEComCmdSettingsWriteAction(SbgStreamBuffer *pOutputStream, SbgEComSettingsAction action);
+
 //----------------------------------------------------------------------//
 //- Settings commands                                                  -//
 //----------------------------------------------------------------------//
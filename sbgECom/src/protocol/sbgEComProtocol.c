@@ -3,449 +3,1431 @@
 #include <streamBuffer/sbgStreamBuffer.h>
 
 //----------------------------------------------------------------------//
-//- Communication protocol operations                                  -//
+//- Select the start of frame scanner according to the target         -//
+//----------------------------------------------------------------------//
+#if (SBG_CONFIG_USE_SIMD == ENABLE) && defined(__AVX2__)
+	#include <immintrin.h>
+	#define SBG_ECOM_SYNC_SCAN_AVX2
+#elif (SBG_CONFIG_USE_SIMD == ENABLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+	#include <emmintrin.h>
+	#define SBG_ECOM_SYNC_SCAN_SSE2
+#endif
+
+#if (defined(SBG_ECOM_SYNC_SCAN_AVX2) || defined(SBG_ECOM_SYNC_SCAN_SSE2)) && defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+//----------------------------------------------------------------------//
+//- Private methods declarations                                       -//
 //----------------------------------------------------------------------//
 
 /*!
- *	Initialize the protocol system used to communicate with the product and return the created handle.
- *	\param[in]	pHandle					Pointer on an allocated protocol structure to initialize.
- *	\param[in]	pInterface				Interface to use for read/write operations.
- *	\return								SBG_NO_ERROR if we have initialised the protocol system.
+ *	Add a value to a reception statistics counter.
+ *	Counters are only written by the thread that receives frames so a relaxed load followed by a relaxed store is enough.
+ *	\param[in]	pCounter				Counter to update.
+ *	\param[in]	value					Value to add.
  */
-SbgErrorCode sbgEComProtocolInit(SbgEComProtocol *pHandle, SbgInterface *pInterface)
+static void sbgEComProtocolStatsAdd(uint32 *pCounter, uint32 value)
 {
-	SbgErrorCode errorCode = SBG_NO_ERROR;
-	
+	SBG_ATOMIC_STORE_RELAXED(*pCounter, SBG_ATOMIC_LOAD_RELAXED(*pCounter) + value);
+}
+
+/*!
+ *	Returns a byte stored in the reception ring buffer.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	offset					Offset of the byte relative to the ring buffer read cursor.
+ *	\return								The byte value.
+ */
+static uint8 sbgEComProtocolRxPeek(const SbgEComProtocol *pHandle, uint32 offset)
+{
+	return pHandle->rxBuffer[(pHandle->rxReadIndex + offset) & SBG_ECOM_RX_BUFFER_MASK];
+}
+
+/*!
+ *	Discard bytes at the beginning of the reception ring buffer by just moving the read cursor.
+ *	The bytes are left untouched until the next read so the views on extracted frames remain valid.
+ *	The CRC computed on the current frame candidate is reset.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	numBytes				Number of bytes to discard (should be less or equal to rxBufferSize).
+ */
+static void sbgEComProtocolRxConsume(SbgEComProtocol *pHandle, uint32 numBytes)
+{
+	pHandle->rxBufferSize -= numBytes;
+	pHandle->rxHoldSize += numBytes;
+	pHandle->rxReadIndex = (pHandle->rxReadIndex + numBytes) & SBG_ECOM_RX_BUFFER_MASK;
+
 	//
-	// Check input parameters
+	// The frame candidate has been dropped or extracted so restart the CRC computation for the next one
 	//
-	if ( (pInterface) && (pHandle) )
+	sbgCrc16Initialize(&pHandle->rxCrc);
+	pHandle->rxCrcSize = 0;
+}
+
+/*!
+ *	Give back the space used by the frames returned before, unless they are held by sbgEComProtocolHoldFrames.
+ *	\param[in]	pHandle					A valid protocol handle.
+ */
+static void sbgEComProtocolRxRelease(SbgEComProtocol *pHandle)
+{
+	if (pHandle->rxHoldCount == 0)
 	{
+		pHandle->rxHoldSize = 0;
+
 		//
-		// Initialize the created protocol handle
+		// The ring buffer is empty so rewind both cursors to reduce the number of frames that will wrap around
 		//
-		pHandle->pLinkedInterface = pInterface;
-		pHandle->rxBufferSize = 0;
-	}
-	else
-	{
-		errorCode = SBG_NULL_POINTER;
+		if (pHandle->rxBufferSize == 0)
+		{
+			pHandle->rxReadIndex = 0;
+			pHandle->rxWriteIndex = 0;
+		}
 	}
-
-	return errorCode;
 }
 
 /*!
- *	Close the protocol system.
- *	\param[in]	pHandle					A valid protocol handle to close.
- *	\return								SBG_NO_ERROR if we have closed and released the protocol system.
+ *	Drop the read times of the bytes that have been consumed before the read cursor.
+ *	The first remaining read time is then the one of the read that has completed the last consumed byte.
+ *	\param[in]	pHandle					A valid protocol handle.
  */
-SbgErrorCode sbgEComProtocolClose(SbgEComProtocol *pHandle)
+static void sbgEComProtocolRxDropReadTimes(SbgEComProtocol *pHandle)
 {
+	uint32 readOffset;
+
 	//
-	// Test that we have a valid protocol handle
+	// Offsets wrap around so compare them using a signed difference
 	//
-	if (pHandle)
+	readOffset = pHandle->rxTotalSize - pHandle->rxBufferSize;
+
+	while ( (pHandle->rxReadTimesCount > 0) && ((int32)(readOffset - pHandle->rxReadTimes[pHandle->rxReadTimesFirst].endOffset) > 0) )
 	{
-		return SBG_NO_ERROR;
+		pHandle->rxReadTimesFirst = (pHandle->rxReadTimesFirst + 1) % SBG_ECOM_RX_READ_TIMES;
+		pHandle->rxReadTimesCount--;
 	}
-	else
+}
+
+/*!
+ *	Store the time of a read that has just appended bytes to the reception ring buffer.
+ *	The oldest read time is dropped if too many reads are still stored in the buffer.
+ *	\param[in]	pHandle					A valid protocol handle.
+ */
+static void sbgEComProtocolRxAddReadTime(SbgEComProtocol *pHandle)
+{
+	SbgEComProtocolReadTime *pReadTime;
+
+	sbgEComProtocolRxDropReadTimes(pHandle);
+
+	if (pHandle->rxReadTimesCount == SBG_ECOM_RX_READ_TIMES)
 	{
-		return SBG_NULL_POINTER;
+		pHandle->rxReadTimesFirst = (pHandle->rxReadTimesFirst + 1) % SBG_ECOM_RX_READ_TIMES;
+		pHandle->rxReadTimesCount--;
 	}
+
+	pReadTime = &pHandle->rxReadTimes[(pHandle->rxReadTimesFirst + pHandle->rxReadTimesCount) % SBG_ECOM_RX_READ_TIMES];
+	pReadTime->endOffset = pHandle->rxTotalSize;
+	pReadTime->time = sbgGetMonotonicNs();
+	pHandle->rxReadTimesCount++;
 }
 
 /*!
- *	Send a frame to the device (size should be less than 4086 bytes).
+ *	Returns the time of the read that has completed the last consumed byte, ie the frame that has just been extracted.
  *	\param[in]	pHandle					A valid protocol handle.
- *	\param[in]	cmd						Command number to send (0 to 65535).
- *	\param[in]	pData					Pointer on the data payload to send or NULL if no payload.
- *	\param[in]	size					Size in bytes of the data payload (less than 4086).
- *	\return								SBG_NO_ERROR if the frame has been sent.
+ *	\return								Monotonic time in ns or 0 if reads aren't time stamped.
  */
-SbgErrorCode sbgEComProtocolSend(SbgEComProtocol *pHandle, uint16 cmd, const void *pData, uint32 size)
+static uint64 sbgEComProtocolRxGetReadTime(SbgEComProtocol *pHandle)
 {
-	SbgErrorCode errorCode = SBG_NO_ERROR;
-	uint8 outputBuffer[SBG_ECOM_MAX_BUFFER_SIZE];
-	SbgStreamBuffer outputStream;
-	uint16 frameCrc;
+	if (pHandle->rxTimeStamps)
+	{
+		sbgEComProtocolRxDropReadTimes(pHandle);
+
+		if (pHandle->rxReadTimesCount > 0)
+		{
+			return pHandle->rxReadTimes[pHandle->rxReadTimesFirst].time;
+		}
+	}
+
+	return 0;
+}
+
+/*!
+ *	Read as much data as we can from the interface and append them to the reception ring buffer.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								Number of bytes that have been appended to the ring buffer.
+ */
+static uint32 sbgEComProtocolRxFill(SbgEComProtocol *pHandle)
+{
+	uint32 chunkSize;
+	uint32 numBytesRead;
+	uint32 totalBytesRead = 0;
 
 	//
-	// First, test input parameters
+	// The views returned by the previous call aren't used anymore
 	//
-	if ( (pHandle) && (size <= SBG_ECOM_MAX_PAYLOAD_SIZE) && ( ((size > 0) && (pData)) || (size == 0) ) )
+	sbgEComProtocolRxRelease(pHandle);
+
+	//
+	// The free space is split in two parts once the write cursor has wrapped around, held bytes are just before the read cursor
+	//
+	while (pHandle->rxBufferSize + pHandle->rxHoldSize < SBG_ECOM_MAX_BUFFER_SIZE)
 	{
 		//
-		// Create a stream buffer to write the frame
+		// Only read the contiguous free space after the write cursor
 		//
-		sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+		chunkSize = SBG_ECOM_MAX_BUFFER_SIZE - pHandle->rxBufferSize - pHandle->rxHoldSize;
 
-		//
-		// Write the header
-		//
-		sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_SYNC_1);
-		sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_SYNC_2);
+		if (chunkSize > SBG_ECOM_MAX_BUFFER_SIZE - pHandle->rxWriteIndex)
+		{
+			chunkSize = SBG_ECOM_MAX_BUFFER_SIZE - pHandle->rxWriteIndex;
+		}
 
-		//
-		// Write the command field
-		//
-		sbgStreamBufferWriteUint16LE(&outputStream, cmd);
+		if (sbgInterfaceRead(pHandle->pLinkedInterface, pHandle->rxBuffer + pHandle->rxWriteIndex, &numBytesRead, chunkSize) != SBG_NO_ERROR)
+		{
+			break;
+		}
 
-		//
-		// Write the length field
-		//
-		sbgStreamBufferWriteUint16LE(&outputStream, (uint16)size);
+		pHandle->rxWriteIndex = (pHandle->rxWriteIndex + numBytesRead) & SBG_ECOM_RX_BUFFER_MASK;
+		pHandle->rxBufferSize += numBytesRead;
+		pHandle->rxTotalSize += numBytesRead;
+		sbgEComProtocolStatsAdd(&pHandle->stats.bytesRead, numBytesRead);
+		totalBytesRead += numBytesRead;
 
 		//
-		// Write the payload part
+		// Time stamp the read as soon as the bytes are available, frames are then dispatched later
 		//
-		sbgStreamBufferWriteBuffer(&outputStream, pData, size);
+		if ( (pHandle->rxTimeStamps) && (numBytesRead > 0) )
+		{
+			sbgEComProtocolRxAddReadTime(pHandle);
+		}
 
-		//
-		// Compute the CRC, we skip the two sync chars
-		//
-		frameCrc = sbgCrc16Compute(((uint8*)sbgStreamBufferGetLinkedBuffer(&outputStream)) + 2, sbgStreamBufferGetLength(&outputStream) - 2);
+		if (pHandle->rxBufferSize > SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.maxRxBacklog))
+		{
+			SBG_ATOMIC_STORE_RELAXED(pHandle->stats.maxRxBacklog, pHandle->rxBufferSize);
+		}
 
 		//
-		// Write the CRC
+		// Only try to read again if the interface has filled the whole chunk
 		//
-		sbgStreamBufferWriteUint16LE(&outputStream, frameCrc);
+		if (numBytesRead < chunkSize)
+		{
+			break;
+		}
+	}
 
-		//
-		// Write ETX char
-		//
-		sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_ETX);
+	return totalBytesRead;
+}
 
-		//
-		// The frame has been generated so send it
-		//
-		errorCode = sbgInterfaceWrite(pHandle->pLinkedInterface, sbgStreamBufferGetLinkedBuffer(&outputStream), sbgStreamBufferGetLength(&outputStream));
-	}
-	else
-	{
-		//
-		// Invalid input parameters
-		//
-		errorCode = SBG_INVALID_PARAMETER;
-	}
+#if defined(SBG_ECOM_SYNC_SCAN_AVX2) || defined(SBG_ECOM_SYNC_SCAN_SSE2)
+/*!
+ *	Returns the index of the first bit set in a non zero mask.
+ *	\param[in]	mask					Non zero bit mask.
+ *	\return								Index of the least significant bit set.
+ */
+static uint32 sbgEComProtocolFirstBitSet(uint32 mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
 
-	return errorCode;
+	_BitScanForward(&index, mask);
+
+	return (uint32)index;
+#else
+	return (uint32)__builtin_ctz(mask);
+#endif
 }
+#endif
 
 /*!
- *	Try to receive a frame from the device and returns the cmd, data and size of data field.
- *	\param[in]	pHandle					A valid protocol handle.
- *	\param[out]	pCmd					Pointer to hold the returned command.
- *	\param[out]	pData					Allocated buffer used to hold received data field.
- *	\param[out]	pSize					Pointer used to hold the received data field size.
- *	\param[in]	maxSize					Max number of bytes that can be stored in the pData buffer.
- *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
- *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
- *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
- *										SBG_NULL_POINTER if an input parameter is NULL.<br>
- *										SBG_BUFFER_OVERFLOW if the received frame payload couldn't fit into the pData buffer.
+ *	Find the first SYNC_1 / SYNC_2 pair in a contiguous buffer.
+ *	The AVX2 or SSE2 implementation is selected at build time and compares 32 or 16 pairs at once.
+ *	The remaining bytes, or the whole buffer on other targets, are scanned using memchr.
+ *	\param[in]	pBuffer					Buffer to scan.
+ *	\param[in]	size					Buffer size in bytes.
+ *	\return								Index of the SYNC_1 char of the first pair or size if no pair has been found.
  */
-SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint16 *pCmd, void *pData, uint32 *pSize, uint32 maxSize)
+static uint32 sbgEComProtocolFindSync(const uint8 *pBuffer, uint32 size)
 {
-	SbgErrorCode errorCode = SBG_NOT_READY;
-	SbgStreamBuffer inputStream;
-	bool syncFound;
-	uint32 payloadSize = 0;
-	uint16 frameCrc;
-	uint16 computedCrc;
-	uint32 i;
-	uint32 numBytesRead;
-	uint16 receivedCmd;
-	uint32 payloadOffset;
+	const uint8 *pCursor;
+	uint32 i = 0;
+#if defined(SBG_ECOM_SYNC_SCAN_AVX2)
+	const __m256i sync1 = _mm256_set1_epi8((char)SBG_ECOM_SYNC_1);
+	const __m256i sync2 = _mm256_set1_epi8((char)SBG_ECOM_SYNC_2);
+	__m256i current;
+	__m256i next;
+	uint32 mask;
 
 	//
-	// First, test input parameters
+	// Compare each byte with SYNC_1 and the following one with SYNC_2, the pair can end on the byte just after the block
 	//
-	if (pHandle)
+	for (; i + 32 < size; i += 32)
 	{
-		// 
-		// Set the return size to 0 in order to avoid possible bugs
-		//
-		if (pSize)
+		current = _mm256_loadu_si256((const __m256i*)(pBuffer + i));
+		next = _mm256_loadu_si256((const __m256i*)(pBuffer + i + 1));
+		mask = (uint32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(current, sync1), _mm256_cmpeq_epi8(next, sync2)));
+
+		if (mask)
 		{
-			*pSize = 0;
+			return i + sbgEComProtocolFirstBitSet(mask);
 		}
+	}
+#elif defined(SBG_ECOM_SYNC_SCAN_SSE2)
+	const __m128i sync1 = _mm_set1_epi8((char)SBG_ECOM_SYNC_1);
+	const __m128i sync2 = _mm_set1_epi8((char)SBG_ECOM_SYNC_2);
+	__m128i current;
+	__m128i next;
+	uint32 mask;
 
-		//
-		// Check if we can receive some new data (the receive buffer isn't full)
-		//
-		if (pHandle->rxBufferSize < SBG_ECOM_MAX_BUFFER_SIZE)
+	//
+	// Compare each byte with SYNC_1 and the following one with SYNC_2, the pair can end on the byte just after the block
+	//
+	for (; i + 16 < size; i += 16)
+	{
+		current = _mm_loadu_si128((const __m128i*)(pBuffer + i));
+		next = _mm_loadu_si128((const __m128i*)(pBuffer + i + 1));
+		mask = (uint32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(current, sync1), _mm_cmpeq_epi8(next, sync2)));
+
+		if (mask)
 		{
-			//
-			// First try to read as much data as we can
-			//
-			if (sbgInterfaceRead(pHandle->pLinkedInterface, pHandle->rxBuffer + pHandle->rxBufferSize, &numBytesRead, SBG_ECOM_MAX_BUFFER_SIZE - pHandle->rxBufferSize) == SBG_NO_ERROR)
-			{
-				//
-				// No error during reading so increment the number of bytes stored in the rx buffer
-				//
-				pHandle->rxBufferSize += numBytesRead;
-			}
+			return i + sbgEComProtocolFirstBitSet(mask);
 		}
+	}
+#endif
 
-		//
-		// We have read all available data and stored them into the rx buffer
-		// We will try to process all received data until we have found a valid frame.
-		//
-		while (pHandle->rxBufferSize > 0)
+	//
+	// Portable scan: jump to the next SYNC_2 char using memchr and check that it follows a SYNC_1 one
+	// SYNC_2 is searched instead of SYNC_1 because 0xFF bytes are very common in line noise and idle lines
+	//
+	while (i + 1 < size)
+	{
+		pCursor = (const uint8*)memchr(pBuffer + i + 1, SBG_ECOM_SYNC_2, size - 1 - i);
+
+		if (pCursor == NULL)
 		{
-			//
-			// For now, we haven't found any start of frame
-			//
-			syncFound = FALSE;
+			break;
+		}
 
-			//
-			// To find a valid start of frame we need at least 2 bytes in the reception buffer
-			//
-			if (pHandle->rxBufferSize >= 2)
-			{
-				//
-				// Try to find a valid start of frame by looking for SYNC_1 and SYNC_2 chars
-				//
-				for (i = 0; i < pHandle->rxBufferSize-1; i++)
-				{
-					//
-					// A valid start of frame should begin with SYNC and when STX chars
-					//
-					if ( (pHandle->rxBuffer[i] == SBG_ECOM_SYNC_1) && (pHandle->rxBuffer[i+1] == SBG_ECOM_SYNC_2) )
-					{
-						//
-						// We have found the sync char, test if we have dummy bytes at the begining of the frame
-						//
-						if (i > 0)
-						{
-							//
-							// Remove all dumy received bytes before the begining of the frame
-							//
-							memmove(pHandle->rxBuffer, pHandle->rxBuffer+i, pHandle->rxBufferSize-i);
-							pHandle->rxBufferSize = pHandle->rxBufferSize-i;
-						}
+		i = (uint32)(pCursor - pBuffer) - 1;
 
-						//
-						// The sync has been found
-						//
-						syncFound = TRUE;
-						break;
-					}
-				}
-			}
+		if (pBuffer[i] == SBG_ECOM_SYNC_1)
+		{
+			return i;
+		}
 
-			//
-			// Check if a valid start of frame has been found
-			//
-			if (syncFound)
-			{
-				//
-				// A valid start of frame has been found, try to extract the frame if we have at least a whole frame.
-				//
-				if (pHandle->rxBufferSize < 8)
-				{
-					//
-					// Don't have enough data for a valid frame
-					//
-					return SBG_NOT_READY;
-				}
+		i += 2;
+	}
 
-				//
-				// Initialize an input stream buffer to parse the received frame
-				//
-				sbgStreamBufferInitForRead(&inputStream, pHandle->rxBuffer, pHandle->rxBufferSize);
+	return size;
+}
 
-				//
-				// Skip both the Sync 1 and Sync 2 chars
-				//
-				sbgStreamBufferSeek(&inputStream, sizeof(uint8)*2, SB_SEEK_CUR_INC);
+/*!
+ *	Find the first SYNC_1 / SYNC_2 pair in the reception ring buffer.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								Offset of the pair relative to the read cursor or rxBufferSize if no pair has been found.
+ */
+static uint32 sbgEComProtocolRxFindSync(const SbgEComProtocol *pHandle)
+{
+	uint32 firstSize;
+	uint32 index;
 
-				//
-				// Read the command
-				//
-				receivedCmd = sbgStreamBufferReadUint16LE(&inputStream);
+	//
+	// The stored bytes are split in two contiguous segments if they wrap around the ring buffer end
+	//
+	firstSize = SBG_ECOM_MAX_BUFFER_SIZE - pHandle->rxReadIndex;
 
-				//
-				// Read the payload size
-				//
-				payloadSize = (uint16)sbgStreamBufferReadUint16LE(&inputStream);
+	if (firstSize >= pHandle->rxBufferSize)
+	{
+		return sbgEComProtocolFindSync(pHandle->rxBuffer + pHandle->rxReadIndex, pHandle->rxBufferSize);
+	}
 
-				//
-				// Check that the payload size is valid
-				//
-				if (payloadSize <= SBG_ECOM_MAX_PAYLOAD_SIZE)
-				{
-					//
-					// Check if we have received the whole frame
-					//
-					if (pHandle->rxBufferSize < payloadSize+9)
-					{
-						//
-						// Don't have received the whole frame
-						//
-						return SBG_NOT_READY;
-					}
+	index = sbgEComProtocolFindSync(pHandle->rxBuffer + pHandle->rxReadIndex, firstSize);
 
-					//
-					// We should have the whole frame so for now, skip the payload part but before store the current cursor
-					//
-					payloadOffset = sbgStreamBufferTell(&inputStream);
-					sbgStreamBufferSeek(&inputStream, payloadSize, SB_SEEK_CUR_INC);
+	if (index < firstSize)
+	{
+		return index;
+	}
 
-					//
-					// Read the frame CRC
-					//
-					frameCrc = sbgStreamBufferReadUint16LE(&inputStream);
+	//
+	// Check the pair that could straddle both segments before scanning the second one
+	//
+	if ( (pHandle->rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE - 1] == SBG_ECOM_SYNC_1) && (pHandle->rxBuffer[0] == SBG_ECOM_SYNC_2) )
+	{
+		return firstSize - 1;
+	}
 
-					//
-					// Read and test the frame ETX
-					//
-					if (sbgStreamBufferReadUint8(&inputStream) == SBG_ECOM_ETX)
-					{
-						//
-						// Go back at the beginning of the payload part
-						//
-						sbgStreamBufferSeek(&inputStream, payloadOffset, SB_SEEK_SET);
+	index = sbgEComProtocolFindSync(pHandle->rxBuffer, pHandle->rxBufferSize - firstSize);
 
-						//
-						// We have a frame so return the received command if needed even if the CRC is still not validated
-						//
-						if (pCmd)
-						{
-							*pCmd = receivedCmd;
-						}
+	return firstSize + index;
+}
 
-						//
-						// Compute the CRC of the received frame (Skip SYNC 1 and SYNC 2 chars)
-						//
-						computedCrc = sbgCrc16Compute(((uint8*)sbgStreamBufferGetLinkedBuffer(&inputStream)) + 2, payloadSize + 4);
-						
-						//
-						// Check if the received frame has a valid CRC
-						//
-						if (frameCrc == computedCrc)
+/*!
+ *	Update the CRC of the frame candidate stored at the beginning of the reception ring buffer.
+ *	Only the bytes that haven't been processed during a previous call are used.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	endOffset				Offset, relative to the frame start, of the first byte not to include in the CRC.
+ *	\param[in]	maxNumBytes				Maximum number of bytes to process, the CRC is then only partially updated.
+ */
+static void sbgEComProtocolRxUpdateCrc(SbgEComProtocol *pHandle, uint32 endOffset, uint32 maxNumBytes)
+{
+	uint32 startIndex;
+	uint32 numBytes;
+	uint32 firstSize;
+
+	//
+	// The CRC doesn't include both SYNC chars
+	//
+	if (pHandle->rxCrcSize < 2)
+	{
+		pHandle->rxCrcSize = 2;
+	}
+
+	if (endOffset > pHandle->rxCrcSize + maxNumBytes)
+	{
+		endOffset = pHandle->rxCrcSize + maxNumBytes;
+	}
+
+	if (endOffset > pHandle->rxCrcSize)
+	{
+		startIndex = (pHandle->rxReadIndex + pHandle->rxCrcSize) & SBG_ECOM_RX_BUFFER_MASK;
+		numBytes = endOffset - pHandle->rxCrcSize;
+
+		//
+		// The new bytes can wrap around the ring buffer end
+		//
+		firstSize = SBG_ECOM_MAX_BUFFER_SIZE - startIndex;
+
+		if (numBytes > firstSize)
+		{
+			sbgCrc16Update(&pHandle->rxCrc, pHandle->rxBuffer + startIndex, firstSize);
+			sbgCrc16Update(&pHandle->rxCrc, pHandle->rxBuffer, numBytes - firstSize);
+		}
+		else
+		{
+			sbgCrc16Update(&pHandle->rxCrc, pHandle->rxBuffer + startIndex, numBytes);
+		}
+
+		pHandle->rxCrcSize = endOffset;
+	}
+}
+
+/*!
+ *	Check if frames with the given command id have to be returned to the user.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	cmd						Command id of the frame.
+ *	\return								TRUE if the frame has to be returned or FALSE if it can be skipped.
+ */
+static bool sbgEComProtocolIsCmdAccepted(const SbgEComProtocol *pHandle, uint16 cmd)
+{
+	return (pHandle->rxCmdFilter[cmd >> 5] & (1u << (cmd & 0x1F))) ? TRUE : FALSE;
+}
+
+/*!
+ *	Returns a pointer on contiguous bytes at the beginning of the reception ring buffer.
+ *	If the requested bytes wrap around the ring buffer end, the wrapped part is copied just after it.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	numBytes				Number of bytes that have to be contiguous (should be less or equal to rxBufferSize).
+ *	\return								Pointer on the first byte.
+ */
+static const uint8 *sbgEComProtocolRxLinearize(SbgEComProtocol *pHandle, uint32 numBytes)
+{
+	if (pHandle->rxReadIndex + numBytes > SBG_ECOM_MAX_BUFFER_SIZE)
+	{
+		memcpy(pHandle->rxBuffer + SBG_ECOM_MAX_BUFFER_SIZE, pHandle->rxBuffer, pHandle->rxReadIndex + numBytes - SBG_ECOM_MAX_BUFFER_SIZE);
+	}
+
+	return pHandle->rxBuffer + pHandle->rxReadIndex;
+}
+
+/*!
+ *	Build the whole frame in a local buffer and send it using a single write operation.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	cmd						Command number to send (0 to 65535).
+ *	\param[in]	pData					Pointer on the data payload to send or NULL if no payload.
+ *	\param[in]	size					Size in bytes of the data payload (less than 4086).
+ *	\return								SBG_NO_ERROR if the frame has been sent.
+ */
+static SbgErrorCode sbgEComProtocolSendContiguous(SbgEComProtocol *pHandle, uint16 cmd, const void *pData, uint32 size)
+{
+	uint8 outputBuffer[SBG_ECOM_MAX_BUFFER_SIZE];
+	SbgStreamBuffer outputStream;
+	uint16 frameCrc;
+
+	//
+	// Create a stream buffer to write the frame
+	//
+	sbgStreamBufferInitForWrite(&outputStream, outputBuffer, sizeof(outputBuffer));
+
+	//
+	// Write the header
+	//
+	sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_SYNC_1);
+	sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_SYNC_2);
+
+	//
+	// Write the command field
+	//
+	sbgStreamBufferWriteUint16LE(&outputStream, cmd);
+
+	//
+	// Write the length field
+	//
+	sbgStreamBufferWriteUint16LE(&outputStream, (uint16)size);
+
+	//
+	// Write the payload part
+	//
+	sbgStreamBufferWriteBuffer(&outputStream, pData, size);
+
+	//
+	// Compute the CRC, we skip the two sync chars
+	//
+	frameCrc = sbgCrc16Compute(((uint8*)sbgStreamBufferGetLinkedBuffer(&outputStream)) + 2, sbgStreamBufferGetLength(&outputStream) - 2);
+
+	//
+	// Write the CRC
+	//
+	sbgStreamBufferWriteUint16LE(&outputStream, frameCrc);
+
+	//
+	// Write ETX char
+	//
+	sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_ETX);
+
+	//
+	// The frame has been generated so send it
+	//
+	return sbgInterfaceWrite(pHandle->pLinkedInterface, sbgStreamBufferGetLinkedBuffer(&outputStream), sbgStreamBufferGetLength(&outputStream));
+}
+
+/*!
+ *	Send the frame header, the payload and the frame footer as separate buffers using a vectored write operation.
+ *	The payload is sent directly from the user buffer so no copy is needed.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	cmd						Command number to send (0 to 65535).
+ *	\param[in]	pData					Pointer on the data payload to send or NULL if no payload.
+ *	\param[in]	size					Size in bytes of the data payload (less than 4086).
+ *	\return								SBG_NO_ERROR if the frame has been sent.
+ */
+static SbgErrorCode sbgEComProtocolSendVectored(SbgEComProtocol *pHandle, uint16 cmd, const void *pData, uint32 size)
+{
+	uint8 header[6];
+	uint8 footer[3];
+	SbgStreamBuffer outputStream;
+	SbgInterfaceBuffer buffers[3];
+	SbgCrc16 frameCrc;
+
+	//
+	// Write the sync chars, the command and the length fields
+	//
+	sbgStreamBufferInitForWrite(&outputStream, header, sizeof(header));
+	sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_SYNC_1);
+	sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_SYNC_2);
+	sbgStreamBufferWriteUint16LE(&outputStream, cmd);
+	sbgStreamBufferWriteUint16LE(&outputStream, (uint16)size);
+
+	//
+	// Compute the CRC on the command, length and payload fields
+	//
+	sbgCrc16Initialize(&frameCrc);
+	sbgCrc16Update(&frameCrc, header + 2, sizeof(header) - 2);
+
+	if (size > 0)
+	{
+		sbgCrc16Update(&frameCrc, pData, size);
+	}
+
+	//
+	// Write the CRC and the ETX char
+	//
+	sbgStreamBufferInitForWrite(&outputStream, footer, sizeof(footer));
+	sbgStreamBufferWriteUint16LE(&outputStream, sbgCrc16Get(&frameCrc));
+	sbgStreamBufferWriteUint8LE(&outputStream, SBG_ECOM_ETX);
+
+	//
+	// Send the header, the payload if any and the footer at once
+	//
+	buffers[0].pBuffer = header;
+	buffers[0].size = sizeof(header);
+	buffers[1].pBuffer = pData;
+	buffers[1].size = size;
+	buffers[2].pBuffer = footer;
+	buffers[2].size = sizeof(footer);
+
+	return sbgInterfaceWriteV(pHandle->pLinkedInterface, buffers, 3);
+}
+
+/*!
+ *	Try to extract the next frame from the reception ring buffer without reading new data from the interface.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pCmd					Pointer to hold the returned command.
+ *	\param[out]	ppData					Pointer used to hold the address of the received data field.
+ *	\param[out]	pSize					Pointer used to hold the received data field size.
+ *	\param[in]	crcBudget				Maximum number of bytes used to update the CRC of an incomplete frame.
+ *	\return								SBG_NO_ERROR if we have extracted a valid frame.<br>
+ *										SBG_NOT_READY if the reception buffer doesn't contain any other complete frame.<br>
+ *										SBG_INVALID_CRC if the extracted frame has an invalid CRC.
+ */
+static SbgErrorCode sbgEComProtocolRxExtract(SbgEComProtocol *pHandle, uint16 *pCmd, const void **ppData, uint32 *pSize, uint32 crcBudget)
+{
+	SbgErrorCode errorCode = SBG_NOT_READY;
+	SbgStreamBuffer inputStream;
+	bool syncFound;
+	uint32 payloadSize = 0;
+	uint16 frameCrc;
+	uint16 computedCrc;
+	uint32 i;
+	uint16 receivedCmd;
+	const uint8 *pFrame;
+	bool cmdAccepted;
+	bool skipFrame;
+
+	//
+	// Set the returned view to an empty one in order to avoid possible bugs
+	//
+	*ppData = NULL;
+	*pSize = 0;
+
+	//
+	// We have read all available data and stored them into the rx buffer
+	// We will try to process all received data until we have found a valid frame.
+	//
+	while (pHandle->rxBufferSize > 0)
+	{
+		//
+		// For now, we haven't found any start of frame
+		//
+		syncFound = FALSE;
+
+		//
+		// To find a valid start of frame we need at least 2 bytes in the reception buffer
+		//
+		if (pHandle->rxBufferSize >= 2)
+		{
+			//
+			// Try to find a valid start of frame by looking for SYNC_1 and SYNC_2 chars
+			//
+			i = sbgEComProtocolRxFindSync(pHandle);
+
+			if (i < pHandle->rxBufferSize)
+			{
+				//
+				// We have found the sync char, remove all dummy bytes before the begining of the frame
+				//
+				if (i > 0)
+				{
+					sbgEComProtocolRxConsume(pHandle, i);
+					sbgEComProtocolStatsAdd(&pHandle->stats.bytesDiscarded, i);
+				}
+
+				//
+				// The sync has been found
+				//
+				syncFound = TRUE;
+			}
+		}
+
+		//
+		// Check if a valid start of frame has been found
+		//
+		if (syncFound)
+		{
+			//
+			// A valid start of frame has been found, try to extract the frame if we have at least a whole frame.
+			//
+			if (pHandle->rxBufferSize < 8)
+			{
+				//
+				// Don't have enough data for a valid frame
+				//
+				return SBG_NOT_READY;
+			}
+
+			//
+			// Read the command and the payload size (little endian) directly from the ring buffer
+			//
+			receivedCmd = (uint16)(sbgEComProtocolRxPeek(pHandle, 2) | (sbgEComProtocolRxPeek(pHandle, 3) << 8));
+			payloadSize = (uint32)(sbgEComProtocolRxPeek(pHandle, 4) | (sbgEComProtocolRxPeek(pHandle, 5) << 8));
+
+			//
+			// Check if the user is interested in this frame
+			//
+			cmdAccepted = sbgEComProtocolIsCmdAccepted(pHandle, receivedCmd);
+
+			//
+			// Check that the payload size is valid
+			//
+			if (payloadSize <= SBG_ECOM_MAX_PAYLOAD_SIZE)
+			{
+				//
+				// Check if we have received the whole frame
+				//
+				if (pHandle->rxBufferSize < payloadSize + SBG_ECOM_FRAME_OVERHEAD)
+				{
+					//
+					// Update the frame CRC with the bytes received so far, so it is almost ready when the frame is complete
+					//
+					if ( (cmdAccepted) || (pHandle->rxFilterCheckCrc) )
+					{
+						if (pHandle->rxBufferSize < payloadSize + 6)
 						{
-							//
-							// Extract the payload if needed
-							//
-							if (payloadSize > 0)
-							{
-								//
-								// Check if input parameters are valid
-								//
-								if ( (pData) && (pSize) )
-								{
-									//
-									// Check if we have enough space to store the payload
-									//
-									if (payloadSize <= maxSize)
-									{
-										//
-										// Copy the payload and return the payload size
-										//
-										*pSize = payloadSize;
-										memcpy(pData, sbgStreamBufferGetCursor(&inputStream), payloadSize);
-										errorCode = SBG_NO_ERROR;
-									}
-									else
-									{
-										//
-										// Not enough space to store the payload, we will just drop the received data
-										//
-										errorCode = SBG_BUFFER_OVERFLOW;
-									}									
-								}
-								else
-								{
-									errorCode = SBG_NULL_POINTER;
-								}
-							}
-							else
-							{
-								//
-								// No payload but the frame has been read successfully
-								//
-								errorCode = SBG_NO_ERROR;
-							}
+							sbgEComProtocolRxUpdateCrc(pHandle, pHandle->rxBufferSize, crcBudget);
 						}
 						else
 						{
-							//
-							// We have an invalid frame CRC and we will directly return this error
-							//
-							errorCode = SBG_INVALID_CRC;
+							sbgEComProtocolRxUpdateCrc(pHandle, payloadSize + 6, crcBudget);
 						}
+					}
 
-						//
-						// We have read a whole valid frame so remove it from the buffer
-						// First, test if the reception buffer contains more than just the current frame
-						//
-						if (pHandle->rxBufferSize > payloadSize+9)
+					//
+					// Don't have received the whole frame
+					//
+					return SBG_NOT_READY;
+				}
+
+				//
+				// Read and test the frame ETX before completing the CRC so invalid frames are rejected cheaply
+				//
+				if (sbgEComProtocolRxPeek(pHandle, payloadSize + SBG_ECOM_FRAME_OVERHEAD - 1) == SBG_ECOM_ETX)
+				{
+					//
+					// Frames the user isn't interested in are skipped without copying them, their CRC is only checked if requested
+					//
+					if (!cmdAccepted)
+					{
+						if (pHandle->rxFilterCheckCrc)
 						{
-							//
-							// We remove the read frame but we keep the remaining data
-							//
-							pHandle->rxBufferSize = pHandle->rxBufferSize-(payloadSize+9);
-							memmove(pHandle->rxBuffer, pHandle->rxBuffer+payloadSize+9, pHandle->rxBufferSize);
+							sbgEComProtocolRxUpdateCrc(pHandle, payloadSize + 6, SBG_ECOM_MAX_BUFFER_SIZE);
+							frameCrc = (uint16)(sbgEComProtocolRxPeek(pHandle, payloadSize + 6) | (sbgEComProtocolRxPeek(pHandle, payloadSize + 7) << 8));
+							skipFrame = (frameCrc == sbgCrc16Get(&pHandle->rxCrc));
 						}
 						else
 						{
-							//
-							// We have parsed the whole received buffer so just empty it
-							//
-							pHandle->rxBufferSize = 0;
+							skipFrame = TRUE;
 						}
 
 						//
-						// We have at least found a complete frame
+						// A skipped frame with an invalid CRC is still reported as any other invalid frame
 						//
-						return errorCode;
+						if (skipFrame)
+						{
+							sbgEComProtocolStatsAdd(&pHandle->stats.framesFiltered, 1);
+							sbgEComProtocolRxConsume(pHandle, payloadSize + SBG_ECOM_FRAME_OVERHEAD);
+							continue;
+						}
 					}
-				}
-				
-				//
-				// Frame size invalid or the found frame is invalid so we should have incorrectly detected a start of frame.
-				// Remove the SYNC 1 and SYNC 2 chars to retry to find a new frame
-				//
-				pHandle->rxBufferSize -= 2;
-				memmove(pHandle->rxBuffer, pHandle->rxBuffer+2, pHandle->rxBufferSize);
-			}
-			else
-			{
-				//
-				// Unable to find a valid start of frame so check if the last byte is a SYNC char in order to keep it for next time
-				//
-				if (pHandle->rxBuffer[pHandle->rxBufferSize-1] == SBG_ECOM_SYNC_1)
-				{
+
+					//
+					// Complete the CRC with the remaining frame bytes, this cost is bounded by the frame size that is consumed below
+					//
+					sbgEComProtocolRxUpdateCrc(pHandle, payloadSize + 6, SBG_ECOM_MAX_BUFFER_SIZE);
+
+					//
+					// Get the whole frame as a contiguous buffer, only frames that wrap around the ring buffer end are copied
+					//
+					pFrame = sbgEComProtocolRxLinearize(pHandle, payloadSize + SBG_ECOM_FRAME_OVERHEAD);
+
+					//
+					// Initialize an input stream buffer to parse the received frame and skip the header
+					//
+					sbgStreamBufferInitForRead(&inputStream, pFrame, payloadSize + SBG_ECOM_FRAME_OVERHEAD);
+					sbgStreamBufferSeek(&inputStream, payloadSize + 6, SB_SEEK_SET);
+
+					//
+					// Read the frame CRC
+					//
+					frameCrc = sbgStreamBufferReadUint16LE(&inputStream);
+
+					//
+					// We have a frame so return the received command if needed even if the CRC is still not validated
+					//
+					if (pCmd)
+					{
+						*pCmd = receivedCmd;
+					}
+
+					//
+					// The CRC of the received frame (without SYNC 1 and SYNC 2 chars) has been computed while receiving it
+					//
+					computedCrc = sbgCrc16Get(&pHandle->rxCrc);
+
+					//
+					// Check if the received frame has a valid CRC
+					//
+					if (frameCrc == computedCrc)
+					{
+						//
+						// Return a view on the payload that is still stored in the reception buffer
+						//
+						*ppData = pFrame + 6;
+						*pSize = payloadSize;
+						errorCode = SBG_NO_ERROR;
+						sbgEComProtocolStatsAdd(&pHandle->stats.framesOk, 1);
+					}
+					else
+					{
+						//
+						// We have an invalid frame CRC and we will directly return this error
+						//
+						errorCode = SBG_INVALID_CRC;
+						sbgEComProtocolStatsAdd(&pHandle->stats.crcErrors, 1);
+					}
+
 					//
-					// Report the SYNC char and discard all other bytes in the buffer
+					// We have read a whole valid frame so remove it from the buffer by moving the read cursor
+					// The frame bytes are left untouched until the next read so the returned view remains valid
 					//
-					pHandle->rxBuffer[0] = SBG_ECOM_SYNC_1;
-					pHandle->rxBufferSize = 1;
+					sbgEComProtocolRxConsume(pHandle, payloadSize + SBG_ECOM_FRAME_OVERHEAD);
+
+					//
+					// We have at least found a complete frame
+					//
+					return errorCode;
 				}
 				else
 				{
-					//
-					// Discard the whole buffer
-					//
-					pHandle->rxBufferSize = 0;
+					sbgEComProtocolStatsAdd(&pHandle->stats.etxErrors, 1);
 				}
+			}
+			else
+			{
+				sbgEComProtocolStatsAdd(&pHandle->stats.oversizeFrames, 1);
+			}
 
+			//
+			// Frame size invalid or the found frame is invalid so we should have incorrectly detected a start of frame.
+			// Remove the SYNC 1 and SYNC 2 chars to retry to find a new frame
+			//
+			sbgEComProtocolRxConsume(pHandle, 2);
+			sbgEComProtocolStatsAdd(&pHandle->stats.bytesDiscarded, 2);
+		}
+		else
+		{
+			//
+			// Unable to find a valid start of frame so check if the last byte is a SYNC char in order to keep it for next time
+			//
+			if (sbgEComProtocolRxPeek(pHandle, pHandle->rxBufferSize-1) == SBG_ECOM_SYNC_1)
+			{
 				//
-				// Unable to find a frame
+				// Report the SYNC char and discard all other bytes in the buffer
 				//
-				return SBG_NOT_READY;
+				sbgEComProtocolStatsAdd(&pHandle->stats.bytesDiscarded, pHandle->rxBufferSize-1);
+				sbgEComProtocolRxConsume(pHandle, pHandle->rxBufferSize-1);
 			}
+			else
+			{
+				//
+				// Discard the whole buffer
+				//
+				sbgEComProtocolStatsAdd(&pHandle->stats.bytesDiscarded, pHandle->rxBufferSize);
+				sbgEComProtocolRxConsume(pHandle, pHandle->rxBufferSize);
+			}
+
+			//
+			// Unable to find a frame
+			//
+			return SBG_NOT_READY;
 		}
+	}
+
+	//
+	// The whole buffer has been paresed and no valid frame has been found
+	//
+	return SBG_NOT_READY;
+}
+
+//----------------------------------------------------------------------//
+//- Communication protocol operations                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize the protocol system used to communicate with the product and return the created handle.
+ *	\param[in]	pHandle					Pointer on an allocated protocol structure to initialize.
+ *	\param[in]	pInterface				Interface to use for read/write operations.
+ *	\return								SBG_NO_ERROR if we have initialised the protocol system.
+ */
+SbgErrorCode sbgEComProtocolInit(SbgEComProtocol *pHandle, SbgInterface *pInterface)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+	
+	//
+	// Check input parameters
+	//
+	if ( (pInterface) && (pHandle) )
+	{
+		//
+		// Initialize the created protocol handle
+		//
+		pHandle->pLinkedInterface = pInterface;
+		pHandle->rxReadIndex = 0;
+		pHandle->rxWriteIndex = 0;
+		pHandle->rxBufferSize = 0;
+		pHandle->rxHoldSize = 0;
+		pHandle->rxHoldCount = 0;
+		sbgCrc16Initialize(&pHandle->rxCrc);
+		pHandle->rxCrcSize = 0;
+		memset(&pHandle->stats, 0x00, sizeof(pHandle->stats));
+
+		//
+		// By default, all frames are returned and skipped frames have their CRC checked
+		//
+		memset(pHandle->rxCmdFilter, 0xFF, sizeof(pHandle->rxCmdFilter));
+		pHandle->rxFilterCheckCrc = TRUE;
+
+		//
+		// Reads are only time stamped on request
+		//
+		pHandle->rxTimeStamps = FALSE;
+		pHandle->rxTotalSize = 0;
+		pHandle->rxReadTimesFirst = 0;
+		pHandle->rxReadTimesCount = 0;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Close the protocol system.
+ *	\param[in]	pHandle					A valid protocol handle to close.
+ *	\return								SBG_NO_ERROR if we have closed and released the protocol system.
+ */
+SbgErrorCode sbgEComProtocolClose(SbgEComProtocol *pHandle)
+{
+	//
+	// Test that we have a valid protocol handle
+	//
+	if (pHandle)
+	{
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
+/*!
+ *	Send a frame to the device (size should be less than 4086 bytes).
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	cmd						Command number to send (0 to 65535).
+ *	\param[in]	pData					Pointer on the data payload to send or NULL if no payload.
+ *	\param[in]	size					Size in bytes of the data payload (less than 4086).
+ *	\return								SBG_NO_ERROR if the frame has been sent.
+ */
+SbgErrorCode sbgEComProtocolSend(SbgEComProtocol *pHandle, uint16 cmd, const void *pData, uint32 size)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// First, test input parameters
+	//
+	if ( (pHandle) && (size <= SBG_ECOM_MAX_PAYLOAD_SIZE) && ( ((size > 0) && (pData)) || (size == 0) ) )
+	{
+		//
+		// Avoid copying the payload if the interface is able to write several buffers at once
+		//
+		if (pHandle->pLinkedInterface->pWriteVFunc)
+		{
+			errorCode = sbgEComProtocolSendVectored(pHandle, cmd, pData, size);
+		}
+		else
+		{
+			errorCode = sbgEComProtocolSendContiguous(pHandle, cmd, pData, size);
+		}
+	}
+	else
+	{
+		//
+		// Invalid input parameters
+		//
+		errorCode = SBG_INVALID_PARAMETER;
+	}
 
+	return errorCode;
+}
+
+/*!
+ *	Try to receive a frame from the device and returns the cmd and a read only view on the data field.
+ *	The payload isn't copied: the returned pointer references the protocol reception buffer and is only valid until
+ *	the next call to sbgEComProtocolReceiveView or sbgEComProtocolReceive.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pCmd					Pointer to hold the returned command.
+ *	\param[out]	ppData					Pointer used to hold the address of the received data field.
+ *	\param[out]	pSize					Pointer used to hold the received data field size.
+ *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
+ *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
+ *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
+ *										SBG_NULL_POINTER if an input parameter is NULL.
+ */
+SbgErrorCode sbgEComProtocolReceiveView(SbgEComProtocol *pHandle, uint16 *pCmd, const void **ppData, uint32 *pSize)
+{
+	uint32 crcBudget;
+
+	//
+	// First, test input parameters
+	//
+	if ( (pHandle) && (ppData) && (pSize) )
+	{
 		//
-		// The whole buffer has been paresed and no valid frame has been found
+		// First try to read as much data as we can (only if the receive buffer isn't full)
+		// The CRC of an incomplete frame is only updated with as many bytes as we have just read so that false start
+		// of frames found in noisy data can't cost more CRC computations than the number of received bytes.
 		//
-		return SBG_NOT_READY;
+		crcBudget = sbgEComProtocolRxFill(pHandle);
+
+		//
+		// Try to find a valid frame in all the received data
+		//
+		return sbgEComProtocolRxExtract(pHandle, pCmd, ppData, pSize, crcBudget);
 	}
 	else
 	{
 		return SBG_NULL_POINTER;
 	}
 }
+
+/*!
+ *	Read new data from the interface once and return a descriptor for each complete frame stored in the reception buffer.
+ *	As for sbgEComProtocolReceiveView, payloads aren't copied: the returned views reference the protocol reception buffer
+ *	and are only valid until the next call to a receive method.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pFrames					Array used to return the frame descriptors.
+ *	\param[in]	maxFrames				Number of descriptors that can be stored in pFrames.
+ *	\param[out]	pNumFrames				Pointer used to return the number of descriptors filled.
+ *	\return								SBG_NO_ERROR if at least one frame descriptor has been returned.<br>
+ *										SBG_NOT_READY if the reception buffer doesn't contain any complete frame.<br>
+ *										SBG_NULL_POINTER if an input parameter is NULL.
+ */
+SbgErrorCode sbgEComProtocolReceiveBatch(SbgEComProtocol *pHandle, SbgEComProtocolFrame *pFrames, uint32 maxFrames, uint32 *pNumFrames)
+{
+	SbgErrorCode errorCode;
+	SbgEComProtocolFrame *pFrame;
+	uint32 crcBudget;
+
+	//
+	// First, test input parameters
+	//
+	if ( (pHandle) && (pFrames) && (pNumFrames) )
+	{
+		*pNumFrames = 0;
+
+		//
+		// Read new data only once for the whole batch
+		//
+		crcBudget = sbgEComProtocolRxFill(pHandle);
+
+		//
+		// Extract all complete frames, extracted frames aren't overwritten as no data is read until the next call
+		//
+		while (*pNumFrames < maxFrames)
+		{
+			pFrame = &pFrames[*pNumFrames];
+
+			errorCode = sbgEComProtocolRxExtract(pHandle, &pFrame->cmd, &pFrame->pData, &pFrame->size, crcBudget);
+
+			if (errorCode == SBG_NOT_READY)
+			{
+				break;
+			}
+
+			pFrame->status = errorCode;
+			pFrame->rxTime = sbgEComProtocolRxGetReadTime(pHandle);
+			(*pNumFrames)++;
+		}
+
+		return (*pNumFrames > 0) ? SBG_NO_ERROR : SBG_NOT_READY;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
+/*!
+ *	Keep the views returned so far valid while the interface is read again, for example to wait for a command from a log callback.
+ *	The reception buffer space used by these frames isn't reused until sbgEComProtocolReleaseFrames is called,
+ *	so fewer bytes can be received meanwhile. Calls can be nested.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								SBG_NO_ERROR if the returned frames are held.
+ */
+SbgErrorCode sbgEComProtocolHoldFrames(SbgEComProtocol *pHandle)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pHandle)
+	{
+		//
+		// Frames that wrap around are linearized after the ring buffer end, as the held bytes contain the ring
+		// buffer end no frame received meanwhile can wrap around and overwrite this area
+		//
+		pHandle->rxHoldCount++;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Release the frames held by the matching sbgEComProtocolHoldFrames call, their space is reused by the next receive call.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								SBG_NO_ERROR if the frames have been released.
+ */
+SbgErrorCode sbgEComProtocolReleaseFrames(SbgEComProtocol *pHandle)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pHandle)
+	{
+		if (pHandle->rxHoldCount > 0)
+		{
+			pHandle->rxHoldCount--;
+		}
+		else
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Check if the reception buffer is full, because frames are held or because the stored bytes don't contain any complete frame yet.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								TRUE if no more bytes can be read from the interface.
+ */
+bool sbgEComProtocolIsRxFull(const SbgEComProtocol *pHandle)
+{
+	uint32 usedSize = pHandle->rxBufferSize;
+
+	//
+	// Bytes of frames that aren't held are given back by the next read
+	//
+	if (pHandle->rxHoldCount > 0)
+	{
+		usedSize += pHandle->rxHoldSize;
+	}
+
+	return (usedSize >= SBG_ECOM_MAX_BUFFER_SIZE);
+}
+
+/*!
+ *	Returns the number of complete frames and the number of bytes still stored in the reception buffer.
+ *	Frames are counted by just following their headers from the read cursor without checking their CRC,
+ *	counting stops at the first incomplete frame or invalid header.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pNumFrames				Pointer used to return the number of complete frames.
+ *	\param[out]	pNumBytes				Optional pointer used to return the number of stored bytes.
+ *	\return								SBG_NO_ERROR if the pending frames have been counted.
+ */
+SbgErrorCode sbgEComProtocolGetPendingFrames(const SbgEComProtocol *pHandle, uint32 *pNumFrames, uint32 *pNumBytes)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+	uint32 offset = 0;
+	uint32 payloadSize;
+
+	//
+	// Check input parameters
+	//
+	if ( (pHandle) && (pNumFrames) )
+	{
+		*pNumFrames = 0;
+
+		//
+		// Jump from one frame header to the next one as long as the whole frame has been received
+		//
+		while (pHandle->rxBufferSize - offset >= SBG_ECOM_FRAME_OVERHEAD)
+		{
+			if ( (sbgEComProtocolRxPeek(pHandle, offset) != SBG_ECOM_SYNC_1) || (sbgEComProtocolRxPeek(pHandle, offset + 1) != SBG_ECOM_SYNC_2) )
+			{
+				break;
+			}
+
+			payloadSize = (uint32)(sbgEComProtocolRxPeek(pHandle, offset + 4) | (sbgEComProtocolRxPeek(pHandle, offset + 5) << 8));
+
+			if ( (payloadSize > SBG_ECOM_MAX_PAYLOAD_SIZE) || (pHandle->rxBufferSize - offset < payloadSize + SBG_ECOM_FRAME_OVERHEAD) )
+			{
+				break;
+			}
+
+			offset += payloadSize + SBG_ECOM_FRAME_OVERHEAD;
+			(*pNumFrames)++;
+		}
+
+		if (pNumBytes)
+		{
+			*pNumBytes = pHandle->rxBufferSize;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Try to receive a frame from the device and returns the cmd, data and size of data field.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pCmd					Pointer to hold the returned command.
+ *	\param[out]	pData					Allocated buffer used to hold received data field.
+ *	\param[out]	pSize					Pointer used to hold the received data field size.
+ *	\param[in]	maxSize					Max number of bytes that can be stored in the pData buffer.
+ *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
+ *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
+ *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
+ *										SBG_NULL_POINTER if an input parameter is NULL.<br>
+ *										SBG_BUFFER_OVERFLOW if the received frame payload couldn't fit into the pData buffer.
+ */
+SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint16 *pCmd, void *pData, uint32 *pSize, uint32 maxSize)
+{
+	SbgErrorCode errorCode;
+	const void *pPayload;
+	uint32 payloadSize;
+
+	//
+	// Set the return size to 0 in order to avoid possible bugs
+	//
+	if (pSize)
+	{
+		*pSize = 0;
+	}
+
+	//
+	// Get a view on the next received frame
+	//
+	errorCode = sbgEComProtocolReceiveView(pHandle, pCmd, &pPayload, &payloadSize);
+
+	//
+	// Extract the payload if needed
+	//
+	if ( (errorCode == SBG_NO_ERROR) && (payloadSize > 0) )
+	{
+		//
+		// Check if input parameters are valid
+		//
+		if ( (pData) && (pSize) )
+		{
+			//
+			// Check if we have enough space to store the payload
+			//
+			if (payloadSize <= maxSize)
+			{
+				//
+				// Copy the payload and return the payload size
+				//
+				*pSize = payloadSize;
+				memcpy(pData, pPayload, payloadSize);
+			}
+			else
+			{
+				//
+				// Not enough space to store the payload, we will just drop the received data
+				//
+				errorCode = SBG_BUFFER_OVERFLOW;
+			}
+		}
+		else
+		{
+			errorCode = SBG_NULL_POINTER;
+		}
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Returns a copy of the reception statistics.
+ *	This method doesn't lock anything and can be called from any thread, for example by a monitoring thread.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pStats					Pointer used to return the reception statistics.
+ *	\return								SBG_NO_ERROR if the statistics have been returned.
+ */
+SbgErrorCode sbgEComProtocolGetStats(const SbgEComProtocol *pHandle, SbgEComProtocolStats *pStats)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Check input parameters
+	//
+	if ( (pHandle) && (pStats) )
+	{
+		//
+		// Each counter is read atomically on its own, this is fine as counters are independent
+		//
+		pStats->bytesRead		= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.bytesRead);
+		pStats->framesOk		= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.framesOk);
+		pStats->crcErrors		= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.crcErrors);
+		pStats->etxErrors		= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.etxErrors);
+		pStats->oversizeFrames	= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.oversizeFrames);
+		pStats->bytesDiscarded	= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.bytesDiscarded);
+		pStats->framesFiltered	= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.framesFiltered);
+		pStats->maxRxBacklog	= SBG_ATOMIC_LOAD_RELAXED(pHandle->stats.maxRxBacklog);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Reset all the reception statistics to zero.
+ *	This method should be called from the thread that receives frames.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								SBG_NO_ERROR if the statistics have been reset.
+ */
+SbgErrorCode sbgEComProtocolResetStats(SbgEComProtocol *pHandle)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Check input parameters
+	//
+	if (pHandle)
+	{
+		//
+		// Counters can be read at the same time by a monitoring thread
+		//
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.bytesRead, 0);
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.framesOk, 0);
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.crcErrors, 0);
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.etxErrors, 0);
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.oversizeFrames, 0);
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.bytesDiscarded, 0);
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.framesFiltered, 0);
+		SBG_ATOMIC_STORE_RELAXED(pHandle->stats.maxRxBacklog, 0);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Define if frames with the given command id have to be returned or skipped.
+ *	Skipped frames are neither copied nor returned by sbgEComProtocolReceive and sbgEComProtocolReceiveView.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	cmd						Command id to accept or skip.
+ *	\param[in]	accept					TRUE to return frames with this command id or FALSE to skip them.
+ *	\return								SBG_NO_ERROR if the filter has been updated.
+ */
+SbgErrorCode sbgEComProtocolSetCmdFilter(SbgEComProtocol *pHandle, uint16 cmd, bool accept)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Check input parameters
+	//
+	if (pHandle)
+	{
+		if (accept)
+		{
+			pHandle->rxCmdFilter[cmd >> 5] |= (1u << (cmd & 0x1F));
+		}
+		else
+		{
+			pHandle->rxCmdFilter[cmd >> 5] &= ~(1u << (cmd & 0x1F));
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Accept or skip frames for all command ids at once.
+ *	Call this method with acceptAll set to FALSE and then sbgEComProtocolSetCmdFilter to only receive a few command ids.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	acceptAll				TRUE to return all frames or FALSE to skip all of them.
+ *	\return								SBG_NO_ERROR if the filter has been updated.
+ */
+SbgErrorCode sbgEComProtocolResetCmdFilter(SbgEComProtocol *pHandle, bool acceptAll)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Check input parameters
+	//
+	if (pHandle)
+	{
+		memset(pHandle->rxCmdFilter, (acceptAll) ? 0xFF : 0x00, sizeof(pHandle->rxCmdFilter));
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Define if the CRC of skipped frames has to be checked.
+ *	Without a CRC check, a false start of frame with a valid ETX can make the protocol skip a valid frame.
+ *	With a CRC check, skipped frames with an invalid CRC are returned as SBG_INVALID_CRC errors.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	checkCrc				TRUE to check the CRC of skipped frames (default) or FALSE to skip them as soon as possible.
+ *	\return								SBG_NO_ERROR if the option has been updated.
+ */
+SbgErrorCode sbgEComProtocolSetFilterCrcCheck(SbgEComProtocol *pHandle, bool checkCrc)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Check input parameters
+	//
+	if (pHandle)
+	{
+		pHandle->rxFilterCheckCrc = checkCrc;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Define if interface reads are time stamped so sbgEComProtocolReceiveBatch returns the time at which each frame has been completed.
+ *	Only the last SBG_ECOM_RX_READ_TIMES reads are kept, older frames still stored in the reception buffer then get a later time.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	enable					TRUE to time stamp the reads or FALSE to return a zero rxTime (default).
+ *	\return								SBG_NO_ERROR if the option has been updated.
+ */
+SbgErrorCode sbgEComProtocolSetRxTimeStamps(SbgEComProtocol *pHandle, bool enable)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Check input parameters
+	//
+	if (pHandle)
+	{
+		//
+		// Bytes already stored haven't been time stamped
+		//
+		pHandle->rxTimeStamps = enable;
+		pHandle->rxReadTimesCount = 0;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
@@ -27,15 +27,21 @@
 
 #include <sbgCommon.h>
 #include <interfaces/sbgInterface.h>
+#include <crc/sbgCrc.h>
 
 //----------------------------------------------------------------------//
 //- Global definitions                                                 -//
 //----------------------------------------------------------------------//
-#define SBG_ECOM_MAX_BUFFER_SIZE				(4096)							/*!< Maximum reception buffer size in bytes. */
+#define SBG_ECOM_MAX_BUFFER_SIZE				(4096)							/*!< Maximum reception buffer size in bytes (must be a power of two). */
+#define SBG_ECOM_RX_BUFFER_MASK					(SBG_ECOM_MAX_BUFFER_SIZE-1)	/*!< Mask used to wrap the reception ring buffer cursors. */
 #define SBG_ECOM_MAX_PAYLOAD_SIZE				(4086)							/*!< Maximum payload size in bytes. */
 #define SBG_ECOM_SYNC_1							(0xFF)							/*!< First synchronization char of the frame. */
 #define SBG_ECOM_SYNC_2							(0x5A)							/*!< Second synchronization char of the frame. */
 #define SBG_ECOM_ETX							(0x33)							/*!< End of frame byte. */
+#define SBG_ECOM_FRAME_OVERHEAD					(9)								/*!< Number of bytes added to the payload by the frame header and footer. */
+#define SBG_ECOM_CMD_FILTER_SIZE				(65536/32)						/*!< Number of 32 bits words used to store one bit per command id. */
+#define SBG_ECOM_RX_BATCH_SIZE					(32)							/*!< Number of frame descriptors used by sbgEComHandle for each call to sbgEComProtocolReceiveBatch. */
+#define SBG_ECOM_RX_READ_TIMES					(16)							/*!< Number of interface reads whose time is kept to time stamp the frames stored in the reception buffer. */
 
 #define SBG_ECOM_RX_TIME_OUT					(450)							/*!< Default time out for new frame reception. */
 
@@ -43,14 +49,66 @@
 //- Communication protocol structs and definitions                     -//
 //----------------------------------------------------------------------//
 
+/*!
+ *	Reception statistics of a protocol handle.
+ *	Each counter is only written by the thread that receives frames, using relaxed atomic stores, so it can be read from
+ *	any other thread without locking using sbgEComProtocolGetStats. Counters wrap around so monitoring code should compute unsigned differences.
+ */
+typedef struct _SbgEComProtocolStats
+{
+	uint32				 bytesRead;									/*!< Number of bytes read from the interface. */
+	uint32				 framesOk;									/*!< Number of frames received with a valid CRC. */
+	uint32				 crcErrors;									/*!< Number of complete frames dropped because of an invalid CRC. */
+	uint32				 etxErrors;									/*!< Number of frame candidates dropped because of an invalid ETX char. */
+	uint32				 oversizeFrames;							/*!< Number of frame candidates dropped because their length field exceeds SBG_ECOM_MAX_PAYLOAD_SIZE. */
+	uint32				 bytesDiscarded;							/*!< Number of bytes dropped while looking for a start of frame. */
+	uint32				 framesFiltered;							/*!< Number of frames skipped because of the command id filter. */
+	uint32				 maxRxBacklog;								/*!< Largest number of bytes that have been stored in the reception buffer. */
+} SbgEComProtocolStats;
+
+/*!
+ *	Descriptor of a frame returned by sbgEComProtocolReceiveBatch.
+ */
+typedef struct _SbgEComProtocolFrame
+{
+	SbgErrorCode		 status;									/*!< SBG_NO_ERROR if the frame is valid or SBG_INVALID_CRC if it has an invalid CRC. */
+	uint16				 cmd;										/*!< Command id of the frame. */
+	const void			*pData;										/*!< Read only view on the frame payload in the reception buffer (NULL if the frame is invalid). */
+	uint32				 size;										/*!< Payload size in bytes. */
+	uint64				 rxTime;									/*!< Monotonic time in ns of the interface read that has completed the frame or 0 if reads aren't time stamped. */
+} SbgEComProtocolFrame;
+
+/*!
+ *	Time of an interface read that has appended bytes to the reception buffer.
+ */
+typedef struct _SbgEComProtocolReadTime
+{
+	uint32				 endOffset;									/*!< Number of bytes read from the interface since the protocol initialization, up to the end of this read. */
+	uint64				 time;										/*!< Monotonic time in ns taken just after the read. */
+} SbgEComProtocolReadTime;
+
 /*!
  *	Struct containing all protocol related data.
  */
 typedef struct _SbgEComProtocol
 {
 	SbgInterface		*pLinkedInterface;							/*!< Associated interface used by the protocol to read/write bytes. */
-	uint8				 rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE];		/*!< The reception buffer. */
-	uint32				 rxBufferSize;								/*!< The current reception buffer size in bytes. */
+	uint8				 rxBuffer[SBG_ECOM_MAX_BUFFER_SIZE*2];		/*!< The reception ring buffer followed by an area used to linearize frames that wrap around. */
+	uint32				 rxReadIndex;								/*!< Index in the ring buffer of the first byte that hasn't been processed yet. */
+	uint32				 rxWriteIndex;								/*!< Index in the ring buffer where the next received byte will be stored. */
+	uint32				 rxBufferSize;								/*!< The current number of bytes stored in the ring buffer. */
+	uint32				 rxHoldSize;								/*!< Number of bytes before the read cursor that belong to returned frames and can't be overwritten yet. */
+	uint32				 rxHoldCount;								/*!< Number of sbgEComProtocolHoldFrames calls not released yet. */
+	SbgCrc16			 rxCrc;										/*!< CRC of the frame candidate stored at the beginning of the ring buffer, updated while bytes are received. */
+	uint32				 rxCrcSize;									/*!< Offset, relative to the frame candidate start, of the first byte not included yet in rxCrc. */
+	SbgEComProtocolStats stats;										/*!< Reception statistics. */
+	uint32				 rxCmdFilter[SBG_ECOM_CMD_FILTER_SIZE];		/*!< One bit per command id set if frames with this id have to be returned or cleared to skip them. */
+	bool				 rxFilterCheckCrc;							/*!< TRUE if the CRC of skipped frames is still checked. */
+	bool				 rxTimeStamps;								/*!< TRUE if interface reads are time stamped to fill the frames rxTime. */
+	uint32				 rxTotalSize;								/*!< Number of bytes read from the interface since the protocol initialization (wraps around). */
+	SbgEComProtocolReadTime rxReadTimes[SBG_ECOM_RX_READ_TIMES];	/*!< Ring of the times of the reads whose bytes are still stored in the reception buffer. */
+	uint32				 rxReadTimesFirst;							/*!< Index of the oldest read time in rxReadTimes. */
+	uint32				 rxReadTimesCount;							/*!< Number of read times stored in rxReadTimes. */
 } SbgEComProtocol;
 
 //----------------------------------------------------------------------//
@@ -97,4 +155,123 @@ SbgErrorCode sbgEComProtocolSend(SbgEComProtocol *pHandle, uint16 cmd, const voi
  */
 SbgErrorCode sbgEComProtocolReceive(SbgEComProtocol *pHandle, uint16 *pCmd, void *pData, uint32 *pSize, uint32 maxSize);
 
+/*!
+ *	Try to receive a frame from the device and returns the cmd and a read only view on the data field.
+ *	The payload isn't copied: the returned pointer references the protocol reception buffer and is only valid until
+ *	the next call to sbgEComProtocolReceiveView or sbgEComProtocolReceive.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pCmd					Pointer to hold the returned command.
+ *	\param[out]	ppData					Pointer used to hold the address of the received data field.
+ *	\param[out]	pSize					Pointer used to hold the received data field size.
+ *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
+ *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
+ *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
+ *										SBG_NULL_POINTER if an input parameter is NULL.
+ */
+SbgErrorCode sbgEComProtocolReceiveView(SbgEComProtocol *pHandle, uint16 *pCmd, const void **ppData, uint32 *pSize);
+
+/*!
+ *	Read new data from the interface once and return a descriptor for each complete frame stored in the reception buffer.
+ *	As for sbgEComProtocolReceiveView, payloads aren't copied: the returned views reference the protocol reception buffer
+ *	and are only valid until the next call to a receive method.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pFrames					Array used to return the frame descriptors.
+ *	\param[in]	maxFrames				Number of descriptors that can be stored in pFrames.
+ *	\param[out]	pNumFrames				Pointer used to return the number of descriptors filled.
+ *	\return								SBG_NO_ERROR if at least one frame descriptor has been returned.<br>
+ *										SBG_NOT_READY if the reception buffer doesn't contain any complete frame.<br>
+ *										SBG_NULL_POINTER if an input parameter is NULL.
+ */
+SbgErrorCode sbgEComProtocolReceiveBatch(SbgEComProtocol *pHandle, SbgEComProtocolFrame *pFrames, uint32 maxFrames, uint32 *pNumFrames);
+
+/*!
+ *	Keep the views returned so far valid while the interface is read again, for example to wait for a command from a log callback.
+ *	The reception buffer space used by these frames isn't reused until sbgEComProtocolReleaseFrames is called,
+ *	so fewer bytes can be received meanwhile. Calls can be nested.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								SBG_NO_ERROR if the returned frames are held.
+ */
+SbgErrorCode sbgEComProtocolHoldFrames(SbgEComProtocol *pHandle);
+
+/*!
+ *	Release the frames held by the matching sbgEComProtocolHoldFrames call, their space is reused by the next receive call.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								SBG_NO_ERROR if the frames have been released.
+ */
+SbgErrorCode sbgEComProtocolReleaseFrames(SbgEComProtocol *pHandle);
+
+/*!
+ *	Check if the reception buffer is full, because frames are held or because the stored bytes don't contain any complete frame yet.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								TRUE if no more bytes can be read from the interface.
+ */
+bool sbgEComProtocolIsRxFull(const SbgEComProtocol *pHandle);
+
+/*!
+ *	Returns the number of complete frames and the number of bytes still stored in the reception buffer.
+ *	Frames are counted by just following their headers from the read cursor without checking their CRC,
+ *	counting stops at the first incomplete frame or invalid header.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pNumFrames				Pointer used to return the number of complete frames.
+ *	\param[out]	pNumBytes				Optional pointer used to return the number of stored bytes.
+ *	\return								SBG_NO_ERROR if the pending frames have been counted.
+ */
+SbgErrorCode sbgEComProtocolGetPendingFrames(const SbgEComProtocol *pHandle, uint32 *pNumFrames, uint32 *pNumBytes);
+
+/*!
+ *	Returns a copy of the reception statistics.
+ *	This method doesn't lock anything and can be called from any thread, for example by a monitoring thread.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[out]	pStats					Pointer used to return the reception statistics.
+ *	\return								SBG_NO_ERROR if the statistics have been returned.
+ */
+SbgErrorCode sbgEComProtocolGetStats(const SbgEComProtocol *pHandle, SbgEComProtocolStats *pStats);
+
+/*!
+ *	Reset all the reception statistics to zero.
+ *	This method should be called from the thread that receives frames.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\return								SBG_NO_ERROR if the statistics have been reset.
+ */
+SbgErrorCode sbgEComProtocolResetStats(SbgEComProtocol *pHandle);
+
+/*!
+ *	Define if frames with the given command id have to be returned or skipped.
+ *	Skipped frames are neither copied nor returned by sbgEComProtocolReceive and sbgEComProtocolReceiveView.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	cmd						Command id to accept or skip.
+ *	\param[in]	accept					TRUE to return frames with this command id or FALSE to skip them.
+ *	\return								SBG_NO_ERROR if the filter has been updated.
+ */
+SbgErrorCode sbgEComProtocolSetCmdFilter(SbgEComProtocol *pHandle, uint16 cmd, bool accept);
+
+/*!
+ *	Accept or skip frames for all command ids at once.
+ *	Call this method with acceptAll set to FALSE and then sbgEComProtocolSetCmdFilter to only receive a few command ids.
+ *	Don't skip the commands class if sbgEComReceiveCmd is used to wait for command answers.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	acceptAll				TRUE to return all frames or FALSE to skip all of them.
+ *	\return								SBG_NO_ERROR if the filter has been updated.
+ */
+SbgErrorCode sbgEComProtocolResetCmdFilter(SbgEComProtocol *pHandle, bool acceptAll);
+
+/*!
+ *	Define if the CRC of skipped frames has to be checked.
+ *	Without a CRC check, a false start of frame with a valid ETX can make the protocol skip a valid frame.
+ *	With a CRC check, skipped frames with an invalid CRC are returned as SBG_INVALID_CRC errors.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	checkCrc				TRUE to check the CRC of skipped frames (default) or FALSE to skip them as soon as possible.
+ *	\return								SBG_NO_ERROR if the option has been updated.
+ */
+SbgErrorCode sbgEComProtocolSetFilterCrcCheck(SbgEComProtocol *pHandle, bool checkCrc);
+
+/*!
+ *	Define if interface reads are time stamped so sbgEComProtocolReceiveBatch returns the time at which each frame has been completed.
+ *	Only the last SBG_ECOM_RX_READ_TIMES reads are kept, older frames still stored in the reception buffer then get a later time.
+ *	\param[in]	pHandle					A valid protocol handle.
+ *	\param[in]	enable					TRUE to time stamp the reads or FALSE to return a zero rxTime (default).
+ *	\return								SBG_NO_ERROR if the option has been updated.
+ */
+SbgErrorCode sbgEComProtocolSetRxTimeStamps(SbgEComProtocol *pHandle, bool enable);
+
 #endif
@@ -1,10 +1,1097 @@
 #include "sbgECom.h"
 #include "sbgEComVersion.h"
+#include <streamBuffer/sbgStreamBuffer.h>
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+/*!
+ *	Locks used to share the handle between a dispatcher thread and command waiters, kept out of the public header.
+ */
+struct _SbgEComHandleLocks
+{
+	SbgPlatformMutex			*pReadLock;					/*!< Held by the thread that reads and dispatches received frames. */
+	SbgPlatformMutex			*pWaiterLock;				/*!< Protects the command waiters slots. */
+	SbgPlatformCond				*pWaiterCond;				/*!< Signaled each time a command frame is given to a waiter. */
+	SbgPlatformMutex			*pAsyncCmdLock;				/*!< Protects the asynchronous commands slots and their sending. */
+};
+#endif
 
 //----------------------------------------------------------------------//
 //- Private methods declarations                                       -//
 //----------------------------------------------------------------------//
 
+/*!
+ *	Parse a received binary log and forward it to the user callback.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	logCmd							The received binary log command id.
+ *	\param[in]	pPayload						Read only pointer on the received payload.
+ *	\param[in]	payloadSize						Payload size in bytes.
+ *	\param[in]	completionTime					Monotonic time in ns of the interface read that has completed the frame or 0 if latencies aren't measured.
+ *	\return										SBG_NO_ERROR if the log has been parsed and handled successfully.
+ */
+static SbgErrorCode sbgEComDispatchLog(SbgEComHandle *pHandle, uint16 logCmd, const void *pPayload, uint32 payloadSize, uint64 completionTime)
+{
+	SbgErrorCode		errorCode = SBG_NO_ERROR;
+	SbgBinaryLogData	logData;
+	SbgEComLogCallback	*pLogCallbacks;
+	uint32				numLogCallbacks;
+	SbgEComLatencyStats	*pLatencyStats;
+	uint64				entryTime = 0;
+	uint64				callbackTime = 0;
+	uint64				startTime = 0;
+	bool				isParsed;
+	uint32				i;
+
+	//
+	// Get the callbacks registered for this log
+	//
+	pLogCallbacks = pHandle->logCallbacks[logCmd];
+	numLogCallbacks = pHandle->numLogCallbacks[logCmd];
+
+	//
+	// Latencies are only measured if the frame completion time is known
+	//
+	pLatencyStats = (completionTime != 0) ? pHandle->pLatencyStats : NULL;
+
+	//
+	// Don't parse the log if nobody is interested in it
+	//
+	isParsed = (pHandle->pReceiveCallback) || (numLogCallbacks > 0);
+
+	if (isParsed)
+	{
+		//
+		// The received frame is a binary log one, parse it directly from the reception buffer
+		// This is done before any callback is called so the parsed log can't depend on what the raw callback does
+		//
+		errorCode = sbgEComBinaryLogParse(logCmd, pPayload, payloadSize, &logData);
+	}
+
+	//
+	// Forward the raw payload first so it can be decoded on demand
+	//
+	if (pHandle->pReceiveRawCallback)
+	{
+		if (pLatencyStats)
+		{
+			entryTime = sbgGetMonotonicNs();
+		}
+
+		pHandle->pReceiveRawCallback(pHandle, (SbgEComCmdId)logCmd, pPayload, payloadSize, pHandle->pRawUserArg);
+
+		if (pLatencyStats)
+		{
+			callbackTime = sbgGetMonotonicNs() - entryTime;
+		}
+	}
+
+	//
+	// Test if the incoming log has been parsed successfully
+	//
+	if ( (isParsed) && (errorCode == SBG_NO_ERROR) )
+	{
+		if (pLatencyStats)
+		{
+			startTime = sbgGetMonotonicNs();
+
+			if (entryTime == 0)
+			{
+				entryTime = startTime;
+			}
+		}
+
+		//
+		// Test if we have a valid callback to handle received logs
+		//
+		if (pHandle->pReceiveCallback)
+		{
+			//
+			// Call the binary log callback
+			//
+			errorCode = pHandle->pReceiveCallback(pHandle, (SbgEComCmdId)logCmd, &logData, pHandle->pUserArg);
+		}
+
+		//
+		// Call all the callbacks registered for this log
+		//
+		for (i = 0; i < numLogCallbacks; i++)
+		{
+			pLogCallbacks[i].pCallback(pHandle, (SbgEComCmdId)logCmd, &logData, pLogCallbacks[i].pUserArg);
+		}
+
+		if (pLatencyStats)
+		{
+			callbackTime += sbgGetMonotonicNs() - startTime;
+		}
+	}
+	else if (isParsed)
+	{
+		//
+		// Call the on error callback
+		//
+	}
+
+	//
+	// Only logs that have reached a callback are recorded
+	//
+	if ( (pLatencyStats) && (entryTime != 0) )
+	{
+		sbgEComLatencyRecord(pLatencyStats, logCmd, entryTime - completionTime, callbackTime);
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Returns an identifier of the calling thread, used to know if it already holds the read lock of a handle.
+ *	\return										Non zero identifier of the calling thread.
+ */
+static uint32 sbgEComGetThreadId(void)
+{
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+	return sbgPlatformGetThreadId();
+#else
+	//
+	// Only one thread uses the library
+	//
+	return 1;
+#endif
+}
+
+/*!
+ *	Acquire the lock that protects the asynchronous commands slots and their sending.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComAsyncCmdLock(SbgEComHandle *pHandle)
+{
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+	sbgPlatformMutexLock(pHandle->pLocks->pAsyncCmdLock);
+#else
+	SBG_UNUSED_PARAMETER(pHandle);
+#endif
+}
+
+/*!
+ *	Release the asynchronous commands lock.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComAsyncCmdUnlock(SbgEComHandle *pHandle)
+{
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+	sbgPlatformMutexUnlock(pHandle->pLocks->pAsyncCmdLock);
+#else
+	SBG_UNUSED_PARAMETER(pHandle);
+#endif
+}
+
+/*!
+ *	Returns the asynchronous command slot associated with a ticket.
+ *	Cancelled commands are ignored as their ticket has already been released.
+ *	The asynchronous commands lock has to be held.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	ticket							Ticket of the command.
+ *	\return										Pointer on the command slot or NULL if the ticket is unknown.
+ */
+static SbgEComAsyncCmd *sbgEComAsyncCmdFind(SbgEComHandle *pHandle, uint32 ticket)
+{
+	uint32	i;
+
+	for (i = 0; i < SBG_ECOM_MAX_ASYNC_CMDS; i++)
+	{
+		if ( (pHandle->asyncCmds[i].state != SBG_ECOM_ASYNC_CMD_FREE) && (pHandle->asyncCmds[i].state != SBG_ECOM_ASYNC_CMD_CANCELLED) && (pHandle->asyncCmds[i].ticket == ticket) )
+		{
+			return &pHandle->asyncCmds[i];
+		}
+	}
+
+	return NULL;
+}
+
+/*!
+ *	Returns the asynchronous command in the given state that has been submitted first.
+ *	The asynchronous commands lock has to be held.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	state							State of the command to look for.
+ *	\return										Pointer on the command slot or NULL if no command is in this state.
+ */
+static SbgEComAsyncCmd *sbgEComAsyncCmdFindOldest(SbgEComHandle *pHandle, SbgEComAsyncCmdState state)
+{
+	SbgEComAsyncCmd	*pOldest = NULL;
+	uint32			i;
+
+	for (i = 0; i < SBG_ECOM_MAX_ASYNC_CMDS; i++)
+	{
+		//
+		// Tickets are compared using a difference so the order is kept when they wrap around
+		//
+		if ( (pHandle->asyncCmds[i].state == state) && ( (pOldest == NULL) || ((int32)(pHandle->asyncCmds[i].ticket - pOldest->ticket) < 0) ) )
+		{
+			pOldest = &pHandle->asyncCmds[i];
+		}
+	}
+
+	return pOldest;
+}
+
+/*!
+ *	Returns the asynchronous command that has been sent and waits for its answer, even if it has been cancelled meanwhile.
+ *	The asynchronous commands lock has to be held.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\return										Pointer on the command slot or NULL if no command is in progress.
+ */
+static SbgEComAsyncCmd *sbgEComAsyncCmdFindSent(SbgEComHandle *pHandle)
+{
+	SbgEComAsyncCmd	*pCmd;
+
+	//
+	// Only one command is in progress at a time
+	//
+	pCmd = sbgEComAsyncCmdFindOldest(pHandle, SBG_ECOM_ASYNC_CMD_SENT);
+
+	if (pCmd == NULL)
+	{
+		pCmd = sbgEComAsyncCmdFindOldest(pHandle, SBG_ECOM_ASYNC_CMD_CANCELLED);
+	}
+
+	return pCmd;
+}
+
+/*!
+ *	Complete an asynchronous command and either call its callback or keep its result until it is read.
+ *	The asynchronous commands lock has to be held, it is released while the callback is called.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pCmd							The command to complete.
+ *	\param[in]	result							The command result.
+ *	\param[in]	pAnswer							Received answer payload or NULL.
+ *	\param[in]	answerSize						Answer payload size in bytes.
+ */
+static void sbgEComAsyncCmdComplete(SbgEComHandle *pHandle, SbgEComAsyncCmd *pCmd, SbgErrorCode result, const void *pAnswer, uint32 answerSize)
+{
+	SbgEComAsyncCmdFunc	 pCallback;
+	void				*pUserArg;
+	uint32				 ticket;
+
+	//
+	// Store the answer in the user buffer if needed
+	//
+	pCmd->answerSize = 0;
+
+	if ( (pAnswer) && (pCmd->pAnswer) )
+	{
+		if (answerSize <= pCmd->maxAnswerSize)
+		{
+			memcpy(pCmd->pAnswer, pAnswer, answerSize);
+			pCmd->answerSize = answerSize;
+		}
+		else if (result == SBG_NO_ERROR)
+		{
+			result = SBG_BUFFER_OVERFLOW;
+		}
+	}
+
+	if (pCmd->pCallback)
+	{
+		pCallback = pCmd->pCallback;
+		pUserArg = pCmd->pUserArg;
+		ticket = pCmd->ticket;
+
+		//
+		// Release the slot and the lock first so the callback can submit a new command
+		//
+		pCmd->state = SBG_ECOM_ASYNC_CMD_FREE;
+
+		sbgEComAsyncCmdUnlock(pHandle);
+		pCallback(pHandle, ticket, result, pAnswer, answerSize, pUserArg);
+		sbgEComAsyncCmdLock(pHandle);
+	}
+	else
+	{
+		pCmd->result = result;
+		pCmd->state = SBG_ECOM_ASYNC_CMD_COMPLETED;
+	}
+}
+
+/*!
+ *	Send the oldest queued asynchronous command and handle the time out of the one that has been sent.
+ *	The asynchronous commands lock has to be held.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComAsyncCmdUpdate(SbgEComHandle *pHandle)
+{
+	SbgErrorCode	errorCode;
+	SbgEComAsyncCmd	*pCmd;
+	uint64			currentTime;
+
+	currentTime = sbgGetTimeUs();
+
+	//
+	// Only one command is sent at a time as answers can only be matched using the command id
+	//
+	pCmd = sbgEComAsyncCmdFindSent(pHandle);
+
+	if (pCmd)
+	{
+		if (currentTime < pCmd->timeOutTime)
+		{
+			return;
+		}
+
+		if (pCmd->state == SBG_ECOM_ASYNC_CMD_CANCELLED)
+		{
+			//
+			// No late answer can be received anymore for the cancelled command
+			//
+			pCmd->state = SBG_ECOM_ASYNC_CMD_FREE;
+			pCmd = NULL;
+		}
+		else if (pCmd->numTrials >= SBG_ECOM_ASYNC_CMD_NUM_TRIALS)
+		{
+			sbgEComAsyncCmdComplete(pHandle, pCmd, SBG_TIME_OUT, NULL, 0);
+			pCmd = NULL;
+		}
+	}
+
+	//
+	// Send the next command, commands that can't be sent are directly completed
+	//
+	do
+	{
+		if (pCmd == NULL)
+		{
+			pCmd = sbgEComAsyncCmdFindOldest(pHandle, SBG_ECOM_ASYNC_CMD_QUEUED);
+
+			if (pCmd == NULL)
+			{
+				break;
+			}
+		}
+
+		errorCode = sbgEComProtocolSend(&pHandle->protocolHandle, pCmd->cmd, pCmd->payload, pCmd->payloadSize);
+
+		if (errorCode == SBG_NO_ERROR)
+		{
+			pCmd->state = SBG_ECOM_ASYNC_CMD_SENT;
+			pCmd->numTrials++;
+			pCmd->timeOutTime = currentTime + (uint64)pCmd->timeOut * 1000;
+		}
+		else
+		{
+			sbgEComAsyncCmdComplete(pHandle, pCmd, errorCode, NULL, 0);
+			pCmd = NULL;
+		}
+	} while (pCmd == NULL);
+}
+
+/*!
+ *	Complete the command that has been sent with its received answer and send the next queued one.
+ *	The answer of a cancelled command is just dropped.
+ *	The asynchronous commands lock has to be held.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pCmd							The command that has been sent.
+ *	\param[in]	result							The command result.
+ *	\param[in]	pAnswer							Received answer payload or NULL.
+ *	\param[in]	answerSize						Answer payload size in bytes.
+ */
+static void sbgEComAsyncCmdFinish(SbgEComHandle *pHandle, SbgEComAsyncCmd *pCmd, SbgErrorCode result, const void *pAnswer, uint32 answerSize)
+{
+	if (pCmd->state == SBG_ECOM_ASYNC_CMD_CANCELLED)
+	{
+		pCmd->state = SBG_ECOM_ASYNC_CMD_FREE;
+	}
+	else
+	{
+		sbgEComAsyncCmdComplete(pHandle, pCmd, result, pAnswer, answerSize);
+	}
+
+	sbgEComAsyncCmdUpdate(pHandle);
+}
+
+/*!
+ *	Check if a received command frame completes the asynchronous command that has been sent.
+ *	The asynchronous commands lock has to be held.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	cmd								Received command id.
+ *	\param[in]	pPayload						Read only pointer on the received payload.
+ *	\param[in]	payloadSize						Payload size in bytes.
+ *	\return										TRUE if the frame has been used by an asynchronous command.
+ */
+static bool sbgEComAsyncCmdProcessFrame(SbgEComHandle *pHandle, uint16 cmd, const void *pPayload, uint32 payloadSize)
+{
+	SbgEComAsyncCmd	*pCmd;
+	SbgStreamBuffer	inputStream;
+	uint16			ackCmd;
+	SbgErrorCode	ackError;
+
+	pCmd = sbgEComAsyncCmdFindSent(pHandle);
+
+	if (pCmd)
+	{
+		if ( (cmd == SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_ACK)) && (payloadSize == 2*sizeof(uint16)) )
+		{
+			//
+			// The ACK frame contains the acknowledged command id and the returned error code
+			//
+			sbgStreamBufferInitForRead(&inputStream, pPayload, payloadSize);
+			ackCmd = sbgStreamBufferReadUint16LE(&inputStream);
+			ackError = (SbgErrorCode)sbgStreamBufferReadUint16LE(&inputStream);
+
+			if (ackCmd == pCmd->cmd)
+			{
+				//
+				// An answer is expected for get commands so only an ACK with an error completes them
+				//
+				if ( (pCmd->type == SBG_ECOM_ASYNC_CMD_WAIT_ACK) || (ackError != SBG_NO_ERROR) )
+				{
+					sbgEComAsyncCmdFinish(pHandle, pCmd, ackError, NULL, 0);
+				}
+
+				return TRUE;
+			}
+		}
+		else if ( (pCmd->type == SBG_ECOM_ASYNC_CMD_WAIT_ANSWER) && (cmd == pCmd->cmd) )
+		{
+			sbgEComAsyncCmdFinish(pHandle, pCmd, SBG_NO_ERROR, pPayload, payloadSize);
+
+			return TRUE;
+		}
+	}
+
+	return FALSE;
+}
+
+/*!
+ *	Acquire the read lock, only the thread that holds it reads the interface and dispatches received frames.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	wait							TRUE to block until the lock is available or FALSE to return immediately.
+ *	\return										TRUE if the read lock has been acquired.
+ */
+static bool sbgEComReadLock(SbgEComHandle *pHandle, bool wait)
+{
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+	if (wait)
+	{
+		sbgPlatformMutexLock(pHandle->pLocks->pReadLock);
+	}
+	else if (!sbgPlatformMutexTryLock(pHandle->pLocks->pReadLock))
+	{
+		return FALSE;
+	}
+#else
+	SBG_UNUSED_PARAMETER(wait);
+#endif
+
+	//
+	// Remember which thread holds this lock
+	//
+	SBG_ATOMIC_STORE_RELAXED(pHandle->readThreadId, sbgEComGetThreadId());
+
+	return TRUE;
+}
+
+/*!
+ *	Release the read lock.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComReadUnlock(SbgEComHandle *pHandle)
+{
+	SBG_ATOMIC_STORE_RELAXED(pHandle->readThreadId, 0);
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+	sbgPlatformMutexUnlock(pHandle->pLocks->pReadLock);
+#endif
+}
+
+/*!
+ *	Check if the calling thread already holds the read lock, for example when a command is sent from a log callback.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\return										TRUE if the calling thread holds the read lock.
+ */
+static bool sbgEComReadIsOwned(const SbgEComHandle *pHandle)
+{
+	//
+	// Only the thread that holds the lock can read its own identifier
+	//
+	return (SBG_ATOMIC_LOAD_RELAXED(pHandle->readThreadId) == sbgEComGetThreadId());
+}
+
+/*!
+ *	Acquire the lock that protects the command waiters slots.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComCmdWaiterLock(SbgEComHandle *pHandle)
+{
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+	sbgPlatformMutexLock(pHandle->pLocks->pWaiterLock);
+#else
+	SBG_UNUSED_PARAMETER(pHandle);
+#endif
+}
+
+/*!
+ *	Release the command waiters lock.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComCmdWaiterUnlock(SbgEComHandle *pHandle)
+{
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+	sbgPlatformMutexUnlock(pHandle->pLocks->pWaiterLock);
+#else
+	SBG_UNUSED_PARAMETER(pHandle);
+#endif
+}
+
+/*!
+ *	Take a free command waiter slot, it has to be registered before the interface is read so no answer can be missed.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	anyCmd							TRUE to accept any command.
+ *	\param[in]	command							The command to look for if anyCmd is FALSE.
+ *	\param[out]	pData							Buffer used to store the received payload.
+ *	\param[in]	maxSize							Max number of bytes that can be stored in the pData buffer.
+ *	\return										The registered waiter or NULL if all slots are used.
+ */
+static SbgEComCmdWaiter *sbgEComCmdWaiterAdd(SbgEComHandle *pHandle, bool anyCmd, uint16 command, void *pData, uint32 maxSize)
+{
+	SbgEComCmdWaiter	*pWaiter = NULL;
+	uint32				 i;
+
+	sbgEComCmdWaiterLock(pHandle);
+
+	for (i = 0; i < SBG_ECOM_MAX_CMD_WAITERS; i++)
+	{
+		if (!pHandle->cmdWaiters[i].used)
+		{
+			pWaiter = &pHandle->cmdWaiters[i];
+
+			pWaiter->used = TRUE;
+			pWaiter->anyCmd = anyCmd;
+			pWaiter->command = command;
+			pWaiter->received = FALSE;
+			pWaiter->pData = pData;
+			pWaiter->maxSize = maxSize;
+			break;
+		}
+	}
+
+	sbgEComCmdWaiterUnlock(pHandle);
+
+	return pWaiter;
+}
+
+/*!
+ *	Release a command waiter slot and return the received frame if any.
+ *	Once released, the dispatcher can't write in the waiter buffer anymore.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pWaiter							The waiter to release.
+ *	\param[out]	pCommand						Optional pointer used to return the received command.
+ *	\param[out]	pSize							Optional pointer used to hold the received data field size.
+ *	\return										SBG_NO_ERROR if a frame has been received.<br>
+ *												SBG_NOT_READY if no matching frame has been received.<br>
+ *												SBG_BUFFER_OVERFLOW if the payload couldn't fit into the waiter buffer.
+ */
+static SbgErrorCode sbgEComCmdWaiterRemove(SbgEComHandle *pHandle, SbgEComCmdWaiter *pWaiter, uint16 *pCommand, uint32 *pSize)
+{
+	SbgErrorCode	errorCode = SBG_NOT_READY;
+
+	sbgEComCmdWaiterLock(pHandle);
+
+	if (pWaiter->received)
+	{
+		if (pCommand)
+		{
+			*pCommand = pWaiter->receivedCmd;
+		}
+
+		if (pSize)
+		{
+			*pSize = pWaiter->payloadSize;
+		}
+
+		errorCode = pWaiter->result;
+	}
+
+	pWaiter->used = FALSE;
+
+	sbgEComCmdWaiterUnlock(pHandle);
+
+	return errorCode;
+}
+
+/*!
+ *	Check if a command waiter has received its frame.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pWaiter							The waiter to check.
+ *	\param[in]	waitTime						Time in ms to wait for the frame if it hasn't been received yet or 0 to return immediately.
+ *	\return										TRUE if the frame has been received.
+ */
+static bool sbgEComCmdWaiterIsReceived(SbgEComHandle *pHandle, SbgEComCmdWaiter *pWaiter, uint32 waitTime)
+{
+	bool	received;
+
+	sbgEComCmdWaiterLock(pHandle);
+
+	//
+	// Check and wait under the same lock so a frame given in between can't be missed
+	//
+	if ( (!pWaiter->received) && (waitTime > 0) )
+	{
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+		sbgPlatformCondWait(pHandle->pLocks->pWaiterCond, pHandle->pLocks->pWaiterLock, waitTime);
+#endif
+	}
+
+	received = pWaiter->received;
+
+	sbgEComCmdWaiterUnlock(pHandle);
+
+	return received;
+}
+
+/*!
+ *	Give a received command frame to a waiter that accepts it and wake up the waiting threads.
+ *	The frame is discarded if nobody waits for it.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	cmd								Received command id.
+ *	\param[in]	pPayload						Read only pointer on the received payload.
+ *	\param[in]	payloadSize						Payload size in bytes.
+ */
+static void sbgEComCmdWaiterPost(SbgEComHandle *pHandle, uint16 cmd, const void *pPayload, uint32 payloadSize)
+{
+	SbgEComCmdWaiter	*pWaiter;
+	uint32				 i;
+
+	sbgEComCmdWaiterLock(pHandle);
+
+	for (i = 0; i < SBG_ECOM_MAX_CMD_WAITERS; i++)
+	{
+		pWaiter = &pHandle->cmdWaiters[i];
+
+		if ( (pWaiter->used) && (!pWaiter->received) && ((pWaiter->anyCmd) || (pWaiter->command == cmd)) )
+		{
+			pWaiter->received = TRUE;
+			pWaiter->receivedCmd = cmd;
+			pWaiter->payloadSize = payloadSize;
+
+			//
+			// Make sure that the payload can be stored and fit in the destination buffer
+			//
+			if ( (payloadSize == 0) || ((pWaiter->pData) && (payloadSize <= pWaiter->maxSize)) )
+			{
+				if (payloadSize > 0)
+				{
+					memcpy(pWaiter->pData, pPayload, payloadSize);
+				}
+
+				pWaiter->result = SBG_NO_ERROR;
+			}
+			else
+			{
+				pWaiter->result = SBG_BUFFER_OVERFLOW;
+			}
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+			sbgPlatformCondBroadcast(pHandle->pLocks->pWaiterCond);
+#endif
+			break;
+		}
+	}
+
+	sbgEComCmdWaiterUnlock(pHandle);
+}
+
+/*!
+ *	Dispatch the frames of the current batch that haven't been dispatched yet.
+ *	The index is updated before each dispatch so a callback can go on with the next frames.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComDispatchPendingFrames(SbgEComHandle *pHandle)
+{
+	const SbgEComProtocolFrame	*pFrame;
+	bool						 isAsyncAnswer;
+
+	while (pHandle->rxFrameIndex < pHandle->rxNumFrames)
+	{
+		pFrame = &pHandle->pRxFrames[pHandle->rxFrameIndex];
+		pHandle->rxFrameIndex++;
+
+		//
+		// Test if we have received a valid frame
+		//
+		if (pFrame->status == SBG_NO_ERROR)
+		{
+			//
+			// Test if the received frame is a binary log
+			//
+			if (sbgEComBinaryLogIsCmdValid(pFrame->cmd))
+			{
+				//
+				// The received frame is a binary log one
+				//
+				sbgEComDispatchLog(pHandle, pFrame->cmd, pFrame->pData, pFrame->size, pFrame->rxTime);
+			}
+			else
+			{
+				sbgEComAsyncCmdLock(pHandle);
+				isAsyncAnswer = sbgEComAsyncCmdProcessFrame(pHandle, pFrame->cmd, pFrame->pData, pFrame->size);
+				sbgEComAsyncCmdUnlock(pHandle);
+
+				if (!isAsyncAnswer)
+				{
+					//
+					// The received command isn't the answer of an asynchronous command so give it to sbgEComReceiveCmd
+					//
+					sbgEComCmdWaiterPost(pHandle, pFrame->cmd, pFrame->pData, pFrame->size);
+				}
+			}
+		}
+		else
+		{
+			//
+			// We have received an invalid frame
+			//
+			SBG_LOG_WARNING(pFrame->status, "Invalid frame received with command id: %u", pFrame->cmd);
+		}
+	}
+}
+
+/*!
+ *	Handle received frames within a budget, the read lock has to be held by the calling thread.
+ *	Nothing is read when called from a callback, while the frames of the current batch are still being dispatched.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	maxFrames						Maximum number of frames to handle or 0 for no limit.
+ *	\param[in]	maxMicros						Maximum time in us spent to handle frames or 0 for no limit.
+ *	\param[out]	pStats							Optional pointer used to return the number of handled and still buffered frames.
+ *	\return										SBG_NOT_READY if all received frames have been handled.<br>
+ *												SBG_NO_ERROR if the budget has been exhausted and some frames may still have to be handled.
+ */
+static SbgErrorCode sbgEComHandleFrames(SbgEComHandle *pHandle, uint32 maxFrames, uint32 maxMicros, SbgEComHandleStats *pStats)
+{
+	SbgErrorCode			errorCode = SBG_NO_ERROR;
+	SbgEComProtocolFrame	frames[SBG_ECOM_RX_BATCH_SIZE];
+	uint32					numFrames;
+	uint32					batchSize;
+	uint32					numHandledFrames = 0;
+	uint64					startTime = 0;
+
+	//
+	// The frames of a batch are views on the reception buffer so a callback can't read the interface again
+	// before all of them have been dispatched, received frames are then left to the outer call
+	//
+	if (pHandle->isDispatching)
+	{
+		if (pStats)
+		{
+			pStats->numFrames = 0;
+			sbgEComProtocolGetPendingFrames(&pHandle->protocolHandle, &pStats->numPendingFrames, &pStats->numPendingBytes);
+		}
+
+		return SBG_NOT_READY;
+	}
+
+	if (maxMicros > 0)
+	{
+		startTime = sbgGetTimeUs();
+	}
+
+	pHandle->isDispatching = TRUE;
+
+	//
+	// Try to read all received frames, each batch reads the interface only once
+	//
+	do
+	{
+		//
+		// Don't extract more frames than allowed by the frames budget as extracted frames are removed from the buffer
+		//
+		batchSize = SBG_ECOM_RX_BATCH_SIZE;
+
+		if ( (maxFrames > 0) && (maxFrames - numHandledFrames < batchSize) )
+		{
+			batchSize = maxFrames - numHandledFrames;
+		}
+
+		//
+		// Get all the frames that are available in the reception buffer
+		//
+		errorCode = sbgEComProtocolReceiveBatch(&pHandle->protocolHandle, frames, batchSize, &numFrames);
+
+		//
+		// The batch is stored in the handle so a callback waiting for a command can dispatch the remaining frames first
+		//
+		pHandle->pRxFrames = frames;
+		pHandle->rxNumFrames = numFrames;
+		pHandle->rxFrameIndex = 0;
+
+		sbgEComDispatchPendingFrames(pHandle);
+
+		//
+		// Drive the asynchronous commands (time out and retries)
+		//
+		sbgEComAsyncCmdLock(pHandle);
+		sbgEComAsyncCmdUpdate(pHandle);
+		sbgEComAsyncCmdUnlock(pHandle);
+
+		numHandledFrames += numFrames;
+
+		//
+		// Stop once the frames or time budget is exhausted
+		//
+		if ( (maxFrames > 0) && (numHandledFrames >= maxFrames) )
+		{
+			break;
+		}
+
+		if ( (maxMicros > 0) && (sbgGetTimeUs() - startTime >= maxMicros) )
+		{
+			break;
+		}
+	} while (errorCode == SBG_NO_ERROR);
+
+	pHandle->isDispatching = FALSE;
+	pHandle->pRxFrames = NULL;
+	pHandle->rxNumFrames = 0;
+	pHandle->rxFrameIndex = 0;
+
+	//
+	// Report what has been done and what is still waiting in the reception buffer
+	//
+	if (pStats)
+	{
+		pStats->numFrames = numHandledFrames;
+		sbgEComProtocolGetPendingFrames(&pHandle->protocolHandle, &pStats->numPendingFrames, &pStats->numPendingBytes);
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Wait for a command frame from a callback, the calling thread already holds the read lock and is dispatching received frames.
+ *	The remaining frames of the current batch are dispatched first so binary logs are still given in order, the interface is then read
+ *	while the frames whose callbacks are still running are held in the reception buffer.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pWaiter							The registered waiter.
+ *	\param[in]	lastValidTime					Time in us after which the command is considered as not received.
+ *	\return										SBG_NO_ERROR if the command has been received.<br>
+ *												SBG_NOT_READY if the reception buffer is full or a command is already waited from a callback.<br>
+ *												SBG_TIME_OUT if the command hasn't been received within the time out.
+ */
+static SbgErrorCode sbgEComWaitCmdInCallback(SbgEComHandle *pHandle, SbgEComCmdWaiter *pWaiter, uint64 lastValidTime)
+{
+	SbgErrorCode				 errorCode = SBG_TIME_OUT;
+	const SbgEComProtocolFrame	*pRxFrames;
+	uint32						 rxNumFrames;
+	uint64						 currentTime;
+
+	//
+	// Callbacks called from here can't wait for a command, each level would hold more of the reception buffer
+	//
+	if (pHandle->isWaitingInCallback)
+	{
+		return SBG_NOT_READY;
+	}
+
+	pHandle->isWaitingInCallback = TRUE;
+
+	sbgEComDispatchPendingFrames(pHandle);
+
+	//
+	// The frames of the current batch are read again by the outer call, its dispatching state is restored at the end
+	//
+	pRxFrames = pHandle->pRxFrames;
+	rxNumFrames = pHandle->rxNumFrames;
+
+	sbgEComProtocolHoldFrames(&pHandle->protocolHandle);
+	pHandle->isDispatching = FALSE;
+
+	do
+	{
+		if (sbgEComHandleFrames(pHandle, SBG_ECOM_RX_BATCH_SIZE, 0, NULL) == SBG_NOT_READY)
+		{
+			if (sbgEComCmdWaiterIsReceived(pHandle, pWaiter, 0))
+			{
+				errorCode = SBG_NO_ERROR;
+				break;
+			}
+
+			//
+			// Nothing more can be read while the frames of the outer calls are held
+			//
+			if (sbgEComProtocolIsRxFull(&pHandle->protocolHandle))
+			{
+				errorCode = SBG_NOT_READY;
+				break;
+			}
+
+			currentTime = sbgGetTimeUs();
+
+			if (lastValidTime > currentTime)
+			{
+				sbgInterfaceWaitReadable(pHandle->protocolHandle.pLinkedInterface, (uint32)((lastValidTime - currentTime + 999) / 1000));
+			}
+		}
+		else if (sbgEComCmdWaiterIsReceived(pHandle, pWaiter, 0))
+		{
+			errorCode = SBG_NO_ERROR;
+			break;
+		}
+	} while (lastValidTime >= sbgGetTimeUs());
+
+	pHandle->isDispatching = TRUE;
+	pHandle->pRxFrames = pRxFrames;
+	pHandle->rxNumFrames = rxNumFrames;
+	pHandle->rxFrameIndex = rxNumFrames;
+	sbgEComProtocolReleaseFrames(&pHandle->protocolHandle);
+
+	pHandle->isWaitingInCallback = FALSE;
+
+	return errorCode;
+}
+
+/*!
+ *	Wait for a command frame, either by reading the interface or, if another thread is dispatching received frames, by waiting for it to give the frame.
+ *	When called from a callback, the frames of the current batch are dispatched first and the interface is then read by the callback.
+ *	When the dispatching thread is blocked in a callback, nothing can be received so the method returns immediately.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	anyCmd							TRUE to accept any command.
+ *	\param[in]	command							The command to look for if anyCmd is FALSE.
+ *	\param[out]	pCommand						Optional pointer used to return the received command.
+ *	\param[out]	pData							Allocated buffer used to hold received data field.
+ *	\param[out]	pSize							Optional pointer used to hold the received data field size.
+ *	\param[in]	maxSize							Max number of bytes that can be stored in the pData buffer.
+ *	\param[in]	timeOut							Time out in ms during which we can receive the command.
+ *	\return										SBG_NO_ERROR if the command has been received.<br>
+ *												SBG_BUFFER_OVERFLOW if the payload couldn't fit into the pData buffer.<br>
+ *												SBG_NOT_READY if the dispatching thread is blocked, if all waiters slots are used or if the command can't be waited from this callback.<br>
+ *												SBG_TIME_OUT if the command hasn't been received within the time out.
+ */
+static SbgErrorCode sbgEComWaitCmd(SbgEComHandle *pHandle, bool anyCmd, uint16 command, uint16 *pCommand, void *pData, uint32 *pSize, uint32 maxSize, uint32 timeOut)
+{
+	SbgErrorCode		 errorCode = SBG_TIME_OUT;
+	SbgEComCmdWaiter	*pWaiter;
+	uint64				 lastValidTime;
+	uint64				 currentTime;
+	uint32				 remainingTime;
+
+	//
+	// Compute the last valid time in us according to the time out, 64 bits values never wrap around
+	//
+	lastValidTime = sbgGetTimeUs() + (uint64)timeOut * 1000;
+
+	//
+	// Register the waiter first so the frame is given to it whichever thread receives it
+	//
+	pWaiter = sbgEComCmdWaiterAdd(pHandle, anyCmd, command, pData, maxSize);
+
+	if (pWaiter == NULL)
+	{
+		return SBG_NOT_READY;
+	}
+
+	do
+	{
+		currentTime = sbgGetTimeUs();
+		remainingTime = (lastValidTime > currentTime) ? (uint32)((lastValidTime - currentTime + 999) / 1000) : 0;
+
+		if (sbgEComReadIsOwned(pHandle))
+		{
+			//
+			// Called from a callback: only this thread receives frames so it reads the interface itself
+			//
+			errorCode = sbgEComWaitCmdInCallback(pHandle, pWaiter, lastValidTime);
+
+			if (errorCode == SBG_NOT_READY)
+			{
+				sbgEComCmdWaiterRemove(pHandle, pWaiter, NULL, NULL);
+
+				return SBG_NOT_READY;
+			}
+
+			break;
+		}
+		else if (sbgEComReadLock(pHandle, FALSE))
+		{
+			//
+			// No other thread is dispatching received frames so read the interface
+			//
+			errorCode = sbgEComHandleFrames(pHandle, SBG_ECOM_RX_BATCH_SIZE, 0, NULL);
+
+			sbgEComReadUnlock(pHandle);
+
+			if (sbgEComCmdWaiterIsReceived(pHandle, pWaiter, 0))
+			{
+				break;
+			}
+
+			//
+			// No more data are present in the reception buffer so block until new data arrive or the time out expires
+			//
+			if ( (errorCode == SBG_NOT_READY) && (remainingTime > 0) )
+			{
+				sbgInterfaceWaitReadable(pHandle->protocolHandle.pLinkedInterface, remainingTime);
+			}
+		}
+		else if (SBG_ATOMIC_LOAD_ACQUIRE(pHandle->isDispatchBlocked) != 0)
+		{
+			//
+			// The dispatching thread is blocked in a callback, for example by a full reader queue, and won't receive anything
+			//
+			sbgEComCmdWaiterRemove(pHandle, pWaiter, NULL, NULL);
+
+			return SBG_NOT_READY;
+		}
+		else
+		{
+			//
+			// Another thread is dispatching received frames, wait for it to give the command
+			// The wait is limited so this thread reads the interface itself if the other one stops dispatching
+			//
+			if (remainingTime > SBG_ECOM_CMD_WAIT_TIME_OUT)
+			{
+				remainingTime = SBG_ECOM_CMD_WAIT_TIME_OUT;
+			}
+
+			if (sbgEComCmdWaiterIsReceived(pHandle, pWaiter, remainingTime))
+			{
+				break;
+			}
+		}
+	} while (lastValidTime >= sbgGetTimeUs());
+
+	//
+	// Release the slot, a frame given in the meantime is still returned
+	//
+	errorCode = sbgEComCmdWaiterRemove(pHandle, pWaiter, pCommand, pSize);
+
+	if (errorCode == SBG_NOT_READY)
+	{
+		errorCode = SBG_TIME_OUT;
+	}
+
+	return errorCode;
+}
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+/*!
+ *	Destroy the locks of a handle, the ones that couldn't be created are NULL.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ */
+static void sbgEComDestroyLocks(SbgEComHandle *pHandle)
+{
+	if (pHandle->pLocks)
+	{
+		sbgPlatformMutexDestroy(pHandle->pLocks->pReadLock);
+		sbgPlatformMutexDestroy(pHandle->pLocks->pWaiterLock);
+		sbgPlatformCondDestroy(pHandle->pLocks->pWaiterCond);
+		sbgPlatformMutexDestroy(pHandle->pLocks->pAsyncCmdLock);
+
+		free(pHandle->pLocks);
+		pHandle->pLocks = NULL;
+	}
+}
+#endif
+
 //----------------------------------------------------------------------//
 //- Public methods declarations                                        -//
 //----------------------------------------------------------------------//
@@ -17,7 +1104,7 @@
  */
 SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface)
 {
-	SbgErrorCode errorCode = SBG_NO_ERROR;
+	SbgErrorCode		errorCode = SBG_NO_ERROR;
 	
 	//
 	// Check input parameters
@@ -29,11 +1116,55 @@ SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface)
 		//
 		pHandle->pReceiveCallback = NULL;
 		pHandle->pUserArg = NULL;
+		pHandle->pReceiveRawCallback = NULL;
+		pHandle->pRawUserArg = NULL;
+		pHandle->pLatencyStats = NULL;
+		memset(pHandle->logCallbacks, 0x00, sizeof(pHandle->logCallbacks));
+		memset(pHandle->numLogCallbacks, 0x00, sizeof(pHandle->numLogCallbacks));
+		memset(pHandle->asyncCmds, 0x00, sizeof(pHandle->asyncCmds));
+		pHandle->nextAsyncTicket = 1;
+		memset(pHandle->cmdWaiters, 0x00, sizeof(pHandle->cmdWaiters));
+		pHandle->pLocks = NULL;
+		pHandle->readThreadId = 0;
+		pHandle->isDispatching = FALSE;
+		pHandle->isDispatchBlocked = 0;
+		pHandle->isWaitingInCallback = FALSE;
+		pHandle->pRxFrames = NULL;
+		pHandle->rxNumFrames = 0;
+		pHandle->rxFrameIndex = 0;
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+		//
+		// Create the locks used to share the handle between a dispatcher thread and command waiters
+		//
+		pHandle->pLocks = (SbgEComHandleLocks*)malloc(sizeof(SbgEComHandleLocks));
+
+		if (pHandle->pLocks)
+		{
+			pHandle->pLocks->pReadLock = sbgPlatformMutexCreate();
+			pHandle->pLocks->pWaiterLock = sbgPlatformMutexCreate();
+			pHandle->pLocks->pWaiterCond = sbgPlatformCondCreate();
+			pHandle->pLocks->pAsyncCmdLock = sbgPlatformMutexCreate();
+
+			if ( (pHandle->pLocks->pReadLock == NULL) || (pHandle->pLocks->pWaiterLock == NULL) || (pHandle->pLocks->pWaiterCond == NULL) || (pHandle->pLocks->pAsyncCmdLock == NULL) )
+			{
+				sbgEComDestroyLocks(pHandle);
+				errorCode = SBG_MALLOC_FAILED;
+			}
+		}
+		else
+		{
+			errorCode = SBG_MALLOC_FAILED;
+		}
+#endif
 
 		//
 		// Initialize the protocol 
 		//
-		errorCode = sbgEComProtocolInit(&pHandle->protocolHandle, pInterface);
+		if (errorCode == SBG_NO_ERROR)
+		{
+			errorCode = sbgEComProtocolInit(&pHandle->protocolHandle, pInterface);
+		}
 	}
 	else
 	{
@@ -48,7 +1179,243 @@ SbgErrorCode sbgEComInit(SbgEComHandle *pHandle, SbgInterface *pInterface)
  *	\param[in]	pHandle							A valid sbgECom handle to close.
  *	\return										SBG_NO_ERROR if we have closed and released the sbgECom system.
  */
-SbgErrorCode sbgEComClose(SbgEComHandle *pHandle)
+SbgErrorCode sbgEComClose(SbgEComHandle *pHandle)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Test that we have a valid protocol handle
+	//
+	if (pHandle)
+	{
+		//
+		// Close the protocol
+		//
+		errorCode = sbgEComProtocolClose(&pHandle->protocolHandle);
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+		sbgEComDestroyLocks(pHandle);
+#endif
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Handle incoming logs.
+ *	When called from a callback, the interface isn't read and SBG_NOT_READY is returned as the received frames are still being dispatched.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\return										SBG_NO_ERROR if no error occurs during incoming logs parsing.
+ */
+SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle)
+{
+	//
+	// Handle all received frames without any budget
+	//
+	return sbgEComHandleEx(pHandle, 0, 0, NULL);
+}
+
+/*!
+ *	Handle incoming logs within a budget so it can be called from a fixed period real time loop.
+ *	The method returns as soon as all received frames have been handled or once the frames or time budget is exhausted.
+ *	Frames that haven't been handled remain stored and will be handled by the next call.
+ *	The time budget is only checked between batches of at most SBG_ECOM_RX_BATCH_SIZE frames, use maxFrames as well for a tighter bound.
+ *	When called from a callback, the interface isn't read and SBG_NOT_READY is returned as the received frames are still being dispatched.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	maxFrames						Maximum number of frames to handle or 0 for no limit.
+ *	\param[in]	maxMicros						Maximum time in us spent to handle frames or 0 for no limit.
+ *	\param[out]	pStats							Optional pointer used to return the number of handled and still buffered frames.
+ *	\return										SBG_NOT_READY if all received frames have been handled.<br>
+ *												SBG_NO_ERROR if the budget has been exhausted and some frames may still have to be handled.<br>
+ *												SBG_NULL_POINTER if pHandle is NULL.
+ */
+SbgErrorCode sbgEComHandleEx(SbgEComHandle *pHandle, uint32 maxFrames, uint32 maxMicros, SbgEComHandleStats *pStats)
+{
+	SbgErrorCode	errorCode;
+	bool			isOwned;
+
+	//
+	// Test that we have a valid protocol handle
+	//
+	if (pHandle)
+	{
+		//
+		// The read lock is already held if this method is called from a callback
+		//
+		isOwned = sbgEComReadIsOwned(pHandle);
+
+		if (!isOwned)
+		{
+			sbgEComReadLock(pHandle, TRUE);
+		}
+
+		errorCode = sbgEComHandleFrames(pHandle, maxFrames, maxMicros, pStats);
+
+		if (!isOwned)
+		{
+			sbgEComReadUnlock(pHandle);
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Wait until any command that is not a output log is recevied during a specific time out.
+ *	All binary logs received during this time are handled trough the standard callback system.
+ *	If another thread is already dispatching received frames, the interface isn't read and that thread copies the command in pData.
+ *	A command received by another thread before this call is discarded, so it should be called soon after the command has been sent.
+ *	When called from a callback, the frames still to be dispatched are handled first and the interface is then read from the callback,
+ *	the views given to the pending callbacks remain valid. Binary logs received meanwhile are dispatched from the callback,
+ *	before the next callbacks of the current log. SBG_NOT_READY is returned if the reception buffer gets full meanwhile
+ *	or if a command is already waited from a callback, sbgEComCmdSubmit can be used instead.
+ *	If the dispatching thread is blocked, see sbgEComSetDispatchBlocked, or if too many threads are waiting, SBG_NOT_READY is returned immediately.
+ *	\param[in]	pHandle					A valid sbgECom handle.
+ *	\param[out]	pCommand				Pointer used to hold the received command.
+ *	\param[out]	pData					Allocated buffer used to hold received data field.
+ *	\param[out]	pSize					Pointer used to hold the received data field size.
+ *	\param[in]	maxSize					Max number of bytes that can be stored in the pData buffer.
+ *	\param[in]	timeOut					Time out in ms during which we can receive the command.
+ *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
+ *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
+ *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
+ *										SBG_NULL_POINTER if an input parameter is NULL.<br>
+ *										SBG_BUFFER_OVERFLOW if the received frame payload couldn't fit into the pData buffer.
+ *										SBG_TIME_OUT if the command hasn't been received withint the specified time out.
+ */
+SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint16 *pCommand, void *pData, uint32 *pSize, uint32 maxSize, uint32 timeOut)
+{
+	SbgErrorCode		errorCode;
+
+	//
+	// Test that we have a valid protocol handle
+	//
+	if (pHandle)
+	{
+		errorCode = sbgEComWaitCmd(pHandle, TRUE, 0, pCommand, pData, pSize, maxSize, timeOut);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Wait for a specific command to be received given a time out.
+ *	All binary logs received during this time are handled trough the standard callback system.
+ *	If another thread is already dispatching received frames, the interface isn't read and that thread copies the command in pData.
+ *	A command received by another thread before this call is discarded, so it should be called soon after the command has been sent.
+ *	When called from a callback, the frames still to be dispatched are handled first and the interface is then read from the callback,
+ *	the views given to the pending callbacks remain valid. Binary logs received meanwhile are dispatched from the callback,
+ *	before the next callbacks of the current log. SBG_NOT_READY is returned if the reception buffer gets full meanwhile
+ *	or if a command is already waited from a callback, sbgEComCmdSubmit can be used instead.
+ *	If the dispatching thread is blocked, see sbgEComSetDispatchBlocked, or if too many threads are waiting, SBG_NOT_READY is returned immediately.
+ *	\param[in]	pHandle					A valid sbgECom handle.
+ *	\param[in]	command					The command we would like to receive.
+ *	\param[out]	pData					Allocated buffer used to hold received data field.
+ *	\param[out]	pSize					Pointer used to hold the received data field size.
+ *	\param[in]	maxSize					Max number of bytes that can be stored in the pData buffer.
+ *	\param[in]	timeOut					Time out in ms during which we can receive the command.
+ *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
+ *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
+ *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
+ *										SBG_NULL_POINTER if an input parameter is NULL.<br>
+ *										SBG_BUFFER_OVERFLOW if the received frame payload couldn't fit into the pData buffer.
+ *										SBG_TIME_OUT if the command hasn't been received withint the specified time out.
+ */
+SbgErrorCode sbgEComReceiveCmd(SbgEComHandle *pHandle, uint16 command, void *pData, uint32 *pSize, uint32 maxSize, uint32 timeOut)
+{
+	SbgErrorCode		errorCode;
+
+	//
+	// Test that we have a valid protocol handle
+	//
+	if (pHandle)
+	{
+		errorCode = sbgEComWaitCmd(pHandle, FALSE, command, NULL, pData, pSize, maxSize, timeOut);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Tell command waiters that the thread dispatching received frames is blocked in a callback and won't read the interface for a while.
+ *	sbgEComReceiveCmd and sbgEComReceiveAnyCmd called from other threads then fail immediately with SBG_NOT_READY instead of waiting for their time out.
+ *	This method should be called by the dispatching thread itself, before and after blocking.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	isBlocked						TRUE before blocking and FALSE once dispatching goes on.
+ *	\return										SBG_NO_ERROR if the state has been defined.
+ */
+SbgErrorCode sbgEComSetDispatchBlocked(SbgEComHandle *pHandle, bool isBlocked)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pHandle)
+	{
+		SBG_ATOMIC_STORE_RELEASE(pHandle->isDispatchBlocked, isBlocked ? 1 : 0);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Define the callback that should be called each time a new binary log is received.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pReceiveCallback				Pointer on the callback to call when a new log is received.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ *	\return										SBG_NO_ERROR if the callback and user argument have been defined successfully.
+ */
+SbgErrorCode sbgEComSetReceiveCallback(SbgEComHandle *pHandle, SbgEComReceiveFunc pReceiveCallback, void *pUserArg)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Test that we have a valid protocol handle
+	//
+	if (pHandle)
+	{
+		//
+		// Define the callback and the user argument
+		//
+		pHandle->pReceiveCallback = pReceiveCallback;
+		pHandle->pUserArg = pUserArg;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Define the callback that should be called each time a new binary log is received with its raw payload.
+ *	This callback is called before the other callbacks and, if no other callback is registered for this log, the log is never parsed.
+ *	When the log is also parsed for other callbacks, it is parsed before this callback is called.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pReceiveRawCallback				Pointer on the callback to call when a new log is received or NULL to remove it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ *	\return										SBG_NO_ERROR if the callback function has been defined.
+ */
+SbgErrorCode sbgEComSetReceiveRawCallback(SbgEComHandle *pHandle, SbgEComReceiveRawFunc pReceiveRawCallback, void *pUserArg)
 {
 	SbgErrorCode errorCode = SBG_NO_ERROR;
 
@@ -58,9 +1425,10 @@ SbgErrorCode sbgEComClose(SbgEComHandle *pHandle)
 	if (pHandle)
 	{
 		//
-		// Close the protocol
+		// Define the raw callback and its user argument
 		//
-		errorCode = sbgEComProtocolClose(&pHandle->protocolHandle);
+		pHandle->pReceiveRawCallback = pReceiveRawCallback;
+		pHandle->pRawUserArg = pUserArg;
 	}
 	else
 	{
@@ -71,86 +1439,49 @@ SbgErrorCode sbgEComClose(SbgEComHandle *pHandle)
 }
 
 /*!
- *	Handle incoming logs.
+ *	Register a callback called each time the given binary log is received.
+ *	Several callbacks can be registered for the same log, they are called in registration order after the receive callback.
+ *	Binary logs without any registered callback nor receive callback are not parsed at all.
+ *	This method shouldn't be called from a callback.
  *	\param[in]	pHandle							A valid sbgECom handle.
- *	\return										SBG_NO_ERROR if no error occurs during incoming logs parsing.
+ *	\param[in]	logCmd							Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	pCallback						Pointer on the callback to call when this log is received.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ *	\return										SBG_NO_ERROR if the callback has been registered.<br>
+ *												SBG_INVALID_PARAMETER if logCmd isn't a valid binary log command id.<br>
+ *												SBG_BUFFER_OVERFLOW if SBG_ECOM_MAX_LOG_CALLBACKS callbacks are already registered for this log.
  */
-SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle)
+SbgErrorCode sbgEComSetLogCallback(SbgEComHandle *pHandle, SbgEComCmdId logCmd, SbgEComReceiveFunc pCallback, void *pUserArg)
 {
-	SbgErrorCode		errorCode = SBG_NO_ERROR;
-	SbgBinaryLogData	logData;
-	uint16				receivedCmd;
-	uint32				payloadSize;
-	uint8				payloadData[SBG_ECOM_MAX_PAYLOAD_SIZE];
-		
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+	SbgEComLogCallback *pLogCallback;
+
 	//
-	// Test that we have a valid protocol handle
+	// Test input parameters
 	//
-	if (pHandle)
+	if ( (pHandle) && (pCallback) )
 	{
-		//
-		// Try to read all received frames
-		//
-		do
+		if (sbgEComBinaryLogIsCmdValid(logCmd))
 		{
 			//
-			// Read a received frame
-			//
-			errorCode = sbgEComProtocolReceive(&pHandle->protocolHandle, &receivedCmd, payloadData, &payloadSize, sizeof(payloadData));
-
-			//
-			// Test if we have received a valid frame
+			// Append the callback to the ones already registered for this log
 			//
-			if (errorCode == SBG_NO_ERROR)
+			if (pHandle->numLogCallbacks[logCmd] < SBG_ECOM_MAX_LOG_CALLBACKS)
 			{
-				//
-				// Test if the received frame is a binary log
-				//
-				if (sbgEComBinaryLogIsCmdValid(receivedCmd))
-				{
-					//
-					// The received frame is a binary log one
-					//
-					errorCode = sbgEComBinaryLogParse(receivedCmd, payloadData, payloadSize, &logData);
-
-					//
-					// Test if the incoming log has been parsed successfully
-					//
-					if (errorCode == SBG_NO_ERROR)
-					{
-						//
-						// Test if we have a valid callback to handle received logs
-						//
-						if (pHandle->pReceiveCallback)
-						{
-							//
-							// Call the binary log callback
-							//
-							errorCode = pHandle->pReceiveCallback(pHandle, (SbgEComCmdId)receivedCmd, &logData, pHandle->pUserArg);
-						}
-					}
-					else
-					{
-						//
-						// Call the on error callback
-						//
-					}
-				}
-				else
-				{
-					//
-					// We have received a command, it shouldn't happen
-					//
-				}
+				pLogCallback = &pHandle->logCallbacks[logCmd][pHandle->numLogCallbacks[logCmd]];
+				pLogCallback->pCallback = pCallback;
+				pLogCallback->pUserArg = pUserArg;
+				pHandle->numLogCallbacks[logCmd]++;
 			}
-			else if (errorCode != SBG_NOT_READY)
+			else
 			{
-				//
-				// We have received an invalid frame
-				//
-				SBG_LOG_WARNING(errorCode, "Invalid frame received with command id: %u", receivedCmd);
+				errorCode = SBG_BUFFER_OVERFLOW;
 			}
-		} while (errorCode != SBG_NOT_READY);
+		}
+		else
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
 	}
 	else
 	{
@@ -161,149 +1492,73 @@ SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle)
 }
 
 /*!
- *	Wait until any command that is not a output log is recevied during a specific time out.
- *	All binary logs received during this time are handled trough the standard callback system.
- *	\param[in]	pHandle					A valid sbgECom handle.
- *	\param[out]	pCommand				Pointer used to hold the received command.
- *	\param[out]	pData					Allocated buffer used to hold received data field.
- *	\param[out]	pSize					Pointer used to hold the received data field size.
- *	\param[in]	maxSize					Max number of bytes that can be stored in the pData buffer.
- *	\param[in]	timeOut					Time out in ms during which we can receive the command.
- *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
- *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
- *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
- *										SBG_NULL_POINTER if an input parameter is NULL.<br>
- *										SBG_BUFFER_OVERFLOW if the received frame payload couldn't fit into the pData buffer.
- *										SBG_TIME_OUT if the command hasn't been received withint the specified time out.
+ *	Unregister a callback previously registered using sbgEComSetLogCallback.
+ *	This method shouldn't be called from a callback.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	logCmd							Binary log command id the callback has been registered for.
+ *	\param[in]	pCallback						Pointer on the registered callback.
+ *	\param[in]	pUserArg						User argument the callback has been registered with.
+ *	\return										SBG_NO_ERROR if the callback has been unregistered.<br>
+ *												SBG_INVALID_PARAMETER if this callback isn't registered for this log.
  */
-SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint16 *pCommand, void *pData, uint32 *pSize, uint32 maxSize, uint32 timeOut)
+SbgErrorCode sbgEComRemoveLogCallback(SbgEComHandle *pHandle, SbgEComCmdId logCmd, SbgEComReceiveFunc pCallback, void *pUserArg)
 {
-	SbgErrorCode		errorCode = SBG_NO_ERROR;
-	SbgBinaryLogData	logData;
-	uint16				receivedCmd;
-	uint32				payloadSize;
-	uint8				payloadData[SBG_ECOM_MAX_PAYLOAD_SIZE];
-	uint32				lastValidTime;
-	
+	SbgErrorCode errorCode = SBG_INVALID_PARAMETER;
+	SbgEComLogCallback *pLogCallbacks;
+	uint32 i;
+
 	//
-	// Test that we have a valid protocol handle
+	// Test input parameters
 	//
 	if (pHandle)
 	{
-		//
-		// Compute the last valid time according to the time out
-		//
-		lastValidTime = sbgGetTime() + timeOut;
-
-		//
-		// Try to receive the desired frame within the specified time out
-		//
-		do
+		if (sbgEComBinaryLogIsCmdValid(logCmd))
 		{
-			//
-			// Read a received frame
-			//
-			errorCode = sbgEComProtocolReceive(&pHandle->protocolHandle, &receivedCmd, payloadData, &payloadSize, sizeof(payloadData));
+			pLogCallbacks = pHandle->logCallbacks[logCmd];
 
-			//
-			// Test if we have received a valid frame
-			//
-			if (errorCode == SBG_NO_ERROR)
+			for (i = 0; i < pHandle->numLogCallbacks[logCmd]; i++)
 			{
-				//
-				// Test if the received frame is a binary log
-				//
-				if (sbgEComBinaryLogIsCmdValid(receivedCmd))
+				if ( (pLogCallbacks[i].pCallback == pCallback) && (pLogCallbacks[i].pUserArg == pUserArg) )
 				{
 					//
-					// The received frame is a binary log one
+					// Remove the callback while keeping the registration order of the other ones
 					//
-					errorCode = sbgEComBinaryLogParse(receivedCmd, payloadData, payloadSize, &logData);
-
-					//
-					// Test if the incoming log has been parsed successfully
-					//
-					if (errorCode == SBG_NO_ERROR)
-					{
-						//
-						// Test if we have a valid callback to handle received logs
-						//
-						if (pHandle->pReceiveCallback)
-						{
-							//
-							// Call the binary log callback
-							//
-							pHandle->pReceiveCallback(pHandle, (SbgEComCmdId)receivedCmd, &logData, pHandle->pUserArg);
-						}
-					}
-					else
-					{
-						//
-						// Call the on error callback
-						//
-					}
+					pHandle->numLogCallbacks[logCmd]--;
+					memmove(&pLogCallbacks[i], &pLogCallbacks[i + 1], (pHandle->numLogCallbacks[logCmd] - i) * sizeof(SbgEComLogCallback));
+					errorCode = SBG_NO_ERROR;
+					break;
 				}
-				else
-				{
-					//
-					// Return the received command
-					//
-					if (pCommand)
-					{
-						*pCommand = receivedCmd;
-					}
+			}
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
 
-					//
-					// We have received a command so return the payload size
-					//
-					if (pSize)
-					{
-						*pSize = payloadSize;
-					}
+	return errorCode;
+}
 
-					//
-					// Test if we have a payload to return
-					//
-					if (payloadSize > 0)
-					{
-						//
-						// Make sure that the payload can be stored and fit in the destination buffer
-						//
-						if ( (pData) && (payloadSize <= maxSize) )
-						{
-							//
-							// Copy the payload
-							//
-							memcpy(pData, payloadData, payloadSize);
-						}
-						else
-						{
-							//
-							// We have a buffer overflow
-							//
-							return SBG_BUFFER_OVERFLOW;
-						}
-					}
+/*!
+ *	Attach latency statistics to the handle so sbgEComHandle records, for each binary log, the time from the
+ *	frame completion to the first callback entry and the time spent inside the callbacks.
+ *	The statistics should have been initialized using sbgEComLatencyInit and this method shouldn't be called from a callback.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pLatencyStats					Latency statistics to update or NULL to stop measuring latencies.
+ *	\return										SBG_NO_ERROR if the latency statistics have been attached.
+ */
+SbgErrorCode sbgEComSetLatencyStats(SbgEComHandle *pHandle, SbgEComLatencyStats *pLatencyStats)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
 
-					//
-					// We have received the frame we are looking for so return
-					//
-					return SBG_NO_ERROR;
-				}
-			}
-			else if (errorCode == SBG_NOT_READY)
-			{
-				//
-				// No more data are present in the reception buffer so release some CPU before the next try
-				//
-				sbgSleep(1);
-			}
-		} while (lastValidTime >= sbgGetTime());
+	if (pHandle)
+	{
+		pHandle->pLatencyStats = pLatencyStats;
 
 		//
-		// The time out has expired so return time out error
+		// Frames are time stamped by the interface reads so latencies include the time spent in the reception buffer
 		//
-		errorCode = SBG_TIME_OUT;
+		sbgEComProtocolSetRxTimeStamps(&pHandle->protocolHandle, (pLatencyStats != NULL));
 	}
 	else
 	{
@@ -314,178 +1569,251 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint16 *pCommand, void
 }
 
 /*!
- *	Wait for a specific command to be received given a time out.
- *	All binary logs received during this time are handled trough the standard callback system.
- *	\param[in]	pHandle					A valid sbgECom handle.
- *	\param[in]	command					The command we would like to receive.
- *	\param[out]	pData					Allocated buffer used to hold received data field.
- *	\param[out]	pSize					Pointer used to hold the received data field size.
- *	\param[in]	maxSize					Max number of bytes that can be stored in the pData buffer.
- *	\param[in]	timeOut					Time out in ms during which we can receive the command.
- *	\return								SBG_NO_ERROR if we have received a valid frame.<br>
- *										SBG_NOT_READY if we haven't received a valid frame or if the serial buffer is empty.<br>
- *										SBG_INVALID_CRC if the received frame has an invalid CRC.<br>
- *										SBG_NULL_POINTER if an input parameter is NULL.<br>
- *										SBG_BUFFER_OVERFLOW if the received frame payload couldn't fit into the pData buffer.
- *										SBG_TIME_OUT if the command hasn't been received withint the specified time out.
+ *	Returns a copy of the protocol reception statistics (bytes read, valid frames, CRC errors, ...).
+ *	This method doesn't lock anything and can be called from a monitoring thread while another thread calls sbgEComHandle.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[out]	pStats							Pointer used to return the reception statistics.
+ *	\return										SBG_NO_ERROR if the statistics have been returned.
  */
-SbgErrorCode sbgEComReceiveCmd(SbgEComHandle *pHandle, uint16 command, void *pData, uint32 *pSize, uint32 maxSize, uint32 timeOut)
+SbgErrorCode sbgEComGetProtocolStats(const SbgEComHandle *pHandle, SbgEComProtocolStats *pStats)
 {
-	SbgErrorCode		errorCode = SBG_NO_ERROR;
-	SbgBinaryLogData	logData;
-	uint16				receivedCmd;
-	uint32				payloadSize;
-	uint8				payloadData[SBG_ECOM_MAX_PAYLOAD_SIZE];
-	uint32				lastValidTime;
-	
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
 	//
 	// Test that we have a valid protocol handle
 	//
 	if (pHandle)
 	{
+		errorCode = sbgEComProtocolGetStats(&pHandle->protocolHandle, pStats);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Queue a command that will be sent and completed asynchronously by sbgEComHandle so log dispatch is never blocked.
+ *	Commands are sent one after the other, each one is sent up to SBG_ECOM_ASYNC_CMD_NUM_TRIALS times if no answer is received
+ *	within SBG_ECOM_ASYNC_CMD_TIME_OUT ms. Blocking commands shouldn't be used while asynchronous commands are pending.
+ *	Asynchronous commands can be submitted, polled and cancelled from any thread, completion callbacks are called by the thread that runs sbgEComHandle.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	cmd								Command id to send, built using SBG_ECOM_BUILD_ID.
+ *	\param[in]	type							Define if the command is completed by an ACK or by an answer frame.
+ *	\param[in]	pPayload						Command payload, copied by this method (can be NULL if payloadSize is 0).
+ *	\param[in]	payloadSize						Payload size in bytes (up to SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE).
+ *	\param[out]	pAnswer							Optional buffer used to store the answer payload once received.
+ *	\param[in]	maxAnswerSize					Number of bytes that can be stored in pAnswer.
+ *	\param[in]	pCallback						Optional callback called on completion, if NULL the result has to be read using sbgEComCmdGetResult.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback.
+ *	\param[out]	pTicket							Optional pointer used to return the ticket that identifies the command.
+ *	\return										SBG_NO_ERROR if the command has been queued.<br>
+ *												SBG_BUFFER_OVERFLOW if SBG_ECOM_MAX_ASYNC_CMDS commands are already queued.<br>
+ *												SBG_INVALID_PARAMETER if the payload is too large.
+ */
+SbgErrorCode sbgEComCmdSubmit(SbgEComHandle *pHandle, uint16 cmd, SbgEComAsyncCmdType type, const void *pPayload, uint32 payloadSize, void *pAnswer, uint32 maxAnswerSize, SbgEComAsyncCmdFunc pCallback, void *pUserArg, uint32 *pTicket)
+{
+	return sbgEComCmdSubmitEx(pHandle, cmd, type, pPayload, payloadSize, pAnswer, maxAnswerSize, SBG_ECOM_ASYNC_CMD_TIME_OUT, pCallback, pUserArg, pTicket);
+}
+
+/*!
+ *	Queue an asynchronous command just like sbgEComCmdSubmit but with a specific time out, used by commands that take longer to be processed by the device.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	cmd								Command id to send, built using SBG_ECOM_BUILD_ID.
+ *	\param[in]	type							Define if the command is completed by an ACK or by an answer frame.
+ *	\param[in]	pPayload						Command payload, copied by this method (can be NULL if payloadSize is 0).
+ *	\param[in]	payloadSize						Payload size in bytes (up to SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE).
+ *	\param[out]	pAnswer							Optional buffer used to store the answer payload once received.
+ *	\param[in]	maxAnswerSize					Number of bytes that can be stored in pAnswer.
+ *	\param[in]	timeOut							Time out in ms to receive the answer of each trial.
+ *	\param[in]	pCallback						Optional callback called on completion, if NULL the result has to be read using sbgEComCmdGetResult.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback.
+ *	\param[out]	pTicket							Optional pointer used to return the ticket that identifies the command.
+ *	\return										SBG_NO_ERROR if the command has been queued.<br>
+ *												SBG_BUFFER_OVERFLOW if SBG_ECOM_MAX_ASYNC_CMDS commands are already queued.<br>
+ *												SBG_INVALID_PARAMETER if the payload is too large.
+ */
+SbgErrorCode sbgEComCmdSubmitEx(SbgEComHandle *pHandle, uint16 cmd, SbgEComAsyncCmdType type, const void *pPayload, uint32 payloadSize, void *pAnswer, uint32 maxAnswerSize, uint32 timeOut, SbgEComAsyncCmdFunc pCallback, void *pUserArg, uint32 *pTicket)
+{
+	SbgEComAsyncCmd	*pCmd;
+
+	//
+	// Check input parameters
+	//
+	if (pHandle)
+	{
+		if ( (payloadSize > SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE) || ( (payloadSize > 0) && (pPayload == NULL) ) )
+		{
+			return SBG_INVALID_PARAMETER;
+		}
+
+		sbgEComAsyncCmdLock(pHandle);
+
+		pCmd = sbgEComAsyncCmdFindOldest(pHandle, SBG_ECOM_ASYNC_CMD_FREE);
+
+		if (pCmd == NULL)
+		{
+			sbgEComAsyncCmdUnlock(pHandle);
+			return SBG_BUFFER_OVERFLOW;
+		}
+
 		//
-		// Compute the last valid time according to the time out
+		// Tickets are never 0 so 0 can be used by the user as an invalid ticket
 		//
-		lastValidTime = sbgGetTime() + timeOut;
+		if (pHandle->nextAsyncTicket == 0)
+		{
+			pHandle->nextAsyncTicket++;
+		}
+
+		pCmd->ticket = pHandle->nextAsyncTicket++;
+		pCmd->cmd = cmd;
+		pCmd->type = type;
+		pCmd->payloadSize = payloadSize;
+
+		if (payloadSize > 0)
+		{
+			memcpy(pCmd->payload, pPayload, payloadSize);
+		}
+
+		pCmd->pAnswer = pAnswer;
+		pCmd->maxAnswerSize = pAnswer ? maxAnswerSize : 0;
+		pCmd->answerSize = 0;
+		pCmd->pCallback = pCallback;
+		pCmd->pUserArg = pUserArg;
+		pCmd->timeOut = timeOut;
+		pCmd->numTrials = 0;
+		pCmd->result = SBG_NOT_READY;
+		pCmd->state = SBG_ECOM_ASYNC_CMD_QUEUED;
 
 		//
-		// Try to receive the desired frame within the specified time out
+		// The ticket is returned before the command is sent as it can be completed right away
 		//
-		do
+		if (pTicket)
 		{
-			//
-			// Read a received frame
-			//
-			errorCode = sbgEComProtocolReceive(&pHandle->protocolHandle, &receivedCmd, payloadData, &payloadSize, sizeof(payloadData));
+			*pTicket = pCmd->ticket;
+		}
 
-			//
-			// Test if we have received a valid frame
-			//
-			if (errorCode == SBG_NO_ERROR)
-			{
-				//
-				// Test if the received frame is a binary log
-				//
-				if (sbgEComBinaryLogIsCmdValid(receivedCmd))
-				{
-					//
-					// The received frame is a binary log one
-					//
-					errorCode = sbgEComBinaryLogParse(receivedCmd, payloadData, payloadSize, &logData);
+		//
+		// Send the command right now if no other command is in progress
+		//
+		sbgEComAsyncCmdUpdate(pHandle);
 
-					//
-					// Test if the incoming log has been parsed successfully
-					//
-					if (errorCode == SBG_NO_ERROR)
-					{
-						//
-						// Test if we have a valid callback to handle received logs
-						//
-						if (pHandle->pReceiveCallback)
-						{
-							//
-							// Call the binary log callback
-							//
-							pHandle->pReceiveCallback(pHandle, (SbgEComCmdId)receivedCmd, &logData, pHandle->pUserArg);
-						}
-					}
-					else
-					{
-						//
-						// Call the on error callback
-						//
-					}
-				}
-				else if (receivedCmd == command)
-				{
-					//
-					// We have received the command we are looking for so return the payload size
-					//
-					if (pSize)
-					{
-						*pSize = payloadSize;
-					}
+		sbgEComAsyncCmdUnlock(pHandle);
 
-					//
-					// Test if we have a payload to return
-					//
-					if (payloadSize > 0)
-					{
-						//
-						// Make sure that the payload can be stored and fit in the destination buffer
-						//
-						if ( (pData) && (payloadSize <= maxSize) )
-						{
-							//
-							// Copy the payload
-							//
-							memcpy(pData, payloadData, payloadSize);
-						}
-						else
-						{
-							//
-							// We have a buffer overflow
-							//
-							return SBG_BUFFER_OVERFLOW;
-						}
-					}
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
 
-					//
-					// We have received the frame we are looking for so return
-					//
-					return SBG_NO_ERROR;
-				}
-			}
-			else if (errorCode == SBG_NOT_READY)
+/*!
+ *	Returns the result of an asynchronous command submitted without callback and release its ticket once completed.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	ticket							Ticket returned by sbgEComCmdSubmit.
+ *	\param[out]	pAnswerSize						Optional pointer used to return the number of bytes stored in the answer buffer.
+ *	\return										SBG_NOT_READY if the command is still in progress.<br>
+ *												SBG_INVALID_PARAMETER if the ticket is unknown.<br>
+ *												Otherwise the command result: the ACK error code, SBG_TIME_OUT, ...
+ */
+SbgErrorCode sbgEComCmdGetResult(SbgEComHandle *pHandle, uint32 ticket, uint32 *pAnswerSize)
+{
+	SbgErrorCode	 errorCode;
+	SbgEComAsyncCmd	*pCmd;
+
+	//
+	// Check input parameters
+	//
+	if (pHandle)
+	{
+		sbgEComAsyncCmdLock(pHandle);
+
+		pCmd = sbgEComAsyncCmdFind(pHandle, ticket);
+
+		if (pCmd == NULL)
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+		else if (pCmd->state != SBG_ECOM_ASYNC_CMD_COMPLETED)
+		{
+			errorCode = SBG_NOT_READY;
+		}
+		else
+		{
+			if (pAnswerSize)
 			{
-				//
-				// No more data are present in the reception buffer so release some CPU before the next try
-				//
-				sbgSleep(1);
+				*pAnswerSize = pCmd->answerSize;
 			}
-		} while (lastValidTime >= sbgGetTime());
 
-		//
-		// The time out has expired so return time out error
-		//
-		errorCode = SBG_TIME_OUT;
+			//
+			// The result has been read so release the ticket
+			//
+			errorCode = pCmd->result;
+			pCmd->state = SBG_ECOM_ASYNC_CMD_FREE;
+		}
+
+		sbgEComAsyncCmdUnlock(pHandle);
+
+		return errorCode;
 	}
 	else
 	{
-		errorCode = SBG_NULL_POINTER;
+		return SBG_NULL_POINTER;
 	}
-
-	return errorCode;
 }
 
 /*!
- *	Define the callback that should be called each time a new binary log is received.
+ *	Cancel an asynchronous command and release its ticket.
+ *	If the command has already been sent, its slot is kept until its answer is received or its time out expires
+ *	so a late answer can't complete the next command, which is only sent then.
  *	\param[in]	pHandle							A valid sbgECom handle.
- *	\param[in]	pReceiveCallback				Pointer on the callback to call when a new log is received.
- *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
- *	\return										SBG_NO_ERROR if the callback and user argument have been defined successfully.
+ *	\param[in]	ticket							Ticket returned by sbgEComCmdSubmit.
+ *	\return										SBG_NO_ERROR if the command has been cancelled.<br>
+ *												SBG_INVALID_PARAMETER if the ticket is unknown.
  */
-SbgErrorCode sbgEComSetReceiveCallback(SbgEComHandle *pHandle, SbgEComReceiveFunc pReceiveCallback, void *pUserArg)
+SbgErrorCode sbgEComCmdCancel(SbgEComHandle *pHandle, uint32 ticket)
 {
-	SbgErrorCode errorCode = SBG_NO_ERROR;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
+	SbgEComAsyncCmd	*pCmd;
 
 	//
-	// Test that we have a valid protocol handle
+	// Check input parameters
 	//
 	if (pHandle)
 	{
-		//
-		// Define the callback and the user argument
-		//
-		pHandle->pReceiveCallback = pReceiveCallback;
-		pHandle->pUserArg = pUserArg;
+		sbgEComAsyncCmdLock(pHandle);
+
+		pCmd = sbgEComAsyncCmdFind(pHandle, ticket);
+
+		if (pCmd == NULL)
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+		else if (pCmd->state == SBG_ECOM_ASYNC_CMD_SENT)
+		{
+			//
+			// The answer is still expected and will be dropped by the asynchronous commands update
+			//
+			pCmd->state = SBG_ECOM_ASYNC_CMD_CANCELLED;
+			pCmd->pCallback = NULL;
+			pCmd->pAnswer = NULL;
+		}
+		else
+		{
+			pCmd->state = SBG_ECOM_ASYNC_CMD_FREE;
+		}
+
+		sbgEComAsyncCmdUnlock(pHandle);
+
+		return errorCode;
 	}
 	else
 	{
-		errorCode = SBG_NULL_POINTER;
+		return SBG_NULL_POINTER;
 	}
-
-	return errorCode;
 }
 
 /*!
@@ -33,9 +33,21 @@ extern "C" {
 
 #include <sbgCommon.h>
 #include "sbgEComIds.h"
+#include "sbgEComLatency.h"
 #include "protocol/sbgEComProtocol.h"
 #include "binaryLogs/sbgEComBinaryLogs.h"
 
+//----------------------------------------------------------------------//
+//- Global definitions                                                 -//
+//----------------------------------------------------------------------//
+#define SBG_ECOM_MAX_LOG_CALLBACKS				(4)							/*!< Maximum number of callbacks that can be registered for each binary log. */
+#define SBG_ECOM_MAX_ASYNC_CMDS					(8)							/*!< Maximum number of asynchronous commands that can be queued. */
+#define SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE		(256)						/*!< Maximum payload size in bytes of an asynchronous command. */
+#define SBG_ECOM_ASYNC_CMD_TIME_OUT				(500)						/*!< Time out in ms to receive the answer of an asynchronous command. */
+#define SBG_ECOM_ASYNC_CMD_NUM_TRIALS			(3)							/*!< Number of times an asynchronous command is sent before giving up. */
+#define SBG_ECOM_MAX_CMD_WAITERS				(4)							/*!< Maximum number of threads that can wait for a command answer at the same time. */
+#define SBG_ECOM_CMD_WAIT_TIME_OUT				(10)						/*!< Time out in ms used by a waiter before checking again if it can read the interface itself. */
+
 //----------------------------------------------------------------------//
 //- Predefinitions                                                     -//
 //----------------------------------------------------------------------//
@@ -45,6 +57,11 @@ extern "C" {
  */
 typedef struct _SbgEComHandle SbgEComHandle;
 
+/*!
+ * Platform locks of a handle, only defined in sbgECom.c and only created if SBG_CONFIG_MULTI_THREAD is enabled.
+ */
+typedef struct _SbgEComHandleLocks SbgEComHandleLocks;
+
 //----------------------------------------------------------------------//
 //- Callbacks definitions                                              -//
 //----------------------------------------------------------------------//
@@ -59,18 +76,138 @@ typedef struct _SbgEComHandle SbgEComHandle;
  */
 typedef SbgErrorCode (*SbgEComReceiveFunc)(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg);
 
+/*!
+ *	Callback definition called each time a new log is received with its raw, still not parsed, payload.
+ *	The payload is a view on the reception buffer, it is only valid during the callback execution and can be decoded on demand using the log accessors.
+ *	The callback can send commands but shouldn't call the sbgEComProtocolReceive methods directly as they would overwrite the reception buffer.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	logCmd									Contains the binary received log command id.
+ *	\param[in]	pPayload								Read only pointer on the received log payload.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\param[in]	pUserArg								Optional user supplied argument.
+ *	\return												SBG_NO_ERROR if the received log has been used successfully.
+ */
+typedef SbgErrorCode (*SbgEComReceiveRawFunc)(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const void *pPayload, uint32 payloadSize, void *pUserArg);
+
+/*!
+ *	Callback definition called when an asynchronous command is completed.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	ticket									Ticket returned when the command has been submitted.
+ *	\param[in]	result									SBG_NO_ERROR if the command has succeeded, the ACK error code or SBG_TIME_OUT otherwise.
+ *	\param[in]	pAnswer									Read only pointer on the received answer payload (NULL if no answer has been received).
+ *	\param[in]	answerSize								Answer payload size in bytes.
+ *	\param[in]	pUserArg								Optional user supplied argument.
+ */
+typedef void (*SbgEComAsyncCmdFunc)(SbgEComHandle *pHandle, uint32 ticket, SbgErrorCode result, const void *pAnswer, uint32 answerSize, void *pUserArg);
+
 //----------------------------------------------------------------------//
 //- Structures definitions                                             -//
 //----------------------------------------------------------------------//
 
+/*!
+ * Callback registered for a specific binary log and its user argument.
+ */
+typedef struct _SbgEComLogCallback
+{
+	SbgEComReceiveFunc			 pCallback;					/*!< Pointer on the method called each time the binary log is received. */
+	void						*pUserArg;					/*!< Optional user supplied argument for this callback. */
+} SbgEComLogCallback;
+
+/*!
+ * Statistics returned by sbgEComHandleEx.
+ */
+typedef struct _SbgEComHandleStats
+{
+	uint32						 numFrames;					/*!< Number of frames handled during the call. */
+	uint32						 numPendingFrames;			/*!< Number of complete frames still stored in the reception buffer. */
+	uint32						 numPendingBytes;			/*!< Number of bytes still stored in the reception buffer. */
+} SbgEComHandleStats;
+
+/*!
+ * Define how an asynchronous command is completed.
+ */
+typedef enum _SbgEComAsyncCmdType
+{
+	SBG_ECOM_ASYNC_CMD_WAIT_ACK,							/*!< The command is completed by an ACK, used for set commands. */
+	SBG_ECOM_ASYNC_CMD_WAIT_ANSWER							/*!< The command is completed by a frame with the same id, used for get commands. */
+} SbgEComAsyncCmdType;
+
+/*!
+ * State of an asynchronous command slot.
+ */
+typedef enum _SbgEComAsyncCmdState
+{
+	SBG_ECOM_ASYNC_CMD_FREE,								/*!< The slot isn't used. */
+	SBG_ECOM_ASYNC_CMD_QUEUED,								/*!< The command is waiting to be sent. */
+	SBG_ECOM_ASYNC_CMD_SENT,								/*!< The command has been sent and waits for its answer. */
+	SBG_ECOM_ASYNC_CMD_COMPLETED,							/*!< The command is completed and waits for its result to be read. */
+	SBG_ECOM_ASYNC_CMD_CANCELLED							/*!< The command has been cancelled after being sent, its slot is kept until its answer or its time out. */
+} SbgEComAsyncCmdState;
+
+/*!
+ * Asynchronous command queued by sbgEComCmdSubmit.
+ */
+typedef struct _SbgEComAsyncCmd
+{
+	SbgEComAsyncCmdState		 state;						/*!< Current state of this command. */
+	uint32						 ticket;					/*!< Ticket that identifies this command. */
+	uint16						 cmd;						/*!< Command id to send. */
+	SbgEComAsyncCmdType			 type;						/*!< Define how the command is completed. */
+	uint8						 payload[SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE];	/*!< Copy of the command payload. */
+	uint32						 payloadSize;				/*!< Command payload size in bytes. */
+	void						*pAnswer;					/*!< Optional buffer used to store the answer payload. */
+	uint32						 maxAnswerSize;				/*!< Number of bytes that can be stored in pAnswer. */
+	uint32						 answerSize;				/*!< Number of bytes stored in pAnswer. */
+	SbgEComAsyncCmdFunc			 pCallback;					/*!< Optional method called on completion. */
+	void						*pUserArg;					/*!< Optional user supplied argument for the callback. */
+	uint32						 timeOut;					/*!< Time out in ms of each trial. */
+	uint32						 numTrials;					/*!< Number of times the command has been sent. */
+	uint64						 timeOutTime;				/*!< Time in us at which the current trial expires. */
+	SbgErrorCode				 result;					/*!< Command result once completed. */
+} SbgEComAsyncCmd;
+
+/*!
+ * Command waited by sbgEComReceiveCmd or sbgEComReceiveAnyCmd, the received payload is directly copied in the waiter buffer.
+ */
+typedef struct _SbgEComCmdWaiter
+{
+	bool						 used;						/*!< TRUE if a thread is waiting with this slot. */
+	bool						 anyCmd;					/*!< TRUE if any command is accepted. */
+	uint16						 command;					/*!< The command waited for if anyCmd is FALSE. */
+	bool						 received;					/*!< TRUE once a matching frame has been received. */
+	uint16						 receivedCmd;				/*!< Received command id. */
+	SbgErrorCode				 result;					/*!< SBG_NO_ERROR or SBG_BUFFER_OVERFLOW if the payload didn't fit in the waiter buffer. */
+	void						*pData;						/*!< Waiter buffer used to store the received payload. */
+	uint32						 maxSize;					/*!< Size in bytes of the waiter buffer. */
+	uint32						 payloadSize;				/*!< Received payload size in bytes. */
+} SbgEComCmdWaiter;
+
 /*!
  * Interface definition that stores methods used to communicate on the interface.
+ * This structure is quite large, about 22 KB with the default settings mostly used by the reception buffer, and should not be allocated on the stack.
+ * A handle can only be shared between threads if the library is built with SBG_CONFIG_MULTI_THREAD enabled.
  */
 struct _SbgEComHandle
 {
 	SbgEComProtocol				  protocolHandle;			/*!< Handle on the protocol system. */
 	SbgEComReceiveFunc			 pReceiveCallback;			/*!< Pointer on the method called each time a new binary log is received. */
 	void						*pUserArg;					/*!< Optional user supplied argument for callbacks. */
+	SbgEComReceiveRawFunc		 pReceiveRawCallback;		/*!< Pointer on the method called each time a new binary log is received with its raw payload. */
+	void						*pRawUserArg;				/*!< Optional user supplied argument for the raw callback. */
+	SbgEComLogCallback			 logCallbacks[SBG_ECOM_LOG_ECOM_NUM_MESSAGES][SBG_ECOM_MAX_LOG_CALLBACKS];	/*!< Callbacks registered for each binary log id. */
+	uint32						 numLogCallbacks[SBG_ECOM_LOG_ECOM_NUM_MESSAGES];							/*!< Number of callbacks registered for each binary log id. */
+	SbgEComLatencyStats			*pLatencyStats;				/*!< Optional latency statistics updated for each dispatched binary log. */
+	SbgEComAsyncCmd				 asyncCmds[SBG_ECOM_MAX_ASYNC_CMDS];		/*!< Asynchronous commands slots. */
+	uint32						 nextAsyncTicket;			/*!< Ticket that will be given to the next asynchronous command. */
+	SbgEComCmdWaiter			 cmdWaiters[SBG_ECOM_MAX_CMD_WAITERS];	/*!< Commands waited by sbgEComReceiveCmd and sbgEComReceiveAnyCmd. */
+	SbgEComHandleLocks			*pLocks;					/*!< Locks used to share the handle between threads, allocated by sbgEComInit and released by sbgEComClose (NULL without SBG_CONFIG_MULTI_THREAD). */
+	volatile uint32				 readThreadId;				/*!< Identifier of the thread that holds the read lock or 0 if it is free. */
+	bool						 isDispatching;				/*!< TRUE while received frames are dispatched, the interface isn't read meanwhile. */
+	bool						 isWaitingInCallback;		/*!< TRUE while a command is waited from a callback, commands waited from nested callbacks then fail. */
+	const SbgEComProtocolFrame	*pRxFrames;					/*!< Frames of the batch being dispatched. */
+	uint32						 rxNumFrames;				/*!< Number of frames in the batch being dispatched. */
+	uint32						 rxFrameIndex;				/*!< Index of the next frame of the batch to dispatch. */
+	volatile uint32				 isDispatchBlocked;			/*!< Non zero while the dispatching thread is blocked in a callback, waited commands then fail immediately. */
 };
 
 //----------------------------------------------------------------------//
@@ -94,14 +231,38 @@ SbgErrorCode sbgEComClose(SbgEComHandle *pHandle);
 
 /*!
  *	Handle incoming logs.
+ *	When called from a callback, the interface isn't read and SBG_NOT_READY is returned as the received frames are still being dispatched.
  *	\param[in]	pHandle							A valid sbgECom handle.
  *	\return										SBG_NO_ERROR if no error occurs during incoming logs parsing.
  */
 SbgErrorCode sbgEComHandle(SbgEComHandle *pHandle);
 
+/*!
+ *	Handle incoming logs within a budget so it can be called from a fixed period real time loop.
+ *	The method returns as soon as all received frames have been handled or once the frames or time budget is exhausted.
+ *	Frames that haven't been handled remain stored and will be handled by the next call.
+ *	The time budget is only checked between batches of at most SBG_ECOM_RX_BATCH_SIZE frames, use maxFrames as well for a tighter bound.
+ *	When called from a callback, the interface isn't read and SBG_NOT_READY is returned as the received frames are still being dispatched.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	maxFrames						Maximum number of frames to handle or 0 for no limit.
+ *	\param[in]	maxMicros						Maximum time in us spent to handle frames or 0 for no limit.
+ *	\param[out]	pStats							Optional pointer used to return the number of handled and still buffered frames.
+ *	\return										SBG_NOT_READY if all received frames have been handled.<br>
+ *												SBG_NO_ERROR if the budget has been exhausted and some frames may still have to be handled.<br>
+ *												SBG_NULL_POINTER if pHandle is NULL.
+ */
+SbgErrorCode sbgEComHandleEx(SbgEComHandle *pHandle, uint32 maxFrames, uint32 maxMicros, SbgEComHandleStats *pStats);
+
 /*!
  *	Wait until any command that is not a output log is recevied during a specific time out.
  *	All binary logs received during this time are handled trough the standard callback system.
+ *	If another thread is already dispatching received frames, the interface isn't read and that thread copies the command in pData.
+ *	A command received by another thread before this call is discarded, so it should be called soon after the command has been sent.
+ *	When called from a callback, the frames still to be dispatched are handled first and the interface is then read from the callback,
+ *	the views given to the pending callbacks remain valid. Binary logs received meanwhile are dispatched from the callback,
+ *	before the next callbacks of the current log. SBG_NOT_READY is returned if the reception buffer gets full meanwhile
+ *	or if a command is already waited from a callback, sbgEComCmdSubmit can be used instead.
+ *	If the dispatching thread is blocked, see sbgEComSetDispatchBlocked, or if too many threads are waiting, SBG_NOT_READY is returned immediately.
  *	\param[in]	pHandle					A valid sbgECom handle.
  *	\param[out]	pCommand				Pointer used to hold the received command.
  *	\param[out]	pData					Allocated buffer used to hold received data field.
@@ -120,6 +281,13 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint16 *pCommand, void
 /*!
  *	Wait for a specific command to be received given a time out.
  *	All binary logs received during this time are handled trough the standard callback system.
+ *	If another thread is already dispatching received frames, the interface isn't read and that thread copies the command in pData.
+ *	A command received by another thread before this call is discarded, so it should be called soon after the command has been sent.
+ *	When called from a callback, the frames still to be dispatched are handled first and the interface is then read from the callback,
+ *	the views given to the pending callbacks remain valid. Binary logs received meanwhile are dispatched from the callback,
+ *	before the next callbacks of the current log. SBG_NOT_READY is returned if the reception buffer gets full meanwhile
+ *	or if a command is already waited from a callback, sbgEComCmdSubmit can be used instead.
+ *	If the dispatching thread is blocked, see sbgEComSetDispatchBlocked, or if too many threads are waiting, SBG_NOT_READY is returned immediately.
  *	\param[in]	pHandle					A valid sbgECom handle.
  *	\param[in]	command					The command we would like to receive.
  *	\param[out]	pData					Allocated buffer used to hold received data field.
@@ -135,6 +303,16 @@ SbgErrorCode sbgEComReceiveAnyCmd(SbgEComHandle *pHandle, uint16 *pCommand, void
  */
 SbgErrorCode sbgEComReceiveCmd(SbgEComHandle *pHandle, uint16 command, void *pData, uint32 *pSize, uint32 maxSize, uint32 timeOut);
 
+/*!
+ *	Tell command waiters that the thread dispatching received frames is blocked in a callback and won't read the interface for a while.
+ *	sbgEComReceiveCmd and sbgEComReceiveAnyCmd called from other threads then fail immediately with SBG_NOT_READY instead of waiting for their time out.
+ *	This method should be called by the dispatching thread itself, before and after blocking.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	isBlocked						TRUE before blocking and FALSE once dispatching goes on.
+ *	\return										SBG_NO_ERROR if the state has been defined.
+ */
+SbgErrorCode sbgEComSetDispatchBlocked(SbgEComHandle *pHandle, bool isBlocked);
+
 /*!
  *	Define the callback that should be called each time a new binary log is received.
  *	\param[in]	pHandle							A valid sbgECom handle.
@@ -144,6 +322,125 @@ SbgErrorCode sbgEComReceiveCmd(SbgEComHandle *pHandle, uint16 command, void *pDa
  */
 SbgErrorCode sbgEComSetReceiveCallback(SbgEComHandle *pHandle, SbgEComReceiveFunc pReceiveCallback, void *pUserArg);
 
+/*!
+ *	Define the callback that should be called each time a new binary log is received with its raw payload.
+ *	This callback is called before the other callbacks and, if no other callback is registered for this log, the log is never parsed.
+ *	When the log is also parsed for other callbacks, it is parsed before this callback is called.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pReceiveRawCallback				Pointer on the callback to call when a new log is received or NULL to remove it.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ *	\return										SBG_NO_ERROR if the callback function has been defined.
+ */
+SbgErrorCode sbgEComSetReceiveRawCallback(SbgEComHandle *pHandle, SbgEComReceiveRawFunc pReceiveRawCallback, void *pUserArg);
+
+/*!
+ *	Register a callback called each time the given binary log is received.
+ *	Several callbacks can be registered for the same log, they are called in registration order after the receive callback.
+ *	Binary logs without any registered callback nor receive callback are not parsed at all.
+ *	This method shouldn't be called from a callback.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	logCmd							Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	pCallback						Pointer on the callback to call when this log is received.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback method.
+ *	\return										SBG_NO_ERROR if the callback has been registered.<br>
+ *												SBG_INVALID_PARAMETER if logCmd isn't a valid binary log command id.<br>
+ *												SBG_BUFFER_OVERFLOW if SBG_ECOM_MAX_LOG_CALLBACKS callbacks are already registered for this log.
+ */
+SbgErrorCode sbgEComSetLogCallback(SbgEComHandle *pHandle, SbgEComCmdId logCmd, SbgEComReceiveFunc pCallback, void *pUserArg);
+
+/*!
+ *	Unregister a callback previously registered using sbgEComSetLogCallback.
+ *	This method shouldn't be called from a callback.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	logCmd							Binary log command id the callback has been registered for.
+ *	\param[in]	pCallback						Pointer on the registered callback.
+ *	\param[in]	pUserArg						User argument the callback has been registered with.
+ *	\return										SBG_NO_ERROR if the callback has been unregistered.<br>
+ *												SBG_INVALID_PARAMETER if this callback isn't registered for this log.
+ */
+SbgErrorCode sbgEComRemoveLogCallback(SbgEComHandle *pHandle, SbgEComCmdId logCmd, SbgEComReceiveFunc pCallback, void *pUserArg);
+
+/*!
+ *	Attach latency statistics to the handle so sbgEComHandle records, for each binary log, the time from the
+ *	frame completion to the first callback entry and the time spent inside the callbacks.
+ *	The statistics should have been initialized using sbgEComLatencyInit and this method shouldn't be called from a callback.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	pLatencyStats					Latency statistics to update or NULL to stop measuring latencies.
+ *	\return										SBG_NO_ERROR if the latency statistics have been attached.
+ */
+SbgErrorCode sbgEComSetLatencyStats(SbgEComHandle *pHandle, SbgEComLatencyStats *pLatencyStats);
+
+/*!
+ *	Returns a copy of the protocol reception statistics (bytes read, valid frames, CRC errors, ...).
+ *	This method doesn't lock anything and can be called from a monitoring thread while another thread calls sbgEComHandle.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[out]	pStats							Pointer used to return the reception statistics.
+ *	\return										SBG_NO_ERROR if the statistics have been returned.
+ */
+SbgErrorCode sbgEComGetProtocolStats(const SbgEComHandle *pHandle, SbgEComProtocolStats *pStats);
+
+/*!
+ *	Queue a command that will be sent and completed asynchronously by sbgEComHandle so log dispatch is never blocked.
+ *	Commands are sent one after the other, each one is sent up to SBG_ECOM_ASYNC_CMD_NUM_TRIALS times if no answer is received
+ *	within SBG_ECOM_ASYNC_CMD_TIME_OUT ms. Blocking commands shouldn't be used while asynchronous commands are pending.
+ *	Asynchronous commands can be submitted, polled and cancelled from any thread, completion callbacks are called by the thread that runs sbgEComHandle.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	cmd								Command id to send, built using SBG_ECOM_BUILD_ID.
+ *	\param[in]	type							Define if the command is completed by an ACK or by an answer frame.
+ *	\param[in]	pPayload						Command payload, copied by this method (can be NULL if payloadSize is 0).
+ *	\param[in]	payloadSize						Payload size in bytes (up to SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE).
+ *	\param[out]	pAnswer							Optional buffer used to store the answer payload once received.
+ *	\param[in]	maxAnswerSize					Number of bytes that can be stored in pAnswer.
+ *	\param[in]	pCallback						Optional callback called on completion, if NULL the result has to be read using sbgEComCmdGetResult.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback.
+ *	\param[out]	pTicket							Optional pointer used to return the ticket that identifies the command.
+ *	\return										SBG_NO_ERROR if the command has been queued.<br>
+ *												SBG_BUFFER_OVERFLOW if SBG_ECOM_MAX_ASYNC_CMDS commands are already queued.<br>
+ *												SBG_INVALID_PARAMETER if the payload is too large.
+ */
+SbgErrorCode sbgEComCmdSubmit(SbgEComHandle *pHandle, uint16 cmd, SbgEComAsyncCmdType type, const void *pPayload, uint32 payloadSize, void *pAnswer, uint32 maxAnswerSize, SbgEComAsyncCmdFunc pCallback, void *pUserArg, uint32 *pTicket);
+
+/*!
+ *	Queue an asynchronous command just like sbgEComCmdSubmit but with a specific time out, used by commands that take longer to be processed by the device.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	cmd								Command id to send, built using SBG_ECOM_BUILD_ID.
+ *	\param[in]	type							Define if the command is completed by an ACK or by an answer frame.
+ *	\param[in]	pPayload						Command payload, copied by this method (can be NULL if payloadSize is 0).
+ *	\param[in]	payloadSize						Payload size in bytes (up to SBG_ECOM_ASYNC_CMD_MAX_PAYLOAD_SIZE).
+ *	\param[out]	pAnswer							Optional buffer used to store the answer payload once received.
+ *	\param[in]	maxAnswerSize					Number of bytes that can be stored in pAnswer.
+ *	\param[in]	timeOut							Time out in ms to receive the answer of each trial.
+ *	\param[in]	pCallback						Optional callback called on completion, if NULL the result has to be read using sbgEComCmdGetResult.
+ *	\param[in]	pUserArg						Optional user argument that will be passed to the callback.
+ *	\param[out]	pTicket							Optional pointer used to return the ticket that identifies the command.
+ *	\return										SBG_NO_ERROR if the command has been queued.<br>
+ *												SBG_BUFFER_OVERFLOW if SBG_ECOM_MAX_ASYNC_CMDS commands are already queued.<br>
+ *												SBG_INVALID_PARAMETER if the payload is too large.
+ */
+SbgErrorCode sbgEComCmdSubmitEx(SbgEComHandle *pHandle, uint16 cmd, SbgEComAsyncCmdType type, const void *pPayload, uint32 payloadSize, void *pAnswer, uint32 maxAnswerSize, uint32 timeOut, SbgEComAsyncCmdFunc pCallback, void *pUserArg, uint32 *pTicket);
+
+/*!
+ *	Returns the result of an asynchronous command submitted without callback and release its ticket once completed.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	ticket							Ticket returned by sbgEComCmdSubmit.
+ *	\param[out]	pAnswerSize						Optional pointer used to return the number of bytes stored in the answer buffer.
+ *	\return										SBG_NOT_READY if the command is still in progress.<br>
+ *												SBG_INVALID_PARAMETER if the ticket is unknown.<br>
+ *												Otherwise the command result: the ACK error code, SBG_TIME_OUT, ...
+ */
+SbgErrorCode sbgEComCmdGetResult(SbgEComHandle *pHandle, uint32 ticket, uint32 *pAnswerSize);
+
+/*!
+ *	Cancel an asynchronous command and release its ticket.
+ *	If the command has already been sent, its slot is kept until its answer is received or its time out expires
+ *	so a late answer can't complete the next command, which is only sent then.
+ *	\param[in]	pHandle							A valid sbgECom handle.
+ *	\param[in]	ticket							Ticket returned by sbgEComCmdSubmit.
+ *	\return										SBG_NO_ERROR if the command has been cancelled.<br>
+ *												SBG_INVALID_PARAMETER if the ticket is unknown.
+ */
+SbgErrorCode sbgEComCmdCancel(SbgEComHandle *pHandle, uint32 ticket);
+
 /*!
  *	Returns an integer representing the version of the sbgCom library.
  *	\return										An integer representing the version of the sbgCom library.<br>
@@ -0,0 +1,218 @@
+#include "sbgEComBroadcast.h"
+
+//----------------------------------------------------------------------//
+//- Public methods definitions                                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize an empty broadcast ring.
+ *	\param[in]	pRing									Broadcast ring to initialize.
+ *	\return												SBG_NO_ERROR if the ring has been initialized.
+ */
+SbgErrorCode sbgEComBroadcastInit(SbgEComBroadcastRing *pRing)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pRing)
+	{
+		pRing->claimSequence = 0;
+		pRing->publishSequence = 0;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Publish a binary log to all readers, it should always be called from the same thread.
+ *	This method matches SbgEComReceiveFunc so it can be registered with sbgEComSetReceiveCallback or sbgEComSetLogCallback.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	logCmd									Contains the binary received log command id.
+ *	\param[in]	pLogData								Contains the received log data as an union.
+ *	\param[in]	pUserArg								The broadcast ring.
+ *	\return												SBG_NO_ERROR if the log has been published.
+ */
+SbgErrorCode sbgEComBroadcastPush(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg)
+{
+	SbgEComBroadcastRing	*pRing = (SbgEComBroadcastRing*)pUserArg;
+	SbgEComBroadcastEntry	*pEntry;
+	uint32					 sequence;
+
+	SBG_UNUSED_PARAMETER(pHandle);
+
+	if ( (pRing) && (pLogData) )
+	{
+		//
+		// Only this thread writes the sequences so they can be read directly
+		//
+		sequence = pRing->publishSequence;
+		pEntry = &pRing->entries[sequence & SBG_ECOM_BROADCAST_RING_MASK];
+
+		//
+		// Claim the entry before modifying it so a reader still using it knows it has been overwritten
+		//
+		pRing->claimSequence = sequence + 1;
+		SBG_ATOMIC_FENCE_RELEASE();
+
+		pEntry->logCmd = logCmd;
+		pEntry->data = *pLogData;
+
+		//
+		// Make the entry visible to all readers
+		//
+		SBG_ATOMIC_STORE_RELEASE(pRing->publishSequence, sequence + 1);
+
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
+/*!
+ *	Initialize a reader cursor, the reader only receives binary logs published after this call.
+ *	\param[in]	pCursor									Cursor to initialize.
+ *	\param[in]	pRing									Broadcast ring to read.
+ *	\return												SBG_NO_ERROR if the cursor has been initialized.
+ */
+SbgErrorCode sbgEComBroadcastCursorInit(SbgEComBroadcastCursor *pCursor, const SbgEComBroadcastRing *pRing)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if ( (pCursor) && (pRing) )
+	{
+		pCursor->pRing = pRing;
+		pCursor->sequence = SBG_ATOMIC_LOAD_ACQUIRE(pRing->publishSequence);
+		pCursor->numLost = 0;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Returns a pointer on the next binary log directly in the ring, without any copy.
+ *	The binary log can be overwritten by the writer while it is used so sbgEComBroadcastRelease
+ *	has to be called once done to know if what has been read is valid.
+ *	\param[in]	pCursor									Reader cursor.
+ *	\param[out]	pLogCmd									Binary log command id.
+ *	\param[out]	ppLogData								Pointer on the binary log data stored in the ring.
+ *	\return												SBG_NO_ERROR if a binary log is available or SBG_NOT_READY if the reader is up to date.
+ */
+SbgErrorCode sbgEComBroadcastPeek(SbgEComBroadcastCursor *pCursor, SbgEComCmdId *pLogCmd, const SbgBinaryLogData **ppLogData)
+{
+	const SbgEComBroadcastEntry	*pEntry;
+	uint32						 publishSequence;
+	uint32						 sequence;
+
+	if ( (pCursor) && (pLogCmd) && (ppLogData) )
+	{
+		publishSequence = SBG_ATOMIC_LOAD_ACQUIRE(pCursor->pRing->publishSequence);
+
+		if (publishSequence == pCursor->sequence)
+		{
+			return SBG_NOT_READY;
+		}
+
+		//
+		// If the reader has been lapped, skip the lost logs and restart half a ring behind the writer to leave it some margin
+		// A reader exactly one ring behind can still read its next log, it is only overwritten by the next push
+		//
+		if (publishSequence - pCursor->sequence > SBG_ECOM_BROADCAST_RING_SIZE)
+		{
+			sequence = publishSequence - SBG_ECOM_BROADCAST_RING_SIZE/2;
+
+			pCursor->numLost += sequence - pCursor->sequence;
+			pCursor->sequence = sequence;
+		}
+
+		pEntry = &pCursor->pRing->entries[pCursor->sequence & SBG_ECOM_BROADCAST_RING_MASK];
+
+		*pLogCmd = pEntry->logCmd;
+		*ppLogData = &pEntry->data;
+
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
+/*!
+ *	Move the cursor to the next binary log once the one returned by sbgEComBroadcastPeek has been used.
+ *	\param[in]	pCursor									Reader cursor.
+ *	\return												SBG_NO_ERROR if the binary log has been valid until now or
+ *														SBG_BUFFER_OVERFLOW if it has been overwritten and what has been read should be discarded.
+ */
+SbgErrorCode sbgEComBroadcastRelease(SbgEComBroadcastCursor *pCursor)
+{
+	SbgErrorCode	errorCode = SBG_NO_ERROR;
+	uint32			claimSequence;
+
+	if (pCursor)
+	{
+		//
+		// The entry has been overwritten if the writer has claimed the same entry one ring later
+		//
+		SBG_ATOMIC_FENCE_ACQUIRE();
+		claimSequence = SBG_ATOMIC_LOAD_ACQUIRE(pCursor->pRing->claimSequence);
+
+		if (claimSequence - pCursor->sequence > SBG_ECOM_BROADCAST_RING_SIZE)
+		{
+			pCursor->numLost++;
+			errorCode = SBG_BUFFER_OVERFLOW;
+		}
+
+		pCursor->sequence++;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Copy the next valid binary log and move the cursor after it.
+ *	\param[in]	pCursor									Reader cursor.
+ *	\param[out]	pLogCmd									Binary log command id.
+ *	\param[out]	pLogData								Copy of the binary log data.
+ *	\return												SBG_NO_ERROR if a binary log has been returned or SBG_NOT_READY if the reader is up to date.
+ */
+SbgErrorCode sbgEComBroadcastRead(SbgEComBroadcastCursor *pCursor, SbgEComCmdId *pLogCmd, SbgBinaryLogData *pLogData)
+{
+	SbgErrorCode			 errorCode;
+	const SbgBinaryLogData	*pEntryData;
+
+	if (pLogData)
+	{
+		//
+		// Retry with the next log each time the copied one has been overwritten during the copy
+		//
+		do
+		{
+			errorCode = sbgEComBroadcastPeek(pCursor, pLogCmd, &pEntryData);
+
+			if (errorCode == SBG_NO_ERROR)
+			{
+				*pLogData = *pEntryData;
+				errorCode = sbgEComBroadcastRelease(pCursor);
+			}
+		} while (errorCode == SBG_BUFFER_OVERFLOW);
+
+		return errorCode;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
@@ -0,0 +1,144 @@
+/*!
+ *	\file		sbgEComBroadcast.h
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Single writer / multiple readers broadcast ring used to share received binary logs.
+ *
+ *	The ring is fed by the thread that calls sbgEComHandle using sbgEComBroadcastPush as receive or log callback.
+ *	Each binary log is stored only once and every reader walks the ring with its own cursor.
+ *	The writer never waits for the readers: a reader that is too slow is lapped, it then skips
+ *	the overwritten logs and counts them as lost.
+ *
+ *	No lock is used, readers only compare sequence numbers published by the writer.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#ifndef __SBG_ECOM_BROADCAST_H__
+#define __SBG_ECOM_BROADCAST_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sbgECom.h"
+
+//----------------------------------------------------------------------//
+//- Global definitions                                                 -//
+//----------------------------------------------------------------------//
+#ifndef SBG_ECOM_BROADCAST_RING_SIZE
+	#define SBG_ECOM_BROADCAST_RING_SIZE		(64)						/*!< Number of binary logs kept in the broadcast ring (should be a power of two). */
+#endif
+
+#define SBG_ECOM_BROADCAST_RING_MASK			(SBG_ECOM_BROADCAST_RING_SIZE-1)	/*!< Mask used to get a ring entry from a sequence number. */
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Binary log stored in the broadcast ring, tagged with its log id.
+ */
+typedef struct _SbgEComBroadcastEntry
+{
+	SbgEComCmdId				 logCmd;					/*!< Binary log command id. */
+	SbgBinaryLogData			 data;						/*!< Parsed binary log data. */
+} SbgEComBroadcastEntry;
+
+/*!
+ * Broadcast ring written by a single thread, this structure is quite large and should not be allocated on the stack.
+ */
+typedef struct _SbgEComBroadcastRing
+{
+	SbgEComBroadcastEntry		 entries[SBG_ECOM_BROADCAST_RING_SIZE];	/*!< Preallocated ring of binary logs. */
+	volatile uint32				 claimSequence;				/*!< Sequence number of the entry being written plus one. */
+	volatile uint32				 publishSequence;			/*!< Number of binary logs published, readers can use all entries before it. */
+} SbgEComBroadcastRing;
+
+/*!
+ * Reader position in a broadcast ring, each reader thread owns its cursor.
+ */
+typedef struct _SbgEComBroadcastCursor
+{
+	const SbgEComBroadcastRing	*pRing;						/*!< Broadcast ring read by this cursor. */
+	uint32						 sequence;					/*!< Sequence number of the next binary log to read. */
+	uint32						 numLost;					/*!< Number of binary logs overwritten before this reader could read them. */
+} SbgEComBroadcastCursor;
+
+//----------------------------------------------------------------------//
+//- Public methods declarations                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize an empty broadcast ring.
+ *	\param[in]	pRing									Broadcast ring to initialize.
+ *	\return												SBG_NO_ERROR if the ring has been initialized.
+ */
+SbgErrorCode sbgEComBroadcastInit(SbgEComBroadcastRing *pRing);
+
+/*!
+ *	Publish a binary log to all readers, it should always be called from the same thread.
+ *	This method matches SbgEComReceiveFunc so it can be registered with sbgEComSetReceiveCallback or sbgEComSetLogCallback.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	logCmd									Contains the binary received log command id.
+ *	\param[in]	pLogData								Contains the received log data as an union.
+ *	\param[in]	pUserArg								The broadcast ring.
+ *	\return												SBG_NO_ERROR if the log has been published.
+ */
+SbgErrorCode sbgEComBroadcastPush(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg);
+
+/*!
+ *	Initialize a reader cursor, the reader only receives binary logs published after this call.
+ *	\param[in]	pCursor									Cursor to initialize.
+ *	\param[in]	pRing									Broadcast ring to read.
+ *	\return												SBG_NO_ERROR if the cursor has been initialized.
+ */
+SbgErrorCode sbgEComBroadcastCursorInit(SbgEComBroadcastCursor *pCursor, const SbgEComBroadcastRing *pRing);
+
+/*!
+ *	Returns a pointer on the next binary log directly in the ring, without any copy.
+ *	The binary log can be overwritten by the writer while it is used so sbgEComBroadcastRelease
+ *	has to be called once done to know if what has been read is valid.
+ *	\param[in]	pCursor									Reader cursor.
+ *	\param[out]	pLogCmd									Binary log command id.
+ *	\param[out]	ppLogData								Pointer on the binary log data stored in the ring.
+ *	\return												SBG_NO_ERROR if a binary log is available or SBG_NOT_READY if the reader is up to date.
+ */
+SbgErrorCode sbgEComBroadcastPeek(SbgEComBroadcastCursor *pCursor, SbgEComCmdId *pLogCmd, const SbgBinaryLogData **ppLogData);
+
+/*!
+ *	Move the cursor to the next binary log once the one returned by sbgEComBroadcastPeek has been used.
+ *	\param[in]	pCursor									Reader cursor.
+ *	\return												SBG_NO_ERROR if the binary log has been valid until now or
+ *														SBG_BUFFER_OVERFLOW if it has been overwritten and what has been read should be discarded.
+ */
+SbgErrorCode sbgEComBroadcastRelease(SbgEComBroadcastCursor *pCursor);
+
+/*!
+ *	Copy the next valid binary log and move the cursor after it.
+ *	\param[in]	pCursor									Reader cursor.
+ *	\param[out]	pLogCmd									Binary log command id.
+ *	\param[out]	pLogData								Copy of the binary log data.
+ *	\return												SBG_NO_ERROR if a binary log has been returned or SBG_NOT_READY if the reader is up to date.
+ */
+SbgErrorCode sbgEComBroadcastRead(SbgEComBroadcastCursor *pCursor, SbgEComCmdId *pLogCmd, SbgBinaryLogData *pLogData);
+
+//----------------------------------------------------------------------//
+//- Footer (close extern C block)                                      -//
+//----------------------------------------------------------------------//
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SBG_ECOM_BROADCAST_H__ */
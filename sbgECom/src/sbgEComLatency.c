@@ -0,0 +1,278 @@
+#include "sbgEComLatency.h"
+
+//----------------------------------------------------------------------//
+//- Private methods declarations                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Returns the bucket index of a duration.
+ *	\param[in]	value									Duration in ns.
+ *	\return												Bucket index from 0 to SBG_ECOM_LATENCY_NUM_BUCKETS-1.
+ */
+static uint32 sbgEComLatencyGetBucketIndex(uint64 value)
+{
+	uint32	msb;
+	uint32	index;
+
+	//
+	// Small values are stored in linear buckets
+	//
+	if (value < 2*SBG_ECOM_LATENCY_SUB_BUCKET_COUNT)
+	{
+		return (uint32)value;
+	}
+
+	//
+	// Find the octave of the value
+	//
+	msb = SBG_ECOM_LATENCY_SUB_BUCKET_BITS + 1;
+
+	while ( (msb < 63) && ((value >> (msb + 1)) != 0) )
+	{
+		msb++;
+	}
+
+	//
+	// Each octave is split in linear sub buckets using the bits that follow the most significant one
+	//
+	index = (msb - SBG_ECOM_LATENCY_SUB_BUCKET_BITS + 1) * SBG_ECOM_LATENCY_SUB_BUCKET_COUNT + (uint32)((value >> (msb - SBG_ECOM_LATENCY_SUB_BUCKET_BITS)) & (SBG_ECOM_LATENCY_SUB_BUCKET_COUNT - 1));
+
+	if (index >= SBG_ECOM_LATENCY_NUM_BUCKETS)
+	{
+		index = SBG_ECOM_LATENCY_NUM_BUCKETS - 1;
+	}
+
+	return index;
+}
+
+/*!
+ *	Add a duration to a histogram.
+ *	\param[in]	pHistogram								Histogram to update.
+ *	\param[in]	value									Duration in ns.
+ */
+static void sbgEComLatencyHistogramAdd(SbgEComLatencyHistogram *pHistogram, uint64 value)
+{
+	pHistogram->buckets[sbgEComLatencyGetBucketIndex(value)]++;
+	pHistogram->count++;
+	pHistogram->sum += value;
+
+	if (value > pHistogram->max)
+	{
+		pHistogram->max = value;
+	}
+}
+
+//----------------------------------------------------------------------//
+//- Public methods definitions                                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize empty latency statistics.
+ *	This method shouldn't be called while the statistics are attached to a running handle, use sbgEComLatencyReset instead.
+ *	\param[in]	pStats									Latency statistics to initialize.
+ *	\return												SBG_NO_ERROR if the statistics have been initialized.
+ */
+SbgErrorCode sbgEComLatencyInit(SbgEComLatencyStats *pStats)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pStats)
+	{
+		memset(pStats, 0x00, sizeof(SbgEComLatencyStats));
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Ask to clear all histograms, it can be called from any thread.
+ *	The histograms are cleared by the dispatching thread just before the next value is recorded.
+ *	\param[in]	pStats									Latency statistics to reset.
+ *	\return												SBG_NO_ERROR if the reset has been requested.
+ */
+SbgErrorCode sbgEComLatencyReset(SbgEComLatencyStats *pStats)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pStats)
+	{
+		SBG_ATOMIC_STORE_RELEASE(pStats->resetRequest, SBG_ATOMIC_LOAD_ACQUIRE(pStats->resetRequest) + 1);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Record the latencies of a dispatched binary log, called by sbgEComHandle.
+ *	This method should always be called from the same thread.
+ *	\param[in]	pStats									Latency statistics.
+ *	\param[in]	logCmd									Binary log command id.
+ *	\param[in]	dispatchTime							Time in ns from the frame completion to the first callback entry.
+ *	\param[in]	callbackTime							Time in ns spent inside the callbacks.
+ */
+void sbgEComLatencyRecord(SbgEComLatencyStats *pStats, uint16 logCmd, uint64 dispatchTime, uint64 callbackTime)
+{
+	uint32	sequence;
+	uint32	resetRequest;
+
+	if ( (pStats) && (logCmd < SBG_ECOM_LOG_ECOM_NUM_MESSAGES) )
+	{
+		//
+		// Only this thread writes the sequence so it can be read directly
+		//
+		sequence = pStats->sequence;
+
+		//
+		// Let the readers know the histograms are being modified
+		//
+		pStats->sequence = sequence + 1;
+		SBG_ATOMIC_FENCE_RELEASE();
+
+		resetRequest = SBG_ATOMIC_LOAD_ACQUIRE(pStats->resetRequest);
+
+		if (resetRequest != pStats->resetDone)
+		{
+			memset(pStats->dispatch, 0x00, sizeof(pStats->dispatch));
+			memset(pStats->callback, 0x00, sizeof(pStats->callback));
+			pStats->resetDone = resetRequest;
+		}
+
+		sbgEComLatencyHistogramAdd(&pStats->dispatch[logCmd], dispatchTime);
+		sbgEComLatencyHistogramAdd(&pStats->callback[logCmd], callbackTime);
+
+		SBG_ATOMIC_STORE_RELEASE(pStats->sequence, sequence + 2);
+	}
+}
+
+/*!
+ *	Returns a consistent copy of the histogram of a binary log, it can be called from any thread.
+ *	\param[in]	pStats									Latency statistics.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	type									Latency to return.
+ *	\param[out]	pHistogram								Copy of the histogram.
+ *	\return												SBG_NO_ERROR if the histogram has been returned.<br>
+ *														SBG_INVALID_PARAMETER if logCmd or type are invalid.
+ */
+SbgErrorCode sbgEComLatencyGetHistogram(const SbgEComLatencyStats *pStats, SbgEComCmdId logCmd, SbgEComLatencyType type, SbgEComLatencyHistogram *pHistogram)
+{
+	const SbgEComLatencyHistogram	*pSource;
+	uint32							 sequence;
+
+	if ( (pStats) && (pHistogram) )
+	{
+		if ( ((uint32)logCmd >= SBG_ECOM_LOG_ECOM_NUM_MESSAGES) || ( (type != SBG_ECOM_LATENCY_DISPATCH) && (type != SBG_ECOM_LATENCY_CALLBACK) ) )
+		{
+			return SBG_INVALID_PARAMETER;
+		}
+
+		pSource = (type == SBG_ECOM_LATENCY_DISPATCH) ? &pStats->dispatch[logCmd] : &pStats->callback[logCmd];
+
+		//
+		// Copy again each time the histograms have been modified during the copy
+		//
+		do
+		{
+			do
+			{
+				sequence = SBG_ATOMIC_LOAD_ACQUIRE(pStats->sequence);
+			} while (sequence & 1);
+
+			*pHistogram = *pSource;
+
+			SBG_ATOMIC_FENCE_ACQUIRE();
+		} while (SBG_ATOMIC_LOAD_ACQUIRE(pStats->sequence) != sequence);
+
+		return SBG_NO_ERROR;
+	}
+	else
+	{
+		return SBG_NULL_POINTER;
+	}
+}
+
+/*!
+ *	Returns the value below which a given percentage of the histogram values fall.
+ *	The returned value is the upper bound of the bucket holding this percentile.
+ *	\param[in]	pHistogram								Histogram returned by sbgEComLatencyGetHistogram.
+ *	\param[in]	percentile								Percentile from 0 to 100 such as 99.9.
+ *	\return												Percentile value in ns or 0 if the histogram is empty.
+ */
+uint64 sbgEComLatencyGetPercentile(const SbgEComLatencyHistogram *pHistogram, double percentile)
+{
+	uint64	target;
+	uint64	count = 0;
+	uint64	value;
+	uint32	i;
+
+	if ( (pHistogram) && (pHistogram->count > 0) )
+	{
+		//
+		// Number of values that should be below the percentile, at least one
+		//
+		if (percentile >= 100.0)
+		{
+			target = pHistogram->count;
+		}
+		else if (percentile <= 0.0)
+		{
+			target = 1;
+		}
+		else
+		{
+			target = (uint64)(percentile * pHistogram->count / 100.0 + 0.5);
+
+			if (target == 0)
+			{
+				target = 1;
+			}
+		}
+
+		for (i = 0; i < SBG_ECOM_LATENCY_NUM_BUCKETS - 1; i++)
+		{
+			count += pHistogram->buckets[i];
+
+			if (count >= target)
+			{
+				//
+				// The bucket upper bound can't be larger than the largest recorded value
+				//
+				value = sbgEComLatencyGetBucketLowerBound(i + 1) - 1;
+
+				return (value < pHistogram->max) ? value : pHistogram->max;
+			}
+		}
+
+		return pHistogram->max;
+	}
+
+	return 0;
+}
+
+/*!
+ *	Returns the smallest value stored in a histogram bucket.
+ *	\param[in]	index									Bucket index from 0 to SBG_ECOM_LATENCY_NUM_BUCKETS-1.
+ *	\return												Lower bound in ns of the bucket.
+ */
+uint64 sbgEComLatencyGetBucketLowerBound(uint32 index)
+{
+	uint32	msb;
+	uint32	subBucket;
+
+	if (index < 2*SBG_ECOM_LATENCY_SUB_BUCKET_COUNT)
+	{
+		return index;
+	}
+
+	msb = index / SBG_ECOM_LATENCY_SUB_BUCKET_COUNT + SBG_ECOM_LATENCY_SUB_BUCKET_BITS - 1;
+	subBucket = index % SBG_ECOM_LATENCY_SUB_BUCKET_COUNT;
+
+	return ((uint64)(SBG_ECOM_LATENCY_SUB_BUCKET_COUNT + subBucket)) << (msb - SBG_ECOM_LATENCY_SUB_BUCKET_BITS);
+}
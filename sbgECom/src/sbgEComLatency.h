@@ -0,0 +1,155 @@
+/*!
+ *	\file		sbgEComLatency.h
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Optional latency histograms of the binary logs dispatching.
+ *
+ *	When latency statistics are attached to a sbgECom handle using sbgEComSetLatencyStats,
+ *	sbgEComHandle records for each binary log id:
+ *		- the dispatch latency: time from the frame completion, when the interface read that returned its last byte ended,
+ *		  to the first callback entry, which includes the time spent behind other frames and the log parsing.
+ *		- the callback duration: time spent inside all the callbacks called for this log.
+ *
+ *	Durations are stored in ns in fixed bucket histograms with a logarithmic bucket width,
+ *	each octave being split in 8 linear sub buckets so any value is known within 12.5%.
+ *	Values are exact below 16 ns and the last bucket holds all values above 17 s.
+ *
+ *	Histograms can be read and reset from any thread while sbgEComHandle is running.
+ *	Nothing is recorded and no time is measured when no statistics are attached to the handle.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#ifndef __SBG_ECOM_LATENCY_H__
+#define __SBG_ECOM_LATENCY_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sbgCommon.h>
+#include "sbgEComIds.h"
+
+//----------------------------------------------------------------------//
+//- Global definitions                                                 -//
+//----------------------------------------------------------------------//
+#define SBG_ECOM_LATENCY_SUB_BUCKET_BITS		(3)							/*!< Each octave is split in 2^SBG_ECOM_LATENCY_SUB_BUCKET_BITS linear sub buckets. */
+#define SBG_ECOM_LATENCY_SUB_BUCKET_COUNT		(1 << SBG_ECOM_LATENCY_SUB_BUCKET_BITS)	/*!< Number of sub buckets in each octave. */
+#define SBG_ECOM_LATENCY_NUM_BUCKETS			(256)						/*!< Number of buckets of each histogram, values up to 2^34 ns can be stored. */
+
+//----------------------------------------------------------------------//
+//- Enums definitions                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Latency measured for each binary log.
+ */
+typedef enum _SbgEComLatencyType
+{
+	SBG_ECOM_LATENCY_DISPATCH = 0,										/*!< Time from the frame completion to the first callback entry. */
+	SBG_ECOM_LATENCY_CALLBACK = 1										/*!< Time spent inside the callbacks. */
+} SbgEComLatencyType;
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Histogram of durations in ns.
+ */
+typedef struct _SbgEComLatencyHistogram
+{
+	uint32						 buckets[SBG_ECOM_LATENCY_NUM_BUCKETS];	/*!< Number of values stored in each bucket. */
+	uint32						 count;						/*!< Total number of values. */
+	uint64						 sum;						/*!< Sum of all values in ns, used to compute the mean. */
+	uint64						 max;						/*!< Largest value in ns. */
+} SbgEComLatencyHistogram;
+
+/*!
+ * Latency histograms of all binary logs, this structure is quite large and should not be allocated on the stack.
+ */
+typedef struct _SbgEComLatencyStats
+{
+	SbgEComLatencyHistogram		 dispatch[SBG_ECOM_LOG_ECOM_NUM_MESSAGES];	/*!< Dispatch latency of each binary log id. */
+	SbgEComLatencyHistogram		 callback[SBG_ECOM_LOG_ECOM_NUM_MESSAGES];	/*!< Callbacks duration of each binary log id. */
+	volatile uint32				 sequence;					/*!< Odd while the histograms are being modified, only written by the dispatching thread. */
+	volatile uint32				 resetRequest;				/*!< Incremented each time a reset is requested. */
+	uint32						 resetDone;					/*!< Last reset request applied by the dispatching thread. */
+} SbgEComLatencyStats;
+
+//----------------------------------------------------------------------//
+//- Public methods declarations                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize empty latency statistics.
+ *	This method shouldn't be called while the statistics are attached to a running handle, use sbgEComLatencyReset instead.
+ *	\param[in]	pStats									Latency statistics to initialize.
+ *	\return												SBG_NO_ERROR if the statistics have been initialized.
+ */
+SbgErrorCode sbgEComLatencyInit(SbgEComLatencyStats *pStats);
+
+/*!
+ *	Ask to clear all histograms, it can be called from any thread.
+ *	The histograms are cleared by the dispatching thread just before the next value is recorded.
+ *	\param[in]	pStats									Latency statistics to reset.
+ *	\return												SBG_NO_ERROR if the reset has been requested.
+ */
+SbgErrorCode sbgEComLatencyReset(SbgEComLatencyStats *pStats);
+
+/*!
+ *	Record the latencies of a dispatched binary log, called by sbgEComHandle.
+ *	This method should always be called from the same thread.
+ *	\param[in]	pStats									Latency statistics.
+ *	\param[in]	logCmd									Binary log command id.
+ *	\param[in]	dispatchTime							Time in ns from the frame completion to the first callback entry.
+ *	\param[in]	callbackTime							Time in ns spent inside the callbacks.
+ */
+void sbgEComLatencyRecord(SbgEComLatencyStats *pStats, uint16 logCmd, uint64 dispatchTime, uint64 callbackTime);
+
+/*!
+ *	Returns a consistent copy of the histogram of a binary log, it can be called from any thread.
+ *	\param[in]	pStats									Latency statistics.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	type									Latency to return.
+ *	\param[out]	pHistogram								Copy of the histogram.
+ *	\return												SBG_NO_ERROR if the histogram has been returned.<br>
+ *														SBG_INVALID_PARAMETER if logCmd or type are invalid.
+ */
+SbgErrorCode sbgEComLatencyGetHistogram(const SbgEComLatencyStats *pStats, SbgEComCmdId logCmd, SbgEComLatencyType type, SbgEComLatencyHistogram *pHistogram);
+
+/*!
+ *	Returns the value below which a given percentage of the histogram values fall.
+ *	The returned value is the upper bound of the bucket holding this percentile.
+ *	\param[in]	pHistogram								Histogram returned by sbgEComLatencyGetHistogram.
+ *	\param[in]	percentile								Percentile from 0 to 100 such as 99.9.
+ *	\return												Percentile value in ns or 0 if the histogram is empty.
+ */
+uint64 sbgEComLatencyGetPercentile(const SbgEComLatencyHistogram *pHistogram, double percentile);
+
+/*!
+ *	Returns the smallest value stored in a histogram bucket.
+ *	\param[in]	index									Bucket index from 0 to SBG_ECOM_LATENCY_NUM_BUCKETS-1.
+ *	\return												Lower bound in ns of the bucket.
+ */
+uint64 sbgEComLatencyGetBucketLowerBound(uint32 index);
+
+//----------------------------------------------------------------------//
+//- Footer (close extern C block)                                      -//
+//----------------------------------------------------------------------//
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SBG_ECOM_LATENCY_H__ */
@@ -44,6 +44,10 @@ extern "C" {
 #include <swap/sbgSwap.h>
 #include "sbgECanId.h"
 #include "sbgEComIds.h"
+#include "sbgEComReader.h"
+#include "sbgEComBroadcast.h"
+#include "sbgEComLatency.h"
+#include "sbgEComLogBatch.h"
 #include "commands/sbgEComCmd.h"
 #include "protocol/sbgEComProtocol.h"
 #include "binaryLogs/sbgEComBinaryLogs.h"
@@ -0,0 +1,620 @@
+#include "sbgEComLogBatch.h"
+#include "binaryLogs/sbgEComBinaryLogSchema.h"
+#include <crc/sbgCrc.h>
+
+//----------------------------------------------------------------------//
+//- Log columns                                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Columns of the SBG_ECOM_LOG_IMU_DATA message with their payload offset and type.
+ */
+#define SBG_ECOM_LOG_IMU_COLUMNS(COLUMN)							\
+	COLUMN(SbgLogImuColumns,	pTimeStamp,		0,	Uint32)			\
+	COLUMN(SbgLogImuColumns,	pStatus,		4,	Uint16)			\
+	COLUMN(SbgLogImuColumns,	pAccelX,		6,	Float)			\
+	COLUMN(SbgLogImuColumns,	pAccelY,		10,	Float)			\
+	COLUMN(SbgLogImuColumns,	pAccelZ,		14,	Float)			\
+	COLUMN(SbgLogImuColumns,	pGyroX,			18,	Float)			\
+	COLUMN(SbgLogImuColumns,	pGyroY,			22,	Float)			\
+	COLUMN(SbgLogImuColumns,	pGyroZ,			26,	Float)			\
+	COLUMN(SbgLogImuColumns,	pTemperature,	30,	Float)			\
+	COLUMN(SbgLogImuColumns,	pDeltaVelX,		34,	Float)			\
+	COLUMN(SbgLogImuColumns,	pDeltaVelY,		38,	Float)			\
+	COLUMN(SbgLogImuColumns,	pDeltaVelZ,		42,	Float)			\
+	COLUMN(SbgLogImuColumns,	pDeltaAngleX,	46,	Float)			\
+	COLUMN(SbgLogImuColumns,	pDeltaAngleY,	50,	Float)			\
+	COLUMN(SbgLogImuColumns,	pDeltaAngleZ,	54,	Float)
+
+/*!
+ * Columns of the SBG_ECOM_LOG_EKF_EULER message with their payload offset and type.
+ */
+#define SBG_ECOM_LOG_EKF_EULER_COLUMNS(COLUMN)						\
+	COLUMN(SbgLogEkfEulerColumns,	pTimeStamp,		0,	Uint32)		\
+	COLUMN(SbgLogEkfEulerColumns,	pRoll,			4,	Float)		\
+	COLUMN(SbgLogEkfEulerColumns,	pPitch,			8,	Float)		\
+	COLUMN(SbgLogEkfEulerColumns,	pYaw,			12,	Float)		\
+	COLUMN(SbgLogEkfEulerColumns,	pRollStdDev,	16,	Float)		\
+	COLUMN(SbgLogEkfEulerColumns,	pPitchStdDev,	20,	Float)		\
+	COLUMN(SbgLogEkfEulerColumns,	pYawStdDev,		24,	Float)		\
+	COLUMN(SbgLogEkfEulerColumns,	pStatus,		28,	Uint32)
+
+/*!
+ * Columns of the SBG_ECOM_LOG_EKF_NAV message with their payload offset and type.
+ */
+#define SBG_ECOM_LOG_EKF_NAV_COLUMNS(COLUMN)							\
+	COLUMN(SbgLogEkfNavColumns,	pTimeStamp,			0,	Uint32)		\
+	COLUMN(SbgLogEkfNavColumns,	pVelocityN,			4,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pVelocityE,			8,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pVelocityD,			12,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pVelocityNStdDev,	16,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pVelocityEStdDev,	20,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pVelocityDStdDev,	24,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pLatitude,			28,	Double)		\
+	COLUMN(SbgLogEkfNavColumns,	pLongitude,			36,	Double)		\
+	COLUMN(SbgLogEkfNavColumns,	pAltitude,			44,	Double)		\
+	COLUMN(SbgLogEkfNavColumns,	pUndulation,		52,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pLatitudeStdDev,	56,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pLongitudeStdDev,	60,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pAltitudeStdDev,	64,	Float)		\
+	COLUMN(SbgLogEkfNavColumns,	pStatus,			68,	Uint32)
+
+/*!
+ * Columns of the SBG_ECOM_LOG_MAG message with their payload offset and type.
+ */
+#define SBG_ECOM_LOG_MAG_COLUMNS(COLUMN)							\
+	COLUMN(SbgLogMagColumns,	pTimeStamp,		0,	Uint32)			\
+	COLUMN(SbgLogMagColumns,	pStatus,		4,	Uint16)			\
+	COLUMN(SbgLogMagColumns,	pMagX,			6,	Float)			\
+	COLUMN(SbgLogMagColumns,	pMagY,			10,	Float)			\
+	COLUMN(SbgLogMagColumns,	pMagZ,			14,	Float)			\
+	COLUMN(SbgLogMagColumns,	pAccelX,		18,	Float)			\
+	COLUMN(SbgLogMagColumns,	pAccelY,		22,	Float)			\
+	COLUMN(SbgLogMagColumns,	pAccelZ,		26,	Float)
+
+//----------------------------------------------------------------------//
+//- Columns table expansion macros                                     -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Expand a column into its payload size in bytes.
+ */
+#define SBG_ECOM_LOG_BATCH_COLUMN_SIZE(structType, member, payloadOffset, type)	\
+	+ sizeof(*((structType*)0)->member)
+
+/*!
+ * Returns the payload size in bytes of a columns table, columns should cover the whole payload.
+ */
+#define SBG_ECOM_LOG_BATCH_PAYLOAD_SIZE(columnsTable)	\
+	(0 columnsTable(SBG_ECOM_LOG_BATCH_COLUMN_SIZE))
+
+/*!
+ * Expand a column into the read of this value for a group of payloads if the column is used.
+ * The pColumns, firstIndex, ppPayloads and numPayloads variables should be defined by the calling code.
+ */
+#define SBG_ECOM_LOG_BATCH_READ_COLUMN(structType, member, payloadOffset, type)					\
+	if (pColumns->member)																		\
+	{																							\
+		sbgEComLogBatchRead##type##Column(ppPayloads, numPayloads, (payloadOffset), pColumns->member + firstIndex);	\
+	}
+
+//----------------------------------------------------------------------//
+//- Private methods declarations                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Read an unsigned 16 bits value from a group of payloads.
+ *	\param[in]	ppPayloads								Payloads to read.
+ *	\param[in]	numPayloads								Number of payloads.
+ *	\param[in]	payloadOffset							Offset of the value in each payload.
+ *	\param[out]	pColumn									Output column position of the first payload value.
+ */
+static void sbgEComLogBatchReadUint16Column(const uint8 *const *ppPayloads, uint32 numPayloads, uint32 payloadOffset, uint16 *pColumn)
+{
+	uint32	i;
+
+	for (i = 0; i < numPayloads; i++)
+	{
+		sbgEComLogReadUint16(ppPayloads[i] + payloadOffset, &pColumn[i], 1);
+	}
+}
+
+/*!
+ *	Read an unsigned 32 bits value from a group of payloads.
+ *	\param[in]	ppPayloads								Payloads to read.
+ *	\param[in]	numPayloads								Number of payloads.
+ *	\param[in]	payloadOffset							Offset of the value in each payload.
+ *	\param[out]	pColumn									Output column position of the first payload value.
+ */
+static void sbgEComLogBatchReadUint32Column(const uint8 *const *ppPayloads, uint32 numPayloads, uint32 payloadOffset, uint32 *pColumn)
+{
+	uint32	i;
+
+	for (i = 0; i < numPayloads; i++)
+	{
+		sbgEComLogReadUint32(ppPayloads[i] + payloadOffset, &pColumn[i], 1);
+	}
+}
+
+/*!
+ *	Read a 32 bits floating point value from a group of payloads.
+ *	\param[in]	ppPayloads								Payloads to read.
+ *	\param[in]	numPayloads								Number of payloads.
+ *	\param[in]	payloadOffset							Offset of the value in each payload.
+ *	\param[out]	pColumn									Output column position of the first payload value.
+ */
+static void sbgEComLogBatchReadFloatColumn(const uint8 *const *ppPayloads, uint32 numPayloads, uint32 payloadOffset, float *pColumn)
+{
+	uint32	i;
+
+	for (i = 0; i < numPayloads; i++)
+	{
+		sbgEComLogReadFloat(ppPayloads[i] + payloadOffset, &pColumn[i], 1);
+	}
+}
+
+/*!
+ *	Read a 64 bits floating point value from a group of payloads.
+ *	\param[in]	ppPayloads								Payloads to read.
+ *	\param[in]	numPayloads								Number of payloads.
+ *	\param[in]	payloadOffset							Offset of the value in each payload.
+ *	\param[out]	pColumn									Output column position of the first payload value.
+ */
+static void sbgEComLogBatchReadDoubleColumn(const uint8 *const *ppPayloads, uint32 numPayloads, uint32 payloadOffset, double *pColumn)
+{
+	uint32	i;
+
+	for (i = 0; i < numPayloads; i++)
+	{
+		sbgEComLogReadDouble(ppPayloads[i] + payloadOffset, &pColumn[i], 1);
+	}
+}
+
+/*!
+ *	Returns the smallest payload size that can be decoded into columns.
+ *	\param[in]	logCmd									Binary log command id.
+ *	\return												Payload size in bytes or 0 if this binary log can't be decoded into columns.
+ */
+static uint32 sbgEComLogBatchGetPayloadSize(SbgEComCmdId logCmd)
+{
+	switch (logCmd)
+	{
+	case SBG_ECOM_LOG_IMU_DATA:
+		return SBG_ECOM_LOG_BATCH_PAYLOAD_SIZE(SBG_ECOM_LOG_IMU_COLUMNS);
+	case SBG_ECOM_LOG_EKF_EULER:
+		return SBG_ECOM_LOG_BATCH_PAYLOAD_SIZE(SBG_ECOM_LOG_EKF_EULER_COLUMNS);
+	case SBG_ECOM_LOG_EKF_NAV:
+		return SBG_ECOM_LOG_BATCH_PAYLOAD_SIZE(SBG_ECOM_LOG_EKF_NAV_COLUMNS);
+	case SBG_ECOM_LOG_MAG:
+		return SBG_ECOM_LOG_BATCH_PAYLOAD_SIZE(SBG_ECOM_LOG_MAG_COLUMNS);
+	default:
+		return 0;
+	}
+}
+
+/*!
+ *	Decode a group of SBG_ECOM_LOG_IMU_DATA payloads.
+ *	\param[in]	pColumns								Output columns.
+ *	\param[in]	firstIndex								Column index of the first payload values.
+ *	\param[in]	ppPayloads								Payloads to decode, each one large enough.
+ *	\param[in]	numPayloads								Number of payloads.
+ */
+static void sbgEComLogBatchDecodeImu(const SbgLogImuColumns *pColumns, uint32 firstIndex, const uint8 *const *ppPayloads, uint32 numPayloads)
+{
+	SBG_ECOM_LOG_IMU_COLUMNS(SBG_ECOM_LOG_BATCH_READ_COLUMN)
+}
+
+/*!
+ *	Decode a group of SBG_ECOM_LOG_EKF_EULER payloads.
+ *	\param[in]	pColumns								Output columns.
+ *	\param[in]	firstIndex								Column index of the first payload values.
+ *	\param[in]	ppPayloads								Payloads to decode, each one large enough.
+ *	\param[in]	numPayloads								Number of payloads.
+ */
+static void sbgEComLogBatchDecodeEkfEuler(const SbgLogEkfEulerColumns *pColumns, uint32 firstIndex, const uint8 *const *ppPayloads, uint32 numPayloads)
+{
+	SBG_ECOM_LOG_EKF_EULER_COLUMNS(SBG_ECOM_LOG_BATCH_READ_COLUMN)
+}
+
+/*!
+ *	Decode a group of SBG_ECOM_LOG_EKF_NAV payloads.
+ *	\param[in]	pColumns								Output columns.
+ *	\param[in]	firstIndex								Column index of the first payload values.
+ *	\param[in]	ppPayloads								Payloads to decode, each one large enough.
+ *	\param[in]	numPayloads								Number of payloads.
+ */
+static void sbgEComLogBatchDecodeEkfNav(const SbgLogEkfNavColumns *pColumns, uint32 firstIndex, const uint8 *const *ppPayloads, uint32 numPayloads)
+{
+	SBG_ECOM_LOG_EKF_NAV_COLUMNS(SBG_ECOM_LOG_BATCH_READ_COLUMN)
+}
+
+/*!
+ *	Decode a group of SBG_ECOM_LOG_MAG payloads.
+ *	\param[in]	pColumns								Output columns.
+ *	\param[in]	firstIndex								Column index of the first payload values.
+ *	\param[in]	ppPayloads								Payloads to decode, each one large enough.
+ *	\param[in]	numPayloads								Number of payloads.
+ */
+static void sbgEComLogBatchDecodeMag(const SbgLogMagColumns *pColumns, uint32 firstIndex, const uint8 *const *ppPayloads, uint32 numPayloads)
+{
+	SBG_ECOM_LOG_MAG_COLUMNS(SBG_ECOM_LOG_BATCH_READ_COLUMN)
+}
+
+/*!
+ *	Decode a group of payloads, column after column, and append them to the batch.
+ *	\param[in]	pBatch									Batch with enough room left for all payloads.
+ *	\param[in]	ppPayloads								Payloads to decode, each one large enough.
+ *	\param[in]	numPayloads								Number of payloads.
+ */
+static void sbgEComLogBatchDecode(SbgEComLogBatch *pBatch, const uint8 *const *ppPayloads, uint32 numPayloads)
+{
+	switch (pBatch->logCmd)
+	{
+	case SBG_ECOM_LOG_IMU_DATA:
+		sbgEComLogBatchDecodeImu(&pBatch->columns.imu, pBatch->numLogs, ppPayloads, numPayloads);
+		break;
+	case SBG_ECOM_LOG_EKF_EULER:
+		sbgEComLogBatchDecodeEkfEuler(&pBatch->columns.ekfEuler, pBatch->numLogs, ppPayloads, numPayloads);
+		break;
+	case SBG_ECOM_LOG_EKF_NAV:
+		sbgEComLogBatchDecodeEkfNav(&pBatch->columns.ekfNav, pBatch->numLogs, ppPayloads, numPayloads);
+		break;
+	case SBG_ECOM_LOG_MAG:
+		sbgEComLogBatchDecodeMag(&pBatch->columns.mag, pBatch->numLogs, ppPayloads, numPayloads);
+		break;
+	default:
+		return;
+	}
+
+	pBatch->numLogs += numPayloads;
+}
+
+/*!
+ *	Find the first SYNC_1 / SYNC_2 pair in a contiguous buffer.
+ *	\param[in]	pBuffer								Buffer to scan.
+ *	\param[in]	size								Buffer size in bytes.
+ *	\return											Index of the SYNC_1 char of the first pair or size if no pair has been found.
+ */
+static uint32 sbgEComLogBatchFindSync(const uint8 *pBuffer, uint32 size)
+{
+	const uint8		*pCursor;
+	uint32			 i = 0;
+
+	//
+	// Jump to the next SYNC_2 char using memchr and check that it follows a SYNC_1 one
+	//
+	while (i + 1 < size)
+	{
+		pCursor = (const uint8*)memchr(pBuffer + i + 1, SBG_ECOM_SYNC_2, size - 1 - i);
+
+		if (!pCursor)
+		{
+			break;
+		}
+
+		i = (uint32)(pCursor - pBuffer) - 1;
+
+		if (pBuffer[i] == SBG_ECOM_SYNC_1)
+		{
+			return i;
+		}
+
+		i++;
+	}
+
+	return size;
+}
+
+//----------------------------------------------------------------------//
+//- Public methods definitions                                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize an empty batch with all its columns set to NULL.
+ *	\param[in]	pBatch									Batch to initialize.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	capacity								Number of values that can be stored in each column.
+ *	\return												SBG_NO_ERROR if the batch has been initialized.<br>
+ *														SBG_INVALID_PARAMETER if this binary log can't be decoded into columns.
+ */
+SbgErrorCode sbgEComLogBatchInit(SbgEComLogBatch *pBatch, SbgEComCmdId logCmd, uint32 capacity)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pBatch)
+	{
+		if (sbgEComLogBatchGetPayloadSize(logCmd) > 0)
+		{
+			memset(pBatch, 0x00, sizeof(SbgEComLogBatch));
+
+			pBatch->logCmd = logCmd;
+			pBatch->capacity = capacity;
+		}
+		else
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Decode payloads stored one after the other at a fixed stride, all of them should be logs of the batch id.
+ *	\param[in]	pBatch									An initialized batch.
+ *	\param[in]	pPayloads								Read only pointer on the first payload.
+ *	\param[in]	payloadSize								Size in bytes of each payload.
+ *	\param[in]	payloadStride							Number of bytes from a payload start to the next one.
+ *	\param[in]	numPayloads								Number of payloads.
+ *	\param[out]	pNumUsed								Number of payloads decoded, can be NULL.
+ *	\return												SBG_NO_ERROR if all payloads have been decoded.<br>
+ *														SBG_BUFFER_OVERFLOW if the columns are full, remaining payloads have been left.<br>
+ *														SBG_INVALID_FRAME if the payload size is too small for this log.
+ */
+SbgErrorCode sbgEComLogBatchAddPayloads(SbgEComLogBatch *pBatch, const void *pPayloads, uint32 payloadSize, uint32 payloadStride, uint32 numPayloads, uint32 *pNumUsed)
+{
+	const uint8		*ppPayloads[SBG_ECOM_LOG_BATCH_GROUP_SIZE];
+	const uint8		*pPayload = (const uint8*)pPayloads;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
+	uint32			 numToDecode = 0;
+	uint32			 numInGroup;
+	uint32			 i;
+
+	if ( (pBatch) && ( (pPayloads) || (numPayloads == 0) ) )
+	{
+		if (payloadSize >= sbgEComLogBatchGetPayloadSize(pBatch->logCmd))
+		{
+			//
+			// Only decode the payloads that fit in the columns
+			//
+			numToDecode = pBatch->capacity - pBatch->numLogs;
+
+			if (numPayloads <= numToDecode)
+			{
+				numToDecode = numPayloads;
+			}
+			else
+			{
+				errorCode = SBG_BUFFER_OVERFLOW;
+			}
+
+			for (i = 0; i < numToDecode; i += numInGroup)
+			{
+				for (numInGroup = 0; (numInGroup < SBG_ECOM_LOG_BATCH_GROUP_SIZE) && (i + numInGroup < numToDecode); numInGroup++)
+				{
+					ppPayloads[numInGroup] = pPayload;
+					pPayload += payloadStride;
+				}
+
+				sbgEComLogBatchDecode(pBatch, ppPayloads, numInGroup);
+			}
+		}
+		else
+		{
+			errorCode = SBG_INVALID_FRAME;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	if (pNumUsed)
+	{
+		*pNumUsed = numToDecode;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Decode the frames returned by sbgEComProtocolReceiveBatch, frames with another id are ignored.
+ *	\param[in]	pBatch									An initialized batch.
+ *	\param[in]	pFrames									Frames to decode.
+ *	\param[in]	numFrames								Number of frames.
+ *	\param[out]	pNumUsed								Number of frames processed, can be NULL.
+ *	\return												SBG_NO_ERROR if all frames have been processed.<br>
+ *														SBG_BUFFER_OVERFLOW if the columns are full, remaining frames have been left.
+ */
+SbgErrorCode sbgEComLogBatchAddFrames(SbgEComLogBatch *pBatch, const SbgEComProtocolFrame *pFrames, uint32 numFrames, uint32 *pNumUsed)
+{
+	const uint8		*ppPayloads[SBG_ECOM_LOG_BATCH_GROUP_SIZE];
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
+	uint32			 minPayloadSize;
+	uint32			 numInGroup = 0;
+	uint32			 i = 0;
+
+	if ( (pBatch) && ( (pFrames) || (numFrames == 0) ) )
+	{
+		minPayloadSize = sbgEComLogBatchGetPayloadSize(pBatch->logCmd);
+
+		for (i = 0; i < numFrames; i++)
+		{
+			if (pFrames[i].cmd == pBatch->logCmd)
+			{
+				if ( (pFrames[i].status == SBG_NO_ERROR) && (pFrames[i].pData) && (pFrames[i].size >= minPayloadSize) )
+				{
+					if (pBatch->numLogs + numInGroup >= pBatch->capacity)
+					{
+						errorCode = SBG_BUFFER_OVERFLOW;
+						break;
+					}
+
+					ppPayloads[numInGroup++] = (const uint8*)pFrames[i].pData;
+
+					if (numInGroup == SBG_ECOM_LOG_BATCH_GROUP_SIZE)
+					{
+						sbgEComLogBatchDecode(pBatch, ppPayloads, numInGroup);
+						numInGroup = 0;
+					}
+				}
+				else
+				{
+					pBatch->numDropped++;
+				}
+			}
+		}
+
+		sbgEComLogBatchDecode(pBatch, ppPayloads, numInGroup);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	if (pNumUsed)
+	{
+		*pNumUsed = i;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Extract the frames from a raw capture of the received bytes and decode the ones with the batch id.
+ *	Frames with an invalid ETX char or CRC are skipped and the capture is resynchronized on the next SYNC chars.
+ *	A frame truncated at the end of the capture isn't consumed so it can be decoded with the next capture chunk.
+ *	\param[in]	pBatch									An initialized batch.
+ *	\param[in]	pCapture								Read only pointer on the captured bytes.
+ *	\param[in]	captureSize								Number of captured bytes.
+ *	\param[out]	pBytesUsed								Number of bytes consumed from the capture, can be NULL.
+ *	\return												SBG_NO_ERROR if the whole capture has been processed.<br>
+ *														SBG_BUFFER_OVERFLOW if the columns are full, remaining bytes have been left.
+ */
+SbgErrorCode sbgEComLogBatchAddCapture(SbgEComLogBatch *pBatch, const void *pCapture, uint32 captureSize, uint32 *pBytesUsed)
+{
+	const uint8		*ppPayloads[SBG_ECOM_LOG_BATCH_GROUP_SIZE];
+	const uint8		*pBuffer = (const uint8*)pCapture;
+	SbgErrorCode	 errorCode = SBG_NO_ERROR;
+	uint32			 minPayloadSize;
+	uint32			 numInGroup = 0;
+	uint32			 index = 0;
+	uint16			 cmd;
+	uint32			 payloadSize;
+	uint16			 frameCrc;
+
+	if ( (pBatch) && ( (pCapture) || (captureSize == 0) ) )
+	{
+		minPayloadSize = sbgEComLogBatchGetPayloadSize(pBatch->logCmd);
+
+		while (index < captureSize)
+		{
+			//
+			// Find the next start of frame
+			//
+			index += sbgEComLogBatchFindSync(pBuffer + index, captureSize - index);
+
+			if (index == captureSize)
+			{
+				//
+				// Keep a trailing SYNC_1 char as it could be the start of a frame in the next chunk
+				//
+				if (pBuffer[captureSize - 1] == SBG_ECOM_SYNC_1)
+				{
+					index--;
+				}
+				break;
+			}
+
+			//
+			// Stop on a truncated frame header, it will be read with the next chunk
+			//
+			if (captureSize - index < 6)
+			{
+				break;
+			}
+
+			cmd = sbgEComLogGetUint16(pBuffer + index + 2);
+			payloadSize = sbgEComLogGetUint16(pBuffer + index + 4);
+
+			if (payloadSize > SBG_ECOM_MAX_PAYLOAD_SIZE)
+			{
+				//
+				// Invalid length field, skip both SYNC chars and resynchronize
+				//
+				index += 2;
+				continue;
+			}
+
+			if (captureSize - index < payloadSize + SBG_ECOM_FRAME_OVERHEAD)
+			{
+				break;
+			}
+
+			//
+			// Check the ETX char first as it is cheap, then the CRC that doesn't include both SYNC chars
+			//
+			if (pBuffer[index + payloadSize + SBG_ECOM_FRAME_OVERHEAD - 1] == SBG_ECOM_ETX)
+			{
+				frameCrc = sbgEComLogGetUint16(pBuffer + index + 6 + payloadSize);
+
+				if (frameCrc != sbgCrc16Compute(pBuffer + index + 2, payloadSize + 4))
+				{
+					if (cmd == pBatch->logCmd)
+					{
+						pBatch->numDropped++;
+					}
+
+					index += 2;
+					continue;
+				}
+			}
+			else
+			{
+				if (cmd == pBatch->logCmd)
+				{
+					pBatch->numDropped++;
+				}
+
+				index += 2;
+				continue;
+			}
+
+			//
+			// Valid frame, only keep the ones with the batch id
+			//
+			if (cmd == pBatch->logCmd)
+			{
+				if (payloadSize >= minPayloadSize)
+				{
+					if (pBatch->numLogs + numInGroup >= pBatch->capacity)
+					{
+						errorCode = SBG_BUFFER_OVERFLOW;
+						break;
+					}
+
+					ppPayloads[numInGroup++] = pBuffer + index + 6;
+
+					if (numInGroup == SBG_ECOM_LOG_BATCH_GROUP_SIZE)
+					{
+						sbgEComLogBatchDecode(pBatch, ppPayloads, numInGroup);
+						numInGroup = 0;
+					}
+				}
+				else
+				{
+					pBatch->numDropped++;
+				}
+			}
+
+			index += payloadSize + SBG_ECOM_FRAME_OVERHEAD;
+		}
+
+		sbgEComLogBatchDecode(pBatch, ppPayloads, numInGroup);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	if (pBytesUsed)
+	{
+		*pBytesUsed = index;
+	}
+
+	return errorCode;
+}
@@ -0,0 +1,217 @@
+/*!
+ *	\file		sbgEComLogBatch.h
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Columnar decoding of many binary logs at once for offline processing.
+ *
+ *	A batch decodes binary logs of a single id straight into caller provided columns,
+ *	one contiguous array per value (time stamps, X accelerometers, Y accelerometers, ...),
+ *	instead of an array of log structures.
+ *	Each value of the n-th decoded log is stored at index n of its column so columns can be
+ *	processed directly by vectorized code such as filters or FFTs.
+ *
+ *	The following binary logs are supported:
+ *		- SBG_ECOM_LOG_IMU_DATA using SbgLogImuColumns.
+ *		- SBG_ECOM_LOG_EKF_EULER using SbgLogEkfEulerColumns.
+ *		- SBG_ECOM_LOG_EKF_NAV using SbgLogEkfNavColumns.
+ *		- SBG_ECOM_LOG_MAG using SbgLogMagColumns.
+ *
+ *	Columns left to NULL are not decoded at all. Logs can be added from packed payloads,
+ *	from frames returned by sbgEComProtocolReceiveBatch or from a raw capture of the serial stream.
+ *
+ *	Columns are written one after the other for groups of logs, so it is best to allocate them with
+ *	a SBG_ECOM_LOG_BATCH_ALIGNMENT bytes alignment and a capacity rounded using SBG_ECOM_LOG_BATCH_ROUND_CAPACITY.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#ifndef __SBG_ECOM_LOG_BATCH_H__
+#define __SBG_ECOM_LOG_BATCH_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sbgCommon.h>
+#include "sbgEComIds.h"
+#include "protocol/sbgEComProtocol.h"
+
+//----------------------------------------------------------------------//
+//- Global definitions                                                 -//
+//----------------------------------------------------------------------//
+#define SBG_ECOM_LOG_BATCH_ALIGNMENT			(64)						/*!< Recommended alignment in bytes of each column, large enough for any SIMD register. */
+#define SBG_ECOM_LOG_BATCH_GROUP_SIZE			(64)						/*!< Number of logs decoded together, column after column. */
+
+/*!
+ * Round a number of logs up so a column of 32 bits values fills a whole number of SBG_ECOM_LOG_BATCH_ALIGNMENT bytes blocks.
+ */
+#define SBG_ECOM_LOG_BATCH_ROUND_CAPACITY(numLogs)	(((numLogs) + SBG_ECOM_LOG_BATCH_ALIGNMENT/4 - 1) & ~(SBG_ECOM_LOG_BATCH_ALIGNMENT/4 - 1))
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Columns of the SBG_ECOM_LOG_IMU_DATA message.
+ */
+typedef struct _SbgLogImuColumns
+{
+	uint32						*pTimeStamp;				/*!< Time in us since the sensor power up. */
+	uint16						*pStatus;					/*!< IMU status bitmask. */
+	float						*pAccelX;					/*!< X accelerometer in m.s^-2. */
+	float						*pAccelY;					/*!< Y accelerometer in m.s^-2. */
+	float						*pAccelZ;					/*!< Z accelerometer in m.s^-2. */
+	float						*pGyroX;					/*!< X gyroscope in rad.s^-1. */
+	float						*pGyroY;					/*!< Y gyroscope in rad.s^-1. */
+	float						*pGyroZ;					/*!< Z gyroscope in rad.s^-1. */
+	float						*pTemperature;				/*!< Internal temperature in C. */
+	float						*pDeltaVelX;				/*!< X delta velocity in m.s^-2. */
+	float						*pDeltaVelY;				/*!< Y delta velocity in m.s^-2. */
+	float						*pDeltaVelZ;				/*!< Z delta velocity in m.s^-2. */
+	float						*pDeltaAngleX;				/*!< X delta angle in rad.s^-1. */
+	float						*pDeltaAngleY;				/*!< Y delta angle in rad.s^-1. */
+	float						*pDeltaAngleZ;				/*!< Z delta angle in rad.s^-1. */
+} SbgLogImuColumns;
+
+/*!
+ * Columns of the SBG_ECOM_LOG_EKF_EULER message.
+ */
+typedef struct _SbgLogEkfEulerColumns
+{
+	uint32						*pTimeStamp;				/*!< Time in us since the sensor power up. */
+	float						*pRoll;						/*!< Roll angle in rad. */
+	float						*pPitch;					/*!< Pitch angle in rad. */
+	float						*pYaw;						/*!< Yaw angle in rad. */
+	float						*pRollStdDev;				/*!< Roll angle 1 sigma standard deviation in rad. */
+	float						*pPitchStdDev;				/*!< Pitch angle 1 sigma standard deviation in rad. */
+	float						*pYawStdDev;				/*!< Yaw angle 1 sigma standard deviation in rad. */
+	uint32						*pStatus;					/*!< EKF solution status bitmask and enum. */
+} SbgLogEkfEulerColumns;
+
+/*!
+ * Columns of the SBG_ECOM_LOG_EKF_NAV message.
+ */
+typedef struct _SbgLogEkfNavColumns
+{
+	uint32						*pTimeStamp;				/*!< Time in us since the sensor power up. */
+	float						*pVelocityN;				/*!< North velocity in m.s^-1. */
+	float						*pVelocityE;				/*!< East velocity in m.s^-1. */
+	float						*pVelocityD;				/*!< Down velocity in m.s^-1. */
+	float						*pVelocityNStdDev;			/*!< North velocity 1 sigma standard deviation in m.s^-1. */
+	float						*pVelocityEStdDev;			/*!< East velocity 1 sigma standard deviation in m.s^-1. */
+	float						*pVelocityDStdDev;			/*!< Down velocity 1 sigma standard deviation in m.s^-1. */
+	double						*pLatitude;					/*!< Latitude in degrees positive North. */
+	double						*pLongitude;				/*!< Longitude in degrees positive East. */
+	double						*pAltitude;					/*!< Altitude above Mean Sea Level in meters. */
+	float						*pUndulation;				/*!< Altitude difference between the geoid and the Ellipsoid in meters. */
+	float						*pLatitudeStdDev;			/*!< Latitude 1 sigma standard deviation in meters. */
+	float						*pLongitudeStdDev;			/*!< Longitude 1 sigma standard deviation in meters. */
+	float						*pAltitudeStdDev;			/*!< Altitude 1 sigma standard deviation in meters. */
+	uint32						*pStatus;					/*!< EKF solution status bitmask and enum. */
+} SbgLogEkfNavColumns;
+
+/*!
+ * Columns of the SBG_ECOM_LOG_MAG message.
+ */
+typedef struct _SbgLogMagColumns
+{
+	uint32						*pTimeStamp;				/*!< Time in us since the sensor power up. */
+	uint16						*pStatus;					/*!< Magnetometer status bitmask. */
+	float						*pMagX;						/*!< X magnetometer in A.U. */
+	float						*pMagY;						/*!< Y magnetometer in A.U. */
+	float						*pMagZ;						/*!< Z magnetometer in A.U. */
+	float						*pAccelX;					/*!< X accelerometer in m.s^-2. */
+	float						*pAccelY;					/*!< Y accelerometer in m.s^-2. */
+	float						*pAccelZ;					/*!< Z accelerometer in m.s^-2. */
+} SbgLogMagColumns;
+
+/*!
+ * Batch of binary logs of a single id decoded into columns.
+ * The columns matching the batch log id should be set after sbgEComLogBatchInit, each one able to store capacity values.
+ */
+typedef struct _SbgEComLogBatch
+{
+	SbgEComCmdId				 logCmd;					/*!< Binary log command id decoded by this batch. */
+	uint32						 capacity;					/*!< Number of values that can be stored in each column. */
+	uint32						 numLogs;					/*!< Number of logs decoded so far, can be set back to 0 to reuse the columns. */
+	uint32						 numDropped;				/*!< Number of logs with this id dropped because of a too small payload or an invalid frame. */
+	union
+	{
+		SbgLogImuColumns		 imu;						/*!< Columns used for the SBG_ECOM_LOG_IMU_DATA message. */
+		SbgLogEkfEulerColumns	 ekfEuler;					/*!< Columns used for the SBG_ECOM_LOG_EKF_EULER message. */
+		SbgLogEkfNavColumns		 ekfNav;					/*!< Columns used for the SBG_ECOM_LOG_EKF_NAV message. */
+		SbgLogMagColumns		 mag;						/*!< Columns used for the SBG_ECOM_LOG_MAG message. */
+	} columns;												/*!< Output columns, NULL columns are not decoded. */
+} SbgEComLogBatch;
+
+//----------------------------------------------------------------------//
+//- Public methods declarations                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize an empty batch with all its columns set to NULL.
+ *	\param[in]	pBatch									Batch to initialize.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	capacity								Number of values that can be stored in each column.
+ *	\return												SBG_NO_ERROR if the batch has been initialized.<br>
+ *														SBG_INVALID_PARAMETER if this binary log can't be decoded into columns.
+ */
+SbgErrorCode sbgEComLogBatchInit(SbgEComLogBatch *pBatch, SbgEComCmdId logCmd, uint32 capacity);
+
+/*!
+ *	Decode payloads stored one after the other at a fixed stride, all of them should be logs of the batch id.
+ *	\param[in]	pBatch									An initialized batch.
+ *	\param[in]	pPayloads								Read only pointer on the first payload.
+ *	\param[in]	payloadSize								Size in bytes of each payload.
+ *	\param[in]	payloadStride							Number of bytes from a payload start to the next one.
+ *	\param[in]	numPayloads								Number of payloads.
+ *	\param[out]	pNumUsed								Number of payloads decoded, can be NULL.
+ *	\return												SBG_NO_ERROR if all payloads have been decoded.<br>
+ *														SBG_BUFFER_OVERFLOW if the columns are full, remaining payloads have been left.<br>
+ *														SBG_INVALID_FRAME if the payload size is too small for this log.
+ */
+SbgErrorCode sbgEComLogBatchAddPayloads(SbgEComLogBatch *pBatch, const void *pPayloads, uint32 payloadSize, uint32 payloadStride, uint32 numPayloads, uint32 *pNumUsed);
+
+/*!
+ *	Decode the frames returned by sbgEComProtocolReceiveBatch, frames with another id are ignored.
+ *	\param[in]	pBatch									An initialized batch.
+ *	\param[in]	pFrames									Frames to decode.
+ *	\param[in]	numFrames								Number of frames.
+ *	\param[out]	pNumUsed								Number of frames processed, can be NULL.
+ *	\return												SBG_NO_ERROR if all frames have been processed.<br>
+ *														SBG_BUFFER_OVERFLOW if the columns are full, remaining frames have been left.
+ */
+SbgErrorCode sbgEComLogBatchAddFrames(SbgEComLogBatch *pBatch, const SbgEComProtocolFrame *pFrames, uint32 numFrames, uint32 *pNumUsed);
+
+/*!
+ *	Extract the frames from a raw capture of the received bytes and decode the ones with the batch id.
+ *	Frames with an invalid ETX char or CRC are skipped and the capture is resynchronized on the next SYNC chars.
+ *	A frame truncated at the end of the capture isn't consumed so it can be decoded with the next capture chunk.
+ *	\param[in]	pBatch									An initialized batch.
+ *	\param[in]	pCapture								Read only pointer on the captured bytes.
+ *	\param[in]	captureSize								Number of captured bytes.
+ *	\param[out]	pBytesUsed								Number of bytes consumed from the capture, can be NULL.
+ *	\return												SBG_NO_ERROR if the whole capture has been processed.<br>
+ *														SBG_BUFFER_OVERFLOW if the columns are full, remaining bytes have been left.
+ */
+SbgErrorCode sbgEComLogBatchAddCapture(SbgEComLogBatch *pBatch, const void *pCapture, uint32 captureSize, uint32 *pBytesUsed);
+
+//----------------------------------------------------------------------//
+//- Footer (close extern C block)                                      -//
+//----------------------------------------------------------------------//
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SBG_ECOM_LOG_BATCH_H__ */
@@ -0,0 +1,630 @@
+#include "sbgEComReader.h"
+
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+
+//----------------------------------------------------------------------//
+//- Private methods declarations                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Lock the reader queue.
+ *	\param[in]	pReader									The reader instance.
+ */
+static void sbgEComReaderLock(SbgEComReader *pReader)
+{
+	sbgPlatformMutexLock(pReader->pLock);
+}
+
+/*!
+ *	Unlock the reader queue.
+ *	\param[in]	pReader									The reader instance.
+ */
+static void sbgEComReaderUnlock(SbgEComReader *pReader)
+{
+	sbgPlatformMutexUnlock(pReader->pLock);
+}
+
+/*!
+ *	Wake up the reader thread if it is waiting for the consumer.
+ *	\param[in]	pReader									The reader instance.
+ */
+static void sbgEComReaderWakeUp(SbgEComReader *pReader)
+{
+	sbgPlatformCondBroadcast(pReader->pNotFullCond);
+}
+
+/*!
+ *	Returns the position in the ring buffer of the oldest or newest queued binary log with a given id.
+ *	The reader lock has to be held.
+ *	\param[in]	pReader									The reader instance.
+ *	\param[in]	logCmd									Binary log command id to look for.
+ *	\param[in]	newest									TRUE to look for the newest binary log or FALSE for the oldest one.
+ *	\return												Position from the oldest queued binary log or depth if none.
+ */
+static uint32 sbgEComReaderFind(const SbgEComReader *pReader, SbgEComCmdId logCmd, bool newest)
+{
+	uint32	i;
+	uint32	position;
+
+	for (i = 0; i < pReader->depth; i++)
+	{
+		position = newest ? (pReader->depth - 1 - i) : i;
+
+		if (pReader->entries[pReader->queue[(pReader->readIndex + position) & SBG_ECOM_LOG_QUEUE_MASK]].logCmd == logCmd)
+		{
+			return position;
+		}
+	}
+
+	return pReader->depth;
+}
+
+/*!
+ *	Remove a queued binary log, the following ones are moved back to keep the queue ordered.
+ *	Only the entries indexes are moved, the binary logs themselves are never copied.
+ *	The reader lock has to be held.
+ *	\param[in]	pReader									The reader instance.
+ *	\param[in]	position								Position from the oldest queued binary log.
+ */
+static void sbgEComReaderRemove(SbgEComReader *pReader, uint32 position)
+{
+	uint16	entry;
+	uint32	logCmd;
+	uint32	i;
+
+	entry = pReader->queue[(pReader->readIndex + position) & SBG_ECOM_LOG_QUEUE_MASK];
+	logCmd = pReader->entries[entry].logCmd;
+
+	if (position == 0)
+	{
+		pReader->readIndex = (pReader->readIndex + 1) & SBG_ECOM_LOG_QUEUE_MASK;
+	}
+	else
+	{
+		for (i = position; i + 1 < pReader->depth; i++)
+		{
+			pReader->queue[(pReader->readIndex + i) & SBG_ECOM_LOG_QUEUE_MASK] = pReader->queue[(pReader->readIndex + i + 1) & SBG_ECOM_LOG_QUEUE_MASK];
+		}
+	}
+
+	//
+	// Give the entry back to the free stack
+	//
+	pReader->depth--;
+	pReader->freeEntries[SBG_ECOM_LOG_QUEUE_SIZE - pReader->depth - 1] = entry;
+
+	if (logCmd < SBG_ECOM_LOG_ECOM_NUM_MESSAGES)
+	{
+		pReader->logStats[logCmd].depth--;
+	}
+}
+
+/*!
+ *	Receive callback used by the reader thread to push each binary log in the queue.
+ *	The receive callback defined before the reader has been started is called first.
+ *	When the queue is full or when the log id has reached its maximum depth, the log id policy is applied.
+ *	\param[in]	pHandle									Valid handle on the sbgECom instance that has called this callback.
+ *	\param[in]	logCmd									Contains the binary received log command id.
+ *	\param[in]	pLogData								Contains the received log data as an union.
+ *	\param[in]	pUserArg								The reader instance.
+ *	\return												SBG_NO_ERROR if the log has been queued or SBG_BUFFER_OVERFLOW if it has been dropped.
+ */
+static SbgErrorCode sbgEComReaderPush(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg)
+{
+	SbgEComReader			*pReader = (SbgEComReader*)pUserArg;
+	SbgEComReaderLogStats	*pLogStats = NULL;
+	SbgEComLogPolicy		 policy = SBG_ECOM_LOG_POLICY_DROP_NEWEST;
+	uint32					 maxDepth = SBG_ECOM_LOG_QUEUE_SIZE;
+	uint32					 logDepth = 0;
+	uint32					 position;
+	uint16					 entry;
+	bool					 hasBlocked = FALSE;
+
+	if (pReader->pPrevReceiveCallback)
+	{
+		pReader->pPrevReceiveCallback(pHandle, logCmd, pLogData, pReader->pPrevUserArg);
+	}
+
+	sbgEComReaderLock(pReader);
+
+	pReader->stats.numLogs++;
+
+	//
+	// Logs from other classes are not tracked and always use the default policy
+	//
+	if ((uint32)logCmd < SBG_ECOM_LOG_ECOM_NUM_MESSAGES)
+	{
+		pLogStats = &pReader->logStats[logCmd];
+		policy = (SbgEComLogPolicy)pReader->policies[logCmd];
+
+		if ( (pReader->maxDepths[logCmd] != 0) && (pReader->maxDepths[logCmd] < SBG_ECOM_LOG_QUEUE_SIZE) )
+		{
+			maxDepth = pReader->maxDepths[logCmd];
+		}
+
+		pLogStats->numLogs++;
+		logDepth = pLogStats->depth;
+	}
+
+	//
+	// Only the newest log is kept: replace the queued one in place so it keeps its place in the queue
+	//
+	if ( (policy == SBG_ECOM_LOG_POLICY_COALESCE) && (logDepth > 0) )
+	{
+		position = sbgEComReaderFind(pReader, logCmd, TRUE);
+		pReader->entries[pReader->queue[(pReader->readIndex + position) & SBG_ECOM_LOG_QUEUE_MASK]].data = *pLogData;
+
+		pLogStats->numCoalesced++;
+		pReader->stats.numCoalesced++;
+
+		sbgEComReaderUnlock(pReader);
+		return SBG_NO_ERROR;
+	}
+
+	//
+	// Apply the policy until there is room for the new log
+	//
+	while ( (pReader->depth >= SBG_ECOM_LOG_QUEUE_SIZE) || (logDepth >= maxDepth) )
+	{
+		if ( (policy == SBG_ECOM_LOG_POLICY_DROP_OLDEST) && (logDepth > 0) )
+		{
+			//
+			// Never drop a log with another id, a full queue with no log of this id drops the new one
+			//
+			sbgEComReaderRemove(pReader, sbgEComReaderFind(pReader, logCmd, FALSE));
+			logDepth--;
+		}
+		else if ( (policy == SBG_ECOM_LOG_POLICY_BLOCK) && (SBG_ATOMIC_LOAD_ACQUIRE(pReader->stopRequested) == 0) )
+		{
+			if (!hasBlocked)
+			{
+				pLogStats->numBlocked++;
+				hasBlocked = TRUE;
+			}
+
+			//
+			// Wait for the consumer, a stop request wakes the reader thread up and drops the log
+			// The handle read lock is kept so the interface isn't read meanwhile, commands waited by other threads fail instead of waiting for an answer that can't be received
+			//
+			sbgEComSetDispatchBlocked(pHandle, TRUE);
+			sbgPlatformCondWait(pReader->pNotFullCond, pReader->pLock, SBG_ECOM_READER_WAIT_TIME_OUT);
+			sbgEComSetDispatchBlocked(pHandle, FALSE);
+			logDepth = pLogStats->depth;
+			continue;
+		}
+		else
+		{
+			if (pLogStats)
+			{
+				pLogStats->numDropped++;
+			}
+
+			pReader->stats.numOverruns++;
+
+			sbgEComReaderUnlock(pReader);
+			return SBG_BUFFER_OVERFLOW;
+		}
+
+		if (pLogStats)
+		{
+			pLogStats->numDropped++;
+		}
+
+		pReader->stats.numOverruns++;
+	}
+
+	//
+	// Take a free entry, fill it and append its index to the queue
+	//
+	entry = pReader->freeEntries[SBG_ECOM_LOG_QUEUE_SIZE - pReader->depth - 1];
+
+	pReader->entries[entry].logCmd = logCmd;
+	pReader->entries[entry].data = *pLogData;
+
+	pReader->queue[(pReader->readIndex + pReader->depth) & SBG_ECOM_LOG_QUEUE_MASK] = entry;
+	pReader->depth++;
+
+	if (pLogStats)
+	{
+		pLogStats->depth++;
+	}
+
+	if (pReader->depth > pReader->stats.maxDepth)
+	{
+		pReader->stats.maxDepth = pReader->depth;
+	}
+
+	sbgEComReaderUnlock(pReader);
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Reader thread main loop that handles all incoming frames until a stop is requested.
+ *	\param[in]	pReader									The reader instance.
+ */
+static void sbgEComReaderRun(SbgEComReader *pReader)
+{
+	SbgInterface	*pInterface = pReader->pHandle->protocolHandle.pLinkedInterface;
+	SbgErrorCode	 errorCode;
+	uint32			 numErrors = 0;
+
+	while (SBG_ATOMIC_LOAD_ACQUIRE(pReader->stopRequested) == 0)
+	{
+		//
+		// Handle all the received frames and wait for new data once the interface is drained
+		//
+		if (sbgEComHandle(pReader->pHandle) == SBG_NOT_READY)
+		{
+			errorCode = sbgInterfaceWaitReadable(pInterface, SBG_ECOM_READER_WAIT_TIME_OUT);
+
+			if ( (errorCode == SBG_NO_ERROR) || (errorCode == SBG_TIME_OUT) )
+			{
+				numErrors = 0;
+			}
+			else
+			{
+				//
+				// A failing interface returns at once, back off instead of spinning and give up if it doesn't recover
+				//
+				numErrors++;
+
+				if (numErrors >= SBG_ECOM_READER_MAX_WAIT_ERRORS)
+				{
+					SBG_ATOMIC_STORE_RELEASE(pReader->exitError, errorCode);
+					break;
+				}
+
+				sbgSleep(SBG_ECOM_READER_WAIT_TIME_OUT);
+			}
+		}
+	}
+}
+
+/*!
+ *	Reader thread entry point.
+ *	\param[in]	pArg									The reader instance.
+ */
+static void sbgEComReaderThread(void *pArg)
+{
+	sbgEComReaderRun((SbgEComReader*)pArg);
+}
+
+//----------------------------------------------------------------------//
+//- Public methods definitions                                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize a reader with an empty queue, all binary logs use the SBG_ECOM_LOG_POLICY_DROP_NEWEST policy without any maximum depth.
+ *	The reader lock is created here and is released by sbgEComReaderClose.
+ *	\param[in]	pReader									Reader instance to initialize.
+ *	\return												SBG_NO_ERROR if the reader has been initialized.
+ */
+SbgErrorCode sbgEComReaderInit(SbgEComReader *pReader)
+{
+	SbgErrorCode	errorCode = SBG_NO_ERROR;
+	uint32			i;
+
+	if (pReader)
+	{
+		memset(pReader, 0x00, sizeof(SbgEComReader));
+
+		for (i = 0; i < SBG_ECOM_LOG_QUEUE_SIZE; i++)
+		{
+			pReader->freeEntries[i] = (uint16)i;
+		}
+
+		//
+		// Create the lock shared by the reader thread and the consumer, it is always taken even if the reader isn't running
+		//
+		pReader->pLock = sbgPlatformMutexCreate();
+		pReader->pNotFullCond = sbgPlatformCondCreate();
+
+		if ( (pReader->pLock == NULL) || (pReader->pNotFullCond == NULL) )
+		{
+			sbgPlatformMutexDestroy(pReader->pLock);
+			sbgPlatformCondDestroy(pReader->pNotFullCond);
+			pReader->pLock = NULL;
+			pReader->pNotFullCond = NULL;
+
+			errorCode = SBG_MALLOC_FAILED;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Define the policy applied to a binary log id when the consumer falls behind.
+ *	It can be called before the reader is started or while it is running.
+ *	\param[in]	pReader									An initialized reader instance.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	policy									Policy applied when the queue is full or when this log id has reached its maximum depth.
+ *	\param[in]	maxDepth								Maximum number of binary logs of this id that can be queued or 0 for no limit.
+ *	\return												SBG_NO_ERROR if the policy has been defined.<br>
+ *														SBG_INVALID_PARAMETER if logCmd or policy are invalid.
+ */
+SbgErrorCode sbgEComReaderSetPolicy(SbgEComReader *pReader, SbgEComCmdId logCmd, SbgEComLogPolicy policy, uint32 maxDepth)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pReader)
+	{
+		if ( ((uint32)logCmd < SBG_ECOM_LOG_ECOM_NUM_MESSAGES) && ((uint32)policy <= SBG_ECOM_LOG_POLICY_BLOCK) )
+		{
+			sbgEComReaderLock(pReader);
+
+			pReader->policies[logCmd] = (uint8)policy;
+			pReader->maxDepths[logCmd] = (uint16)((maxDepth < SBG_ECOM_LOG_QUEUE_SIZE) ? maxDepth : 0);
+
+			//
+			// A blocked reader thread may now be allowed to go on
+			//
+			sbgEComReaderWakeUp(pReader);
+
+			sbgEComReaderUnlock(pReader);
+		}
+		else
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Start a reader thread that continuously handles incoming frames and stores received binary logs in the queue.
+ *	The reader should have been initialized using sbgEComReaderInit, logs left in the queue by a previous run are kept.
+ *	The sbgECom receive callback is used by the reader and should not be modified while it is running.
+ *	A receive callback defined before is kept and called by the reader thread before each binary log is queued, it is restored by sbgEComReaderStop.
+ *	\param[in]	pReader									Reader instance to start.
+ *	\param[in]	pHandle									A valid and initialized sbgECom handle.
+ *	\return												SBG_NO_ERROR if the reader thread has been started.
+ */
+SbgErrorCode sbgEComReaderStart(SbgEComReader *pReader, SbgEComHandle *pHandle)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	//
+	// Check input parameters
+	//
+	if ( (pReader) && (pHandle) )
+	{
+		if (SBG_ATOMIC_LOAD_ACQUIRE(pReader->isRunning) == 0)
+		{
+			pReader->pHandle = pHandle;
+			pReader->stopRequested = 0;
+			pReader->exitError = SBG_NO_ERROR;
+
+			//
+			// All binary logs are now forwarded to the queue, the current receive callback is chained
+			//
+			pReader->pPrevReceiveCallback = pHandle->pReceiveCallback;
+			pReader->pPrevUserArg = pHandle->pUserArg;
+
+			sbgEComSetReceiveCallback(pHandle, sbgEComReaderPush, pReader);
+
+			SBG_ATOMIC_STORE_RELEASE(pReader->isRunning, 1);
+
+			//
+			// Create the reader thread
+			//
+			pReader->pThread = sbgPlatformThreadCreate(sbgEComReaderThread, pReader);
+
+			if (pReader->pThread == NULL)
+			{
+				SBG_ATOMIC_STORE_RELEASE(pReader->isRunning, 0);
+				sbgEComSetReceiveCallback(pHandle, pReader->pPrevReceiveCallback, pReader->pPrevUserArg);
+
+				errorCode = SBG_ERROR;
+			}
+		}
+		else
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Stop the reader thread and wait until it has exited.
+ *	Binary logs still stored in the queue can be popped after the reader has been stopped.
+ *	\param[in]	pReader									Reader instance to stop.
+ *	\return												SBG_NO_ERROR if the reader thread has been stopped.
+ */
+SbgErrorCode sbgEComReaderStop(SbgEComReader *pReader)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pReader)
+	{
+		if (SBG_ATOMIC_LOAD_ACQUIRE(pReader->isRunning) != 0)
+		{
+			//
+			// Ask the reader thread to exit, wake it up if it is blocked by a full queue and wait for it
+			//
+			sbgEComReaderLock(pReader);
+			SBG_ATOMIC_STORE_RELEASE(pReader->stopRequested, 1);
+			sbgEComReaderWakeUp(pReader);
+			sbgEComReaderUnlock(pReader);
+
+			sbgPlatformThreadJoin(pReader->pThread);
+			pReader->pThread = NULL;
+
+			SBG_ATOMIC_STORE_RELEASE(pReader->isRunning, 0);
+
+			//
+			// The sbgECom handle can be used again from the caller thread with its previous receive callback
+			//
+			sbgEComSetReceiveCallback(pReader->pHandle, pReader->pPrevReceiveCallback, pReader->pPrevUserArg);
+		}
+		else
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Stop the reader thread if it is running and release the reader lock.
+ *	Binary logs still stored in the queue are discarded and the reader has to be initialized again before being used.
+ *	\param[in]	pReader									Reader instance to close.
+ *	\return												SBG_NO_ERROR if the reader has been closed.
+ */
+SbgErrorCode sbgEComReaderClose(SbgEComReader *pReader)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if (pReader)
+	{
+		if (SBG_ATOMIC_LOAD_ACQUIRE(pReader->isRunning) != 0)
+		{
+			errorCode = sbgEComReaderStop(pReader);
+		}
+
+		sbgPlatformMutexDestroy(pReader->pLock);
+		sbgPlatformCondDestroy(pReader->pNotFullCond);
+		pReader->pLock = NULL;
+		pReader->pNotFullCond = NULL;
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Pop the oldest binary log from the reader queue.
+ *	This method should always be called from the same consumer thread.
+ *	\param[in]	pReader									A started reader instance.
+ *	\param[out]	pLogCmd									Binary log command id.
+ *	\param[out]	pLogData								Parsed binary log data.
+ *	\return												SBG_NO_ERROR if a binary log has been returned or SBG_NOT_READY if the queue is empty.<br>
+ *														The interface error if the queue is empty and the reader thread has exited because of it.
+ */
+SbgErrorCode sbgEComReaderPop(SbgEComReader *pReader, SbgEComCmdId *pLogCmd, SbgBinaryLogData *pLogData)
+{
+	SbgErrorCode	errorCode = SBG_NO_ERROR;
+	uint16			entry;
+
+	if ( (pReader) && (pLogCmd) && (pLogData) )
+	{
+		sbgEComReaderLock(pReader);
+
+		if (pReader->depth > 0)
+		{
+			//
+			// Copy the oldest entry and then give it back to the reader thread
+			//
+			entry = pReader->queue[pReader->readIndex];
+
+			*pLogCmd = pReader->entries[entry].logCmd;
+			*pLogData = pReader->entries[entry].data;
+
+			sbgEComReaderRemove(pReader, 0);
+
+			//
+			// The reader thread may be waiting for room in the queue
+			//
+			sbgEComReaderWakeUp(pReader);
+		}
+		else if (SBG_ATOMIC_LOAD_ACQUIRE(pReader->exitError) != SBG_NO_ERROR)
+		{
+			errorCode = (SbgErrorCode)SBG_ATOMIC_LOAD_ACQUIRE(pReader->exitError);
+		}
+		else
+		{
+			errorCode = SBG_NOT_READY;
+		}
+
+		sbgEComReaderUnlock(pReader);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Returns the reader queue statistics.
+ *	\param[in]	pReader									A reader instance.
+ *	\param[out]	pStats									Returned statistics.
+ *	\return												SBG_NO_ERROR if the statistics have been returned.
+ */
+SbgErrorCode sbgEComReaderGetStats(SbgEComReader *pReader, SbgEComReaderStats *pStats)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if ( (pReader) && (pStats) )
+	{
+		sbgEComReaderLock(pReader);
+		*pStats = pReader->stats;
+		sbgEComReaderUnlock(pReader);
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+/*!
+ *	Returns the counters of a binary log id.
+ *	\param[in]	pReader									A reader instance.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[out]	pStats									Returned counters.
+ *	\return												SBG_NO_ERROR if the counters have been returned.<br>
+ *														SBG_INVALID_PARAMETER if logCmd is invalid.
+ */
+SbgErrorCode sbgEComReaderGetLogStats(SbgEComReader *pReader, SbgEComCmdId logCmd, SbgEComReaderLogStats *pStats)
+{
+	SbgErrorCode errorCode = SBG_NO_ERROR;
+
+	if ( (pReader) && (pStats) )
+	{
+		if ((uint32)logCmd < SBG_ECOM_LOG_ECOM_NUM_MESSAGES)
+		{
+			sbgEComReaderLock(pReader);
+			*pStats = pReader->logStats[logCmd];
+			sbgEComReaderUnlock(pReader);
+		}
+		else
+		{
+			errorCode = SBG_INVALID_PARAMETER;
+		}
+	}
+	else
+	{
+		errorCode = SBG_NULL_POINTER;
+	}
+
+	return errorCode;
+}
+
+#endif
@@ -0,0 +1,240 @@
+/*!
+ *	\file		sbgEComReader.h
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Optional reader thread that decodes incoming binary logs into a queue.
+ *
+ *	The reader thread calls sbgEComHandle continuously and stores each received binary log
+ *	in a preallocated queue shared with a single consumer thread.
+ *	The application then pops the logs from its own thread at its own pace, so a slow log
+ *	processing doesn't prevent the interface from being read anymore.
+ *
+ *	When the consumer falls behind, what happens to a new binary log is defined per log id by a policy:
+ *		- SBG_ECOM_LOG_POLICY_DROP_NEWEST: the new log is dropped (default).
+ *		- SBG_ECOM_LOG_POLICY_DROP_OLDEST: the oldest queued log with the same id is dropped.
+ *		- SBG_ECOM_LOG_POLICY_COALESCE: only the newest log is kept, it replaces the queued one.
+ *		- SBG_ECOM_LOG_POLICY_BLOCK: the reader thread waits until the consumer has made room.
+ *
+ *	A maximum depth can be given to each log id so high rate logs such as SBG_ECOM_LOG_IMU_DATA can't
+ *	fill the whole queue and push out low rate but critical logs such as SBG_ECOM_LOG_STATUS or SBG_ECOM_LOG_UTC_TIME.
+ *
+ *	While the reader is running, blocking commands can still be sent from other threads as their answers
+ *	are copied in the waiting threads buffers by the reader thread.
+ *	The SBG_ECOM_LOG_POLICY_BLOCK policy is the exception: the reader thread waits with the sbgECom handle
+ *	read lock held, so nothing is received and such commands fail with SBG_NOT_READY until the consumer
+ *	has made room. The consumer thread must never wait for a command answer while the reader is blocked.
+ *	sbgEComReaderPop should always be called from the same consumer thread.
+ *
+ *	If the interface keeps failing, the reader thread backs off and exits after SBG_ECOM_READER_MAX_WAIT_ERRORS
+ *	consecutive errors. sbgEComReaderPop then returns this error once the queue has been drained.
+ *
+ *	The reader is only available if the library is built with SBG_CONFIG_MULTI_THREAD enabled.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#ifndef __SBG_ECOM_READER_H__
+#define __SBG_ECOM_READER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sbgECom.h"
+
+//
+// The reader needs the threads and locks of the platform layer
+//
+#if SBG_CONFIG_MULTI_THREAD == ENABLE
+
+//----------------------------------------------------------------------//
+//- Global definitions                                                 -//
+//----------------------------------------------------------------------//
+#ifndef SBG_ECOM_LOG_QUEUE_SIZE
+	#define SBG_ECOM_LOG_QUEUE_SIZE				(64)						/*!< Number of binary logs that can be stored in the reader queue (should be a power of two up to 65536). */
+#endif
+
+#define SBG_ECOM_LOG_QUEUE_MASK					(SBG_ECOM_LOG_QUEUE_SIZE-1)	/*!< Mask used to wrap the reader queue indexes. */
+
+#define SBG_ECOM_READER_WAIT_TIME_OUT			(10)						/*!< Time out in ms used by the reader thread to wait for incoming data. */
+#define SBG_ECOM_READER_MAX_WAIT_ERRORS			(10)						/*!< Number of consecutive interface errors after which the reader thread exits. */
+
+//----------------------------------------------------------------------//
+//- Enums definitions                                                  -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Policy applied to a new binary log when the queue is full or when its log id has reached its maximum depth.
+ */
+typedef enum _SbgEComLogPolicy
+{
+	SBG_ECOM_LOG_POLICY_DROP_NEWEST = 0,								/*!< The new binary log is dropped. */
+	SBG_ECOM_LOG_POLICY_DROP_OLDEST = 1,								/*!< The oldest queued binary log with the same id is dropped to make room. */
+	SBG_ECOM_LOG_POLICY_COALESCE = 2,									/*!< Only the newest binary log is kept: a queued one with the same id is replaced in place. */
+	SBG_ECOM_LOG_POLICY_BLOCK = 3										/*!< The reader thread waits until the consumer has made room, the interface isn't read meanwhile. */
+																		/*!< Commands waited from other threads fail with SBG_NOT_READY while the reader thread is blocked. */
+} SbgEComLogPolicy;
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+/*!
+ * Binary log stored in the reader queue, tagged with its log id.
+ */
+typedef struct _SbgEComLogQueueEntry
+{
+	SbgEComCmdId				 logCmd;					/*!< Binary log command id. */
+	SbgBinaryLogData			 data;						/*!< Parsed binary log data. */
+} SbgEComLogQueueEntry;
+
+/*!
+ * Statistics about the reader queue usage.
+ */
+typedef struct _SbgEComReaderStats
+{
+	uint32						 numLogs;					/*!< Number of binary logs pushed in the queue. */
+	uint32						 numOverruns;				/*!< Number of binary logs dropped because the queue was full. */
+	uint32						 numCoalesced;				/*!< Number of queued binary logs replaced by a newer one. */
+	uint32						 maxDepth;					/*!< Maximum number of binary logs that have been waiting in the queue. */
+} SbgEComReaderStats;
+
+/*!
+ * Policy and counters of a binary log id.
+ */
+typedef struct _SbgEComReaderLogStats
+{
+	uint32						 numLogs;					/*!< Number of binary logs received by the reader thread. */
+	uint32						 numDropped;				/*!< Number of binary logs dropped, either new or oldest ones. */
+	uint32						 numCoalesced;				/*!< Number of queued binary logs replaced by a newer one. */
+	uint32						 numBlocked;				/*!< Number of times the reader thread had to wait for the consumer. */
+	uint32						 depth;						/*!< Number of binary logs currently waiting in the queue. */
+} SbgEComReaderLogStats;
+
+/*!
+ * Reader thread and its queue, this structure is quite large and should not be allocated on the stack.
+ */
+typedef struct _SbgEComReader
+{
+	SbgEComHandle				*pHandle;					/*!< sbgECom handle read by the reader thread. */
+	SbgEComLogQueueEntry		 entries[SBG_ECOM_LOG_QUEUE_SIZE];	/*!< Preallocated binary logs storage. */
+	uint16						 queue[SBG_ECOM_LOG_QUEUE_SIZE];	/*!< Ring buffer of the queued entries indexes, from the oldest to the newest. */
+	uint16						 freeEntries[SBG_ECOM_LOG_QUEUE_SIZE];	/*!< Stack of the unused entries indexes. */
+	uint32						 readIndex;					/*!< Position of the oldest queued binary log in the ring buffer. */
+	uint32						 depth;						/*!< Number of queued binary logs. */
+	uint8						 policies[SBG_ECOM_LOG_ECOM_NUM_MESSAGES];	/*!< Policy of each binary log id. */
+	uint16						 maxDepths[SBG_ECOM_LOG_ECOM_NUM_MESSAGES];	/*!< Maximum number of queued binary logs of each id. */
+	SbgEComReaderLogStats		 logStats[SBG_ECOM_LOG_ECOM_NUM_MESSAGES];	/*!< Counters of each binary log id. */
+	SbgEComReaderStats			 stats;						/*!< Queue statistics. */
+	SbgEComReceiveFunc			 pPrevReceiveCallback;		/*!< Receive callback defined before the reader has been started, called for each binary log. */
+	void						*pPrevUserArg;				/*!< User argument of the previous receive callback. */
+	volatile uint32				 stopRequested;				/*!< Set to non zero to ask the reader thread to exit. */
+	volatile uint32				 isRunning;					/*!< Non zero if the reader thread has been started. */
+	volatile uint32				 exitError;					/*!< Error that has made the reader thread exit on its own or SBG_NO_ERROR. */
+	SbgPlatformMutex			*pLock;						/*!< Protects the queue and its statistics. */
+	SbgPlatformCond				*pNotFullCond;				/*!< Signaled each time a binary log is popped. */
+	SbgPlatformThread			*pThread;					/*!< Reader thread handle. */
+} SbgEComReader;
+
+//----------------------------------------------------------------------//
+//- Public methods declarations                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize a reader with an empty queue, all binary logs use the SBG_ECOM_LOG_POLICY_DROP_NEWEST policy without any maximum depth.
+ *	The reader lock is created here and is released by sbgEComReaderClose.
+ *	\param[in]	pReader									Reader instance to initialize.
+ *	\return												SBG_NO_ERROR if the reader has been initialized.<br>
+ *														SBG_MALLOC_FAILED if the reader lock couldn't be created.
+ */
+SbgErrorCode sbgEComReaderInit(SbgEComReader *pReader);
+
+/*!
+ *	Define the policy applied to a binary log id when the consumer falls behind.
+ *	It can be called before the reader is started or while it is running.
+ *	\param[in]	pReader									An initialized reader instance.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[in]	policy									Policy applied when the queue is full or when this log id has reached its maximum depth.
+ *	\param[in]	maxDepth								Maximum number of binary logs of this id that can be queued or 0 for no limit.
+ *	\return												SBG_NO_ERROR if the policy has been defined.<br>
+ *														SBG_INVALID_PARAMETER if logCmd or policy are invalid.
+ */
+SbgErrorCode sbgEComReaderSetPolicy(SbgEComReader *pReader, SbgEComCmdId logCmd, SbgEComLogPolicy policy, uint32 maxDepth);
+
+/*!
+ *	Start a reader thread that continuously handles incoming frames and stores received binary logs in the queue.
+ *	The reader should have been initialized using sbgEComReaderInit, logs left in the queue by a previous run are kept.
+ *	The sbgECom receive callback is used by the reader and should not be modified while it is running.
+ *	A receive callback defined before is kept and called by the reader thread before each binary log is queued, it is restored by sbgEComReaderStop.
+ *	\param[in]	pReader									Reader instance to start.
+ *	\param[in]	pHandle									A valid and initialized sbgECom handle.
+ *	\return												SBG_NO_ERROR if the reader thread has been started.
+ */
+SbgErrorCode sbgEComReaderStart(SbgEComReader *pReader, SbgEComHandle *pHandle);
+
+/*!
+ *	Stop the reader thread and wait until it has exited.
+ *	Binary logs still stored in the queue can be popped after the reader has been stopped.
+ *	\param[in]	pReader									Reader instance to stop.
+ *	\return												SBG_NO_ERROR if the reader thread has been stopped.
+ */
+SbgErrorCode sbgEComReaderStop(SbgEComReader *pReader);
+
+/*!
+ *	Stop the reader thread if it is running and release the reader lock.
+ *	Binary logs still stored in the queue are discarded and the reader has to be initialized again before being used.
+ *	\param[in]	pReader									Reader instance to close.
+ *	\return												SBG_NO_ERROR if the reader has been closed.
+ */
+SbgErrorCode sbgEComReaderClose(SbgEComReader *pReader);
+
+/*!
+ *	Pop the oldest binary log from the reader queue.
+ *	This method should always be called from the same consumer thread.
+ *	\param[in]	pReader									A started reader instance.
+ *	\param[out]	pLogCmd									Binary log command id.
+ *	\param[out]	pLogData								Parsed binary log data.
+ *	\return												SBG_NO_ERROR if a binary log has been returned or SBG_NOT_READY if the queue is empty.<br>
+ *														The interface error if the queue is empty and the reader thread has exited because of it.
+ */
+SbgErrorCode sbgEComReaderPop(SbgEComReader *pReader, SbgEComCmdId *pLogCmd, SbgBinaryLogData *pLogData);
+
+/*!
+ *	Returns the reader queue statistics.
+ *	\param[in]	pReader									A reader instance.
+ *	\param[out]	pStats									Returned statistics.
+ *	\return												SBG_NO_ERROR if the statistics have been returned.
+ */
+SbgErrorCode sbgEComReaderGetStats(SbgEComReader *pReader, SbgEComReaderStats *pStats);
+
+/*!
+ *	Returns the counters of a binary log id.
+ *	\param[in]	pReader									A reader instance.
+ *	\param[in]	logCmd									Binary log command id such as SBG_ECOM_LOG_IMU_DATA.
+ *	\param[out]	pStats									Returned counters.
+ *	\return												SBG_NO_ERROR if the counters have been returned.<br>
+ *														SBG_INVALID_PARAMETER if logCmd is invalid.
+ */
+SbgErrorCode sbgEComReaderGetLogStats(SbgEComReader *pReader, SbgEComCmdId logCmd, SbgEComReaderLogStats *pStats);
+
+//----------------------------------------------------------------------//
+//- Footer (close extern C block)                                      -//
+//----------------------------------------------------------------------//
+#endif	/* SBG_CONFIG_MULTI_THREAD == ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SBG_ECOM_READER_H__ */
@@ -0,0 +1,31 @@
+#!/bin/sh
+# This script is used to build and run the sbgECom tests on unix systems.
+# The sbgECom library should have been built first with the multi-thread support:
+# projects/unix/build.sh -DSBG_CONFIG_MULTI_THREAD=ENABLE
+# Example: ./build.sh
+
+# Define the GCC options, they have to match the library configuration
+gccOptions="-I ../common/ -I ../src/ -Wall -DSBG_CONFIG_MULTI_THREAD=ENABLE"
+gccLibs="-L../ -lSbgECom -lpthread -lm"
+
+# Build all the tests
+gcc $gccOptions sbgEComDispatchTest.c sbgEComTestDevice.c $gccLibs -o sbgEComDispatchTest || exit 1
+gcc $gccOptions sbgEComAsyncCmdTest.c sbgEComTestDevice.c $gccLibs -o sbgEComAsyncCmdTest || exit 1
+gcc $gccOptions sbgEComCrcTest.c $gccLibs -o sbgEComCrcTest || exit 1
+gcc $gccOptions sbgEComReaderTest.c sbgEComTestDevice.c $gccLibs -o sbgEComReaderTest || exit 1
+gcc $gccOptions sbgEComBroadcastTest.c $gccLibs -o sbgEComBroadcastTest || exit 1
+gcc $gccOptions sbgEComSchemaTest.c $gccLibs -o sbgEComSchemaTest || exit 1
+gcc $gccOptions -DSBG_ECOM_LOG_PORTABLE_READS sbgEComSchemaTest.c ../src/binaryLogs/*.c $gccLibs -o sbgEComSchemaPortableTest || exit 1
+gcc $gccOptions sbgEComLogBatchTest.c sbgEComTestDevice.c $gccLibs -o sbgEComLogBatchTest || exit 1
+gcc $gccOptions sbgEComLatencyTest.c $gccLibs -o sbgEComLatencyTest || exit 1
+
+# Run all the tests, the script fails as soon as one test fails
+./sbgEComDispatchTest || exit 1
+./sbgEComAsyncCmdTest || exit 1
+./sbgEComCrcTest || exit 1
+./sbgEComReaderTest || exit 1
+./sbgEComBroadcastTest || exit 1
+./sbgEComSchemaTest || exit 1
+./sbgEComSchemaPortableTest || exit 1
+./sbgEComLogBatchTest || exit 1
+./sbgEComLatencyTest || exit 1
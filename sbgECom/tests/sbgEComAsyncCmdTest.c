@@ -0,0 +1,248 @@
+/*!
+ *	\file		sbgEComAsyncCmdTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Regression tests of the asynchronous commands engine.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include "sbgEComTestDevice.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_CMD					SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO)	/*!< Command used by the tests. */
+#define TEST_CANCELLED_TIME_OUT		(30)								/*!< Time out in ms of the cancelled command. */
+#define TEST_TIME_OUT				(500)								/*!< Time out in ms of the other commands. */
+
+/*!
+ * Completion of an asynchronous command recorded by the test callback.
+ */
+typedef struct _TestCompletion
+{
+	uint32			numCalls;											/*!< Number of times the callback has been called. */
+	SbgErrorCode	result;												/*!< Last command result. */
+	uint8			answer[4];											/*!< Last received answer. */
+	uint32			answerSize;											/*!< Last received answer size. */
+} TestCompletion;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static SbgEComTestDevice	gDevice;
+static SbgEComHandle		gHandle;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Asynchronous command callback that records the completion.
+ *	\param[in]	pHandle									The sbgECom handle.
+ *	\param[in]	ticket									Ticket of the completed command.
+ *	\param[in]	result									Command result.
+ *	\param[in]	pAnswer									Received answer.
+ *	\param[in]	answerSize								Answer size in bytes.
+ *	\param[in]	pUserArg								The TestCompletion to fill.
+ */
+static void testOnCompleted(SbgEComHandle *pHandle, uint32 ticket, SbgErrorCode result, const void *pAnswer, uint32 answerSize, void *pUserArg)
+{
+	TestCompletion	*pCompletion = (TestCompletion*)pUserArg;
+
+	SBG_UNUSED_PARAMETER(pHandle);
+	SBG_UNUSED_PARAMETER(ticket);
+
+	pCompletion->numCalls++;
+	pCompletion->result = result;
+	pCompletion->answerSize = answerSize;
+
+	if ( (pAnswer) && (answerSize <= sizeof(pCompletion->answer)) )
+	{
+		memcpy(pCompletion->answer, pAnswer, answerSize);
+	}
+}
+
+/*!
+ *	Submit a get command that is completed by an answer.
+ *	\param[in]	timeOut									Time out in ms of each trial.
+ *	\param[in]	pCompletion								Completion filled by the callback.
+ *	\param[out]	pTicket									Returned ticket.
+ *	\return												SBG_NO_ERROR if the command has been submitted.
+ */
+static SbgErrorCode testSubmit(uint32 timeOut, TestCompletion *pCompletion, uint32 *pTicket)
+{
+	memset(pCompletion, 0x00, sizeof(TestCompletion));
+
+	return sbgEComCmdSubmitEx(&gHandle, TEST_CMD, SBG_ECOM_ASYNC_CMD_WAIT_ANSWER, NULL, 0, NULL, 0, timeOut, testOnCompleted, pCompletion, pTicket);
+}
+
+/*!
+ *	Initialize the simulated device, it never answers on its own.
+ */
+static void testSetUp(void)
+{
+	sbgEComTestDeviceInit(&gDevice, SBG_ECOM_MAX_BUFFER_SIZE);
+	sbgEComInit(&gHandle, &gDevice.interface);
+}
+
+/*!
+ *	Print a test result.
+ *	\param[in]	pName									Test name.
+ *	\param[in]	passed									TRUE if the test has passed.
+ *	\return												passed.
+ */
+static bool testReport(const char *pName, bool passed)
+{
+	printf("%-40s %s\n", pName, passed ? "passed" : "FAILED");
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	A late answer to a cancelled command must be dropped instead of completing the next command with the same id.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testLateAnswerOfCancelledCmd(void)
+{
+	TestCompletion	cancelled;
+	TestCompletion	next;
+	uint32			cancelledTicket;
+	uint32			nextTicket;
+	bool			passed = TRUE;
+
+	testSetUp();
+
+	passed &= (testSubmit(TEST_CANCELLED_TIME_OUT, &cancelled, &cancelledTicket) == SBG_NO_ERROR);
+	passed &= (gDevice.numFramesWritten == 1);
+	passed &= (sbgEComCmdCancel(&gHandle, cancelledTicket) == SBG_NO_ERROR);
+
+	//
+	// The next command has to wait for the cancelled one to be answered
+	//
+	passed &= (testSubmit(TEST_TIME_OUT, &next, &nextTicket) == SBG_NO_ERROR);
+	passed &= (gDevice.numFramesWritten == 1);
+
+	sbgEComTestDeviceSendFrame(&gDevice, TEST_CMD, "late", 4);
+	sbgEComHandle(&gHandle);
+
+	passed &= (cancelled.numCalls == 0) && (next.numCalls == 0);
+	passed &= (gDevice.numFramesWritten == 2);
+
+	//
+	// Only the answer sent after the next command completes it
+	//
+	sbgEComTestDeviceSendFrame(&gDevice, TEST_CMD, "next", 4);
+	sbgEComHandle(&gHandle);
+
+	passed &= (next.numCalls == 1) && (next.result == SBG_NO_ERROR) && (next.answerSize == 4) && (memcmp(next.answer, "next", 4) == 0);
+	passed &= (cancelled.numCalls == 0);
+
+	sbgEComClose(&gHandle);
+
+	return testReport("late answer of a cancelled command", passed);
+}
+
+/*!
+ *	The slot of a cancelled command that is never answered is released once its time out has expired.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCancelledCmdTimeOut(void)
+{
+	TestCompletion	cancelled;
+	TestCompletion	next;
+	uint32			cancelledTicket;
+	uint32			nextTicket;
+	bool			passed = TRUE;
+
+	testSetUp();
+
+	passed &= (testSubmit(TEST_CANCELLED_TIME_OUT, &cancelled, &cancelledTicket) == SBG_NO_ERROR);
+	passed &= (sbgEComCmdCancel(&gHandle, cancelledTicket) == SBG_NO_ERROR);
+	passed &= (sbgEComCmdCancel(&gHandle, cancelledTicket) == SBG_INVALID_PARAMETER);
+	passed &= (testSubmit(TEST_TIME_OUT, &next, &nextTicket) == SBG_NO_ERROR);
+
+	sbgEComHandle(&gHandle);
+	passed &= (gDevice.numFramesWritten == 1);
+
+	sbgSleep(TEST_CANCELLED_TIME_OUT + 10);
+
+	sbgEComHandle(&gHandle);
+	passed &= (gDevice.numFramesWritten == 2);
+
+	sbgEComTestDeviceSendFrame(&gDevice, TEST_CMD, "next", 4);
+	sbgEComHandle(&gHandle);
+
+	passed &= (next.numCalls == 1) && (next.result == SBG_NO_ERROR) && (memcmp(next.answer, "next", 4) == 0);
+	passed &= (cancelled.numCalls == 0);
+
+	sbgEComClose(&gHandle);
+
+	return testReport("time out of a cancelled command", passed);
+}
+
+/*!
+ *	A queued command that is cancelled before being sent releases its slot immediately.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCancelQueuedCmd(void)
+{
+	TestCompletion	sent;
+	TestCompletion	queued;
+	uint32			sentTicket;
+	uint32			queuedTicket;
+	bool			passed = TRUE;
+
+	testSetUp();
+
+	passed &= (testSubmit(TEST_TIME_OUT, &sent, &sentTicket) == SBG_NO_ERROR);
+	passed &= (testSubmit(TEST_TIME_OUT, &queued, &queuedTicket) == SBG_NO_ERROR);
+	passed &= (sbgEComCmdCancel(&gHandle, queuedTicket) == SBG_NO_ERROR);
+
+	sbgEComTestDeviceSendFrame(&gDevice, TEST_CMD, "sent", 4);
+	sbgEComHandle(&gHandle);
+
+	passed &= (sent.numCalls == 1) && (memcmp(sent.answer, "sent", 4) == 0);
+	passed &= (queued.numCalls == 0) && (gDevice.numFramesWritten == 1);
+
+	sbgEComClose(&gHandle);
+
+	return testReport("cancel of a queued command", passed);
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	bool	passed = TRUE;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	passed &= testLateAnswerOfCancelledCmd();
+	passed &= testCancelledCmdTimeOut();
+	passed &= testCancelQueuedCmd();
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
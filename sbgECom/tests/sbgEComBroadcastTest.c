@@ -0,0 +1,405 @@
+/*!
+ *	\file		sbgEComBroadcastTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Regression tests of the broadcast ring shared by several reader threads.
+ *
+ *	A writer publishes numbered IMU logs whose fields are all derived from their sequence number
+ *	so a reader can tell if a log has been partially overwritten while it was copied.
+ *	Each reader checks that it never returns such a torn log, that the logs are returned in order
+ *	and that every published log has been either returned or counted as lost.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include <sbgEComBroadcast.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_NUM_LOGS				(500000)							/*!< Number of IMU logs published by the writer thread. */
+#define TEST_NUM_READERS			(3)									/*!< Number of reader threads. */
+#define TEST_SLOW_READER_PERIOD		(16)								/*!< The slow reader sleeps every TEST_SLOW_READER_PERIOD logs so it is lapped. */
+#define TEST_LAPPED_EXTRA_LOGS		(10)								/*!< Number of logs published after a whole ring to lap a reader. */
+
+/*!
+ * Way a reader thread gets the logs from the ring.
+ */
+typedef enum _TestReaderMode
+{
+	TEST_READER_COPY,													/*!< The logs are copied with sbgEComBroadcastRead. */
+	TEST_READER_PEEK,													/*!< The logs are checked in place with sbgEComBroadcastPeek and sbgEComBroadcastRelease. */
+	TEST_READER_SLOW													/*!< The logs are copied by a reader that regularly sleeps. */
+} TestReaderMode;
+
+/*!
+ * Reader thread state and counters.
+ */
+typedef struct _TestReader
+{
+	SbgEComBroadcastCursor	cursor;										/*!< Reader cursor. */
+	TestReaderMode			mode;										/*!< Way the logs are read. */
+	SbgPlatformThread		*pThread;									/*!< Reader thread handle. */
+	uint32					numReceived;								/*!< Number of valid logs returned by the ring. */
+	uint32					numTorn;									/*!< Number of returned logs whose fields don't match their sequence number. */
+	uint32					numOutOfOrder;								/*!< Number of returned logs older than a previous one. */
+	uint32					numDiscarded;								/*!< Number of peeked logs overwritten before being released. */
+	uint32					lastSequence;								/*!< Sequence number of the last returned log. */
+} TestReader;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static SbgEComBroadcastRing	gRing;
+static TestReader			gReaders[TEST_NUM_READERS];
+static volatile uint32		gWriterDone;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Publish an IMU log whose fields are all derived from a sequence number.
+ *	\param[in]	sequence								Sequence number stored in the time stamp.
+ */
+static void testPush(uint32 sequence)
+{
+	SbgBinaryLogData	logData;
+	float				value = (float)(sequence & 0xFFFF);
+	uint32				i;
+
+	logData.imuData.timeStamp = sequence;
+	logData.imuData.status = (uint16)sequence;
+	logData.imuData.temperature = value;
+
+	for (i = 0; i < 3; i++)
+	{
+		logData.imuData.accelerometers[i] = value + (float)i;
+		logData.imuData.gyroscopes[i] = value + (float)(3 + i);
+		logData.imuData.deltaVelocity[i] = value + (float)(6 + i);
+		logData.imuData.deltaAngle[i] = value + (float)(9 + i);
+	}
+
+	sbgEComBroadcastPush(NULL, SBG_ECOM_LOG_IMU_DATA, &logData, &gRing);
+}
+
+/*!
+ *	Check that all the fields of an IMU log match its sequence number.
+ *	\param[in]	logCmd									Returned log id.
+ *	\param[in]	pLogData								Returned log.
+ *	\return												TRUE if the log is intact.
+ */
+static bool testCheck(SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData)
+{
+	float	value = (float)(pLogData->imuData.timeStamp & 0xFFFF);
+	uint32	i;
+
+	if ( (logCmd != SBG_ECOM_LOG_IMU_DATA) || (pLogData->imuData.status != (uint16)pLogData->imuData.timeStamp) || (pLogData->imuData.temperature != value) )
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		if ( (pLogData->imuData.accelerometers[i] != value + (float)i) ||
+			 (pLogData->imuData.gyroscopes[i] != value + (float)(3 + i)) ||
+			 (pLogData->imuData.deltaVelocity[i] != value + (float)(6 + i)) ||
+			 (pLogData->imuData.deltaAngle[i] != value + (float)(9 + i)) )
+		{
+			return FALSE;
+		}
+	}
+
+	return TRUE;
+}
+
+/*!
+ *	Record a log returned by the ring.
+ *	\param[in]	pReader									Reader that has received the log.
+ *	\param[in]	intact									TRUE if all the log fields match its sequence number.
+ *	\param[in]	sequence								Sequence number of the log.
+ */
+static void testRecord(TestReader *pReader, bool intact, uint32 sequence)
+{
+	if (!intact)
+	{
+		pReader->numTorn++;
+	}
+	else if ( (pReader->numReceived > 0) && (sequence <= pReader->lastSequence) )
+	{
+		pReader->numOutOfOrder++;
+	}
+
+	pReader->lastSequence = sequence;
+	pReader->numReceived++;
+}
+
+/*!
+ *	Read all the logs available in the ring.
+ *	\param[in]	pReader									Reader to use.
+ *	\return												Number of logs returned or discarded.
+ */
+static uint32 testReadAvailable(TestReader *pReader)
+{
+	SbgEComCmdId			 logCmd;
+	SbgBinaryLogData		 logData;
+	const SbgBinaryLogData	*pLogData;
+	uint32					 numLogs = 0;
+	bool					 intact;
+	uint32					 sequence;
+
+	if (pReader->mode == TEST_READER_PEEK)
+	{
+		while (sbgEComBroadcastPeek(&pReader->cursor, &logCmd, &pLogData) == SBG_NO_ERROR)
+		{
+			intact = testCheck(logCmd, pLogData);
+			sequence = pLogData->imuData.timeStamp;
+
+			//
+			// What has been checked in place is only meaningful if the log hasn't been overwritten meanwhile
+			//
+			if (sbgEComBroadcastRelease(&pReader->cursor) == SBG_NO_ERROR)
+			{
+				testRecord(pReader, intact, sequence);
+			}
+			else
+			{
+				pReader->numDiscarded++;
+			}
+
+			numLogs++;
+		}
+	}
+	else
+	{
+		while (sbgEComBroadcastRead(&pReader->cursor, &logCmd, &logData) == SBG_NO_ERROR)
+		{
+			testRecord(pReader, testCheck(logCmd, &logData), logData.imuData.timeStamp);
+			numLogs++;
+
+			if ( (pReader->mode == TEST_READER_SLOW) && (numLogs % TEST_SLOW_READER_PERIOD == 0) )
+			{
+				sbgSleep(1);
+			}
+		}
+	}
+
+	return numLogs;
+}
+
+/*!
+ *	Reader thread that reads the ring until the writer is done and the reader is up to date.
+ *	\param[in]	pArg									The reader.
+ */
+static void testReaderThread(void *pArg)
+{
+	TestReader	*pReader = (TestReader*)pArg;
+	uint32		 writerDone;
+
+	do
+	{
+		writerDone = SBG_ATOMIC_LOAD_ACQUIRE(gWriterDone);
+
+		if (testReadAvailable(pReader) == 0)
+		{
+			sbgSleep(0);
+		}
+	} while ( (writerDone == 0) || (pReader->cursor.sequence != SBG_ATOMIC_LOAD_ACQUIRE(gRing.publishSequence)) );
+}
+
+/*!
+ *	Print the counters of a reader and check them.
+ *	\param[in]	pName									Test name.
+ *	\param[in]	pReader									Reader to check.
+ *	\param[in]	numPublished							Number of logs published since the reader cursor has been initialized.
+ *	\return												TRUE if no torn or out of order log has been returned and every log has been received or counted as lost.
+ */
+static bool testCheckReader(const char *pName, const TestReader *pReader, uint32 numPublished)
+{
+	bool	passed;
+
+	passed = (pReader->numTorn == 0) && (pReader->numOutOfOrder == 0) && (pReader->numReceived + pReader->cursor.numLost == numPublished);
+
+	printf("%-40s %s: received=%u lost=%u discarded=%u torn=%u out of order=%u\n",
+		pName, passed ? "passed" : "FAILED", pReader->numReceived, pReader->cursor.numLost, pReader->numDiscarded, pReader->numTorn, pReader->numOutOfOrder);
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	A reader that keeps up receives every log in order and is then up to date.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testUpToDate(void)
+{
+	TestReader	reader;
+	uint32		i;
+	bool		passed;
+
+	memset(&reader, 0x00, sizeof(reader));
+	sbgEComBroadcastInit(&gRing);
+	sbgEComBroadcastCursorInit(&reader.cursor, &gRing);
+
+	for (i = 0; i < SBG_ECOM_BROADCAST_RING_SIZE; i++)
+	{
+		testPush(i);
+	}
+
+	testReadAvailable(&reader);
+
+	passed = testCheckReader("reader up to date", &reader, SBG_ECOM_BROADCAST_RING_SIZE);
+	passed = passed && (reader.cursor.numLost == 0) && (reader.lastSequence == SBG_ECOM_BROADCAST_RING_SIZE - 1);
+
+	return passed;
+}
+
+/*!
+ *	A reader lapped by the writer skips the overwritten logs, counts them as lost and restarts half a ring behind the writer.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testLapped(void)
+{
+	TestReader			reader;
+	SbgEComCmdId		logCmd;
+	SbgBinaryLogData	logData;
+	uint32				numPublished = SBG_ECOM_BROADCAST_RING_SIZE + TEST_LAPPED_EXTRA_LOGS;
+	uint32				i;
+	bool				passed;
+
+	memset(&reader, 0x00, sizeof(reader));
+	sbgEComBroadcastInit(&gRing);
+	sbgEComBroadcastCursorInit(&reader.cursor, &gRing);
+
+	for (i = 0; i < numPublished; i++)
+	{
+		testPush(i);
+	}
+
+	passed = (sbgEComBroadcastRead(&reader.cursor, &logCmd, &logData) == SBG_NO_ERROR);
+	passed = passed && (logData.imuData.timeStamp == numPublished - SBG_ECOM_BROADCAST_RING_SIZE/2) && (reader.cursor.numLost == logData.imuData.timeStamp);
+
+	testRecord(&reader, testCheck(logCmd, &logData), logData.imuData.timeStamp);
+	testReadAvailable(&reader);
+
+	passed = testCheckReader("lapped reader", &reader, numPublished) && passed;
+
+	return passed;
+}
+
+/*!
+ *	A log peeked by a reader and overwritten before being released must be reported as lost.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testOverwrittenPeek(void)
+{
+	SbgEComBroadcastCursor	 cursor;
+	SbgEComCmdId			 logCmd;
+	const SbgBinaryLogData	*pLogData;
+	SbgErrorCode			 errorCode = SBG_ERROR;
+	uint32					 i;
+	bool					 passed;
+
+	sbgEComBroadcastInit(&gRing);
+	sbgEComBroadcastCursorInit(&cursor, &gRing);
+
+	testPush(0);
+
+	if (sbgEComBroadcastPeek(&cursor, &logCmd, &pLogData) == SBG_NO_ERROR)
+	{
+		//
+		// The writer overwrites the peeked entry while the reader is using it
+		//
+		for (i = 1; i <= SBG_ECOM_BROADCAST_RING_SIZE; i++)
+		{
+			testPush(i);
+		}
+
+		errorCode = sbgEComBroadcastRelease(&cursor);
+	}
+
+	passed = (errorCode == SBG_BUFFER_OVERFLOW) && (cursor.numLost == 1) && (cursor.sequence == 1);
+
+	printf("%-40s %s: lost=%u\n", "overwritten peeked log", passed ? "passed" : "FAILED", cursor.numLost);
+
+	return passed;
+}
+
+/*!
+ *	Several reader threads, one of them too slow to keep up, read the ring while the writer publishes as fast as it can.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testConcurrentReaders(void)
+{
+	static const char	*pNames[TEST_NUM_READERS] = { "concurrent copying reader", "concurrent peeking reader", "concurrent slow reader" };
+	uint32				 i;
+	bool				 passed = TRUE;
+
+	sbgEComBroadcastInit(&gRing);
+	SBG_ATOMIC_STORE_RELEASE(gWriterDone, 0);
+
+	for (i = 0; i < TEST_NUM_READERS; i++)
+	{
+		memset(&gReaders[i], 0x00, sizeof(TestReader));
+		gReaders[i].mode = (TestReaderMode)i;
+		sbgEComBroadcastCursorInit(&gReaders[i].cursor, &gRing);
+		gReaders[i].pThread = sbgPlatformThreadCreate(testReaderThread, &gReaders[i]);
+	}
+
+	for (i = 0; i < TEST_NUM_LOGS; i++)
+	{
+		testPush(i);
+	}
+
+	SBG_ATOMIC_STORE_RELEASE(gWriterDone, 1);
+
+	for (i = 0; i < TEST_NUM_READERS; i++)
+	{
+		sbgPlatformThreadJoin(gReaders[i].pThread);
+		passed = testCheckReader(pNames[i], &gReaders[i], TEST_NUM_LOGS) && passed;
+	}
+
+	//
+	// The slow reader has to be lapped for the test to be meaningful
+	//
+	passed = passed && (gReaders[TEST_READER_SLOW].cursor.numLost > 0);
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	bool	passed = TRUE;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	passed &= testUpToDate();
+	passed &= testLapped();
+	passed &= testOverwrittenPeek();
+	passed &= testConcurrentReaders();
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
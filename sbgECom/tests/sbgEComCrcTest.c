@@ -0,0 +1,297 @@
+/*!
+ *	\file		sbgEComCrcTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Equivalence tests of the CRC kernels.
+ *
+ *	Every kernel supported by the processor is checked against a bit by bit reference
+ *	and against the byte kernel, for all lengths up to a few cache lines, misaligned
+ *	buffers and chained updates.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include <crc/sbgCrc.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_MAX_SIZE				(1100)								/*!< Every length from 0 up to this one is tested. */
+#define TEST_LARGE_SIZE				(SBG_ECOM_MAX_BUFFER_SIZE + 8)		/*!< Largest length tested, around a full frame. */
+#define TEST_MAX_OFFSET				(8)									/*!< Buffers start at every offset below this one. */
+#define TEST_NUM_SPLITS				(2000)								/*!< Number of random chained updates tested. */
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static const char	*gKernelNames[] = { "auto", "byte", "slicing-by-4", "slicing-by-8", "pclmul" };
+static uint8		 gData[TEST_LARGE_SIZE + TEST_MAX_OFFSET];
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Returns the next value of a simple linear congruential generator.
+ *	\param[in]	pState									Generator state, updated by the call.
+ *	\return												A 24 bits random value.
+ */
+static uint32 testRandom(uint32 *pState)
+{
+	*pState = *pState * 1103515245u + 12345u;
+
+	return *pState >> 8;
+}
+
+/*!
+ *	Bit by bit CRC-16, reflected polynom 0x8408 with a zero initial value.
+ *	\param[in]	crc										Current CRC value.
+ *	\param[in]	pData									Data buffer.
+ *	\param[in]	dataSize								Data size in bytes.
+ *	\return												The updated CRC value.
+ */
+static uint16 testCrc16Reference(uint16 crc, const uint8 *pData, uint32 dataSize)
+{
+	uint32	i;
+	uint32	bit;
+
+	for (i = 0; i < dataSize; i++)
+	{
+		crc ^= pData[i];
+
+		for (bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x0001) ? ((crc >> 1) ^ 0x8408) : (crc >> 1);
+		}
+	}
+
+	return crc;
+}
+
+/*!
+ *	Bit by bit Ethernet CRC-32, MSB first on 32 bit little endian words.
+ *	\param[in]	crc										Current CRC value.
+ *	\param[in]	pData									Data buffer.
+ *	\param[in]	dataSize								Data size in bytes (multiple of 4).
+ *	\return												The updated CRC value.
+ */
+static uint32 testCrc32Reference(uint32 crc, const uint8 *pData, uint32 dataSize)
+{
+	uint32	i;
+	uint32	bit;
+
+	for (i = 0; i < dataSize; i++)
+	{
+		crc ^= (uint32)pData[i ^ 0x03] << 24;
+
+		for (bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x80000000) ? ((crc << 1) ^ 0x04C11DB7) : (crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+/*!
+ *	Print a test result.
+ *	\param[in]	pName									Test name.
+ *	\param[in]	passed									TRUE if the test has passed.
+ *	\return												passed.
+ */
+static bool testReport(const char *pName, bool passed)
+{
+	printf("%-40s %s\n", pName, passed ? "passed" : "FAILED");
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	The CRC-16 of "123456789" is the CRC-16/KERMIT check value.
+ *	\param[in]	kernel									Kernel to test.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCrc16CheckValue(SbgCrcKernel kernel)
+{
+	sbgCrcSetKernel(kernel);
+
+	return (sbgCrc16Compute("123456789", 9) == 0x2189);
+}
+
+/*!
+ *	CRC-16 of every length and buffer offset against the reference and the byte kernel.
+ *	\param[in]	kernel									Kernel to test.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCrc16Lengths(SbgCrcKernel kernel)
+{
+	uint32	offset;
+	uint32	size;
+	uint16	reference;
+	uint16	byteCrc;
+	bool	passed = TRUE;
+
+	for (offset = 0; offset < TEST_MAX_OFFSET; offset++)
+	{
+		for (size = 0; size <= TEST_LARGE_SIZE; size = (size == TEST_MAX_SIZE) ? (TEST_LARGE_SIZE - 16) : (size + 1))
+		{
+			reference = testCrc16Reference(0, gData + offset, size);
+
+			sbgCrcSetKernel(SBG_CRC_KERNEL_BYTE);
+			byteCrc = sbgCrc16Compute(gData + offset, size);
+
+			sbgCrcSetKernel(kernel);
+			passed &= (byteCrc == reference) && (sbgCrc16Compute(gData + offset, size) == reference);
+		}
+	}
+
+	return passed;
+}
+
+/*!
+ *	CRC-32 of every length multiple of 4 and buffer offset against the reference and the byte kernel.
+ *	\param[in]	kernel									Kernel to test.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCrc32Lengths(SbgCrcKernel kernel)
+{
+	uint32	offset;
+	uint32	size;
+	uint32	reference;
+	uint32	byteCrc;
+	bool	passed = TRUE;
+
+	for (offset = 0; offset < TEST_MAX_OFFSET; offset++)
+	{
+		for (size = 0; size <= TEST_LARGE_SIZE; size = (size == TEST_MAX_SIZE) ? (TEST_LARGE_SIZE - 16) : (size + 4))
+		{
+			reference = testCrc32Reference(0xFFFFFFFF, gData + offset, size);
+
+			sbgCrcSetKernel(SBG_CRC_KERNEL_BYTE);
+			byteCrc = sbgCrc32Compute(gData + offset, size);
+
+			sbgCrcSetKernel(kernel);
+			passed &= (byteCrc == reference) && (sbgCrc32Compute(gData + offset, size) == reference);
+		}
+	}
+
+	return passed;
+}
+
+/*!
+ *	Chained updates over random splits give the same CRCs as a single update.
+ *	\param[in]	kernel									Kernel to test.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testChainedUpdates(SbgCrcKernel kernel)
+{
+	SbgCrc16	crc16;
+	SbgCrc32	crc32;
+	uint32		state = 1;
+	uint32		offset;
+	uint32		size;
+	uint32		split;
+	uint32		i;
+	bool		passed = TRUE;
+
+	sbgCrcSetKernel(kernel);
+
+	for (i = 0; i < TEST_NUM_SPLITS; i++)
+	{
+		offset = testRandom(&state) % TEST_MAX_OFFSET;
+		size = testRandom(&state) % (TEST_LARGE_SIZE + 1);
+		split = testRandom(&state) % (size + 1);
+
+		sbgCrc16Initialize(&crc16);
+		sbgCrc16Update(&crc16, gData + offset, split);
+		sbgCrc16Update(&crc16, gData + offset + split, size - split);
+
+		passed &= (sbgCrc16Get(&crc16) == testCrc16Reference(0, gData + offset, size));
+
+		//
+		// The 32 bit CRC only accepts sizes multiple of 4
+		//
+		size &= ~0x03u;
+		split &= ~0x03u;
+
+		if (split > size)
+		{
+			split = size;
+		}
+
+		sbgCrc32Initialize(&crc32);
+		sbgCrc32Update(&crc32, gData + offset, split);
+		sbgCrc32Update(&crc32, gData + offset + split, size - split);
+
+		passed &= (sbgCrc32Get(&crc32) == testCrc32Reference(0xFFFFFFFF, gData + offset, size));
+	}
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	char			name[64];
+	uint32			state = 1;
+	uint32			i;
+	SbgCrcKernel	kernel;
+	bool			passed = TRUE;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	for (i = 0; i < sizeof(gData); i++)
+	{
+		gData[i] = (uint8)testRandom(&state);
+	}
+
+	for (kernel = SBG_CRC_KERNEL_BYTE; kernel <= SBG_CRC_KERNEL_PCLMUL; kernel++)
+	{
+		if (!sbgCrcIsKernelSupported(kernel))
+		{
+			printf("%-40s %s\n", gKernelNames[kernel], "not supported");
+			continue;
+		}
+
+		passed &= (sbgCrcSetKernel(kernel) == SBG_NO_ERROR) && (sbgCrcGetKernel() == kernel);
+
+		sprintf(name, "%s: CRC-16 check value", gKernelNames[kernel]);
+		passed &= testReport(name, testCrc16CheckValue(kernel));
+
+		sprintf(name, "%s: CRC-16 lengths and offsets", gKernelNames[kernel]);
+		passed &= testReport(name, testCrc16Lengths(kernel));
+
+		sprintf(name, "%s: CRC-32 lengths and offsets", gKernelNames[kernel]);
+		passed &= testReport(name, testCrc32Lengths(kernel));
+
+		sprintf(name, "%s: chained updates", gKernelNames[kernel]);
+		passed &= testReport(name, testChainedUpdates(kernel));
+	}
+
+	sbgCrcSetKernel(SBG_CRC_KERNEL_AUTO);
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,501 @@
+/*!
+ *	\file		sbgEComDispatchTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Regression tests of the sbgEComHandle frames dispatching.
+ *
+ *	A simulated device streams numbered IMU logs and the callbacks check that every log
+ *	is received exactly once, in order and with the expected content.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include "sbgEComTestDevice.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_NUM_LOGS				(2000)								/*!< Number of IMU logs streamed by the simulated device. */
+#define TEST_MAX_READ_SIZE			(1000)								/*!< Maximum number of bytes returned by each read so frames wrap around the reception buffer. */
+#define TEST_CMD_PERIOD				(8)									/*!< A command is sent every TEST_CMD_PERIOD logs. */
+#define TEST_CMD_TIME_OUT			(50)								/*!< Time out in ms of the commands sent from the callbacks. */
+#define TEST_STREAM_CHUNK			(16)								/*!< Number of logs streamed before handling them when commands have to be answered. */
+#define TEST_LATENCY_SLEEP			(20)								/*!< Time in ms a log is left in the reception buffer when measuring its dispatch latency. */
+
+/*!
+ * Counters filled by the test callbacks.
+ */
+typedef struct _TestResult
+{
+	uint8			seen[TEST_NUM_LOGS];								/*!< Number of times each log has been received. */
+	uint32			numLogs;											/*!< Number of received logs. */
+	uint32			numGarbage;											/*!< Number of logs whose content doesn't match any sent log. */
+	uint32			numOutOfOrder;										/*!< Number of logs received before a previous one. */
+	uint32			numCmds;											/*!< Number of commands sent from the callbacks. */
+	uint32			numCmdAnswers;										/*!< Number of commands that have received their own answer. */
+	uint32			numCmdErrors;										/*!< Number of commands that have failed in an unexpected way. */
+	uint32			cmdDepth;											/*!< Number of commands being waited, more than one if a command is sent from a nested callback. */
+	bool			expectAnswers;										/*!< TRUE if every command sent from a top level callback has to be answered. */
+	uint32			numRawGarbage;										/*!< Number of raw payloads whose content doesn't match the parsed log. */
+	uint32			numCmdReads;										/*!< Number of interface reads done from the callbacks. */
+	uint32			lastSequence;										/*!< Sequence number of the last received log. */
+} TestResult;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static SbgEComTestDevice	gDevice;
+static SbgEComHandle		gHandle;
+static TestResult			gResult;
+static SbgEComLatencyStats	gLatencyStats;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Simulated device command handler that answers each command with its own payload.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	cmd										Received command id.
+ *	\param[in]	pPayload								Received payload.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\param[in]	pUserArg								Unused.
+ */
+static void testDeviceEcho(SbgEComTestDevice *pDevice, uint16 cmd, const uint8 *pPayload, uint32 payloadSize, void *pUserArg)
+{
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	sbgEComTestDeviceSendFrame(pDevice, cmd, pPayload, payloadSize);
+}
+
+/*!
+ *	Record a received IMU log.
+ *	\param[in]	pImuData								Received IMU log.
+ */
+static void testRecordImu(const SbgLogImuData *pImuData)
+{
+	uint32	sequence = pImuData->timeStamp;
+
+	if ( (sequence < TEST_NUM_LOGS) && (sbgEComTestDeviceCheckImu(pImuData, sequence)) )
+	{
+		if ( (gResult.numLogs > 0) && (sequence <= gResult.lastSequence) )
+		{
+			gResult.numOutOfOrder++;
+		}
+
+		gResult.seen[sequence]++;
+		gResult.lastSequence = sequence;
+	}
+	else
+	{
+		gResult.numGarbage++;
+	}
+
+	gResult.numLogs++;
+}
+
+/*!
+ *	Send a command and wait for its answer from a callback, the interface reads done meanwhile are counted.
+ *	A command sent from a callback called while another command is waited can't be waited and should fail with SBG_NOT_READY.
+ *	\param[in]	pHandle									The sbgECom handle that has called the callback.
+ */
+static void testSendCmd(SbgEComHandle *pHandle)
+{
+	uint16			cmd = SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO);
+	uint32			sentValue = gResult.numLogs;
+	uint32			answer[4];
+	uint32			answerSize;
+	uint32			numReads;
+	SbgErrorCode	errorCode = SBG_ERROR;
+
+	numReads = gDevice.numReads;
+
+	gResult.cmdDepth++;
+
+	if (sbgEComProtocolSend(&pHandle->protocolHandle, cmd, &sentValue, sizeof(sentValue)) == SBG_NO_ERROR)
+	{
+		errorCode = sbgEComReceiveCmd(pHandle, cmd, answer, &answerSize, sizeof(answer), TEST_CMD_TIME_OUT);
+	}
+
+	gResult.cmdDepth--;
+
+	if ( (errorCode == SBG_NO_ERROR) && (answerSize == sizeof(sentValue)) && (answer[0] == sentValue) )
+	{
+		gResult.numCmdAnswers++;
+	}
+	else if (gResult.cmdDepth > 0)
+	{
+		if (errorCode != SBG_NOT_READY)
+		{
+			gResult.numCmdErrors++;
+		}
+	}
+	else if ( (gResult.expectAnswers) || ((errorCode != SBG_NO_ERROR) && (errorCode != SBG_NOT_READY)) )
+	{
+		gResult.numCmdErrors++;
+	}
+
+	gResult.numCmds++;
+	gResult.numCmdReads += gDevice.numReads - numReads;
+
+	//
+	// Reads done by nested callbacks have already been counted
+	//
+	gDevice.numReads = numReads;
+}
+
+/*!
+ *	Log callback that sends a command every TEST_CMD_PERIOD logs.
+ *	\param[in]	pHandle									The sbgECom handle that has called the callback.
+ *	\param[in]	logCmd									Received log id.
+ *	\param[in]	pLogData								Received log.
+ *	\param[in]	pUserArg								Unused.
+ *	\return												Always SBG_NO_ERROR.
+ */
+static SbgErrorCode testLogSendingCmd(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg)
+{
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	if (logCmd == SBG_ECOM_LOG_IMU_DATA)
+	{
+		testRecordImu(&pLogData->imuData);
+
+		if (gResult.numLogs % TEST_CMD_PERIOD == 0)
+		{
+			testSendCmd(pHandle);
+		}
+	}
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Raw log callback that records the log, sends a command every TEST_CMD_PERIOD logs and then checks the payload again.
+ *	\param[in]	pHandle									The sbgECom handle that has called the callback.
+ *	\param[in]	logCmd									Received log id.
+ *	\param[in]	pPayload								Received payload.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\param[in]	pUserArg								Unused.
+ *	\return												Always SBG_NO_ERROR.
+ */
+static SbgErrorCode testRawSendingCmd(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const void *pPayload, uint32 payloadSize, void *pUserArg)
+{
+	SbgLogImuData	imuData;
+	uint32			sequence;
+
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	if (logCmd == SBG_ECOM_LOG_IMU_DATA)
+	{
+		sequence = sbgEComLogImuGetTimestamp(pPayload, payloadSize);
+
+		if (sbgEComBinaryLogParseImuData(pPayload, payloadSize, &imuData) == SBG_NO_ERROR)
+		{
+			testRecordImu(&imuData);
+		}
+		else
+		{
+			gResult.numRawGarbage++;
+		}
+
+		if (gResult.numLogs % TEST_CMD_PERIOD == 0)
+		{
+			testSendCmd(pHandle);
+		}
+
+		//
+		// The payload should still be valid after the command, the logs received meanwhile have been dispatched from the command
+		//
+		if ( (sbgEComBinaryLogParseImuData(pPayload, payloadSize, &imuData) != SBG_NO_ERROR) ||
+			 (sbgEComLogImuGetTimestamp(pPayload, payloadSize) != sequence) ||
+			 (!sbgEComTestDeviceCheckImu(&imuData, sequence)) )
+		{
+			gResult.numRawGarbage++;
+		}
+	}
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Log callback that only checks the content of the received logs, they can be received out of order if a command is waited from the raw callback.
+ *	\param[in]	pHandle									The sbgECom handle that has called the callback.
+ *	\param[in]	logCmd									Received log id.
+ *	\param[in]	pLogData								Received log.
+ *	\param[in]	pUserArg								Unused.
+ *	\return												Always SBG_NO_ERROR.
+ */
+static SbgErrorCode testLogChecking(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg)
+{
+	SBG_UNUSED_PARAMETER(pHandle);
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	if ( (logCmd == SBG_ECOM_LOG_IMU_DATA) && (!sbgEComTestDeviceCheckImu(&pLogData->imuData, pLogData->imuData.timeStamp)) )
+	{
+		gResult.numGarbage++;
+	}
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Log callback that handles the incoming frames again every TEST_CMD_PERIOD logs.
+ *	\param[in]	pHandle									The sbgECom handle that has called the callback.
+ *	\param[in]	logCmd									Received log id.
+ *	\param[in]	pLogData								Received log.
+ *	\param[in]	pUserArg								Unused.
+ *	\return												Always SBG_NO_ERROR.
+ */
+static SbgErrorCode testLogHandlingFrames(SbgEComHandle *pHandle, SbgEComCmdId logCmd, const SbgBinaryLogData *pLogData, void *pUserArg)
+{
+	uint32	numReads;
+
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	if (logCmd == SBG_ECOM_LOG_IMU_DATA)
+	{
+		testRecordImu(&pLogData->imuData);
+
+		if (gResult.numLogs % TEST_CMD_PERIOD == 0)
+		{
+			numReads = gDevice.numReads;
+
+			sbgEComHandle(pHandle);
+
+			gResult.numCmdReads += gDevice.numReads - numReads;
+			gDevice.numReads = numReads;
+		}
+	}
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Stream all the IMU logs and handle them with the current callbacks.
+ *	\param[in]	chunkSize								Number of logs streamed before handling them.
+ */
+static void testStream(uint32 chunkSize)
+{
+	uint32	i;
+
+	for (i = 0; i < TEST_NUM_LOGS; i++)
+	{
+		sbgEComTestDeviceSendImu(&gDevice, i);
+
+		if ((i + 1) % chunkSize == 0)
+		{
+			while (sbgEComHandle(&gHandle) != SBG_NOT_READY)
+			{
+			}
+		}
+	}
+
+	//
+	// Answers of commands sent from the callbacks are streamed after the logs
+	//
+	while ( (sbgEComHandle(&gHandle) != SBG_NOT_READY) || (sbgEComTestDeviceGetPendingBytes(&gDevice) > 0) )
+	{
+	}
+}
+
+/*!
+ *	Check the counters filled by the callbacks and print the test result.
+ *	\param[in]	pName									Test name.
+ *	\param[in]	readsAllowed							TRUE if the callbacks are allowed to read the interface.
+ *	\return												TRUE if every log has been received exactly once, in order and intact.
+ */
+static bool testCheck(const char *pName, bool readsAllowed)
+{
+	uint32	numLost = 0;
+	uint32	numDuplicated = 0;
+	uint32	i;
+	bool	passed;
+
+	for (i = 0; i < TEST_NUM_LOGS; i++)
+	{
+		if (gResult.seen[i] == 0)
+		{
+			numLost++;
+		}
+		else if (gResult.seen[i] > 1)
+		{
+			numDuplicated += gResult.seen[i] - 1;
+		}
+	}
+
+	passed = (numLost == 0) && (numDuplicated == 0) && (gResult.numGarbage == 0) && (gResult.numRawGarbage == 0) && (gResult.numOutOfOrder == 0) && (gResult.numCmdErrors == 0);
+
+	if (!readsAllowed)
+	{
+		passed = passed && (gResult.numCmdReads == 0);
+	}
+
+	printf("%-40s %s: lost=%u duplicated=%u garbage=%u raw garbage=%u out of order=%u commands=%u answered=%u errors=%u reads from callbacks=%u\n",
+		pName, passed ? "passed" : "FAILED", numLost, numDuplicated, gResult.numGarbage, gResult.numRawGarbage, gResult.numOutOfOrder, gResult.numCmds, gResult.numCmdAnswers, gResult.numCmdErrors, gResult.numCmdReads);
+
+	return passed;
+}
+
+/*!
+ *	Initialize the simulated device, the sbgECom handle and the counters.
+ */
+static void testSetUp(void)
+{
+	sbgEComTestDeviceInit(&gDevice, TEST_MAX_READ_SIZE);
+	sbgEComTestDeviceSetCmdCallback(&gDevice, testDeviceEcho, NULL);
+	sbgEComInit(&gHandle, &gDevice.interface);
+
+	memset(&gResult, 0x00, sizeof(gResult));
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	A log callback that sends a blocking command must receive its answer without corrupting the frames still to be dispatched.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCmdFromLogCallback(void)
+{
+	bool	passed;
+
+	testSetUp();
+	gResult.expectAnswers = TRUE;
+	sbgEComSetReceiveCallback(&gHandle, testLogSendingCmd, NULL);
+
+	testStream(TEST_STREAM_CHUNK);
+	passed = testCheck("command sent from a log callback", TRUE);
+
+	sbgEComClose(&gHandle);
+
+	return passed;
+}
+
+/*!
+ *	A raw callback that sends a blocking command must receive its answer without corrupting its own payload nor the log parsed for the other callbacks.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCmdFromRawCallback(void)
+{
+	bool	passed;
+
+	testSetUp();
+	gResult.expectAnswers = TRUE;
+	sbgEComSetReceiveRawCallback(&gHandle, testRawSendingCmd, NULL);
+	sbgEComSetReceiveCallback(&gHandle, testLogChecking, NULL);
+
+	testStream(TEST_STREAM_CHUNK);
+	passed = testCheck("command sent from a raw callback", TRUE);
+
+	sbgEComClose(&gHandle);
+
+	return passed;
+}
+
+/*!
+ *	A log callback that sends a blocking command while a large backlog is received fills the reception buffer with the held frames.
+ *	The command should then fail with SBG_NOT_READY instead of waiting for its time out, and no log should be lost.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCmdFromLogCallbackBacklog(void)
+{
+	bool	passed;
+
+	testSetUp();
+	sbgEComSetReceiveCallback(&gHandle, testLogSendingCmd, NULL);
+
+	testStream(TEST_NUM_LOGS);
+	passed = testCheck("command sent with a backlog", TRUE);
+
+	sbgEComClose(&gHandle);
+
+	return passed;
+}
+
+/*!
+ *	A log callback that calls sbgEComHandle must neither read the interface nor corrupt the frames still to be dispatched.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testHandleFromLogCallback(void)
+{
+	bool	passed;
+
+	testSetUp();
+	sbgEComSetReceiveCallback(&gHandle, testLogHandlingFrames, NULL);
+
+	testStream(TEST_NUM_LOGS);
+	passed = testCheck("sbgEComHandle called from a log callback", FALSE);
+
+	sbgEComClose(&gHandle);
+
+	return passed;
+}
+
+/*!
+ *	The dispatch latency of a log left in the reception buffer must include the time spent there.
+ *	Two logs are read at once, the second one is only dispatched by the next call, after a sleep and without any new read.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testLatencyOfBufferedLog(void)
+{
+	SbgEComLatencyHistogram	histogram;
+	bool					passed;
+
+	testSetUp();
+	sbgEComSetReceiveCallback(&gHandle, testLogChecking, NULL);
+	sbgEComLatencyInit(&gLatencyStats);
+	sbgEComSetLatencyStats(&gHandle, &gLatencyStats);
+
+	sbgEComTestDeviceSendImu(&gDevice, 0);
+	sbgEComTestDeviceSendImu(&gDevice, 1);
+
+	sbgEComHandleEx(&gHandle, 1, 0, NULL);
+	sbgSleep(TEST_LATENCY_SLEEP);
+	sbgEComHandleEx(&gHandle, 1, 0, NULL);
+
+	sbgEComLatencyGetHistogram(&gLatencyStats, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LATENCY_DISPATCH, &histogram);
+
+	passed = (histogram.count == 2) && (histogram.max >= (uint64)TEST_LATENCY_SLEEP * 1000000) && (gResult.numGarbage == 0);
+
+	printf("%-40s %s: logs=%u max latency=%.1f ms\n", "latency of a buffered log", passed ? "passed" : "FAILED", histogram.count, histogram.max / 1e6);
+
+	sbgEComClose(&gHandle);
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	bool	passed = TRUE;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	passed &= testCmdFromLogCallback();
+	passed &= testCmdFromRawCallback();
+	passed &= testCmdFromLogCallbackBacklog();
+	passed &= testHandleFromLogCallback();
+	passed &= testLatencyOfBufferedLog();
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
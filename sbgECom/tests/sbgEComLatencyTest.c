@@ -0,0 +1,425 @@
+/*!
+ *	\file		sbgEComLatencyTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Regression tests of the binary logs latency histograms.
+ *
+ *	The bucket of a value is found by recording it in empty statistics, the tests then check the
+ *	bucket boundaries, the 12.5% precision of the sub buckets, the percentiles, the values above
+ *	the last bucket and the histograms read and reset from another thread while values are recorded.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include <sbgEComLatency.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_LOG					SBG_ECOM_LOG_IMU_DATA				/*!< Binary log whose latencies are recorded. */
+#define TEST_NUM_RANDOM_VALUES		(10000)								/*!< Number of random values checked against their bucket bounds. */
+#define TEST_NUM_PERCENTILE_VALUES	(1000)								/*!< Values from 1 to TEST_NUM_PERCENTILE_VALUES are recorded to check the percentiles. */
+#define TEST_NUM_RECORDS			(1000000)							/*!< Number of values recorded by the recording thread. */
+#define TEST_RECORDS_BURST			(100)								/*!< The recording thread yields every TEST_RECORDS_BURST values so it is interleaved with the reads even on a single CPU. */
+#define TEST_RESET_PERIOD			(16)								/*!< A reset is requested every TEST_RESET_PERIOD histogram copies. */
+#define TEST_DISPATCH_TIME			(1000)								/*!< Dispatch time recorded by the recording thread. */
+#define TEST_CALLBACK_TIME			(3000000)							/*!< Callback time recorded by the recording thread. */
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static SbgEComLatencyStats	gStats;
+static volatile uint32		gRecorderDone;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Returns the bucket a value is stored in.
+ *	\param[in]	value									Duration in ns.
+ *	\return												Bucket index or SBG_ECOM_LATENCY_NUM_BUCKETS if the value hasn't been stored in exactly one bucket.
+ */
+static uint32 testGetBucketIndex(uint64 value)
+{
+	SbgEComLatencyHistogram	histogram;
+	uint32					index = SBG_ECOM_LATENCY_NUM_BUCKETS;
+	uint32					numBuckets = 0;
+	uint32					i;
+
+	sbgEComLatencyInit(&gStats);
+	sbgEComLatencyRecord(&gStats, TEST_LOG, value, 0);
+	sbgEComLatencyGetHistogram(&gStats, TEST_LOG, SBG_ECOM_LATENCY_DISPATCH, &histogram);
+
+	for (i = 0; i < SBG_ECOM_LATENCY_NUM_BUCKETS; i++)
+	{
+		if (histogram.buckets[i] != 0)
+		{
+			index = i;
+			numBuckets++;
+		}
+	}
+
+	return (numBuckets == 1) ? index : SBG_ECOM_LATENCY_NUM_BUCKETS;
+}
+
+/*!
+ *	Check that a histogram copy is consistent for values all equal to the same duration.
+ *	\param[in]	pHistogram								Histogram copy.
+ *	\param[in]	bucketIndex								Bucket of the recorded duration.
+ *	\param[in]	value									Recorded duration in ns.
+ *	\return												TRUE if the buckets, the count, the sum and the max all match.
+ */
+static bool testCheckConstantHistogram(const SbgEComLatencyHistogram *pHistogram, uint32 bucketIndex, uint64 value)
+{
+	uint32	numValues = 0;
+	uint32	i;
+
+	for (i = 0; i < SBG_ECOM_LATENCY_NUM_BUCKETS; i++)
+	{
+		numValues += pHistogram->buckets[i];
+	}
+
+	return (numValues == pHistogram->count) && (pHistogram->buckets[bucketIndex] == pHistogram->count) &&
+		(pHistogram->sum == pHistogram->count * value) && (pHistogram->max == ((pHistogram->count > 0) ? value : 0));
+}
+
+/*!
+ *	Thread that records the same durations by bursts.
+ *	\param[in]	pArg									Unused.
+ */
+static void testRecorderThread(void *pArg)
+{
+	uint32	i;
+
+	SBG_UNUSED_PARAMETER(pArg);
+
+	for (i = 0; i < TEST_NUM_RECORDS; i++)
+	{
+		sbgEComLatencyRecord(&gStats, TEST_LOG, TEST_DISPATCH_TIME, TEST_CALLBACK_TIME);
+
+		if (i % TEST_RECORDS_BURST == 0)
+		{
+			sbgSleep(0);
+		}
+	}
+
+	SBG_ATOMIC_STORE_RELEASE(gRecorderDone, 1);
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Check that each bucket starts at its lower bound and that the previous value is in the previous bucket.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testBucketBoundaries(void)
+{
+	uint64	lowerBound;
+	uint32	numErrors = 0;
+	uint32	i;
+	bool	passed;
+
+	if (testGetBucketIndex(0) != 0)
+	{
+		numErrors++;
+	}
+
+	for (i = 1; i < SBG_ECOM_LATENCY_NUM_BUCKETS; i++)
+	{
+		lowerBound = sbgEComLatencyGetBucketLowerBound(i);
+
+		if ( (lowerBound <= sbgEComLatencyGetBucketLowerBound(i - 1)) || (testGetBucketIndex(lowerBound) != i) || (testGetBucketIndex(lowerBound - 1) != i - 1) )
+		{
+			numErrors++;
+		}
+	}
+
+	passed = (numErrors == 0);
+
+	printf("%-40s %s: errors=%u last bucket=%llu ns\n", "bucket boundaries", passed ? "passed" : "FAILED",
+		numErrors, (unsigned long long)sbgEComLatencyGetBucketLowerBound(SBG_ECOM_LATENCY_NUM_BUCKETS - 1));
+
+	return passed;
+}
+
+/*!
+ *	Check that small values are exact and that any other value is within 12.5% of its bucket lower bound.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testSubBucketPrecision(void)
+{
+	uint64	seed = 1;
+	uint64	value;
+	uint64	lowerBound;
+	uint64	width;
+	uint32	index;
+	uint32	numErrors = 0;
+	uint32	i;
+	bool	passed;
+
+	for (i = 0; i < 2*SBG_ECOM_LATENCY_SUB_BUCKET_COUNT; i++)
+	{
+		if ( (testGetBucketIndex(i) != i) || (sbgEComLatencyGetBucketLowerBound(i) != i) )
+		{
+			numErrors++;
+		}
+	}
+
+	//
+	// Random values spread over all octaves, below the last bucket
+	//
+	for (i = 0; i < TEST_NUM_RANDOM_VALUES; i++)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		value = (seed >> 30) >> (seed % 34);
+
+		index = testGetBucketIndex(value);
+
+		if (index >= SBG_ECOM_LATENCY_NUM_BUCKETS - 1)
+		{
+			if (value < sbgEComLatencyGetBucketLowerBound(SBG_ECOM_LATENCY_NUM_BUCKETS - 1))
+			{
+				numErrors++;
+			}
+
+			continue;
+		}
+
+		lowerBound = sbgEComLatencyGetBucketLowerBound(index);
+		width = sbgEComLatencyGetBucketLowerBound(index + 1) - lowerBound;
+
+		if ( (value < lowerBound) || (value >= lowerBound + width) || ( (value >= 2*SBG_ECOM_LATENCY_SUB_BUCKET_COUNT) && (width * SBG_ECOM_LATENCY_SUB_BUCKET_COUNT > value) ) )
+		{
+			numErrors++;
+		}
+	}
+
+	passed = (numErrors == 0);
+
+	printf("%-40s %s: errors=%u\n", "sub bucket precision", passed ? "passed" : "FAILED", numErrors);
+
+	return passed;
+}
+
+/*!
+ *	Check the percentiles of values from 1 to TEST_NUM_PERCENTILE_VALUES, each one recorded once.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testPercentiles(void)
+{
+	static const double		percentiles[] = { 1.0, 10.0, 25.0, 50.0, 75.0, 90.0, 99.0, 99.9 };
+	SbgEComLatencyHistogram	histogram;
+	uint64					exact;
+	uint64					value;
+	uint32					numErrors = 0;
+	uint32					i;
+	bool					passed;
+
+	sbgEComLatencyInit(&gStats);
+	sbgEComLatencyGetHistogram(&gStats, TEST_LOG, SBG_ECOM_LATENCY_DISPATCH, &histogram);
+
+	if (sbgEComLatencyGetPercentile(&histogram, 50.0) != 0)
+	{
+		numErrors++;
+	}
+
+	for (i = 1; i <= TEST_NUM_PERCENTILE_VALUES; i++)
+	{
+		sbgEComLatencyRecord(&gStats, TEST_LOG, i, 0);
+	}
+
+	sbgEComLatencyGetHistogram(&gStats, TEST_LOG, SBG_ECOM_LATENCY_DISPATCH, &histogram);
+
+	//
+	// A percentile is the upper bound of the bucket of the exact value, so it is at most 12.5% larger
+	//
+	for (i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++)
+	{
+		exact = (uint64)(percentiles[i] * TEST_NUM_PERCENTILE_VALUES / 100.0 + 0.5);
+		value = sbgEComLatencyGetPercentile(&histogram, percentiles[i]);
+
+		if ( (value < exact) || (value > exact + exact / SBG_ECOM_LATENCY_SUB_BUCKET_COUNT) )
+		{
+			printf("percentile %.1f: %llu instead of %llu\n", percentiles[i], (unsigned long long)value, (unsigned long long)exact);
+			numErrors++;
+		}
+	}
+
+	if ( (sbgEComLatencyGetPercentile(&histogram, 0.0) != 1) || (sbgEComLatencyGetPercentile(&histogram, 100.0) != TEST_NUM_PERCENTILE_VALUES) ||
+		 (histogram.count != TEST_NUM_PERCENTILE_VALUES) || (histogram.sum != TEST_NUM_PERCENTILE_VALUES * (TEST_NUM_PERCENTILE_VALUES + 1) / 2) )
+	{
+		numErrors++;
+	}
+
+	passed = (numErrors == 0);
+
+	printf("%-40s %s: p50=%llu p99=%llu max=%llu\n", "percentiles", passed ? "passed" : "FAILED",
+		(unsigned long long)sbgEComLatencyGetPercentile(&histogram, 50.0), (unsigned long long)sbgEComLatencyGetPercentile(&histogram, 99.0), (unsigned long long)histogram.max);
+
+	return passed;
+}
+
+/*!
+ *	Check that values too large for the histogram are stored in the last bucket and still returned by the largest percentiles.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testOverflow(void)
+{
+	static const uint64		values[] = { 1ull << 34, 1ull << 40, 0xFFFFFFFFFFFFFFFFull };
+	SbgEComLatencyHistogram	histogram;
+	uint32					numErrors = 0;
+	uint32					i;
+	bool					passed;
+
+	for (i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+	{
+		if (testGetBucketIndex(values[i]) != SBG_ECOM_LATENCY_NUM_BUCKETS - 1)
+		{
+			numErrors++;
+		}
+	}
+
+	sbgEComLatencyInit(&gStats);
+	sbgEComLatencyRecord(&gStats, TEST_LOG, 100, 0);
+
+	for (i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+	{
+		sbgEComLatencyRecord(&gStats, TEST_LOG, values[i], 0);
+	}
+
+	sbgEComLatencyGetHistogram(&gStats, TEST_LOG, SBG_ECOM_LATENCY_DISPATCH, &histogram);
+
+	if ( (histogram.buckets[SBG_ECOM_LATENCY_NUM_BUCKETS - 1] != 3) || (histogram.count != 4) || (histogram.max != 0xFFFFFFFFFFFFFFFFull) ||
+		 (sbgEComLatencyGetPercentile(&histogram, 50.0) != histogram.max) || (sbgEComLatencyGetPercentile(&histogram, 100.0) != histogram.max) ||
+		 (sbgEComLatencyGetPercentile(&histogram, 25.0) > 100 + 100 / SBG_ECOM_LATENCY_SUB_BUCKET_COUNT) )
+	{
+		numErrors++;
+	}
+
+	//
+	// Invalid log ids are neither recorded nor returned
+	//
+	sbgEComLatencyRecord(&gStats, SBG_ECOM_LOG_ECOM_NUM_MESSAGES, 100, 0);
+
+	if (sbgEComLatencyGetHistogram(&gStats, SBG_ECOM_LOG_ECOM_NUM_MESSAGES, SBG_ECOM_LATENCY_DISPATCH, &histogram) != SBG_INVALID_PARAMETER)
+	{
+		numErrors++;
+	}
+
+	passed = (numErrors == 0);
+
+	printf("%-40s %s: errors=%u\n", "overflow into the last bucket", passed ? "passed" : "FAILED", numErrors);
+
+	return passed;
+}
+
+/*!
+ *	Read and reset the histograms while another thread records values.
+ *	Every copy has to be consistent and the resets have to be applied by the recording thread.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testResetWhileRecording(void)
+{
+	SbgEComLatencyHistogram	 dispatch;
+	SbgEComLatencyHistogram	 callback;
+	SbgPlatformThread		*pThread;
+	uint32					 dispatchIndex;
+	uint32					 callbackIndex;
+	uint32					 numCopies = 0;
+	uint32					 numTorn = 0;
+	uint32					 numResets = 0;
+	uint32					 numResetsApplied = 0;
+	uint32					 lastCount = 0;
+	bool					 passed;
+
+	dispatchIndex = testGetBucketIndex(TEST_DISPATCH_TIME);
+	callbackIndex = testGetBucketIndex(TEST_CALLBACK_TIME);
+
+	sbgEComLatencyInit(&gStats);
+	SBG_ATOMIC_STORE_RELEASE(gRecorderDone, 0);
+
+	pThread = sbgPlatformThreadCreate(testRecorderThread, NULL);
+
+	while (SBG_ATOMIC_LOAD_ACQUIRE(gRecorderDone) == 0)
+	{
+		sbgEComLatencyGetHistogram(&gStats, TEST_LOG, SBG_ECOM_LATENCY_DISPATCH, &dispatch);
+		sbgEComLatencyGetHistogram(&gStats, TEST_LOG, SBG_ECOM_LATENCY_CALLBACK, &callback);
+		numCopies++;
+
+		if (!testCheckConstantHistogram(&dispatch, dispatchIndex, TEST_DISPATCH_TIME) || !testCheckConstantHistogram(&callback, callbackIndex, TEST_CALLBACK_TIME))
+		{
+			numTorn++;
+		}
+
+		//
+		// The count only goes down when a reset has been applied
+		//
+		if (dispatch.count < lastCount)
+		{
+			numResetsApplied++;
+		}
+
+		lastCount = dispatch.count;
+
+		if (numCopies % TEST_RESET_PERIOD == 0)
+		{
+			sbgEComLatencyReset(&gStats);
+			numResets++;
+		}
+
+		sbgSleep(0);
+	}
+
+	sbgPlatformThreadJoin(pThread);
+
+	//
+	// A reset requested while nothing is recorded is applied with the next value
+	//
+	sbgEComLatencyReset(&gStats);
+	sbgEComLatencyRecord(&gStats, TEST_LOG, TEST_DISPATCH_TIME, TEST_CALLBACK_TIME);
+	sbgEComLatencyGetHistogram(&gStats, TEST_LOG, SBG_ECOM_LATENCY_DISPATCH, &dispatch);
+
+	passed = (numTorn == 0) && (numResets > 0) && (numResetsApplied > 0) && (dispatch.count == 1) && testCheckConstantHistogram(&dispatch, dispatchIndex, TEST_DISPATCH_TIME);
+
+	printf("%-40s %s: copies=%u torn=%u resets=%u applied=%u\n", "reset while recording", passed ? "passed" : "FAILED", numCopies, numTorn, numResets, numResetsApplied);
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	bool	passed = TRUE;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	passed &= testBucketBoundaries();
+	passed &= testSubBucketPrecision();
+	passed &= testPercentiles();
+	passed &= testOverflow();
+	passed &= testResetWhileRecording();
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
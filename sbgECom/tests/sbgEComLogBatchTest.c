@@ -0,0 +1,383 @@
+/*!
+ *	\file		sbgEComLogBatchTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Regression tests of the columnar binary logs decoding.
+ *
+ *	The same pseudo random payloads are decoded into columns from packed payloads, from received frames
+ *	and from a raw capture split in chunks. Every value of every column is then compared with the log
+ *	decoded by sbgEComBinaryLogParse. Values are compared bitwise as random floats can be NaN.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include <sbgEComLogBatch.h>
+#include "sbgEComTestDevice.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_NUM_LOGS				(200)								/*!< Number of logs of each id, not a multiple of SBG_ECOM_LOG_BATCH_GROUP_SIZE. */
+#define TEST_PAYLOAD_STRIDE			(80)								/*!< Number of bytes from a packed payload start to the next one. */
+#define TEST_MAX_COLUMNS			(15)								/*!< Maximum number of columns of a log. */
+#define TEST_CAPTURE_CHUNK			(500)								/*!< Number of captured bytes added at once, frames are split across chunks. */
+#define TEST_OTHER_LOG				SBG_ECOM_LOG_STATUS					/*!< Log id interleaved with the decoded logs, it has to be ignored. */
+
+/*!
+ * Column of a log and the matching member of its parsed structure.
+ */
+typedef struct _TestColumn
+{
+	size_t			columnOffset;										/*!< Offset of the column pointer in the columns union. */
+	size_t			fieldOffset;										/*!< Offset of the value in the parsed log. */
+	uint32			valueSize;											/*!< Size in bytes of the value. */
+} TestColumn;
+
+/*!
+ * Log decoded by the tests.
+ */
+typedef struct _TestLog
+{
+	const char		*pName;												/*!< Log name. */
+	SbgEComCmdId	 logCmd;											/*!< Binary log id. */
+	uint32			 payloadSize;										/*!< Payload size in bytes. */
+	const TestColumn *pColumns;											/*!< Columns of the log. */
+	uint32			 numColumns;										/*!< Number of columns. */
+} TestLog;
+
+/*!
+ * Declare a column of a log, the value of the parsed structure is given by its member such as accelerometers[1].
+ */
+#define TEST_COLUMN(columnsType, column, logType, member)	\
+	{ offsetof(columnsType, column), offsetof(logType, member), sizeof(((logType*)0)->member) }
+
+//----------------------------------------------------------------------//
+//- Columns                                                            -//
+//----------------------------------------------------------------------//
+
+static const TestColumn gImuColumns[] =
+{
+	TEST_COLUMN(SbgLogImuColumns,		pTimeStamp,			SbgLogImuData,		timeStamp),
+	TEST_COLUMN(SbgLogImuColumns,		pStatus,			SbgLogImuData,		status),
+	TEST_COLUMN(SbgLogImuColumns,		pAccelX,			SbgLogImuData,		accelerometers[0]),
+	TEST_COLUMN(SbgLogImuColumns,		pAccelY,			SbgLogImuData,		accelerometers[1]),
+	TEST_COLUMN(SbgLogImuColumns,		pAccelZ,			SbgLogImuData,		accelerometers[2]),
+	TEST_COLUMN(SbgLogImuColumns,		pGyroX,				SbgLogImuData,		gyroscopes[0]),
+	TEST_COLUMN(SbgLogImuColumns,		pGyroY,				SbgLogImuData,		gyroscopes[1]),
+	TEST_COLUMN(SbgLogImuColumns,		pGyroZ,				SbgLogImuData,		gyroscopes[2]),
+	TEST_COLUMN(SbgLogImuColumns,		pTemperature,		SbgLogImuData,		temperature),
+	TEST_COLUMN(SbgLogImuColumns,		pDeltaVelX,			SbgLogImuData,		deltaVelocity[0]),
+	TEST_COLUMN(SbgLogImuColumns,		pDeltaVelY,			SbgLogImuData,		deltaVelocity[1]),
+	TEST_COLUMN(SbgLogImuColumns,		pDeltaVelZ,			SbgLogImuData,		deltaVelocity[2]),
+	TEST_COLUMN(SbgLogImuColumns,		pDeltaAngleX,		SbgLogImuData,		deltaAngle[0]),
+	TEST_COLUMN(SbgLogImuColumns,		pDeltaAngleY,		SbgLogImuData,		deltaAngle[1]),
+	TEST_COLUMN(SbgLogImuColumns,		pDeltaAngleZ,		SbgLogImuData,		deltaAngle[2]),
+};
+
+static const TestColumn gEkfEulerColumns[] =
+{
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pTimeStamp,			SbgLogEkfEulerData,	timeStamp),
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pRoll,				SbgLogEkfEulerData,	euler[0]),
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pPitch,				SbgLogEkfEulerData,	euler[1]),
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pYaw,				SbgLogEkfEulerData,	euler[2]),
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pRollStdDev,		SbgLogEkfEulerData,	eulerStdDev[0]),
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pPitchStdDev,		SbgLogEkfEulerData,	eulerStdDev[1]),
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pYawStdDev,			SbgLogEkfEulerData,	eulerStdDev[2]),
+	TEST_COLUMN(SbgLogEkfEulerColumns,	pStatus,			SbgLogEkfEulerData,	status),
+};
+
+static const TestColumn gEkfNavColumns[] =
+{
+	TEST_COLUMN(SbgLogEkfNavColumns,	pTimeStamp,			SbgLogEkfNavData,	timeStamp),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pVelocityN,			SbgLogEkfNavData,	velocity[0]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pVelocityE,			SbgLogEkfNavData,	velocity[1]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pVelocityD,			SbgLogEkfNavData,	velocity[2]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pVelocityNStdDev,	SbgLogEkfNavData,	velocityStdDev[0]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pVelocityEStdDev,	SbgLogEkfNavData,	velocityStdDev[1]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pVelocityDStdDev,	SbgLogEkfNavData,	velocityStdDev[2]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pLatitude,			SbgLogEkfNavData,	position[0]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pLongitude,			SbgLogEkfNavData,	position[1]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pAltitude,			SbgLogEkfNavData,	position[2]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pUndulation,		SbgLogEkfNavData,	undulation),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pLatitudeStdDev,	SbgLogEkfNavData,	positionStdDev[0]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pLongitudeStdDev,	SbgLogEkfNavData,	positionStdDev[1]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pAltitudeStdDev,	SbgLogEkfNavData,	positionStdDev[2]),
+	TEST_COLUMN(SbgLogEkfNavColumns,	pStatus,			SbgLogEkfNavData,	status),
+};
+
+static const TestColumn gMagColumns[] =
+{
+	TEST_COLUMN(SbgLogMagColumns,		pTimeStamp,			SbgLogMag,			timeStamp),
+	TEST_COLUMN(SbgLogMagColumns,		pStatus,			SbgLogMag,			status),
+	TEST_COLUMN(SbgLogMagColumns,		pMagX,				SbgLogMag,			magnetometers[0]),
+	TEST_COLUMN(SbgLogMagColumns,		pMagY,				SbgLogMag,			magnetometers[1]),
+	TEST_COLUMN(SbgLogMagColumns,		pMagZ,				SbgLogMag,			magnetometers[2]),
+	TEST_COLUMN(SbgLogMagColumns,		pAccelX,			SbgLogMag,			accelerometers[0]),
+	TEST_COLUMN(SbgLogMagColumns,		pAccelY,			SbgLogMag,			accelerometers[1]),
+	TEST_COLUMN(SbgLogMagColumns,		pAccelZ,			SbgLogMag,			accelerometers[2]),
+};
+
+static const TestLog gTestLogs[] =
+{
+	{ "IMU_DATA",	SBG_ECOM_LOG_IMU_DATA,	58,	gImuColumns,		sizeof(gImuColumns) / sizeof(gImuColumns[0])			},
+	{ "EKF_EULER",	SBG_ECOM_LOG_EKF_EULER,	32,	gEkfEulerColumns,	sizeof(gEkfEulerColumns) / sizeof(gEkfEulerColumns[0])	},
+	{ "EKF_NAV",	SBG_ECOM_LOG_EKF_NAV,	72,	gEkfNavColumns,		sizeof(gEkfNavColumns) / sizeof(gEkfNavColumns[0])		},
+	{ "MAG",		SBG_ECOM_LOG_MAG,		30,	gMagColumns,		sizeof(gMagColumns) / sizeof(gMagColumns[0])			},
+};
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static uint8				gPayloads[TEST_NUM_LOGS][TEST_PAYLOAD_STRIDE];
+static SbgBinaryLogData		gExpected[TEST_NUM_LOGS];
+static uint64				gColumnsStorage[TEST_MAX_COLUMNS][TEST_NUM_LOGS];
+static SbgEComProtocolFrame	gFrames[2 * TEST_NUM_LOGS + 1];
+static SbgEComTestDevice	gCapture;
+static uint32				gSeed;
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Fill the payloads with pseudo random bytes and parse them with sbgEComBinaryLogParse.
+ *	\param[in]	pLog									Log to generate.
+ */
+static void testGenerate(const TestLog *pLog)
+{
+	uint32	i;
+	uint32	j;
+
+	for (i = 0; i < TEST_NUM_LOGS; i++)
+	{
+		for (j = 0; j < TEST_PAYLOAD_STRIDE; j++)
+		{
+			gSeed = gSeed * 1103515245 + 12345;
+			gPayloads[i][j] = (uint8)(gSeed >> 16);
+		}
+
+		sbgEComBinaryLogParse((uint16)pLog->logCmd, gPayloads[i], pLog->payloadSize, &gExpected[i]);
+	}
+}
+
+/*!
+ *	Initialize a batch with all the columns of a log.
+ *	\param[out]	pBatch									Batch to initialize.
+ *	\param[in]	pLog									Log decoded by the batch.
+ */
+static void testInitBatch(SbgEComLogBatch *pBatch, const TestLog *pLog)
+{
+	uint32	i;
+
+	sbgEComLogBatchInit(pBatch, pLog->logCmd, TEST_NUM_LOGS);
+	memset(gColumnsStorage, 0x00, sizeof(gColumnsStorage));
+
+	for (i = 0; i < pLog->numColumns; i++)
+	{
+		*(void**)((uint8*)&pBatch->columns + pLog->pColumns[i].columnOffset) = gColumnsStorage[i];
+	}
+}
+
+/*!
+ *	Compare every value of every column with the logs parsed by sbgEComBinaryLogParse and print the result.
+ *	\param[in]	pName									Test name.
+ *	\param[in]	pBatch									Decoded batch.
+ *	\param[in]	pLog									Log decoded by the batch.
+ *	\param[in]	errorCode								Error code returned when the logs have been added.
+ *	\param[in]	expectedDropped							Expected number of dropped logs.
+ *	\return												TRUE if all the values match.
+ */
+static bool testCheck(const char *pName, const SbgEComLogBatch *pBatch, const TestLog *pLog, SbgErrorCode errorCode, uint32 expectedDropped)
+{
+	const TestColumn	*pColumn;
+	uint32				 numMismatches = 0;
+	uint32				 i;
+	uint32				 j;
+	bool				 passed;
+
+	for (i = 0; i < pLog->numColumns; i++)
+	{
+		pColumn = &pLog->pColumns[i];
+
+		for (j = 0; j < TEST_NUM_LOGS; j++)
+		{
+			if (memcmp((const uint8*)gColumnsStorage[i] + j * pColumn->valueSize, (const uint8*)&gExpected[j] + pColumn->fieldOffset, pColumn->valueSize) != 0)
+			{
+				numMismatches++;
+			}
+		}
+	}
+
+	passed = (errorCode == SBG_NO_ERROR) && (pBatch->numLogs == TEST_NUM_LOGS) && (pBatch->numDropped == expectedDropped) && (numMismatches == 0);
+
+	printf("%-10s %-10s %s: logs=%u dropped=%u mismatches=%u\n", pLog->pName, pName, passed ? "passed" : "FAILED", pBatch->numLogs, pBatch->numDropped, numMismatches);
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Decode the packed payloads, stored at a stride larger than their size.
+ *	\param[in]	pLog									Log to decode.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testAddPayloads(const TestLog *pLog)
+{
+	SbgEComLogBatch	batch;
+	SbgErrorCode	errorCode;
+	uint32			numUsed;
+
+	testInitBatch(&batch, pLog);
+
+	errorCode = sbgEComLogBatchAddPayloads(&batch, gPayloads, pLog->payloadSize, TEST_PAYLOAD_STRIDE, TEST_NUM_LOGS, &numUsed);
+
+	return testCheck("payloads", &batch, pLog, errorCode, 0) && (numUsed == TEST_NUM_LOGS);
+}
+
+/*!
+ *	Decode received frames interleaved with frames of another log, an invalid frame of the decoded log is dropped.
+ *	\param[in]	pLog									Log to decode.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testAddFrames(const TestLog *pLog)
+{
+	SbgEComLogBatch	batch;
+	SbgErrorCode	errorCode;
+	uint32			numFrames = 0;
+	uint32			numUsed;
+	uint32			i;
+
+	testInitBatch(&batch, pLog);
+	memset(gFrames, 0x00, sizeof(gFrames));
+
+	for (i = 0; i < TEST_NUM_LOGS; i++)
+	{
+		gFrames[numFrames].status = SBG_NO_ERROR;
+		gFrames[numFrames].cmd = (uint16)pLog->logCmd;
+		gFrames[numFrames].pData = gPayloads[i];
+		gFrames[numFrames].size = pLog->payloadSize;
+		numFrames++;
+
+		if (i % 3 == 0)
+		{
+			gFrames[numFrames].status = SBG_NO_ERROR;
+			gFrames[numFrames].cmd = TEST_OTHER_LOG;
+			gFrames[numFrames].pData = gPayloads[i];
+			gFrames[numFrames].size = pLog->payloadSize;
+			numFrames++;
+		}
+	}
+
+	gFrames[numFrames].status = SBG_INVALID_CRC;
+	gFrames[numFrames].cmd = (uint16)pLog->logCmd;
+	numFrames++;
+
+	errorCode = sbgEComLogBatchAddFrames(&batch, gFrames, numFrames, &numUsed);
+
+	return testCheck("frames", &batch, pLog, errorCode, 1) && (numUsed == numFrames);
+}
+
+/*!
+ *	Decode a raw capture split in chunks, with line noise, frames of another log and a frame with an invalid CRC.
+ *	\param[in]	pLog									Log to decode.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testAddCapture(const TestLog *pLog)
+{
+	static const uint8	noise[] = { 0x00, SBG_ECOM_SYNC_1, 0x13, SBG_ECOM_ETX, SBG_ECOM_SYNC_2 };
+	SbgEComLogBatch		batch;
+	SbgErrorCode		errorCode = SBG_NO_ERROR;
+	uint8				zeros[TEST_PAYLOAD_STRIDE];
+	uint32				crcIndex;
+	uint32				position = 0;
+	uint32				end = 0;
+	uint32				bytesUsed;
+	uint32				i;
+
+	testInitBatch(&batch, pLog);
+	sbgEComTestDeviceInit(&gCapture, SBG_ECOM_TEST_DEVICE_STREAM_SIZE);
+	memset(zeros, 0x00, sizeof(zeros));
+
+	for (i = 0; i < TEST_NUM_LOGS; i++)
+	{
+		sbgEComTestDeviceSendFrame(&gCapture, (uint16)pLog->logCmd, gPayloads[i], pLog->payloadSize);
+
+		if (i % 3 == 0)
+		{
+			sbgEComTestDeviceSendFrame(&gCapture, TEST_OTHER_LOG, gPayloads[i], pLog->payloadSize);
+		}
+
+		if (i % 7 == 0)
+		{
+			sbgEComTestDeviceSendBytes(&gCapture, noise, sizeof(noise));
+		}
+
+		//
+		// A frame of the decoded log with a corrupted CRC is dropped
+		//
+		if (i == TEST_NUM_LOGS / 2)
+		{
+			sbgEComTestDeviceSendFrame(&gCapture, (uint16)pLog->logCmd, zeros, pLog->payloadSize);
+			crcIndex = gCapture.writeIndex - 3;
+			gCapture.stream[crcIndex] ^= 0xFF;
+		}
+	}
+
+	//
+	// Add the capture chunk after chunk, the bytes left by a call are given again with the next chunk
+	//
+	while ( (end < gCapture.writeIndex) && (errorCode == SBG_NO_ERROR) )
+	{
+		end = (end + TEST_CAPTURE_CHUNK < gCapture.writeIndex) ? end + TEST_CAPTURE_CHUNK : gCapture.writeIndex;
+
+		errorCode = sbgEComLogBatchAddCapture(&batch, gCapture.stream + position, end - position, &bytesUsed);
+		position += bytesUsed;
+	}
+
+	return testCheck("capture", &batch, pLog, errorCode, 1) && (position == gCapture.writeIndex);
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	bool	passed = TRUE;
+	uint32	i;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	gSeed = 1;
+
+	for (i = 0; i < sizeof(gTestLogs) / sizeof(gTestLogs[0]); i++)
+	{
+		testGenerate(&gTestLogs[i]);
+
+		passed &= testAddPayloads(&gTestLogs[i]);
+		passed &= testAddFrames(&gTestLogs[i]);
+		passed &= testAddCapture(&gTestLogs[i]);
+	}
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,541 @@
+/*!
+ *	\file		sbgEComReaderTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Regression tests of the reader thread and its queue policies.
+ *
+ *	A simulated device streams numbered IMU logs that are queued by the reader thread
+ *	and popped by the test, which checks which logs have been kept for each policy.
+ *	The simulated device isn't thread safe so it is wrapped in an interface that locks it.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include <sbgEComReader.h>
+#include "sbgEComTestDevice.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_NUM_LOGS				(100)								/*!< Number of IMU logs streamed by the drop and coalesce tests, more than the queue can hold. */
+#define TEST_NUM_BLOCKED_LOGS		(500)								/*!< Number of IMU logs streamed by the block test. */
+#define TEST_MAX_DEPTH				(8)									/*!< Maximum depth of the IMU logs for the drop oldest and block tests. */
+#define TEST_MAX_READ_SIZE			(1000)								/*!< Maximum number of bytes returned by each read. */
+#define TEST_CMD					SBG_ECOM_BUILD_ID(SBG_ECOM_CLASS_LOG_CMD_0, SBG_ECOM_CMD_INFO)	/*!< Command sent while the reader thread dispatches logs. */
+#define TEST_NUM_CMDS				(20)								/*!< Number of commands sent while the reader thread dispatches logs. */
+#define TEST_LOGS_PER_CMD			(50)								/*!< Number of IMU logs streamed before each command. */
+#define TEST_CMD_TIME_OUT			(500)								/*!< Time out in ms of the commands sent while the reader is running. */
+#define TEST_WAIT_TIME_OUT			(2000)								/*!< Maximum time in ms to wait for the reader thread. */
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static SbgEComTestDevice	gDevice;
+static SbgInterface			gInterface;
+static SbgPlatformMutex		*gpDeviceLock;
+static SbgEComHandle		gHandle;
+static SbgEComReader		gReader;
+
+//----------------------------------------------------------------------//
+//- Locked simulated device                                            -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Read function of the locked interface.
+ *	\param[in]	pHandle									The locked interface.
+ *	\param[out]	pBuffer									Buffer used to return the read bytes.
+ *	\param[out]	pReadBytes								Number of bytes read.
+ *	\param[in]	bytesToRead								Maximum number of bytes to read.
+ *	\return												The simulated device result.
+ */
+static SbgErrorCode testLockedRead(SbgInterface *pHandle, void *pBuffer, uint32 *pReadBytes, uint32 bytesToRead)
+{
+	SbgErrorCode	errorCode;
+
+	SBG_UNUSED_PARAMETER(pHandle);
+
+	sbgPlatformMutexLock(gpDeviceLock);
+	errorCode = sbgInterfaceRead(&gDevice.interface, pBuffer, pReadBytes, bytesToRead);
+	sbgPlatformMutexUnlock(gpDeviceLock);
+
+	return errorCode;
+}
+
+/*!
+ *	Write function of the locked interface, the command callback is called with the lock held.
+ *	\param[in]	pHandle									The locked interface.
+ *	\param[in]	pBuffer									Written frame.
+ *	\param[in]	bytesToWrite							Frame size in bytes.
+ *	\return												The simulated device result.
+ */
+static SbgErrorCode testLockedWrite(SbgInterface *pHandle, const void *pBuffer, uint32 bytesToWrite)
+{
+	SbgErrorCode	errorCode;
+
+	SBG_UNUSED_PARAMETER(pHandle);
+
+	sbgPlatformMutexLock(gpDeviceLock);
+	errorCode = sbgInterfaceWrite(&gDevice.interface, pBuffer, bytesToWrite);
+	sbgPlatformMutexUnlock(gpDeviceLock);
+
+	return errorCode;
+}
+
+/*!
+ *	Wait readable function of the locked interface, the CPU is released when nothing can be read.
+ *	\param[in]	pHandle									The locked interface.
+ *	\param[in]	timeOut									Maximum time to wait in ms.
+ *	\return												SBG_NO_ERROR if some bytes can be read or SBG_TIME_OUT otherwise.
+ */
+static SbgErrorCode testLockedWaitReadable(SbgInterface *pHandle, uint32 timeOut)
+{
+	uint32	pendingBytes;
+
+	SBG_UNUSED_PARAMETER(pHandle);
+
+	sbgPlatformMutexLock(gpDeviceLock);
+	pendingBytes = sbgEComTestDeviceGetPendingBytes(&gDevice);
+	sbgPlatformMutexUnlock(gpDeviceLock);
+
+	if (pendingBytes > 0)
+	{
+		return SBG_NO_ERROR;
+	}
+
+	if (timeOut > 0)
+	{
+		sbgSleep(1);
+	}
+
+	return SBG_TIME_OUT;
+}
+
+/*!
+ *	Wait readable function of an interface that keeps failing.
+ *	\param[in]	pHandle									The failing interface.
+ *	\param[in]	timeOut									Unused.
+ *	\return												Always SBG_READ_ERROR.
+ */
+static SbgErrorCode testFailingWaitReadable(SbgInterface *pHandle, uint32 timeOut)
+{
+	SBG_UNUSED_PARAMETER(pHandle);
+	SBG_UNUSED_PARAMETER(timeOut);
+
+	return SBG_READ_ERROR;
+}
+
+/*!
+ *	Simulated device command handler that answers each command with its own payload.
+ *	It is called from the locked interface write function so the device is already locked.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	cmd										Received command id.
+ *	\param[in]	pPayload								Received payload.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\param[in]	pUserArg								Unused.
+ */
+static void testDeviceEcho(SbgEComTestDevice *pDevice, uint16 cmd, const uint8 *pPayload, uint32 payloadSize, void *pUserArg)
+{
+	SBG_UNUSED_PARAMETER(pUserArg);
+
+	sbgEComTestDeviceSendFrame(pDevice, cmd, pPayload, payloadSize);
+}
+
+/*!
+ *	Stream numbered IMU logs while the reader thread may be reading the device.
+ *	\param[in]	firstSequence							Sequence number of the first log.
+ *	\param[in]	numLogs									Number of logs to stream.
+ */
+static void testStream(uint32 firstSequence, uint32 numLogs)
+{
+	uint32	i;
+
+	sbgPlatformMutexLock(gpDeviceLock);
+
+	for (i = 0; i < numLogs; i++)
+	{
+		sbgEComTestDeviceSendImu(&gDevice, firstSequence + i);
+	}
+
+	sbgPlatformMutexUnlock(gpDeviceLock);
+}
+
+//----------------------------------------------------------------------//
+//- Private methods                                                    -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize the simulated device, the locked interface, the sbgECom handle and the reader.
+ */
+static void testSetUp(void)
+{
+	sbgEComTestDeviceInit(&gDevice, TEST_MAX_READ_SIZE);
+	sbgEComTestDeviceSetCmdCallback(&gDevice, testDeviceEcho, NULL);
+
+	sbgInterfaceZeroInit(&gInterface);
+	gInterface.pReadFunc = testLockedRead;
+	gInterface.pWriteFunc = testLockedWrite;
+	gInterface.pWaitReadableFunc = testLockedWaitReadable;
+
+	sbgEComInit(&gHandle, &gInterface);
+	sbgEComReaderInit(&gReader);
+}
+
+/*!
+ *	Close the reader and the sbgECom handle.
+ */
+static void testTearDown(void)
+{
+	sbgEComReaderClose(&gReader);
+	sbgEComClose(&gHandle);
+}
+
+/*!
+ *	Wait until the reader thread has received a number of logs.
+ *	\param[in]	numLogs									Number of logs to wait for.
+ *	\return												TRUE if the logs have been received before TEST_WAIT_TIME_OUT.
+ */
+static bool testWaitLogs(uint32 numLogs)
+{
+	SbgEComReaderStats	stats;
+	uint32				i;
+
+	for (i = 0; i < TEST_WAIT_TIME_OUT; i++)
+	{
+		sbgEComReaderGetStats(&gReader, &stats);
+
+		if (stats.numLogs >= numLogs)
+		{
+			return TRUE;
+		}
+
+		sbgSleep(1);
+	}
+
+	return FALSE;
+}
+
+/*!
+ *	Pop all the queued logs and check they are a range of intact and ordered IMU logs.
+ *	\param[in]	firstSequence							Expected sequence number of the first log.
+ *	\param[in]	numLogs									Expected number of logs.
+ *	\return												TRUE if exactly the expected logs have been popped.
+ */
+static bool testPopRange(uint32 firstSequence, uint32 numLogs)
+{
+	SbgEComCmdId		logCmd;
+	SbgBinaryLogData	logData;
+	uint32				numPopped = 0;
+	bool				passed = TRUE;
+
+	while (sbgEComReaderPop(&gReader, &logCmd, &logData) == SBG_NO_ERROR)
+	{
+		if ( (logCmd != SBG_ECOM_LOG_IMU_DATA) || (!sbgEComTestDeviceCheckImu(&logData.imuData, firstSequence + numPopped)) )
+		{
+			passed = FALSE;
+		}
+
+		numPopped++;
+	}
+
+	return passed && (numPopped == numLogs);
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	With the default drop newest policy, a full queue keeps the oldest logs and drops the new ones.
+ *	The logs are popped once the reader has been stopped.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testDropNewest(void)
+{
+	SbgEComReaderStats	stats;
+	bool				passed;
+
+	testSetUp();
+	testStream(0, TEST_NUM_LOGS);
+
+	sbgEComReaderStart(&gReader, &gHandle);
+	passed = testWaitLogs(TEST_NUM_LOGS);
+	sbgEComReaderStop(&gReader);
+
+	sbgEComReaderGetStats(&gReader, &stats);
+	passed = passed && (stats.numOverruns == TEST_NUM_LOGS - SBG_ECOM_LOG_QUEUE_SIZE) && (stats.maxDepth == SBG_ECOM_LOG_QUEUE_SIZE);
+	passed = testPopRange(0, SBG_ECOM_LOG_QUEUE_SIZE) && passed;
+
+	printf("%-40s %s: logs=%u overruns=%u max depth=%u\n", "drop newest policy", passed ? "passed" : "FAILED", stats.numLogs, stats.numOverruns, stats.maxDepth);
+
+	testTearDown();
+
+	return passed;
+}
+
+/*!
+ *	With the drop oldest policy and a maximum depth, only the newest logs are kept.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testDropOldest(void)
+{
+	SbgEComReaderLogStats	logStats;
+	bool					passed;
+
+	testSetUp();
+	sbgEComReaderSetPolicy(&gReader, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LOG_POLICY_DROP_OLDEST, TEST_MAX_DEPTH);
+	testStream(0, TEST_NUM_LOGS);
+
+	sbgEComReaderStart(&gReader, &gHandle);
+	passed = testWaitLogs(TEST_NUM_LOGS);
+	sbgEComReaderStop(&gReader);
+
+	sbgEComReaderGetLogStats(&gReader, SBG_ECOM_LOG_IMU_DATA, &logStats);
+	passed = passed && (logStats.numDropped == TEST_NUM_LOGS - TEST_MAX_DEPTH) && (logStats.depth == TEST_MAX_DEPTH);
+	passed = testPopRange(TEST_NUM_LOGS - TEST_MAX_DEPTH, TEST_MAX_DEPTH) && passed;
+
+	printf("%-40s %s: logs=%u dropped=%u depth=%u\n", "drop oldest policy", passed ? "passed" : "FAILED", logStats.numLogs, logStats.numDropped, logStats.depth);
+
+	testTearDown();
+
+	return passed;
+}
+
+/*!
+ *	With the coalesce policy, a single queued log is replaced by each new one.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCoalesce(void)
+{
+	SbgEComReaderLogStats	logStats;
+	bool					passed;
+
+	testSetUp();
+	sbgEComReaderSetPolicy(&gReader, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LOG_POLICY_COALESCE, 0);
+	testStream(0, TEST_NUM_LOGS);
+
+	sbgEComReaderStart(&gReader, &gHandle);
+	passed = testWaitLogs(TEST_NUM_LOGS);
+	sbgEComReaderStop(&gReader);
+
+	sbgEComReaderGetLogStats(&gReader, SBG_ECOM_LOG_IMU_DATA, &logStats);
+	passed = passed && (logStats.numCoalesced == TEST_NUM_LOGS - 1) && (logStats.numDropped == 0);
+	passed = testPopRange(TEST_NUM_LOGS - 1, 1) && passed;
+
+	printf("%-40s %s: logs=%u coalesced=%u\n", "coalesce policy", passed ? "passed" : "FAILED", logStats.numLogs, logStats.numCoalesced);
+
+	testTearDown();
+
+	return passed;
+}
+
+/*!
+ *	With the block policy, the reader thread waits for a slow consumer and no log is lost.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testBlock(void)
+{
+	SbgEComReaderLogStats	logStats;
+	SbgEComCmdId			logCmd;
+	SbgBinaryLogData		logData;
+	uint32					numPopped = 0;
+	uint32					numGarbage = 0;
+	uint32					i;
+	bool					passed;
+
+	testSetUp();
+	sbgEComReaderSetPolicy(&gReader, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LOG_POLICY_BLOCK, TEST_MAX_DEPTH);
+	testStream(0, TEST_NUM_BLOCKED_LOGS);
+
+	sbgEComReaderStart(&gReader, &gHandle);
+
+	//
+	// Pop the logs slower than the reader thread receives them
+	//
+	for (i = 0; (i < TEST_WAIT_TIME_OUT) && (numPopped < TEST_NUM_BLOCKED_LOGS); i++)
+	{
+		while (sbgEComReaderPop(&gReader, &logCmd, &logData) == SBG_NO_ERROR)
+		{
+			if ( (logCmd != SBG_ECOM_LOG_IMU_DATA) || (!sbgEComTestDeviceCheckImu(&logData.imuData, numPopped)) )
+			{
+				numGarbage++;
+			}
+
+			numPopped++;
+		}
+
+		sbgSleep(1);
+	}
+
+	sbgEComReaderStop(&gReader);
+	sbgEComReaderGetLogStats(&gReader, SBG_ECOM_LOG_IMU_DATA, &logStats);
+
+	passed = (numPopped == TEST_NUM_BLOCKED_LOGS) && (numGarbage == 0) && (logStats.numDropped == 0) && (logStats.numBlocked > 0);
+
+	printf("%-40s %s: popped=%u garbage=%u dropped=%u blocked=%u\n", "block policy", passed ? "passed" : "FAILED", numPopped, numGarbage, logStats.numDropped, logStats.numBlocked);
+
+	testTearDown();
+
+	return passed;
+}
+
+/*!
+ *	Stopping a reader thread blocked by a full queue must wake it up, the queued logs can still be popped.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testStopWhileBlocked(void)
+{
+	SbgEComReaderLogStats	logStats;
+	uint32					i;
+	bool					passed = FALSE;
+
+	testSetUp();
+	sbgEComReaderSetPolicy(&gReader, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LOG_POLICY_BLOCK, TEST_MAX_DEPTH);
+	testStream(0, TEST_NUM_LOGS);
+
+	sbgEComReaderStart(&gReader, &gHandle);
+
+	for (i = 0; (i < TEST_WAIT_TIME_OUT) && (!passed); i++)
+	{
+		sbgEComReaderGetLogStats(&gReader, SBG_ECOM_LOG_IMU_DATA, &logStats);
+		passed = (logStats.numBlocked > 0);
+		sbgSleep(1);
+	}
+
+	passed = passed && (sbgEComReaderStop(&gReader) == SBG_NO_ERROR) && (gReader.isRunning == 0);
+	passed = testPopRange(0, TEST_MAX_DEPTH) && passed;
+
+	//
+	// The sbgECom handle can be used again once the reader has been stopped
+	//
+	passed = passed && (gHandle.pReceiveCallback == NULL);
+
+	printf("%-40s %s: blocked=%u\n", "stop while blocked", passed ? "passed" : "FAILED", logStats.numBlocked);
+
+	testTearDown();
+
+	return passed;
+}
+
+/*!
+ *	Blocking commands sent from the consumer thread are answered while the reader thread dispatches logs.
+ *	Each answer is streamed after a batch of logs so the reader thread has to dispatch them first.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testCmdWhileDispatching(void)
+{
+	SbgEComReaderStats	stats;
+	uint32				sentValue;
+	uint32				answer[4];
+	uint32				answerSize;
+	uint32				numAnswers = 0;
+	uint32				i;
+	SbgErrorCode		errorCode;
+	bool				passed;
+
+	testSetUp();
+	sbgEComReaderSetPolicy(&gReader, SBG_ECOM_LOG_IMU_DATA, SBG_ECOM_LOG_POLICY_DROP_OLDEST, 0);
+	sbgEComReaderStart(&gReader, &gHandle);
+
+	for (i = 0; i < TEST_NUM_CMDS; i++)
+	{
+		testStream(i * TEST_LOGS_PER_CMD, TEST_LOGS_PER_CMD);
+
+		sentValue = i;
+		errorCode = sbgEComProtocolSend(&gHandle.protocolHandle, TEST_CMD, &sentValue, sizeof(sentValue));
+
+		if (errorCode == SBG_NO_ERROR)
+		{
+			errorCode = sbgEComReceiveCmd(&gHandle, TEST_CMD, answer, &answerSize, sizeof(answer), TEST_CMD_TIME_OUT);
+		}
+
+		if ( (errorCode == SBG_NO_ERROR) && (answerSize == sizeof(sentValue)) && (answer[0] == sentValue) )
+		{
+			numAnswers++;
+		}
+	}
+
+	passed = testWaitLogs(TEST_NUM_CMDS * TEST_LOGS_PER_CMD);
+	sbgEComReaderStop(&gReader);
+
+	sbgEComReaderGetStats(&gReader, &stats);
+	passed = passed && (numAnswers == TEST_NUM_CMDS) && (stats.numLogs == TEST_NUM_CMDS * TEST_LOGS_PER_CMD);
+
+	printf("%-40s %s: commands=%u answered=%u logs=%u\n", "command while dispatching", passed ? "passed" : "FAILED", TEST_NUM_CMDS, numAnswers, stats.numLogs);
+
+	testTearDown();
+
+	return passed;
+}
+
+/*!
+ *	A reader thread whose interface keeps failing must exit on its own and report the error once the queue is drained.
+ *	\return												TRUE if the test has passed.
+ */
+static bool testWaitError(void)
+{
+	SbgEComCmdId		logCmd;
+	SbgBinaryLogData	logData;
+	SbgErrorCode		errorCode = SBG_NOT_READY;
+	uint32				i;
+	bool				passed;
+
+	testSetUp();
+	gInterface.pWaitReadableFunc = testFailingWaitReadable;
+
+	sbgEComReaderStart(&gReader, &gHandle);
+
+	for (i = 0; (i < TEST_WAIT_TIME_OUT) && (errorCode == SBG_NOT_READY); i++)
+	{
+		errorCode = sbgEComReaderPop(&gReader, &logCmd, &logData);
+		sbgSleep(1);
+	}
+
+	passed = (errorCode == SBG_READ_ERROR) && (sbgEComReaderStop(&gReader) == SBG_NO_ERROR);
+
+	printf("%-40s %s: error=%s\n", "interface error", passed ? "passed" : "FAILED", SbgErrorCodeString[errorCode]);
+
+	testTearDown();
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	bool	passed = TRUE;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	gpDeviceLock = sbgPlatformMutexCreate();
+
+	passed &= testDropNewest();
+	passed &= testDropOldest();
+	passed &= testCoalesce();
+	passed &= testBlock();
+	passed &= testStopWhileBlocked();
+	passed &= testCmdWhileDispatching();
+	passed &= testWaitError();
+
+	sbgPlatformMutexDestroy(gpDeviceLock);
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,507 @@
+/*!
+ *	\file		sbgEComSchemaTest.c
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Regression tests of the table driven binary logs decoding.
+ *
+ *	Each payload is written field per field with the stream buffer, in the order the former
+ *	hand written parsers read them, while the expected log is filled with the same values.
+ *	The payload is then decoded by sbgEComBinaryLogParse and compared with the expected log.
+ *
+ *	The test is built twice by build.sh: once against the library, which uses the memcpy reads
+ *	on little endian hosts, and once with the binary logs sources built with SBG_ECOM_LOG_PORTABLE_READS.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#include <sbgECom.h>
+#include <binaryLogs/sbgEComBinaryLogSchema.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------//
+//- Definitions                                                        -//
+//----------------------------------------------------------------------//
+#define TEST_PAYLOAD_SIZE			(512)								/*!< Size of the payloads buffer. */
+#define TEST_NUM_EXTRA_BYTES		(3)									/*!< Number of bytes appended by a newer firmware after the known fields. */
+
+#ifdef SBG_ECOM_LOG_LITTLE_ENDIAN_HOST
+	#define TEST_READS_NAME			"memcpy"							/*!< Name of the tested reads. */
+#else
+	#define TEST_READS_NAME			"portable"							/*!< Name of the tested reads. */
+#endif
+
+/*!
+ *	Write a payload and fill the expected log with the written values.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							TRUE to write the optional fields or FALSE to expect their default values.
+ */
+typedef void (*TestBuildFunc)(SbgBinaryLogData *pExpected, bool withOptional);
+
+/*!
+ * Payload decoded by a test case.
+ */
+typedef struct _TestCase
+{
+	const char		*pName;												/*!< Test case name. */
+	uint16			 logId;												/*!< Binary log id given to sbgEComBinaryLogParse. */
+	TestBuildFunc	 pBuildFunc;										/*!< Function that writes the payload. */
+	bool			 withOptional;										/*!< TRUE if the optional fields are written. */
+	uint32			 numExtraBytes;										/*!< Number of unknown bytes appended to the payload. */
+	uint32			 expectedSize;										/*!< Expected payload size before the extra bytes. */
+} TestCase;
+
+//----------------------------------------------------------------------//
+//- Private variables                                                  -//
+//----------------------------------------------------------------------//
+
+static SbgStreamBuffer		gStream;
+static uint8				gPayload[TEST_PAYLOAD_SIZE];
+static uint32				gSeed;
+
+//----------------------------------------------------------------------//
+//- Fields writes                                                      -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Returns the next pseudo random value so every byte of every field is different.
+ *	\return												Pseudo random value.
+ */
+static uint32 testNextValue(void)
+{
+	gSeed = gSeed * 1103515245 + 12345;
+
+	return gSeed;
+}
+
+/*!
+ *	Write an unsigned 8 bits field.
+ *	\param[out]	pField									Expected field value.
+ */
+static void testWriteUint8(uint8 *pField)
+{
+	*pField = (uint8)(testNextValue() >> 16);
+	sbgStreamBufferWriteUint8(&gStream, *pField);
+}
+
+/*!
+ *	Write a signed 8 bits field.
+ *	\param[out]	pField									Expected field value.
+ */
+static void testWriteInt8(int8 *pField)
+{
+	*pField = (int8)(testNextValue() >> 16);
+	sbgStreamBufferWriteInt8(&gStream, *pField);
+}
+
+/*!
+ *	Write an unsigned 16 bits field.
+ *	\param[out]	pField									Expected field value.
+ */
+static void testWriteUint16(uint16 *pField)
+{
+	*pField = (uint16)(testNextValue() >> 8);
+	sbgStreamBufferWriteUint16LE(&gStream, *pField);
+}
+
+/*!
+ *	Write an unsigned 32 bits field.
+ *	\param[out]	pField									Expected field value.
+ */
+static void testWriteUint32(uint32 *pField)
+{
+	*pField = testNextValue();
+	sbgStreamBufferWriteUint32LE(&gStream, *pField);
+}
+
+/*!
+ *	Write a signed 32 bits field.
+ *	\param[out]	pField									Expected field value.
+ */
+static void testWriteInt32(int32 *pField)
+{
+	*pField = (int32)testNextValue();
+	sbgStreamBufferWriteInt32LE(&gStream, *pField);
+}
+
+/*!
+ *	Write an array of 32 bits floating point fields.
+ *	\param[out]	pFields									Expected fields values.
+ *	\param[in]	count									Number of fields.
+ */
+static void testWriteFloats(float *pFields, uint32 count)
+{
+	uint32	i;
+
+	for (i = 0; i < count; i++)
+	{
+		pFields[i] = (float)(int32)testNextValue() / 1024.0f;
+		sbgStreamBufferWriteFloatLE(&gStream, pFields[i]);
+	}
+}
+
+/*!
+ *	Write a 64 bits floating point field.
+ *	\param[out]	pField									Expected field value.
+ */
+static void testWriteDouble(double *pField)
+{
+	*pField = (double)(int32)testNextValue() / 3.0;
+	sbgStreamBufferWriteDoubleLE(&gStream, *pField);
+}
+
+//----------------------------------------------------------------------//
+//- Payloads                                                           -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Write a SBG_ECOM_LOG_DEBUG_0 payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildDebug0(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->debug0Data.timeStamp);
+	testWriteFloats(pExpected->debug0Data.data, 64);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_DVL_BOTTOM_TRACK payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildDvl(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->dvlData.timeStamp);
+	testWriteUint16(&pExpected->dvlData.status);
+	testWriteFloats(pExpected->dvlData.velocity, 3);
+	testWriteFloats(pExpected->dvlData.velocityStdDev, 3);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_EVENT_A payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildEvent(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->eventMarker.timeStamp);
+	testWriteUint16(&pExpected->eventMarker.status);
+	testWriteUint16(&pExpected->eventMarker.timeOffset0);
+	testWriteUint16(&pExpected->eventMarker.timeOffset1);
+	testWriteUint16(&pExpected->eventMarker.timeOffset2);
+	testWriteUint16(&pExpected->eventMarker.timeOffset3);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_GPS1_VEL payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildGpsVel(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->gpsVelData.timeStamp);
+	testWriteUint32(&pExpected->gpsVelData.status);
+	testWriteUint32(&pExpected->gpsVelData.timeOfWeek);
+	testWriteFloats(pExpected->gpsVelData.velocity, 3);
+	testWriteFloats(pExpected->gpsVelData.velocityAcc, 3);
+	testWriteFloats(&pExpected->gpsVelData.course, 1);
+	testWriteFloats(&pExpected->gpsVelData.courseAcc, 1);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_GPS1_POS payload, the legacy payload doesn't contain the satellites and base station information.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							TRUE to write the satellites and base station information.
+ */
+static void testBuildGpsPos(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	testWriteUint32(&pExpected->gpsPosData.timeStamp);
+	testWriteUint32(&pExpected->gpsPosData.status);
+	testWriteUint32(&pExpected->gpsPosData.timeOfWeek);
+	testWriteDouble(&pExpected->gpsPosData.latitude);
+	testWriteDouble(&pExpected->gpsPosData.longitude);
+	testWriteDouble(&pExpected->gpsPosData.altitude);
+	testWriteFloats(&pExpected->gpsPosData.undulation, 1);
+	testWriteFloats(&pExpected->gpsPosData.latitudeAccuracy, 1);
+	testWriteFloats(&pExpected->gpsPosData.longitudeAccuracy, 1);
+	testWriteFloats(&pExpected->gpsPosData.altitudeAccuracy, 1);
+
+	if (withOptional)
+	{
+		testWriteUint8(&pExpected->gpsPosData.numSvUsed);
+		testWriteUint16(&pExpected->gpsPosData.baseStationId);
+		testWriteUint16(&pExpected->gpsPosData.differentialAge);
+	}
+	else
+	{
+		pExpected->gpsPosData.numSvUsed = 0;
+		pExpected->gpsPosData.baseStationId = 0xFFFF;
+		pExpected->gpsPosData.differentialAge = 0xFFFF;
+	}
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_GPS1_HDT payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildGpsHdt(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->gpsHdtData.timeStamp);
+	testWriteUint16(&pExpected->gpsHdtData.status);
+	testWriteUint32(&pExpected->gpsHdtData.timeOfWeek);
+	testWriteFloats(&pExpected->gpsHdtData.heading, 1);
+	testWriteFloats(&pExpected->gpsHdtData.headingAccuracy, 1);
+	testWriteFloats(&pExpected->gpsHdtData.pitch, 1);
+	testWriteFloats(&pExpected->gpsHdtData.pitchAccuracy, 1);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_MAG payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildMag(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->magData.timeStamp);
+	testWriteUint16(&pExpected->magData.status);
+	testWriteFloats(pExpected->magData.magnetometers, 3);
+	testWriteFloats(pExpected->magData.accelerometers, 3);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_MAG_CALIB payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildMagCalib(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	uint32	i;
+
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->magCalibData.timeStamp);
+	testWriteUint16(&pExpected->magCalibData.reserved);
+
+	for (i = 0; i < 16; i++)
+	{
+		testWriteUint8(&pExpected->magCalibData.magData[i]);
+	}
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_ODO_VEL payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildOdometer(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->odometerData.timeStamp);
+	testWriteUint16(&pExpected->odometerData.status);
+	testWriteFloats(&pExpected->odometerData.velocity, 1);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_PRESSURE payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildPressure(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->pressureData.timeStamp);
+	testWriteUint16(&pExpected->pressureData.status);
+	testWriteFloats(&pExpected->pressureData.pressure, 1);
+	testWriteFloats(&pExpected->pressureData.height, 1);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_SHIP_MOTION_0 payload, the legacy payload doesn't contain the velocities and the status.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							TRUE to write the velocities and the status.
+ */
+static void testBuildShipMotion(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	testWriteUint32(&pExpected->shipMotionData.timeStamp);
+	testWriteFloats(&pExpected->shipMotionData.mainHeavePeriod, 1);
+	testWriteFloats(pExpected->shipMotionData.shipMotion, 3);
+	testWriteFloats(pExpected->shipMotionData.shipAccel, 3);
+
+	if (withOptional)
+	{
+		testWriteFloats(pExpected->shipMotionData.shipVel, 3);
+		testWriteUint16(&pExpected->shipMotionData.status);
+	}
+	else
+	{
+		pExpected->shipMotionData.shipVel[0] = 0.0f;
+		pExpected->shipMotionData.shipVel[1] = 0.0f;
+		pExpected->shipMotionData.shipVel[2] = 0.0f;
+		pExpected->shipMotionData.status = 0;
+	}
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_USBL payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildUsbl(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->usblData.timeStamp);
+	testWriteUint16(&pExpected->usblData.status);
+	testWriteDouble(&pExpected->usblData.latitude);
+	testWriteDouble(&pExpected->usblData.longitude);
+	testWriteFloats(&pExpected->usblData.depth, 1);
+	testWriteFloats(&pExpected->usblData.latitudeAccuracy, 1);
+	testWriteFloats(&pExpected->usblData.longitudeAccuracy, 1);
+	testWriteFloats(&pExpected->usblData.depthAccuracy, 1);
+}
+
+/*!
+ *	Write a SBG_ECOM_LOG_UTC_TIME payload.
+ *	\param[out]	pExpected								Expected log.
+ *	\param[in]	withOptional							Unused.
+ */
+static void testBuildUtc(SbgBinaryLogData *pExpected, bool withOptional)
+{
+	SBG_UNUSED_PARAMETER(withOptional);
+
+	testWriteUint32(&pExpected->utcData.timeStamp);
+	testWriteUint16(&pExpected->utcData.status);
+	testWriteUint16(&pExpected->utcData.year);
+	testWriteInt8(&pExpected->utcData.month);
+	testWriteInt8(&pExpected->utcData.day);
+	testWriteInt8(&pExpected->utcData.hour);
+	testWriteInt8(&pExpected->utcData.minute);
+	testWriteInt8(&pExpected->utcData.second);
+	testWriteInt32(&pExpected->utcData.nanoSecond);
+	testWriteUint32(&pExpected->utcData.gpsTimeOfWeek);
+}
+
+//----------------------------------------------------------------------//
+//- Tests                                                              -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Test cases, the legacy payloads of the logs with optional fields are decoded with the default values.
+ */
+static const TestCase gTestCases[] =
+{
+	{ "DEBUG_0",					SBG_ECOM_LOG_DEBUG_0,			testBuildDebug0,		FALSE,	0,						260	},
+	{ "DVL_BOTTOM_TRACK",			SBG_ECOM_LOG_DVL_BOTTOM_TRACK,	testBuildDvl,			FALSE,	0,						30	},
+	{ "EVENT_A",					SBG_ECOM_LOG_EVENT_A,			testBuildEvent,			FALSE,	0,						14	},
+	{ "GPS1_VEL",					SBG_ECOM_LOG_GPS1_VEL,			testBuildGpsVel,		FALSE,	0,						44	},
+	{ "GPS1_POS",					SBG_ECOM_LOG_GPS1_POS,			testBuildGpsPos,		TRUE,	0,						57	},
+	{ "GPS1_POS legacy",			SBG_ECOM_LOG_GPS1_POS,			testBuildGpsPos,		FALSE,	0,						52	},
+	{ "GPS1_POS legacy + 1 byte",	SBG_ECOM_LOG_GPS1_POS,			testBuildGpsPos,		FALSE,	1,						52	},
+	{ "GPS1_POS + extra bytes",		SBG_ECOM_LOG_GPS1_POS,			testBuildGpsPos,		TRUE,	TEST_NUM_EXTRA_BYTES,	57	},
+	{ "GPS1_HDT",					SBG_ECOM_LOG_GPS1_HDT,			testBuildGpsHdt,		FALSE,	0,						26	},
+	{ "MAG",						SBG_ECOM_LOG_MAG,				testBuildMag,			FALSE,	0,						30	},
+	{ "MAG_CALIB",					SBG_ECOM_LOG_MAG_CALIB,			testBuildMagCalib,		FALSE,	0,						22	},
+	{ "ODO_VEL",					SBG_ECOM_LOG_ODO_VEL,			testBuildOdometer,		FALSE,	0,						10	},
+	{ "PRESSURE",					SBG_ECOM_LOG_PRESSURE,			testBuildPressure,		FALSE,	0,						14	},
+	{ "SHIP_MOTION",				SBG_ECOM_LOG_SHIP_MOTION_0,		testBuildShipMotion,	TRUE,	0,						46	},
+	{ "SHIP_MOTION legacy",			SBG_ECOM_LOG_SHIP_MOTION_0,		testBuildShipMotion,	FALSE,	0,						32	},
+	{ "SHIP_MOTION legacy + 1 byte",	SBG_ECOM_LOG_SHIP_MOTION_0,		testBuildShipMotion,	FALSE,	1,						32	},
+	{ "SHIP_MOTION + extra bytes",	SBG_ECOM_LOG_SHIP_MOTION_0,		testBuildShipMotion,	TRUE,	TEST_NUM_EXTRA_BYTES,	46	},
+	{ "USBL",						SBG_ECOM_LOG_USBL,				testBuildUsbl,			FALSE,	0,						38	},
+	{ "UTC_TIME",					SBG_ECOM_LOG_UTC_TIME,			testBuildUtc,			FALSE,	0,						21	},
+};
+
+/*!
+ *	Write the payload of a test case, decode it and compare the decoded log with the expected one.
+ *	A payload that doesn't contain all the optional fields must still contain the required ones, it is rejected if one byte is missing.
+ *	\param[in]	pTestCase								Test case to run.
+ *	\return												TRUE if the test case has passed.
+ */
+static bool testRun(const TestCase *pTestCase)
+{
+	SbgBinaryLogData	expected;
+	SbgBinaryLogData	decoded;
+	uint32				payloadSize;
+	uint32				i;
+	SbgErrorCode		errorCode;
+	SbgErrorCode		shortErrorCode = SBG_INVALID_FRAME;
+	bool				passed;
+
+	//
+	// Padding bytes are left untouched by both the test and the parser so the logs can be compared as a whole
+	//
+	memset(&expected, 0x00, sizeof(expected));
+
+	sbgStreamBufferInitForWrite(&gStream, gPayload, sizeof(gPayload));
+	pTestCase->pBuildFunc(&expected, pTestCase->withOptional);
+	payloadSize = sbgStreamBufferGetLength(&gStream);
+
+	if (!pTestCase->withOptional)
+	{
+		shortErrorCode = sbgEComBinaryLogParse(pTestCase->logId, gPayload, payloadSize - 1, &decoded);
+	}
+
+	for (i = 0; i < pTestCase->numExtraBytes; i++)
+	{
+		sbgStreamBufferWriteUint8(&gStream, 0xA5);
+	}
+
+	memset(&decoded, 0x00, sizeof(decoded));
+	errorCode = sbgEComBinaryLogParse(pTestCase->logId, gPayload, sbgStreamBufferGetLength(&gStream), &decoded);
+
+	passed = (payloadSize == pTestCase->expectedSize) && (errorCode == SBG_NO_ERROR) && (shortErrorCode != SBG_NO_ERROR) && (memcmp(&expected, &decoded, sizeof(expected)) == 0);
+
+	printf("%-9s %-30s %s: payload=%u bytes\n", TEST_READS_NAME, pTestCase->pName, passed ? "passed" : "FAILED", payloadSize);
+
+	return passed;
+}
+
+//----------------------------------------------------------------------//
+//- Main program                                                       -//
+//----------------------------------------------------------------------//
+
+int main(int argc, char** argv)
+{
+	bool	passed = TRUE;
+	uint32	i;
+
+	SBG_UNUSED_PARAMETER(argc);
+	SBG_UNUSED_PARAMETER(argv);
+
+	gSeed = 1;
+
+	for (i = 0; i < sizeof(gTestCases) / sizeof(gTestCases[0]); i++)
+	{
+		passed &= testRun(&gTestCases[i]);
+	}
+
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,283 @@
+#include "sbgEComTestDevice.h"
+#include <crc/sbgCrc.h>
+#include <streamBuffer/sbgStreamBuffer.h>
+
+//----------------------------------------------------------------------//
+//- Private methods declarations                                       -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Returns the IMU field value derived from a sequence number.
+ *	\param[in]	sequence								Sequence number of the IMU log.
+ *	\param[in]	field									Index of the float field in the IMU log.
+ *	\return												Field value.
+ */
+static float sbgEComTestDeviceImuValue(uint32 sequence, uint32 field)
+{
+	return (float)(sequence % 100000) + (float)field * 0.25f;
+}
+
+/*!
+ *	Read function of the simulated device interface.
+ *	\param[in]	pHandle									The simulated device interface.
+ *	\param[out]	pBuffer									Buffer used to return the read bytes.
+ *	\param[out]	pReadBytes								Number of bytes read.
+ *	\param[in]	bytesToRead								Maximum number of bytes to read.
+ *	\return												Always SBG_NO_ERROR.
+ */
+static SbgErrorCode sbgEComTestDeviceRead(SbgInterface *pHandle, void *pBuffer, uint32 *pReadBytes, uint32 bytesToRead)
+{
+	SbgEComTestDevice	*pDevice = (SbgEComTestDevice*)pHandle->handle;
+	uint32				 numBytes;
+
+	numBytes = pDevice->writeIndex - pDevice->readIndex;
+
+	if (numBytes > bytesToRead)
+	{
+		numBytes = bytesToRead;
+	}
+
+	if (numBytes > pDevice->maxReadSize)
+	{
+		numBytes = pDevice->maxReadSize;
+	}
+
+	memcpy(pBuffer, pDevice->stream + pDevice->readIndex, numBytes);
+	pDevice->readIndex += numBytes;
+	pDevice->numReads++;
+
+	//
+	// Start over from the stream beginning once everything has been read
+	//
+	if (pDevice->readIndex == pDevice->writeIndex)
+	{
+		pDevice->readIndex = 0;
+		pDevice->writeIndex = 0;
+	}
+
+	*pReadBytes = numBytes;
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Write function of the simulated device interface, each written frame is decoded and given to the command callback.
+ *	The sbgECom protocol always writes a complete frame at once.
+ *	\param[in]	pHandle									The simulated device interface.
+ *	\param[in]	pBuffer									Written frame.
+ *	\param[in]	bytesToWrite							Frame size in bytes.
+ *	\return												SBG_NO_ERROR if the frame is valid.
+ */
+static SbgErrorCode sbgEComTestDeviceWrite(SbgInterface *pHandle, const void *pBuffer, uint32 bytesToWrite)
+{
+	SbgEComTestDevice	*pDevice = (SbgEComTestDevice*)pHandle->handle;
+	const uint8			*pFrame = (const uint8*)pBuffer;
+	uint16				 cmd;
+	uint32				 payloadSize;
+
+	if ( (bytesToWrite < 9) || (pFrame[0] != SBG_ECOM_SYNC_1) || (pFrame[1] != SBG_ECOM_SYNC_2) )
+	{
+		return SBG_INVALID_FRAME;
+	}
+
+	cmd = (uint16)(pFrame[2] | (pFrame[3] << 8));
+	payloadSize = (uint32)(pFrame[4] | (pFrame[5] << 8));
+
+	if (payloadSize + 9 != bytesToWrite)
+	{
+		return SBG_INVALID_FRAME;
+	}
+
+	pDevice->numFramesWritten++;
+
+	if (pDevice->pCmdFunc)
+	{
+		pDevice->pCmdFunc(pDevice, cmd, pFrame + 6, payloadSize, pDevice->pUserArg);
+	}
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Wait readable function of the simulated device interface, the device never sends anything on its own.
+ *	\param[in]	pHandle									The simulated device interface.
+ *	\param[in]	timeOut									Unused.
+ *	\return												SBG_NO_ERROR if some bytes can be read or SBG_TIME_OUT otherwise.
+ */
+static SbgErrorCode sbgEComTestDeviceWaitReadable(SbgInterface *pHandle, uint32 timeOut)
+{
+	SbgEComTestDevice	*pDevice = (SbgEComTestDevice*)pHandle->handle;
+
+	SBG_UNUSED_PARAMETER(timeOut);
+
+	return (pDevice->writeIndex != pDevice->readIndex) ? SBG_NO_ERROR : SBG_TIME_OUT;
+}
+
+//----------------------------------------------------------------------//
+//- Public methods definitions                                         -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize a simulated device with an empty stream.
+ *	\param[in]	pDevice									Simulated device to initialize.
+ *	\param[in]	maxReadSize								Maximum number of bytes returned by each read.
+ */
+void sbgEComTestDeviceInit(SbgEComTestDevice *pDevice, uint32 maxReadSize)
+{
+	sbgInterfaceZeroInit(&pDevice->interface);
+
+	pDevice->interface.handle = pDevice;
+	pDevice->interface.pReadFunc = sbgEComTestDeviceRead;
+	pDevice->interface.pWriteFunc = sbgEComTestDeviceWrite;
+	pDevice->interface.pWaitReadableFunc = sbgEComTestDeviceWaitReadable;
+
+	pDevice->readIndex = 0;
+	pDevice->writeIndex = 0;
+	pDevice->maxReadSize = maxReadSize;
+	pDevice->pCmdFunc = NULL;
+	pDevice->pUserArg = NULL;
+	pDevice->numReads = 0;
+	pDevice->numFramesWritten = 0;
+}
+
+/*!
+ *	Define the callback called for each frame written by the host.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	pCmdFunc								Callback or NULL to ignore the written frames.
+ *	\param[in]	pUserArg								Optional user argument given to the callback.
+ */
+void sbgEComTestDeviceSetCmdCallback(SbgEComTestDevice *pDevice, SbgEComTestDeviceCmdFunc pCmdFunc, void *pUserArg)
+{
+	pDevice->pCmdFunc = pCmdFunc;
+	pDevice->pUserArg = pUserArg;
+}
+
+/*!
+ *	Append a complete frame to the stream read by the host.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	cmd										Command id, built with SBG_ECOM_BUILD_ID for extended classes.
+ *	\param[in]	pPayload								Payload or NULL if payloadSize is 0.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\return												SBG_NO_ERROR if the frame has been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComTestDeviceSendFrame(SbgEComTestDevice *pDevice, uint16 cmd, const void *pPayload, uint32 payloadSize)
+{
+	uint8	*pFrame;
+	uint16	 crc;
+
+	if ( (payloadSize > SBG_ECOM_MAX_PAYLOAD_SIZE) || (pDevice->writeIndex + payloadSize + 9 > SBG_ECOM_TEST_DEVICE_STREAM_SIZE) )
+	{
+		return SBG_BUFFER_OVERFLOW;
+	}
+
+	pFrame = pDevice->stream + pDevice->writeIndex;
+
+	pFrame[0] = SBG_ECOM_SYNC_1;
+	pFrame[1] = SBG_ECOM_SYNC_2;
+	pFrame[2] = (uint8)cmd;
+	pFrame[3] = (uint8)(cmd >> 8);
+	pFrame[4] = (uint8)payloadSize;
+	pFrame[5] = (uint8)(payloadSize >> 8);
+
+	if (payloadSize > 0)
+	{
+		memcpy(pFrame + 6, pPayload, payloadSize);
+	}
+
+	//
+	// The CRC covers the command, the length and the payload
+	//
+	crc = sbgCrc16Compute(pFrame + 2, payloadSize + 4);
+
+	pFrame[payloadSize + 6] = (uint8)crc;
+	pFrame[payloadSize + 7] = (uint8)(crc >> 8);
+	pFrame[payloadSize + 8] = SBG_ECOM_ETX;
+
+	pDevice->writeIndex += payloadSize + 9;
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Append raw bytes, such as line noise, to the stream read by the host.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	pBuffer									Bytes to append.
+ *	\param[in]	size									Number of bytes to append.
+ *	\return												SBG_NO_ERROR if the bytes have been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComTestDeviceSendBytes(SbgEComTestDevice *pDevice, const void *pBuffer, uint32 size)
+{
+	if (pDevice->writeIndex + size > SBG_ECOM_TEST_DEVICE_STREAM_SIZE)
+	{
+		return SBG_BUFFER_OVERFLOW;
+	}
+
+	memcpy(pDevice->stream + pDevice->writeIndex, pBuffer, size);
+	pDevice->writeIndex += size;
+
+	return SBG_NO_ERROR;
+}
+
+/*!
+ *	Append an SBG_ECOM_LOG_IMU_DATA frame whose fields are all derived from a sequence number.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	sequence								Sequence number stored in the time stamp.
+ *	\return												SBG_NO_ERROR if the frame has been appended.
+ */
+SbgErrorCode sbgEComTestDeviceSendImu(SbgEComTestDevice *pDevice, uint32 sequence)
+{
+	uint8			payload[58];
+	SbgStreamBuffer	outputStream;
+	uint32			i;
+
+	sbgStreamBufferInitForWrite(&outputStream, payload, sizeof(payload));
+
+	sbgStreamBufferWriteUint32LE(&outputStream, sequence);
+	sbgStreamBufferWriteUint16LE(&outputStream, (uint16)sequence);
+
+	for (i = 0; i < 13; i++)
+	{
+		sbgStreamBufferWriteFloatLE(&outputStream, sbgEComTestDeviceImuValue(sequence, i));
+	}
+
+	return sbgEComTestDeviceSendFrame(pDevice, SBG_ECOM_LOG_IMU_DATA, payload, sizeof(payload));
+}
+
+/*!
+ *	Check that an IMU log has been built by sbgEComTestDeviceSendImu with a given sequence number.
+ *	\param[in]	pImuData								Parsed IMU log.
+ *	\param[in]	sequence								Expected sequence number.
+ *	\return												TRUE if all the fields match the sequence number.
+ */
+bool sbgEComTestDeviceCheckImu(const SbgLogImuData *pImuData, uint32 sequence)
+{
+	uint32	i;
+
+	if ( (pImuData->timeStamp != sequence) || (pImuData->status != (uint16)sequence) )
+	{
+		return FALSE;
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		if ( (pImuData->accelerometers[i] != sbgEComTestDeviceImuValue(sequence, i)) ||
+			 (pImuData->gyroscopes[i] != sbgEComTestDeviceImuValue(sequence, 3 + i)) ||
+			 (pImuData->deltaVelocity[i] != sbgEComTestDeviceImuValue(sequence, 7 + i)) ||
+			 (pImuData->deltaAngle[i] != sbgEComTestDeviceImuValue(sequence, 10 + i)) )
+		{
+			return FALSE;
+		}
+	}
+
+	return (pImuData->temperature == sbgEComTestDeviceImuValue(sequence, 6));
+}
+
+/*!
+ *	Returns the number of bytes that haven't been read by the host yet.
+ *	\param[in]	pDevice									The simulated device.
+ *	\return												Number of pending bytes.
+ */
+uint32 sbgEComTestDeviceGetPendingBytes(const SbgEComTestDevice *pDevice)
+{
+	return pDevice->writeIndex - pDevice->readIndex;
+}
@@ -0,0 +1,143 @@
+/*!
+ *	\file		sbgEComTestDevice.h
+ *  \author		SBG Systems
+ *	\date		18 October 2026
+ *
+ *	\brief		Simulated device interface used by the sbgECom tests and benchmarks.
+ *
+ *	The simulated device is an SbgInterface that reads from an in memory stream.
+ *	Frames are appended to the stream by the test itself, and each frame written by
+ *	the host is decoded and given to an optional command callback that can answer it.
+ *
+ *	Each read returns at most maxReadSize bytes so frames are split across reads and
+ *	wrap around the sbgECom reception buffer like on a real serial port.
+ *	The device isn't thread safe and should only be used from one thread.
+ *
+ *	\section CodeCopyright Copyright Notice
+ *	Copyright (C) 2007-2013, SBG Systems SAS. All rights reserved.
+ *
+ *	This source code is intended for use only by SBG Systems SAS and
+ *	those that have explicit written permission to use it from
+ *	SBG Systems SAS.
+ *
+ *	THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ *	KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ *	IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ *	PARTICULAR PURPOSE.
+ */
+
+#ifndef __SBG_ECOM_TEST_DEVICE_H__
+#define __SBG_ECOM_TEST_DEVICE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sbgECom.h>
+
+//----------------------------------------------------------------------//
+//- Global definitions                                                 -//
+//----------------------------------------------------------------------//
+#define SBG_ECOM_TEST_DEVICE_STREAM_SIZE		(1024*1024)					/*!< Maximum number of bytes the simulated device can hold for the host. */
+
+//----------------------------------------------------------------------//
+//- Structures definitions                                             -//
+//----------------------------------------------------------------------//
+
+typedef struct _SbgEComTestDevice SbgEComTestDevice;
+
+/*!
+ *	Callback called for each frame written by the host.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	cmd										Received command id.
+ *	\param[in]	pPayload								Received payload.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\param[in]	pUserArg								Optional user argument.
+ */
+typedef void (*SbgEComTestDeviceCmdFunc)(SbgEComTestDevice *pDevice, uint16 cmd, const uint8 *pPayload, uint32 payloadSize, void *pUserArg);
+
+/*!
+ * Simulated device, this structure is quite large and should not be allocated on the stack.
+ */
+struct _SbgEComTestDevice
+{
+	SbgInterface				 interface;					/*!< Interface given to sbgEComInit. */
+	uint8						 stream[SBG_ECOM_TEST_DEVICE_STREAM_SIZE];	/*!< Bytes sent by the device and not yet read by the host. */
+	uint32						 readIndex;					/*!< Position of the next byte read by the host. */
+	uint32						 writeIndex;				/*!< Position of the next byte sent by the device. */
+	uint32						 maxReadSize;				/*!< Maximum number of bytes returned by each read. */
+	SbgEComTestDeviceCmdFunc	 pCmdFunc;					/*!< Optional callback called for each frame written by the host. */
+	void						*pUserArg;					/*!< Optional user argument given to pCmdFunc. */
+	uint32						 numReads;					/*!< Number of read calls. */
+	uint32						 numFramesWritten;			/*!< Number of frames written by the host. */
+};
+
+//----------------------------------------------------------------------//
+//- Public methods declarations                                        -//
+//----------------------------------------------------------------------//
+
+/*!
+ *	Initialize a simulated device with an empty stream.
+ *	\param[in]	pDevice									Simulated device to initialize.
+ *	\param[in]	maxReadSize								Maximum number of bytes returned by each read.
+ */
+void sbgEComTestDeviceInit(SbgEComTestDevice *pDevice, uint32 maxReadSize);
+
+/*!
+ *	Define the callback called for each frame written by the host.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	pCmdFunc								Callback or NULL to ignore the written frames.
+ *	\param[in]	pUserArg								Optional user argument given to the callback.
+ */
+void sbgEComTestDeviceSetCmdCallback(SbgEComTestDevice *pDevice, SbgEComTestDeviceCmdFunc pCmdFunc, void *pUserArg);
+
+/*!
+ *	Append a complete frame to the stream read by the host.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	cmd										Command id, built with SBG_ECOM_BUILD_ID for extended classes.
+ *	\param[in]	pPayload								Payload or NULL if payloadSize is 0.
+ *	\param[in]	payloadSize								Payload size in bytes.
+ *	\return												SBG_NO_ERROR if the frame has been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComTestDeviceSendFrame(SbgEComTestDevice *pDevice, uint16 cmd, const void *pPayload, uint32 payloadSize);
+
+/*!
+ *	Append raw bytes, such as line noise, to the stream read by the host.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	pBuffer									Bytes to append.
+ *	\param[in]	size									Number of bytes to append.
+ *	\return												SBG_NO_ERROR if the bytes have been appended or SBG_BUFFER_OVERFLOW if the stream is full.
+ */
+SbgErrorCode sbgEComTestDeviceSendBytes(SbgEComTestDevice *pDevice, const void *pBuffer, uint32 size);
+
+/*!
+ *	Append an SBG_ECOM_LOG_IMU_DATA frame whose fields are all derived from a sequence number.
+ *	\param[in]	pDevice									The simulated device.
+ *	\param[in]	sequence								Sequence number stored in the time stamp.
+ *	\return												SBG_NO_ERROR if the frame has been appended.
+ */
+SbgErrorCode sbgEComTestDeviceSendImu(SbgEComTestDevice *pDevice, uint32 sequence);
+
+/*!
+ *	Check that an IMU log has been built by sbgEComTestDeviceSendImu with a given sequence number.
+ *	\param[in]	pImuData								Parsed IMU log.
+ *	\param[in]	sequence								Expected sequence number.
+ *	\return												TRUE if all the fields match the sequence number.
+ */
+bool sbgEComTestDeviceCheckImu(const SbgLogImuData *pImuData, uint32 sequence);
+
+/*!
+ *	Returns the number of bytes that haven't been read by the host yet.
+ *	\param[in]	pDevice									The simulated device.
+ *	\return												Number of pending bytes.
+ */
+uint32 sbgEComTestDeviceGetPendingBytes(const SbgEComTestDevice *pDevice);
+
+//----------------------------------------------------------------------//
+//- Footer (close extern C block)                                      -//
+//----------------------------------------------------------------------//
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SBG_ECOM_TEST_DEVICE_H__ */